@@ -111,6 +111,7 @@ add_library(core
   fboss/agent/L2Entry.cpp
   fboss/agent/LacpController.cpp
   fboss/agent/LacpMachines.cpp
+  fboss/agent/LacpScheduler.cpp
   fboss/agent/LacpTypes.cpp
   fboss/agent/LinkAggregationManager.cpp
   fboss/agent/LldpManager.cpp
@@ -125,6 +126,8 @@ add_library(core
   fboss/agent/MirrorManagerImpl.cpp
   fboss/agent/MPLSHandler.cpp
   fboss/agent/NdpCache.cpp
+  fboss/agent/NeighborResolutionLimiter.cpp
+  fboss/agent/NeighborTimerWheel.cpp
   fboss/agent/NeighborUpdater.cpp
   fboss/agent/NeighborUpdaterImpl.cpp
   fboss/agent/PhySnapshotManager.cpp
@@ -133,17 +136,21 @@ add_library(core
   fboss/agent/ResolvedNexthopProbe.cpp
   fboss/agent/ResolvedNexthopProbeScheduler.cpp
   fboss/agent/RestartTimeTracker.cpp
+  fboss/agent/RouteChangeTracker.cpp
+  fboss/agent/RouteUpdateBatcher.cpp
   fboss/agent/RouteUpdateLogger.cpp
   fboss/agent/RouteUpdateLoggingPrefixTracker.cpp
   fboss/agent/RouteUpdateWrapper.cpp
   fboss/agent/StaticL2ForNeighborObserver.cpp
   fboss/agent/StaticL2ForNeighborUpdater.cpp
   fboss/agent/StaticL2ForNeighborSwSwitchUpdater.cpp
+  fboss/agent/StateUpdateTracer.cpp
   fboss/agent/SwSwitch.cpp
   fboss/agent/SwSwitchRouteUpdateWrapper.cpp
   fboss/agent/ThreadHeartbeat.cpp
   fboss/agent/TunIntf.cpp
   fboss/agent/TunManager.cpp
+  fboss/agent/TxPacketTemplate.cpp
   fboss/agent/ndp/IPv6RouteAdvertiser.cpp
   fboss/agent/oss/RouteUpdateLogger.cpp
   fboss/agent/oss/SwSwitch.cpp
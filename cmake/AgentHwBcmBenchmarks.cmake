@@ -303,6 +303,47 @@ target_link_libraries(bcm_rib_sync_fib_speed
   Folly::follybenchmark
 )
 
+add_executable(bcm_acl_change_speed /dev/null)
+
+target_link_libraries(bcm_acl_change_speed
+  -Wl,--whole-archive
+  bcm
+  config
+  bcm_switch_ensemble
+  config_factory
+  hw_acl_change_speed
+  -Wl,--no-whole-archive
+  hw_benchmark_main
+  Folly::folly
+  ${OPENNSA}
+  Folly::follybenchmark
+)
+
+add_executable(bcm_prod_config_reload_speed /dev/null)
+
+target_link_libraries(bcm_prod_config_reload_speed
+  -Wl,--whole-archive
+  bcm
+  config
+  bcm_switch_ensemble
+  hw_prod_config_reload_speed
+  -Wl,--no-whole-archive
+  hw_benchmark_main
+  Folly::folly
+  ${OPENNSA}
+  Folly::follybenchmark
+)
+
+add_executable(bcm_sflow_export_speed
+  fboss/agent/hw/bcm/tests/BcmSflowExporterBenchmark.cpp
+)
+
+target_link_libraries(bcm_sflow_export_speed
+  bcm
+  ${OPENNSA}
+  Folly::folly
+)
+
 if (BENCHMARK_INSTALL)
   install(TARGETS bcm_ecmp_shrink_speed)
   install(TARGETS bcm_ecmp_shrink_with_competing_route_updates_speed)
@@ -325,4 +366,7 @@ if (BENCHMARK_INSTALL)
   install(TARGETS bcm_init_and_exit_100Gx100G)
   install(TARGETS bcm_rib_resolution_speed)
   install(TARGETS bcm_rib_sync_fib_speed)
+  install(TARGETS bcm_acl_change_speed)
+  install(TARGETS bcm_prod_config_reload_speed)
+  install(TARGETS bcm_sflow_export_speed)
 endif()
@@ -51,6 +51,7 @@ add_executable(bcm_test
   fboss/agent/hw/bcm/tests/BcmQueueStatCollectionTests.cpp
   fboss/agent/hw/bcm/tests/BcmRtag7Test.cpp
   fboss/agent/hw/bcm/tests/BcmRouteTests.cpp
+  fboss/agent/hw/bcm/tests/BcmSflowExporterTest.cpp
   fboss/agent/hw/bcm/tests/BcmStateDeltaTests.cpp
   fboss/agent/hw/bcm/tests/BcmTrunkTests.cpp
   fboss/agent/hw/bcm/tests/BcmTrunkUtils.cpp
@@ -162,6 +162,27 @@ target_link_libraries(hw_rib_sync_fib_speed
   Folly::folly
 )
 
+add_library(hw_acl_change_speed
+  fboss/agent/hw/benchmarks/HwAclChangeBenchmark.cpp
+)
+
+target_link_libraries(hw_acl_change_speed
+  config_factory
+  hw_queue_per_host_utils
+  hw_benchmark_main
+  Folly::folly
+)
+
+add_library(hw_prod_config_reload_speed
+  fboss/agent/hw/benchmarks/HwProdConfigReloadBenchmark.cpp
+)
+
+target_link_libraries(hw_prod_config_reload_speed
+  prod_config_factory
+  hw_benchmark_main
+  Folly::folly
+)
+
 add_library(hw_ecmp_shrink_speed
   fboss/agent/hw/benchmarks/HwEcmpShrinkSpeedBenchmark.cpp
 )
@@ -389,6 +389,40 @@ function(BUILD_SAI_BENCHMARKS SAI_IMPL_NAME SAI_IMPL_ARG)
     -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
   )
 
+  add_executable(sai_acl_change_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX} /dev/null)
+
+  target_link_libraries(sai_acl_change_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    -Wl,--whole-archive
+    sai_switch_ensemble
+    hw_acl_change_speed
+    ${SAI_IMPL_ARG}
+    -Wl,--no-whole-archive
+  )
+
+  set_target_properties(sai_acl_change_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    PROPERTIES COMPILE_FLAGS
+    "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+    -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+    -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+  )
+
+  add_executable(sai_prod_config_reload_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX} /dev/null)
+
+  target_link_libraries(sai_prod_config_reload_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    -Wl,--whole-archive
+    sai_switch_ensemble
+    hw_prod_config_reload_speed
+    ${SAI_IMPL_ARG}
+    -Wl,--no-whole-archive
+  )
+
+  set_target_properties(sai_prod_config_reload_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    PROPERTIES COMPILE_FLAGS
+    "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+    -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+    -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+  )
+
 endfunction()
 
 if(BUILD_SAI_FAKE_BENCHMARKS)
@@ -462,4 +496,10 @@ if(SAI_IMPL AND BENCHMARK_INSTALL)
   install(
     TARGETS
     sai_rib_resolution_speed-sai_impl-${SAI_VER_SUFFIX})
+  install(
+    TARGETS
+    sai_acl_change_speed-sai_impl-${SAI_VER_SUFFIX})
+  install(
+    TARGETS
+    sai_prod_config_reload_speed-sai_impl-${SAI_VER_SUFFIX})
 endif()
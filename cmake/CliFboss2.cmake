@@ -70,6 +70,7 @@ add_executable(fboss2
   fboss/cli/fboss2/utils/CmdClientUtils.cpp
   fboss/cli/fboss2/utils/Table.cpp
   fboss/cli/fboss2/utils/HostInfo.h
+  fboss/cli/fboss2/utils/StreamingOutput.h
   fboss/cli/fboss2/utils/oss/CmdClientUtils.cpp
   fboss/cli/fboss2/utils/oss/CmdUtils.cpp
   fboss/cli/fboss2/utils/oss/CLIParserUtils.cpp
@@ -11,9 +11,12 @@
 
 #include <folly/FileUtil.h>
 #include <folly/gen/Base.h>
+#include <folly/hash/Hash.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <future>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
 
 #include "fboss/agent/FbossError.h"
@@ -84,6 +87,11 @@ DEFINE_bool(
     false,
     "Allow multiple acl tables (acl table group)");
 
+DEFINE_bool(
+    parallel_config_sections,
+    true,
+    "Build the independent sections of a new config in parallel");
+
 namespace {
 
 const uint8_t kV6LinkLocalAddrMask{64};
@@ -126,17 +134,24 @@ class ThriftConfigApplier {
       const std::shared_ptr<SwitchState>& orig,
       const cfg::SwitchConfig* config,
       const Platform* platform,
-      RoutingInformationBase* rib)
-      : orig_(orig), cfg_(config), platform_(platform), rib_(rib) {}
+      RoutingInformationBase* rib,
+      AppliedConfigSections* appliedSections)
+      : orig_(orig),
+        cfg_(config),
+        platform_(platform),
+        rib_(rib),
+        appliedSections_(appliedSections) {}
   ThriftConfigApplier(
       const std::shared_ptr<SwitchState>& orig,
       const cfg::SwitchConfig* config,
       const Platform* platform,
-      RouteUpdateWrapper* routeUpdater)
+      RouteUpdateWrapper* routeUpdater,
+      AppliedConfigSections* appliedSections)
       : orig_(orig),
         cfg_(config),
         platform_(platform),
-        routeUpdater_(routeUpdater) {}
+        routeUpdater_(routeUpdater),
+        appliedSections_(appliedSections) {}
 
   std::shared_ptr<SwitchState> run();
 
@@ -165,6 +180,66 @@ class ThriftConfigApplier {
     }
   }
 
+  /*
+   * A config section that a reload may skip: the fingerprint of the config
+   * fields it is built from, and the state nodes it reads. The first node is
+   * the one the section rebuilds.
+   */
+  struct SectionInputs {
+    AppliedConfigSections::Section section;
+    uint64_t fingerprint;
+    AppliedConfigSections::Nodes nodes;
+  };
+
+  SectionInputs portsInputs() const;
+  SectionInputs aggregatePortsInputs() const;
+  SectionInputs qosPoliciesInputs() const;
+  SectionInputs aclsInputs() const;
+  SectionInputs vlansInputs() const;
+
+  // Fingerprint of the fields that copyFields() copies to an empty config
+  template <typename CopyFieldsFn>
+  uint64_t sectionFingerprint(CopyFieldsFn copyFields) const {
+    if (!appliedSections_) {
+      return 0;
+    }
+    cfg::SwitchConfig fields;
+    copyFields(fields);
+    return folly::hash::fnv64(
+        apache::thrift::CompactSerializer::serialize<std::string>(fields));
+  }
+
+  /*
+   * Calls update() for the section, unless it is unchanged since it was last
+   * applied, in which case the section yields null. If async, update() runs
+   * on its own thread, otherwise on the thread calling get() on the result.
+   */
+  template <typename UpdateFn>
+  auto updateSection(const SectionInputs& inputs, bool async, UpdateFn update)
+      -> std::future<decltype(update())> {
+    if (appliedSections_ &&
+        appliedSections_->isUnchanged(
+            inputs.section, inputs.fingerprint, inputs.nodes)) {
+      skippedSections_.insert(inputs.section);
+      return std::async(
+          std::launch::deferred, [] { return decltype(update())(); });
+    }
+    return std::async(
+        async ? std::launch::async : std::launch::deferred, std::move(update));
+  }
+
+  template <typename Node>
+  void recordSection(SectionInputs inputs, const std::shared_ptr<Node>& node) {
+    if (!appliedSections_) {
+      return;
+    }
+    if (node) {
+      inputs.nodes.front() = node;
+    }
+    appliedSections_->update(
+        inputs.section, inputs.fingerprint, std::move(inputs.nodes));
+  }
+
   // Interface route prefix. IPAddress has mask applied
   typedef std::pair<InterfaceID, folly::IPAddress> IntfAddress;
   typedef boost::container::flat_map<folly::CIDRNetwork, IntfAddress> IntfRoute;
@@ -347,6 +422,8 @@ class ThriftConfigApplier {
   const Platform* platform_{nullptr};
   RoutingInformationBase* rib_{nullptr};
   RouteUpdateWrapper* routeUpdater_{nullptr};
+  AppliedConfigSections* appliedSections_{nullptr};
+  std::set<AppliedConfigSections::Section> skippedSections_;
 
   struct VlanIpInfo {
     VlanIpInfo(uint8_t mask, MacAddress mac, InterfaceID intf)
@@ -407,8 +484,25 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
+  // Ports, aggregate ports and qos policies only depend on the config, the
+  // original state and the buffer pools, so they can be built in parallel.
+  auto newPortsInputs = portsInputs();
+  auto newAggPortsInputs = aggregatePortsInputs();
+  auto newQosPoliciesInputs = qosPoliciesInputs();
+  auto newAggPortsFuture = updateSection(
+      newAggPortsInputs, FLAGS_parallel_config_sections, [this] {
+        return updateAggregatePorts();
+      });
+  auto newQosPoliciesFuture = updateSection(
+      newQosPoliciesInputs, FLAGS_parallel_config_sections, [this] {
+        return updateQosPolicies();
+      });
+  auto newPortsFuture =
+      updateSection(newPortsInputs, false, [this] { return updatePorts(); });
+
   {
-    auto newPorts = updatePorts();
+    auto newPorts = newPortsFuture.get();
+    recordSection(std::move(newPortsInputs), newPorts);
     if (newPorts) {
       new_->resetPorts(std::move(newPorts));
       changed = true;
@@ -416,13 +510,23 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   {
-    auto newAggPorts = updateAggregatePorts();
+    auto newAggPorts = newAggPortsFuture.get();
+    recordSection(std::move(newAggPortsInputs), newAggPorts);
     if (newAggPorts) {
       new_->resetAggregatePorts(std::move(newAggPorts));
       changed = true;
     }
   }
 
+  {
+    auto newQosPolicies = newQosPoliciesFuture.get();
+    recordSection(std::move(newQosPoliciesInputs), newQosPolicies);
+    if (newQosPolicies) {
+      new_->resetQosPolicies(std::move(newQosPolicies));
+      changed = true;
+    }
+  }
+
   // updateMirrors must be called after updatePorts, mirror needs ports!
   {
     auto newMirrors = updateMirrors();
@@ -433,30 +537,46 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // updateAcls must be called after updateMirrors, acls may need mirror!
-  {
-    if (FLAGS_enable_acl_table_group) {
-      auto newAclGroup = updateAclTableGroup();
-      if (newAclGroup) {
-        new_->resetAclTableGroup(std::move(newAclGroup));
-        changed = true;
-      }
-    } else {
-      auto newAcls = updateAcls(*cfg_->acls_ref());
-      if (newAcls) {
-        new_->resetAcls(std::move(newAcls));
-        changed = true;
-      }
-    }
+  // They don't depend on interfaces though, which are built meanwhile.
+  auto newAclsInputs = aclsInputs();
+  std::future<std::shared_ptr<AclTableGroup>> newAclGroupFuture;
+  std::future<std::shared_ptr<AclMap>> newAclsFuture;
+  if (FLAGS_enable_acl_table_group) {
+    newAclGroupFuture = updateSection(
+        newAclsInputs, FLAGS_parallel_config_sections, [this] {
+          return updateAclTableGroup();
+        });
+  } else {
+    newAclsFuture = updateSection(
+        newAclsInputs, FLAGS_parallel_config_sections, [this] {
+          return updateAcls(*cfg_->acls_ref());
+        });
   }
 
-  {
-    auto newQosPolicies = updateQosPolicies();
-    if (newQosPolicies) {
-      new_->resetQosPolicies(std::move(newQosPolicies));
+  // ACLs read new_, only modify it once they are done
+  auto newIntfs = updateInterfaces();
+
+  if (FLAGS_enable_acl_table_group) {
+    auto newAclGroup = newAclGroupFuture.get();
+    recordSection(std::move(newAclsInputs), newAclGroup);
+    if (newAclGroup) {
+      new_->resetAclTableGroup(std::move(newAclGroup));
+      changed = true;
+    }
+  } else {
+    auto newAcls = newAclsFuture.get();
+    recordSection(std::move(newAclsInputs), newAcls);
+    if (newAcls) {
+      new_->resetAcls(std::move(newAcls));
       changed = true;
     }
   }
 
+  if (newIntfs) {
+    new_->resetIntfs(std::move(newIntfs));
+    changed = true;
+  }
+
   // reset the default qos policy
   {
     auto newDefaultQosPolicy = updateDataplaneDefaultQosPolicy();
@@ -466,18 +586,14 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
-    auto newIntfs = updateInterfaces();
-    if (newIntfs) {
-      new_->resetIntfs(std::move(newIntfs));
-      changed = true;
-    }
-  }
-
   // Note: updateInterfaces() must be called before updateVlans(),
   // as updateInterfaces() populates the vlanInterfaces_ data structure.
   {
-    auto newVlans = updateVlans();
+    auto newVlansInputs = vlansInputs();
+    auto newVlans =
+        updateSection(newVlansInputs, false, [this] { return updateVlans(); })
+            .get();
+    recordSection(std::move(newVlansInputs), newVlans);
     if (newVlans) {
       new_->resetVlans(std::move(newVlans));
       changed = true;
@@ -657,12 +773,93 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
         << "Normalizer failed to initialize, skipping loading counter tags";
   }
 
+  if (appliedSections_) {
+    appliedSections_->setSkipped(std::move(skippedSections_));
+  }
+
   if (!changed) {
     return nullptr;
   }
   return new_;
 }
 
+ThriftConfigApplier::SectionInputs ThriftConfigApplier::portsInputs() const {
+  auto fingerprint = sectionFingerprint([this](cfg::SwitchConfig& fields) {
+    fields.ports_ref() = *cfg_->ports_ref();
+    fields.vlanPorts_ref() = *cfg_->vlanPorts_ref();
+    fields.portQueueConfigs_ref() = *cfg_->portQueueConfigs_ref();
+    fields.defaultPortQueues_ref() = *cfg_->defaultPortQueues_ref();
+    fields.portPgConfigs_ref().copy_from(cfg_->portPgConfigs_ref());
+    fields.qosPolicies_ref() = *cfg_->qosPolicies_ref();
+    fields.dataPlaneTrafficPolicy_ref().copy_from(
+        cfg_->dataPlaneTrafficPolicy_ref());
+  });
+  return {
+      AppliedConfigSections::Section::PORTS,
+      fingerprint,
+      {orig_->getPorts(), new_->getBufferPoolCfgs()}};
+}
+
+ThriftConfigApplier::SectionInputs ThriftConfigApplier::aggregatePortsInputs()
+    const {
+  auto fingerprint = sectionFingerprint([this](cfg::SwitchConfig& fields) {
+    fields.aggregatePorts_ref() = *cfg_->aggregatePorts_ref();
+    fields.lacp_ref().copy_from(cfg_->lacp_ref());
+  });
+  return {
+      AppliedConfigSections::Section::AGGREGATE_PORTS,
+      fingerprint,
+      {orig_->getAggregatePorts()}};
+}
+
+ThriftConfigApplier::SectionInputs ThriftConfigApplier::qosPoliciesInputs()
+    const {
+  auto fingerprint = sectionFingerprint([this](cfg::SwitchConfig& fields) {
+    fields.qosPolicies_ref() = *cfg_->qosPolicies_ref();
+    fields.dataPlaneTrafficPolicy_ref().copy_from(
+        cfg_->dataPlaneTrafficPolicy_ref());
+  });
+  return {
+      AppliedConfigSections::Section::QOS_POLICIES,
+      fingerprint,
+      {orig_->getQosPolicies(), orig_->getDefaultDataPlaneQosPolicy()}};
+}
+
+ThriftConfigApplier::SectionInputs ThriftConfigApplier::aclsInputs() const {
+  auto fingerprint = sectionFingerprint([this](cfg::SwitchConfig& fields) {
+    fields.acls_ref() = *cfg_->acls_ref();
+    fields.aclTableGroup_ref().copy_from(cfg_->aclTableGroup_ref());
+    fields.cpuTrafficPolicy_ref().copy_from(cfg_->cpuTrafficPolicy_ref());
+    fields.dataPlaneTrafficPolicy_ref().copy_from(
+        cfg_->dataPlaneTrafficPolicy_ref());
+    fields.trafficCounters_ref() = *cfg_->trafficCounters_ref();
+  });
+  AppliedConfigSections::Nodes nodes;
+  if (FLAGS_enable_acl_table_group) {
+    nodes.push_back(orig_->getAclTableGroup());
+  } else {
+    nodes.push_back(orig_->getAcls());
+  }
+  // Mirrors are rebuilt before, and ACLs may refer to them
+  nodes.push_back(new_->getMirrors());
+  return {
+      AppliedConfigSections::Section::ACLS, fingerprint, std::move(nodes)};
+}
+
+ThriftConfigApplier::SectionInputs ThriftConfigApplier::vlansInputs() const {
+  // vlanPorts_ and vlanInterfaces_ are built from the VLAN ports and the
+  // interfaces config
+  auto fingerprint = sectionFingerprint([this](cfg::SwitchConfig& fields) {
+    fields.vlans_ref() = *cfg_->vlans_ref();
+    fields.vlanPorts_ref() = *cfg_->vlanPorts_ref();
+    fields.interfaces_ref() = *cfg_->interfaces_ref();
+  });
+  return {
+      AppliedConfigSections::Section::VLANS,
+      fingerprint,
+      {orig_->getVlans(), new_->getInterfaces()}};
+}
+
 void ThriftConfigApplier::processVlanPorts() {
   // Build the Port --> Vlan mappings
   //
@@ -3283,21 +3480,43 @@ ThriftConfigApplier::updateStaticMplsRoutes(
   return labelFib;
 }
 
+bool AppliedConfigSections::isUnchanged(
+    Section section,
+    uint64_t fingerprint,
+    const Nodes& nodes) const {
+  auto applied = applied_.find(section);
+  return applied != applied_.end() &&
+      applied->second.fingerprint == fingerprint &&
+      applied->second.nodes == nodes;
+}
+
+void AppliedConfigSections::update(
+    Section section,
+    uint64_t fingerprint,
+    Nodes nodes) {
+  applied_[section] = Applied{fingerprint, std::move(nodes)};
+}
+
 shared_ptr<SwitchState> applyThriftConfig(
     const shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RoutingInformationBase* rib) {
+    RoutingInformationBase* rib,
+    AppliedConfigSections* appliedSections) {
   cfg::SwitchConfig emptyConfig;
-  return ThriftConfigApplier(state, config, platform, rib).run();
+  return ThriftConfigApplier(state, config, platform, rib, appliedSections)
+      .run();
 }
 shared_ptr<SwitchState> applyThriftConfig(
     const shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RouteUpdateWrapper* routeUpdater) {
+    RouteUpdateWrapper* routeUpdater,
+    AppliedConfigSections* appliedSections) {
   cfg::SwitchConfig emptyConfig;
-  return ThriftConfigApplier(state, config, platform, routeUpdater).run();
+  return ThriftConfigApplier(
+             state, config, platform, routeUpdater, appliedSections)
+      .run();
 }
 
 } // namespace facebook::fboss
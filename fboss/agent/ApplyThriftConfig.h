@@ -10,7 +10,12 @@
 #pragma once
 
 #include <folly/Range.h>
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <set>
+#include <utility>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -20,10 +25,55 @@ namespace cfg {
 class SwitchConfig;
 }
 
+class NodeBase;
 class Platform;
 class SwitchState;
 class RouteUpdateWrapper;
 
+/*
+ * The config sections applied by previous applyThriftConfig() calls, so that
+ * a reload can skip the sections whose config didn't change.
+ *
+ * For each section it records a fingerprint of the config fields the section
+ * is built from, and the state nodes it read and produced. A section is only
+ * skipped if both are still the same: the nodes being the same objects means
+ * nothing modified them since, so runtime changes to e.g. a port are still
+ * reverted by a config reload.
+ *
+ * Use one instance per SwitchState lineage, and not from concurrent calls.
+ */
+class AppliedConfigSections {
+ public:
+  enum class Section {
+    PORTS,
+    AGGREGATE_PORTS,
+    QOS_POLICIES,
+    ACLS,
+    VLANS,
+  };
+  using Nodes = std::vector<std::shared_ptr<const NodeBase>>;
+
+  bool isUnchanged(Section section, uint64_t fingerprint, const Nodes& nodes)
+      const;
+  void update(Section section, uint64_t fingerprint, Nodes nodes);
+
+  // Sections skipped by the last applyThriftConfig() call
+  const std::set<Section>& getSkipped() const {
+    return skipped_;
+  }
+  void setSkipped(std::set<Section> skipped) {
+    skipped_ = std::move(skipped);
+  }
+
+ private:
+  struct Applied {
+    uint64_t fingerprint{0};
+    Nodes nodes;
+  };
+  std::map<Section, Applied> applied_;
+  std::set<Section> skipped_;
+};
+
 /*
  * Apply a thrift config structure to a SwitchState object.
  *
@@ -34,11 +84,13 @@ std::shared_ptr<SwitchState> applyThriftConfig(
     const std::shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RoutingInformationBase* rib = nullptr);
+    RoutingInformationBase* rib = nullptr,
+    AppliedConfigSections* appliedSections = nullptr);
 
 std::shared_ptr<SwitchState> applyThriftConfig(
     const std::shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RouteUpdateWrapper* routeUpdater);
+    RouteUpdateWrapper* routeUpdater,
+    AppliedConfigSections* appliedSections = nullptr);
 } // namespace facebook::fboss
@@ -21,6 +21,7 @@
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/TxPacket.h"
+#include "fboss/agent/packet/EthHdr.h"
 #include "fboss/agent/packet/PktUtil.h"
 #include "fboss/agent/state/AggregatePort.h"
 #include "fboss/agent/state/ArpEntry.h"
@@ -166,6 +167,49 @@ void ArpHandler::handlePacket(
   (void)targetMac; // unused
 }
 
+namespace {
+
+// Offset of the target IP in an ARP packet with an 802.1Q header: it follows
+// htype, ptype, hlen, plen, op and the sender and target hardware addresses
+constexpr uint32_t kArpTargetIPOffset =
+    EthHdr::SIZE + 8 + 2 * MacAddress::SIZE + IPAddressV4::byteCount();
+
+// TODO: We need a more robust mechanism for setting up the ethernet
+// header in the response.  The HwSwitch should probably be responsible for
+// setting it up, and determinine whether or not a VLAN tag needs to be
+// present.
+//
+// The minimum packet length is 64.  We use 68 here on the assumption that
+// the packet will go out untagged, which will remove 4 bytes.
+constexpr uint32_t kArpPktLen = 68;
+
+void writeArp(
+    RWPrivateCursor* cursor,
+    VlanID vlan,
+    ArpOpCode op,
+    MacAddress senderMac,
+    IPAddressV4 senderIP,
+    MacAddress targetMac,
+    IPAddressV4 targetIP) {
+  TxPacket::writeEthHeader(
+      cursor, targetMac, senderMac, vlan, ArpHandler::ETHERTYPE_ARP);
+  cursor->writeBE<uint16_t>(ARP_HTYPE_ETHERNET);
+  cursor->writeBE<uint16_t>(ARP_PTYPE_IPV4);
+  cursor->writeBE<uint8_t>(ARP_HLEN_ETHERNET);
+  cursor->writeBE<uint8_t>(ARP_PLEN_IPV4);
+  cursor->writeBE<uint16_t>(op);
+  cursor->push(senderMac.bytes(), MacAddress::SIZE);
+  cursor->write<uint32_t>(senderIP.toLong());
+  cursor->push(
+      ((op == ARP_OP_REQUEST) ? MacAddress::ZERO.bytes() : targetMac.bytes()),
+      MacAddress::SIZE);
+  cursor->write<uint32_t>(targetIP.toLong());
+  // Fill the padding with 0s
+  memset(cursor->writableData(), 0, cursor->length());
+}
+
+} // namespace
+
 static void sendArp(
     SwSwitch* sw,
     VlanID vlan,
@@ -179,36 +223,50 @@ static void sendArp(
              << " on vlan " << vlan << " to " << targetIP.str() << " ("
              << targetMac << "): " << senderIP.str() << " is " << senderMac;
 
-  // TODO: We need a more robust mechanism for setting up the ethernet
-  // header in the response.  The HwSwitch should probably be responsible for
-  // setting it up, and determinine whether or not a VLAN tag needs to be
-  // present.
-  //
-  // The minimum packet length is 64.  We use 68 here on the assumption that
-  // the packet will go out untagged, which will remove 4 bytes.
-  uint32_t pktLen = 68;
-  auto pkt = sw->allocatePacket(pktLen);
+  auto pkt = sw->allocatePacket(kArpPktLen);
   RWPrivateCursor cursor(pkt->buf());
-
-  pkt->writeEthHeader(
-      &cursor, targetMac, senderMac, vlan, ArpHandler::ETHERTYPE_ARP);
-  cursor.writeBE<uint16_t>(ARP_HTYPE_ETHERNET);
-  cursor.writeBE<uint16_t>(ARP_PTYPE_IPV4);
-  cursor.writeBE<uint8_t>(ARP_HLEN_ETHERNET);
-  cursor.writeBE<uint8_t>(ARP_PLEN_IPV4);
-  cursor.writeBE<uint16_t>(op);
-  cursor.push(senderMac.bytes(), MacAddress::SIZE);
-  cursor.write<uint32_t>(senderIP.toLong());
-  cursor.push(
-      ((op == ARP_OP_REQUEST) ? MacAddress::ZERO.bytes() : targetMac.bytes()),
-      MacAddress::SIZE);
-  cursor.write<uint32_t>(targetIP.toLong());
-  // Fill the padding with 0s
-  memset(cursor.writableData(), 0, cursor.length());
+  writeArp(&cursor, vlan, op, senderMac, senderIP, targetMac, targetIP);
 
   sw->sendNetworkControlPacketAsync(std::move(pkt), portDesc);
 }
 
+void ArpHandler::sendArpRequestFromTemplate(
+    VlanID vlan,
+    const MacAddress& senderMac,
+    const IPAddressV4& senderIP,
+    const IPAddressV4& targetIP) {
+  XLOG(DBG4) << "sending ARP request on vlan " << vlan << " to "
+             << targetIP.str() << ": " << senderIP.str() << " is "
+             << senderMac;
+
+  auto tmpl = requestTemplates_.get(
+      ArpRequestKey(vlan, senderMac, senderIP), [&]() {
+        return std::make_shared<const TxPacketTemplate>(
+            kArpPktLen, [&](RWPrivateCursor* cursor) {
+              writeArp(
+                  cursor,
+                  vlan,
+                  ARP_OP_REQUEST,
+                  senderMac,
+                  senderIP,
+                  MacAddress::BROADCAST,
+                  IPAddressV4());
+            });
+      });
+  auto pkt = tmpl->allocatePacket(sw_);
+  if (!pkt) {
+    XLOG(DBG4) << "Failed to allocate tx packet for ARP request to "
+               << targetIP;
+    return;
+  }
+  TxPacketTemplate::patch(
+      pkt.get(),
+      kArpTargetIPOffset,
+      folly::ByteRange(targetIP.bytes(), IPAddressV4::byteCount()));
+
+  sw_->sendNetworkControlPacketAsync(std::move(pkt), std::nullopt);
+}
+
 void ArpHandler::floodGratuituousArp() {
   for (const auto& intf : *sw_->getState()->getInterfaces()) {
     for (const auto& addrEntry : intf->getAddresses()) {
@@ -218,14 +276,8 @@ void ArpHandler::floodGratuituousArp() {
       auto v4Addr = addrEntry.first.asV4();
       // Gratuitous arps have both source and destination IPs set to
       // originator's address
-      sendArp(
-          sw_,
-          intf->getVlanID(),
-          ARP_OP_REQUEST,
-          intf->getMac(),
-          v4Addr,
-          MacAddress::BROADCAST,
-          v4Addr);
+      sendArpRequestFromTemplate(
+          intf->getVlanID(), intf->getMac(), v4Addr, v4Addr);
     }
   }
 }
@@ -260,14 +312,19 @@ void ArpHandler::sendArpRequest(
     const IPAddressV4& senderIP,
     const IPAddressV4& targetIP) {
   sw->stats()->arpRequestTx();
-  sendArp(
-      sw,
-      vlanID,
-      ARP_OP_REQUEST,
-      srcMac,
-      senderIP,
-      MacAddress::BROADCAST,
-      targetIP);
+  auto handler = sw->getArpHandler();
+  if (!handler) {
+    sendArp(
+        sw,
+        vlanID,
+        ARP_OP_REQUEST,
+        srcMac,
+        senderIP,
+        MacAddress::BROADCAST,
+        targetIP);
+    return;
+  }
+  handler->sendArpRequestFromTemplate(vlanID, srcMac, senderIP, targetIP);
 }
 
 void ArpHandler::sendArpRequest(
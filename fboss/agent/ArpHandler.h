@@ -9,12 +9,14 @@
  */
 #pragma once
 
+#include "fboss/agent/TxPacketTemplate.h"
 #include "fboss/agent/state/Interface.h"
 #include "fboss/agent/state/NeighborEntry.h"
 #include "fboss/agent/state/Vlan.h"
 #include "fboss/agent/types.h"
 
 #include <memory>
+#include <tuple>
 
 #include <folly/IPAddressV4.h>
 #include <folly/MacAddress.h>
@@ -85,7 +87,21 @@ class ArpHandler {
       folly::MacAddress targetMac,
       folly::IPAddressV4 targetIP);
 
+  /*
+   * Send an ARP request from a template with everything but the target IP
+   * filled in, which is built the first time a sender asks.
+   */
+  void sendArpRequestFromTemplate(
+      VlanID vlan,
+      const folly::MacAddress& senderMac,
+      const folly::IPAddressV4& senderIP,
+      const folly::IPAddressV4& targetIP);
+
+  using ArpRequestKey =
+      std::tuple<VlanID, folly::MacAddress, folly::IPAddressV4>;
+
   SwSwitch* sw_{nullptr};
+  TxPacketTemplateCache<ArpRequestKey, TxPacketTemplate> requestTemplates_;
 };
 
 } // namespace facebook::fboss
@@ -13,6 +13,7 @@
 #include "fboss/agent/normalization/Normalizer.h"
 
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/TxPacket.h"
 #include "fboss/agent/Utils.h"
 
 #include <fb303/ThreadCachedServiceData.h>
@@ -55,6 +56,19 @@ void HwSwitch::switchRunStateChanged(SwitchRunState newState) {
   }
 }
 
+size_t HwSwitch::sendPacketsOutOfPortAsync(
+    std::vector<std::pair<std::unique_ptr<TxPacket>, PortID>> pkts,
+    std::optional<uint8_t> queue) noexcept {
+  size_t numSent = 0;
+  for (auto& pktAndPort : pkts) {
+    if (sendPacketOutOfPortAsync(
+            std::move(pktAndPort.first), pktAndPort.second, queue)) {
+      ++numSent;
+    }
+  }
+  return numSent;
+}
+
 void HwSwitch::updateStats(SwitchStats* switchStats) {
   updateStatsImpl(switchStats);
   // send to normalizer
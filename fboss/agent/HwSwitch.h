@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include "fboss/agent/MemoryUsage.h"
 #include "fboss/agent/Platform.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/hw/gen-cpp2/hardware_stats_types.h"
@@ -21,6 +22,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace folly {
 struct dynamic;
@@ -195,6 +197,19 @@ class HwSwitch {
       PortID portID,
       std::optional<uint8_t> queue = std::nullopt) noexcept = 0;
 
+  /*
+   * Send a batch of packets, each out of the port paired with it, using
+   * VLAN and destination MAC from the packets.
+   *
+   * Implementations able to hand several packets to the HW at once should
+   * override this; by default they are sent one by one.
+   *
+   * @return The number of packets successfully sent to HW.
+   */
+  virtual size_t sendPacketsOutOfPortAsync(
+      std::vector<std::pair<std::unique_ptr<TxPacket>, PortID>> pkts,
+      std::optional<uint8_t> queue = std::nullopt) noexcept;
+
   /*
    * Send a packet, use switching logic to send it out the correct port(s)
    * for the specified VLAN and destination MAC.
@@ -230,6 +245,14 @@ class HwSwitch {
    * Get latest device watermark bytes
    */
   virtual uint64_t getDeviceWatermarkBytes() const = 0;
+
+  /*
+   * Approximate memory used by the software copies of HW objects kept by
+   * the HwSwitch, keyed by object type.
+   */
+  virtual MemoryUsageByType getMemoryUsage() {
+    return {};
+  }
   /*
    * Allow hardware to perform any warm boot related cleanup
    * before we exit the application.
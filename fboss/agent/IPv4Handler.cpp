@@ -228,7 +228,7 @@ void IPv4Handler::handlePacket(
   // We will need to manage the rate somehow. Either from HW
   // or a SW control here
   stats->port(port)->ipv4Nexthop();
-  if (!resolveMac(state, port, v4Hdr.dstAddr, pkt->getSrcVlan())) {
+  if (!resolveMac(state, port, v4Hdr.dstAddr, pkt->getSrcVlan(), true)) {
     stats->port(port)->ipv4NoArp();
     XLOG(DBG4) << "Cannot find the interface to send out ARP request for "
                << v4Hdr.dstAddr.str();
@@ -243,7 +243,8 @@ bool IPv4Handler::resolveMac(
     std::shared_ptr<SwitchState> state,
     PortID ingressPort,
     IPAddressV4 dest,
-    VlanID ingressVlan) {
+    VlanID ingressVlan,
+    bool punted) {
   // need to find out our own IP and MAC addresses so that we can send the
   // ARP request out. Since the request will be broadcast, there is no need to
   // worry about which port to send the packet out.
@@ -280,6 +281,9 @@ bool IPv4Handler::resolveMac(
       if (vlan) {
         auto entry = vlan->getArpTable()->getEntryIf(target);
         if (entry == nullptr) {
+          if (punted && !shouldSendArpRequest(vlanID, target)) {
+            continue;
+          }
           // No entry in ARP table, send ARP request
           auto mac = intf->getMac();
           ArpHandler::sendArpRequest(sw_, vlanID, mac, source, target);
@@ -299,4 +303,24 @@ bool IPv4Handler::resolveMac(
   return sent;
 }
 
+bool IPv4Handler::shouldSendArpRequest(VlanID vlan, IPAddressV4 target) {
+  // The pending entry for target may not be in the state yet, so this is
+  // what keeps a burst of punted packets from sending a burst of requests
+  switch (resolutionLimiter_.shouldResolve(vlan, IPAddress(target))) {
+    case NeighborResolutionLimiter::Result::RESOLVE:
+      return true;
+    case NeighborResolutionLimiter::Result::DEDUPED:
+      XLOG(DBG4) << "not sending arp for " << target.str()
+                 << ", one was sent recently";
+      sw_->stats()->arpRequestDeduped();
+      return false;
+    case NeighborResolutionLimiter::Result::RATE_LIMITED:
+      XLOG(DBG4) << "not sending arp for " << target.str()
+                 << ", over the resolution rate";
+      sw_->stats()->arpRequestRateLimited();
+      return false;
+  }
+  return false;
+}
+
 } // namespace facebook::fboss
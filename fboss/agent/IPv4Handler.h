@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include "fboss/agent/NeighborResolutionLimiter.h"
 #include "fboss/agent/types.h"
 
 #include <memory>
@@ -45,12 +46,16 @@ class IPv4Handler {
   /*
    * TODO(aeckert): t17949183 unify packet handling pipeline and then
    * make this private again.
+   *
+   * ARP requests for packets punted to the CPU (punted set) go through the
+   * resolution limiter, those for packets sent by the agent itself don't.
    */
   bool resolveMac(
       std::shared_ptr<SwitchState> state,
       PortID ingressPort,
       folly::IPAddressV4 dest,
-      VlanID ingressVlan);
+      VlanID ingressVlan,
+      bool punted = false);
 
  private:
   void sendICMPTimeExceeded(
@@ -60,11 +65,15 @@ class IPv4Handler {
       IPv4Hdr& v4Hdr,
       folly::io::Cursor cursor);
 
+  // Whether to send an ARP request for a punted packet to target
+  bool shouldSendArpRequest(VlanID vlan, folly::IPAddressV4 target);
+
   // Forbidden copy constructor and assignment operator
   IPv4Handler(IPv4Handler const&) = delete;
   IPv4Handler& operator=(IPv4Handler const&) = delete;
 
   SwSwitch* sw_{nullptr};
+  NeighborResolutionLimiter resolutionLimiter_;
 };
 
 } // namespace facebook::fboss
@@ -20,7 +20,9 @@
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/TxPacket.h"
+#include "fboss/agent/TxPacketTemplate.h"
 #include "fboss/agent/Utils.h"
+#include "fboss/agent/packet/EthHdr.h"
 #include "fboss/agent/packet/ICMPHdr.h"
 #include "fboss/agent/packet/IPv6Hdr.h"
 #include "fboss/agent/packet/NDP.h"
@@ -48,8 +50,8 @@ using std::unique_ptr;
 namespace facebook::fboss {
 
 template <typename BodyFn>
-std::unique_ptr<TxPacket> createICMPv6Pkt(
-    SwSwitch* sw,
+void writeICMPv6Pkt(
+    RWPrivateCursor* cursor,
     folly::MacAddress dstMac,
     folly::MacAddress srcMac,
     VlanID vlan,
@@ -67,15 +69,131 @@ std::unique_ptr<TxPacket> createICMPv6Pkt(
 
   ICMPHdr icmp6(
       static_cast<uint8_t>(icmp6Type), static_cast<uint8_t>(icmp6Code), 0);
+  icmp6.serializeFullPacket(
+      cursor, dstMac, srcMac, vlan, ipv6, bodyLength, serializeBody);
+}
 
-  uint32_t pktLen = icmp6.computeTotalLengthV6(bodyLength);
+template <typename BodyFn>
+std::unique_ptr<TxPacket> createICMPv6Pkt(
+    SwSwitch* sw,
+    folly::MacAddress dstMac,
+    folly::MacAddress srcMac,
+    VlanID vlan,
+    const folly::IPAddressV6& dstIP,
+    const folly::IPAddressV6& srcIP,
+    ICMPv6Type icmp6Type,
+    ICMPv6Code icmp6Code,
+    uint32_t bodyLength,
+    BodyFn serializeBody) {
+  uint32_t pktLen = ICMPHdr::computeTotalLengthV6(bodyLength);
   auto pkt = sw->allocatePacket(pktLen);
   RWPrivateCursor cursor(pkt->buf());
-  icmp6.serializeFullPacket(
-      &cursor, dstMac, srcMac, vlan, ipv6, bodyLength, serializeBody);
+  writeICMPv6Pkt(
+      &cursor,
+      dstMac,
+      srcMac,
+      vlan,
+      dstIP,
+      srcIP,
+      icmp6Type,
+      icmp6Code,
+      bodyLength,
+      serializeBody);
   return pkt;
 }
 
+namespace {
+
+// Offsets of the fields of a neighbor solicitation with an 802.1Q header
+constexpr uint32_t kIPv6Offset = EthHdr::SIZE;
+constexpr uint32_t kIPv6DstOffset = kIPv6Offset + 8 + IPAddressV6::byteCount();
+constexpr uint32_t kICMPv6Offset = kIPv6Offset + IPv6Hdr::SIZE;
+constexpr uint32_t kICMPv6ChecksumOffset = kICMPv6Offset + 2;
+constexpr uint32_t kSolicitationTargetOffset =
+    kICMPv6Offset + ICMPHdr::SIZE + ICMPHdr::ICMPV6_UNUSED_LEN;
+
+// The one's complement sum of an address, as in the ICMPv6 checksum
+uint32_t addressSum(const IPAddressV6& addr) {
+  uint32_t sum = 0;
+  auto bytes = addr.bytes();
+  for (size_t i = 0; i < IPAddressV6::byteCount(); i += 2) {
+    sum += (static_cast<uint32_t>(bytes[i]) << 8) | bytes[i + 1];
+  }
+  return sum;
+}
+
+} // namespace
+
+/*
+ * A neighbor solicitation with the destination MAC, destination IP and
+ * target all zero, and the checksum computed over the rest of the packet.
+ */
+struct IPv6Handler::SolicitationTemplate {
+  SolicitationTemplate(
+      VlanID vlan,
+      const MacAddress& srcMac,
+      const IPAddressV6& srcIP,
+      const NDPOptions& ndpOptions)
+      : pkt(
+            ICMPHdr::computeTotalLengthV6(
+                ICMPHdr::ICMPV6_UNUSED_LEN + IPAddressV6::byteCount() +
+                ndpOptions.computeTotalLength()),
+            [&](RWPrivateCursor* cursor) {
+              writeICMPv6Pkt(
+                  cursor,
+                  MacAddress(),
+                  srcMac,
+                  vlan,
+                  IPAddressV6(),
+                  srcIP,
+                  ICMPv6Type::ICMPV6_TYPE_NDP_NEIGHBOR_SOLICITATION,
+                  ICMPv6Code::ICMPV6_CODE_NDP_MESSAGE_CODE,
+                  ICMPHdr::ICMPV6_UNUSED_LEN + IPAddressV6::byteCount() +
+                      ndpOptions.computeTotalLength(),
+                  [&](RWPrivateCursor* bodyCursor) {
+                    bodyCursor->writeBE<uint32_t>(0); // reserved
+                    bodyCursor->push(
+                        IPAddressV6().bytes(), IPAddressV6::byteCount());
+                    ndpOptions.serialize(bodyCursor);
+                  });
+            }) {
+    // Undo the final complement to get the sum of the fixed fields back
+    auto csum = pkt.bytes().data() + kICMPv6ChecksumOffset;
+    fixedSum = static_cast<uint16_t>(~((csum[0] << 8) | csum[1]));
+  }
+
+  std::unique_ptr<TxPacket> allocatePacket(
+      SwSwitch* sw,
+      const MacAddress& dstMac,
+      const IPAddressV6& dstIP,
+      const IPAddressV6& neighborIP) const {
+    auto txPkt = pkt.allocatePacket(sw);
+    if (!txPkt) {
+      return nullptr;
+    }
+    TxPacketTemplate::patch(
+        txPkt.get(), 0, folly::ByteRange(dstMac.bytes(), MacAddress::SIZE));
+    TxPacketTemplate::patch(
+        txPkt.get(),
+        kIPv6DstOffset,
+        folly::ByteRange(dstIP.bytes(), IPAddressV6::byteCount()));
+    TxPacketTemplate::patch(
+        txPkt.get(),
+        kSolicitationTargetOffset,
+        folly::ByteRange(neighborIP.bytes(), IPAddressV6::byteCount()));
+    auto csum = PktUtil::finalizeChecksum(
+        fixedSum + addressSum(dstIP) + addressSum(neighborIP));
+    uint8_t csumBytes[2] = {
+        static_cast<uint8_t>(csum >> 8), static_cast<uint8_t>(csum)};
+    TxPacketTemplate::patch(
+        txPkt.get(), kICMPv6ChecksumOffset, folly::ByteRange(csumBytes, 2));
+    return txPkt;
+  }
+
+  TxPacketTemplate pkt;
+  uint32_t fixedSum{0};
+};
+
 struct IPv6Handler::ICMPHeaders {
   folly::MacAddress dst;
   folly::MacAddress src;
@@ -783,6 +901,9 @@ void IPv6Handler::resolveDestAndHandlePacket(
         if (vlan) {
           auto entry = vlan->getNdpTable()->getEntryIf(target);
           if (nullptr == entry) {
+            if (!shouldSendNeighborSolicitation(vlanID, target)) {
+              continue;
+            }
             // No entry in NDP table, create a neighbor solicitation packet
             sendMulticastNeighborSolicitation(
                 sw_, target, intf->getMac(), vlan->getID());
@@ -851,6 +972,29 @@ void IPv6Handler::sendMulticastNeighborSolicitations(
   }
 }
 
+bool IPv6Handler::shouldSendNeighborSolicitation(
+    VlanID vlan,
+    const IPAddressV6& target) {
+  // The pending entry for target may not be in the state yet, so this is
+  // what keeps a burst of punted packets from sending a burst of
+  // solicitations
+  switch (resolutionLimiter_.shouldResolve(vlan, folly::IPAddress(target))) {
+    case NeighborResolutionLimiter::Result::RESOLVE:
+      return true;
+    case NeighborResolutionLimiter::Result::DEDUPED:
+      XLOG(DBG5) << "not sending neighbor solicitation for " << target.str()
+                 << ", one was sent recently";
+      sw_->stats()->ndpSolicitationDeduped();
+      return false;
+    case NeighborResolutionLimiter::Result::RATE_LIMITED:
+      XLOG(DBG5) << "not sending neighbor solicitation for " << target.str()
+                 << ", over the resolution rate";
+      sw_->stats()->ndpSolicitationRateLimited();
+      return false;
+  }
+  return false;
+}
+
 void IPv6Handler::floodNeighborAdvertisements() {
   for (const auto& intf : *sw_->getState()->getInterfaces()) {
     for (const auto& addrEntry : intf->getAddresses()) {
@@ -922,7 +1066,31 @@ void IPv6Handler::sendNeighborSolicitation(
     const VlanID& vlanID,
     const std::optional<PortDescriptor>& portDescriptor,
     const NDPOptions& ndpOptions) {
-  auto state = sw->getState();
+  auto handler = sw->getIPv6Handler();
+  if (handler) {
+    // Only the destination, target and checksum change from one
+    // solicitation to the next, so fill them into a template
+    auto tmpl = handler->solicitationTemplates_.get(
+        SolicitationKey(
+            vlanID,
+            srcMac,
+            srcIP,
+            ndpOptions.mtu,
+            ndpOptions.sourceLinkLayerAddress,
+            ndpOptions.targetLinkLayerAddress),
+        [&]() {
+          return std::make_shared<const SolicitationTemplate>(
+              vlanID, srcMac, srcIP, ndpOptions);
+        });
+    auto pkt = tmpl->allocatePacket(sw, dstMac, dstIP, neighborIP);
+    if (!pkt) {
+      XLOG(DBG4) << "Failed to allocate tx packet for neighbor solicitation "
+                 << "to " << neighborIP;
+      return;
+    }
+    sw->sendNetworkControlPacketAsync(std::move(pkt), portDescriptor);
+    return;
+  }
 
   uint32_t bodyLength = ICMPHdr::ICMPV6_UNUSED_LEN + IPAddressV6::byteCount() +
       ndpOptions.computeTotalLength();
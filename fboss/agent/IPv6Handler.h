@@ -9,7 +9,9 @@
  */
 #pragma once
 
+#include "fboss/agent/NeighborResolutionLimiter.h"
 #include "fboss/agent/StateObserver.h"
+#include "fboss/agent/TxPacketTemplate.h"
 #include "fboss/agent/ndp/IPv6RouteAdvertiser.h"
 #include "fboss/agent/packet/ICMPHdr.h"
 #include "fboss/agent/packet/NDP.h"
@@ -19,6 +21,8 @@
 #include <folly/IPAddressV6.h>
 #include <folly/MacAddress.h>
 #include <memory>
+#include <optional>
+#include <tuple>
 namespace folly {
 namespace io {
 class Cursor;
@@ -57,6 +61,9 @@ class IPv6Handler : public AutoRegisterStateObserver {
   /*
    * TODO(aeckert): 17949183 unify packet handling pipeline and then
    * make this private again.
+   *
+   * Used for packets sent by the agent itself, so unlike solicitations for
+   * punted packets these don't go through the resolution limiter.
    */
   void sendMulticastNeighborSolicitations(
       PortID ingressPort,
@@ -91,6 +98,7 @@ class IPv6Handler : public AutoRegisterStateObserver {
 
  private:
   struct ICMPHeaders;
+  struct SolicitationTemplate;
   typedef boost::container::flat_map<InterfaceID, IPv6RouteAdvertiser> RAMap;
 
   // Forbidden copy constructor and assignment operator
@@ -153,6 +161,11 @@ class IPv6Handler : public AutoRegisterStateObserver {
 
   bool checkNdpPacket(const ICMPHeaders& hdr, const RxPacket* pkt) const;
 
+  // Whether to send a neighbor solicitation for a punted packet to target
+  bool shouldSendNeighborSolicitation(
+      VlanID vlan,
+      const folly::IPAddressV6& target);
+
   void sendNeighborAdvertisement(
       VlanID vlan,
       folly::MacAddress srcMac,
@@ -181,8 +194,19 @@ class IPv6Handler : public AutoRegisterStateObserver {
           std::optional<PortDescriptor>(),
       const NDPOptions& options = NDPOptions());
 
+  using SolicitationKey = std::tuple<
+      VlanID,
+      folly::MacAddress,
+      folly::IPAddressV6,
+      std::optional<uint32_t>,
+      std::optional<folly::MacAddress>,
+      std::optional<folly::MacAddress>>;
+
   SwSwitch* sw_{nullptr};
   RAMap routeAdvertisers_;
+  TxPacketTemplateCache<SolicitationKey, SolicitationTemplate>
+      solicitationTemplates_;
+  NeighborResolutionLimiter resolutionLimiter_;
 };
 
 } // namespace facebook::fboss
@@ -26,12 +26,13 @@ LacpController::LacpController(
     folly::EventBase* evb,
     LacpServicerIf* servicer)
     : portID_(portID),
-      tx_(*this, evb, servicer),
+      scheduler_(LacpScheduler::get(evb)),
+      tx_(*this, servicer),
       rx_(*this,
-          evb,
+          *scheduler_,
           servicer,
           cfg::switch_config_constants::DEFAULT_LACP_HOLD_TIMER_MULTIPLIER()),
-      periodicTx_(*this, evb),
+      periodicTx_(*this, *scheduler_, servicer),
       mux_(*this, evb, servicer),
       selector_(*this),
       evb_(evb),
@@ -55,9 +56,10 @@ LacpController::LacpController(
       portID_(portID),
       portPriority_(portPriority),
       systemPriority_(systemPriority),
-      tx_(*this, evb, servicer),
-      rx_(*this, evb, servicer, holdTimerMultiplier),
-      periodicTx_(*this, evb),
+      scheduler_(LacpScheduler::get(evb)),
+      tx_(*this, servicer),
+      rx_(*this, *scheduler_, servicer, holdTimerMultiplier),
+      periodicTx_(*this, *scheduler_, servicer),
       mux_(*this, evb, servicer),
       selector_(*this, minLinkCount),
       evb_(evb),
@@ -93,6 +93,10 @@ class LacpController : public std::enable_shared_from_this<LacpController> {
 
   LacpState actorState_{LacpState::NONE};
 
+  // Shared by the controllers on evb_, declared first so it outlives the
+  // machines scheduled on it
+  std::shared_ptr<LacpScheduler> scheduler_;
+
   TransmitMachine tx_;
   ReceiveMachine rx_;
   PeriodicTransmissionMachine periodicTx_;
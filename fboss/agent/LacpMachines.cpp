@@ -140,11 +140,11 @@ std::ostream& operator<<(std::ostream& out, MuxMachine::MuxState s) {
 
 ReceiveMachine::ReceiveMachine(
     LacpController& controller,
-    folly::EventBase* evb,
+    LacpScheduler& scheduler,
     LacpServicerIf* servicer,
     uint16_t holdTimerMultiplier)
-    : folly::AsyncTimeout(evb),
-      controller_(controller),
+    : controller_(controller),
+      scheduler_(scheduler),
       servicer_(servicer),
       slowEpochSeconds_(std::chrono::seconds(30 * holdTimerMultiplier)),
       fastEpochSeconds_(std::chrono::seconds(1 * holdTimerMultiplier)) {}
@@ -339,7 +339,7 @@ void ReceiveMachine::recordPDU(LACPDU& lacpdu) {
 }
 
 void ReceiveMachine::startNextEpoch(std::chrono::seconds duration) {
-  scheduleTimeout(duration);
+  scheduler_.timer().scheduleTimeout(this, duration);
 }
 
 void ReceiveMachine::endThisEpoch() {
@@ -407,10 +407,13 @@ const std::chrono::seconds PeriodicTransmissionMachine::LONG_PERIOD(30);
 
 PeriodicTransmissionMachine::PeriodicTransmissionMachine(
     LacpController& controller,
-    folly::EventBase* evb)
-    : folly::AsyncTimeout(evb), controller_(controller) {}
+    LacpScheduler& scheduler,
+    LacpServicerIf* servicer)
+    : controller_(controller), scheduler_(scheduler), servicer_(servicer) {}
 
-PeriodicTransmissionMachine::~PeriodicTransmissionMachine() {}
+PeriodicTransmissionMachine::~PeriodicTransmissionMachine() {
+  scheduler_.cancel(this);
+}
 
 void PeriodicTransmissionMachine::start() {
   state_ = determineTransmissionRate();
@@ -418,7 +421,7 @@ void PeriodicTransmissionMachine::start() {
 }
 
 void PeriodicTransmissionMachine::stop() {
-  cancelTimeout();
+  endThisPeriod();
 }
 
 void PeriodicTransmissionMachine::portUp() {
@@ -432,7 +435,7 @@ void PeriodicTransmissionMachine::portUp() {
 void PeriodicTransmissionMachine::portDown() {
   CHECK(controller_.evb()->inRunningEventBaseThread());
 
-  cancelTimeout();
+  endThisPeriod();
 }
 
 void PeriodicTransmissionMachine::beginNextPeriod() {
@@ -440,28 +443,45 @@ void PeriodicTransmissionMachine::beginNextPeriod() {
     case PeriodicState::SLOW:
       XLOG(DBG4) << "PeriodicTransmissionMachine[" << controller_.portID()
                  << "]: scheduling timeout for long period";
-      scheduleTimeout(LONG_PERIOD);
+      period_ = LONG_PERIOD;
       break;
     case PeriodicState::FAST:
       XLOG(DBG4) << "PeriodicTransmissionMachine[" << controller_.portID()
                  << "]: scheduling timeout for short period";
-      scheduleTimeout(SHORT_PERIOD);
+      period_ = SHORT_PERIOD;
       break;
     case PeriodicState::NONE:
       XLOG(DBG4) << "PeriodicTransmissionMachine[" << controller_.portID()
                  << "]: not scheduling a timeout";
-      break;
+      return;
     case PeriodicState::TX:
       throw LACPError("invalid transition to ", state_);
       break;
   }
+  periodStart_ = LacpScheduler::Clock::now();
+  scheduler_.schedule(this, period_);
 }
 
-void PeriodicTransmissionMachine::timeoutExpired() noexcept {
+void PeriodicTransmissionMachine::endThisPeriod() {
+  scheduler_.cancel(this);
+  periodStart_.reset();
+}
+
+void PeriodicTransmissionMachine::periodExpired(
+    std::chrono::milliseconds lateness) noexcept {
   try {
     XLOG(DBG4) << "PeriodicTransmissionMachine[" << controller_.portID()
                << "]: end of period";
 
+    auto now = LacpScheduler::Clock::now();
+    std::optional<std::chrono::milliseconds> jitter;
+    if (periodStart_) {
+      auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+          now - *periodStart_);
+      jitter = elapsed > period_ ? elapsed - period_ : period_ - elapsed;
+    }
+    servicer_->recordLacpPeriodicTransmission(lateness, jitter);
+
     state_ = PeriodicState::TX;
 
     controller_.ntt();
@@ -472,7 +492,7 @@ void PeriodicTransmissionMachine::timeoutExpired() noexcept {
   } catch (...) {
     std::exception_ptr e = std::current_exception();
     CHECK(e);
-    XLOG(FATAL) << "PeriodicTranmissionMachine::timeoutExpired(): "
+    XLOG(FATAL) << "PeriodicTranmissionMachine::periodExpired(): "
                 << folly::exceptionStr(e);
   }
 }
@@ -497,34 +517,40 @@ const int TransmitMachine::MAX_TRANSMISSIONS_IN_SHORT_PERIOD = 3;
 
 TransmitMachine::TransmitMachine(
     LacpController& controller,
-    folly::EventBase* evb,
     LacpServicerIf* servicer)
-    : folly::AsyncTimeout(evb), controller_(controller), servicer_(servicer) {}
+    : controller_(controller), servicer_(servicer) {}
 
 TransmitMachine::~TransmitMachine() {}
 
 void TransmitMachine::start() {
-  scheduleTimeout(TransmitMachine::TX_REPLENISH_RATE);
+  lastReplenished_ = std::chrono::steady_clock::now();
 }
 
 void TransmitMachine::stop() {
-  cancelTimeout();
-}
-
-void TransmitMachine::timeoutExpired() noexcept {
-  replenishTranmissionsLeft();
+  lastReplenished_.reset();
 }
 
 void TransmitMachine::replenishTranmissionsLeft() noexcept {
-  transmissionsLeft_ = std::min(
-      transmissionsLeft_ + 1,
+  if (!lastReplenished_) {
+    return;
+  }
+  // One transmission is replenished for every TX_REPLENISH_RATE elapsed
+  auto now = std::chrono::steady_clock::now();
+  auto replenished = (now - *lastReplenished_) / TX_REPLENISH_RATE;
+  if (replenished == 0) {
+    return;
+  }
+  *lastReplenished_ += replenished * TX_REPLENISH_RATE;
+  transmissionsLeft_ = std::min<int64_t>(
+      transmissionsLeft_ + replenished,
       TransmitMachine::MAX_TRANSMISSIONS_IN_SHORT_PERIOD);
-  scheduleTimeout(TransmitMachine::TX_REPLENISH_RATE);
 }
 
 void TransmitMachine::ntt(LACPDU lacpdu) {
   CHECK(controller_.evb()->inRunningEventBaseThread());
 
+  replenishTranmissionsLeft();
+
   if (transmissionsLeft_ == 0) {
     // TODO(samank): figure out stale ntt details
     XLOG(DBG4) << "TransmitMachine[" << controller_.portID() << "]: "
@@ -10,10 +10,13 @@
 #pragma once
 
 #include <folly/io/async/AsyncTimeout.h>
+#include <folly/io/async/HHWheelTimer.h>
+#include <chrono>
 #include <optional>
 
 #include <boost/container/flat_map.hpp>
 
+#include "fboss/agent/LacpScheduler.h"
 #include "fboss/agent/LacpTypes.h"
 #include "fboss/agent/state/AggregatePort.h"
 #include "fboss/agent/types.h"
@@ -30,11 +33,11 @@ class LacpServicerIf;
  * See IEEE 802.3AD-2000 43.4.3 for an overview of each state machine
  */
 
-class ReceiveMachine : private folly::AsyncTimeout {
+class ReceiveMachine : private folly::HHWheelTimer::Callback {
  public:
   explicit ReceiveMachine(
       LacpController& controller,
-      folly::EventBase* evb,
+      LacpScheduler& scheduler,
       LacpServicerIf* servicer,
       uint16_t holdTimerMultiplier);
   ~ReceiveMachine() override;
@@ -74,6 +77,7 @@ class ReceiveMachine : private folly::AsyncTimeout {
 
   // Timer-related
   void timeoutExpired() noexcept override;
+  void callbackCanceled() noexcept override {}
   void startNextEpoch(std::chrono::seconds duration);
   void endThisEpoch();
 
@@ -91,6 +95,7 @@ class ReceiveMachine : private folly::AsyncTimeout {
   ParticipantInfo partnerInfo_; // operational
 
   LacpController& controller_;
+  LacpScheduler& scheduler_;
   LacpServicerIf* servicer_{nullptr};
   std::chrono::seconds slowEpochSeconds_;
   std::chrono::seconds fastEpochSeconds_;
@@ -98,11 +103,12 @@ class ReceiveMachine : private folly::AsyncTimeout {
 void toAppend(ReceiveMachine::ReceiveState state, std::string* result);
 std::ostream& operator<<(std::ostream& out, ReceiveMachine::ReceiveState s);
 
-class PeriodicTransmissionMachine : private folly::AsyncTimeout {
+class PeriodicTransmissionMachine : private LacpScheduler::PeriodicCallback {
  public:
   explicit PeriodicTransmissionMachine(
       LacpController& controller,
-      folly::EventBase* evb);
+      LacpScheduler& scheduler,
+      LacpServicerIf* servicer);
   ~PeriodicTransmissionMachine() override;
 
   void portUp();
@@ -121,24 +127,27 @@ class PeriodicTransmissionMachine : private folly::AsyncTimeout {
       PeriodicTransmissionMachine::PeriodicState state,
       std::string* result);
 
-  void timeoutExpired() noexcept override;
+  void periodExpired(std::chrono::milliseconds lateness) noexcept override;
   void beginNextPeriod();
+  void endThisPeriod();
   PeriodicState determineTransmissionRate();
 
   PeriodicState state_{PeriodicState::NONE};
   LacpController& controller_;
+  LacpScheduler& scheduler_;
+  LacpServicerIf* servicer_{nullptr};
+  // Start and length of the period being waited for, used to compute jitter
+  std::optional<LacpScheduler::Clock::time_point> periodStart_;
+  std::chrono::milliseconds period_{0};
 };
 void toAppend(
     PeriodicTransmissionMachine::PeriodicState state,
     std::string* result);
 
-class TransmitMachine : private folly::AsyncTimeout {
+class TransmitMachine {
  public:
-  TransmitMachine(
-      LacpController& controller,
-      folly::EventBase* evb,
-      LacpServicerIf* servicer);
-  ~TransmitMachine() override;
+  TransmitMachine(LacpController& controller, LacpServicerIf* servicer);
+  ~TransmitMachine();
 
   void ntt(LACPDU lacpdu);
 
@@ -148,13 +157,15 @@ class TransmitMachine : private folly::AsyncTimeout {
  private:
   enum class PeriodicState { NONE, SLOW, FAST, TX };
 
-  void timeoutExpired() noexcept override;
+  // Transmissions are replenished lazily, on the next ntt, rather than from
+  // a timer firing every TX_REPLENISH_RATE
   void replenishTranmissionsLeft() noexcept;
 
   static const int MAX_TRANSMISSIONS_IN_SHORT_PERIOD;
   static const std::chrono::seconds TX_REPLENISH_RATE;
 
   int transmissionsLeft_{MAX_TRANSMISSIONS_IN_SHORT_PERIOD};
+  std::optional<std::chrono::steady_clock::time_point> lastReplenished_;
   LacpController& controller_;
   LacpServicerIf* servicer_{nullptr};
 };
@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/LacpScheduler.h"
+
+#include <folly/Indestructible.h>
+#include <folly/Synchronized.h>
+#include <glog/logging.h>
+
+#include <unordered_map>
+
+DEFINE_int32(
+    lacp_tick_ms,
+    50,
+    "Granularity of the periodic LACPDU transmissions. The transmissions "
+    "due in the same tick are sent together.");
+
+namespace facebook::fboss {
+
+namespace {
+LacpScheduler::Clock::time_point roundUpToTick(
+    LacpScheduler::Clock::time_point deadline) {
+  std::chrono::milliseconds tick(FLAGS_lacp_tick_ms);
+  if (tick.count() <= 0) {
+    return deadline;
+  }
+  auto remainder = deadline.time_since_epoch() % tick;
+  if (remainder.count() > 0) {
+    deadline += tick - remainder;
+  }
+  return deadline;
+}
+} // namespace
+
+std::shared_ptr<LacpScheduler> LacpScheduler::get(folly::EventBase* evb) {
+  using Schedulers =
+      std::unordered_map<folly::EventBase*, std::weak_ptr<LacpScheduler>>;
+  static folly::Indestructible<folly::Synchronized<Schedulers>> schedulers;
+
+  auto locked = schedulers->wlock();
+  for (auto it = locked->begin(); it != locked->end();) {
+    it = it->second.expired() ? locked->erase(it) : std::next(it);
+  }
+  auto& entry = (*locked)[evb];
+  auto scheduler = entry.lock();
+  if (!scheduler) {
+    scheduler = std::make_shared<LacpScheduler>(evb);
+    entry = scheduler;
+  }
+  return scheduler;
+}
+
+LacpScheduler::LacpScheduler(folly::EventBase* evb)
+    : folly::AsyncTimeout(evb), evb_(evb) {}
+
+LacpScheduler::~LacpScheduler() {
+  for (auto& deadline : deadlines_) {
+    deadline.second->deadline_.reset();
+  }
+}
+
+void LacpScheduler::schedule(
+    PeriodicCallback* callback,
+    std::chrono::milliseconds period) {
+  DCHECK(evb_->isInEventBaseThread());
+  cancel(callback);
+  auto now = Clock::now();
+  callback->deadline_ =
+      deadlines_.emplace(roundUpToTick(now + period), callback);
+  scheduleNextTick(now);
+}
+
+void LacpScheduler::cancel(PeriodicCallback* callback) {
+  if (!callback->deadline_) {
+    return;
+  }
+  deadlines_.erase(*callback->deadline_);
+  callback->deadline_.reset();
+  if (deadlines_.empty()) {
+    cancelTimeout();
+    nextTick_.reset();
+  }
+}
+
+void LacpScheduler::scheduleNextTick(Clock::time_point now) {
+  if (deadlines_.empty()) {
+    return;
+  }
+  auto earliest = deadlines_.begin()->first;
+  if (nextTick_ && *nextTick_ <= earliest) {
+    return;
+  }
+  nextTick_ = earliest;
+  auto timeout = earliest > now
+      ? std::chrono::ceil<std::chrono::milliseconds>(earliest - now)
+      : std::chrono::milliseconds(0);
+  scheduleTimeout(timeout);
+}
+
+void LacpScheduler::timeoutExpired() noexcept {
+  ++ticks_;
+  nextTick_.reset();
+  auto now = Clock::now();
+  // Callbacks may cancel or reschedule any deadline, so take them one at a
+  // time rather than iterating over the map. Rescheduled ones land in a later
+  // tick, since periods are never shorter than a tick.
+  while (!deadlines_.empty() && deadlines_.begin()->first <= now) {
+    auto it = deadlines_.begin();
+    auto deadline = it->first;
+    auto callback = it->second;
+    deadlines_.erase(it);
+    callback->deadline_.reset();
+    callback->periodExpired(
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - deadline));
+  }
+  scheduleNextTick(Clock::now());
+}
+
+} // namespace facebook::fboss
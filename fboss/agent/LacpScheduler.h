@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/io/async/AsyncTimeout.h>
+#include <folly/io/async/EventBase.h>
+#include <folly/io/async/HHWheelTimer.h>
+#include <gflags/gflags.h>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <optional>
+
+DECLARE_int32(lacp_tick_ms);
+
+namespace facebook::fboss {
+
+/*
+ * All the LacpControllers running on the same EventBase share one
+ * LacpScheduler. Rather than arming a timer per member port, the periodic
+ * transmission deadlines are rounded up to a tick of FLAGS_lacp_tick_ms and
+ * kept sorted here, and a single timeout fires every callback due in a tick,
+ * so that their LACPDUs go out together. Receive timeouts are scheduled on
+ * the timer wheel of the EventBase.
+ *
+ * Apart from get(), this class must only be used from the EventBase thread.
+ */
+class LacpScheduler : private folly::AsyncTimeout {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  class PeriodicCallback {
+   public:
+    virtual ~PeriodicCallback() = default;
+
+    // lateness is how long after its deadline the callback was run
+    virtual void periodExpired(std::chrono::milliseconds lateness) noexcept = 0;
+
+    bool isPeriodScheduled() const {
+      return deadline_.has_value();
+    }
+
+   private:
+    friend class LacpScheduler;
+    std::optional<std::multimap<Clock::time_point, PeriodicCallback*>::iterator>
+        deadline_;
+  };
+
+  // The scheduler of evb, created if there isn't one yet
+  static std::shared_ptr<LacpScheduler> get(folly::EventBase* evb);
+
+  explicit LacpScheduler(folly::EventBase* evb);
+  ~LacpScheduler() override;
+
+  // Run callback once period has elapsed, replacing its current deadline
+  void schedule(PeriodicCallback* callback, std::chrono::milliseconds period);
+  void cancel(PeriodicCallback* callback);
+
+  folly::HHWheelTimer& timer() {
+    return evb_->timer();
+  }
+
+  // For testing purpose
+  uint64_t getTicks() const {
+    return ticks_;
+  }
+  size_t getNumScheduled() const {
+    return deadlines_.size();
+  }
+
+ private:
+  void timeoutExpired() noexcept override;
+  void scheduleNextTick(Clock::time_point now);
+
+  // Forbidden copy constructor and assignment operator
+  LacpScheduler(LacpScheduler const&) = delete;
+  LacpScheduler& operator=(LacpScheduler const&) = delete;
+
+  folly::EventBase* evb_{nullptr};
+  std::multimap<Clock::time_point, PeriodicCallback*> deadlines_;
+  std::optional<Clock::time_point> nextTick_;
+  uint64_t ticks_{0};
+};
+
+} // namespace facebook::fboss
@@ -17,6 +17,7 @@
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/TxPacket.h"
+#include "fboss/agent/TxPacketTemplate.h"
 #include "fboss/agent/state/AggregatePortMap.h"
 #include "fboss/agent/state/DeltaFunctions.h"
 #include "fboss/agent/state/Port.h"
@@ -200,6 +201,7 @@ void LinkAggregationManager::aggregatePortRemoved(
     CHECK_NE(it, portToController_.end());
     it->second->stopMachines();
     portToController_.erase(it);
+    lastSentLacpdus_.wlock()->erase(subport.portID);
   }
 }
 
@@ -209,6 +211,7 @@ void LinkAggregationManager::stopLacpOnSubPort(PortID subPort) {
   CHECK_NE(it, portToController_.end());
   it->second->stopMachines();
   portToController_.erase(it);
+  lastSentLacpdus_.wlock()->erase(subPort);
 }
 
 void LinkAggregationManager::aggregatePortChanged(
@@ -322,37 +325,63 @@ void LinkAggregationManager::populatePartnerPairs(
 bool LinkAggregationManager::transmit(LACPDU lacpdu, PortID portID) {
   CHECK(sw_->getLacpEvb()->inRunningEventBaseThread());
 
-  auto pkt = sw_->allocatePacket(LACPDU::LENGTH);
-  if (!pkt) {
-    XLOG(DBG4) << "Failed to allocate tx packet for LACPDU transmission";
-    return false;
-  }
-
-  folly::io::RWPrivateCursor writer(pkt->buf());
-
-  folly::MacAddress cpuMac = sw_->getPlatform()->getLocalMac();
-
   auto port = sw_->getState()->getPorts()->getPortIf(portID);
   CHECK(port);
 
-  TxPacket::writeEthHeader(
-      &writer,
-      LACPDU::kSlowProtocolsDstMac(),
-      cpuMac,
-      port->getIngressVlan(),
-      LACPDU::EtherType::SLOW_PROTOCOLS);
-
-  writer.writeBE<uint8_t>(LACPDU::EtherSubtype::LACP);
+  // Periodic transmissions repeat the same LACPDU until the actor or partner
+  // state changes, so the frame last sent out of the port is reused as is.
+  std::shared_ptr<const TxPacketTemplate> frame;
+  {
+    auto lastSentLacpdus = lastSentLacpdus_.wlock();
+    auto& lastSent = (*lastSentLacpdus)[portID];
+    if (!lastSent.frame || lastSent.vlan != port->getIngressVlan() ||
+        !(lastSent.actorInfo == lacpdu.actorInfo) ||
+        !(lastSent.partnerInfo == lacpdu.partnerInfo) ||
+        lastSent.maxDelay != lacpdu.maxDelay) {
+      folly::MacAddress cpuMac = sw_->getPlatform()->getLocalMac();
+      lastSent.frame = std::make_shared<const TxPacketTemplate>(
+          LACPDU::LENGTH, [&](folly::io::RWPrivateCursor* writer) {
+            TxPacket::writeEthHeader(
+                writer,
+                LACPDU::kSlowProtocolsDstMac(),
+                cpuMac,
+                port->getIngressVlan(),
+                LACPDU::EtherType::SLOW_PROTOCOLS);
+
+            writer->writeBE<uint8_t>(LACPDU::EtherSubtype::LACP);
+
+            lacpdu.to(writer);
+          });
+      lastSent.vlan = port->getIngressVlan();
+      lastSent.actorInfo = lacpdu.actorInfo;
+      lastSent.partnerInfo = lacpdu.partnerInfo;
+      lastSent.maxDelay = lacpdu.maxDelay;
+    }
+    frame = lastSent.frame;
+  }
 
-  lacpdu.to(&writer);
+  auto pkt = frame->allocatePacket(sw_);
+  if (!pkt) {
+    XLOG(DBG4) << "Failed to allocate tx packet for LACPDU transmission";
+    return false;
+  }
 
   // TODO(joseph5wu) Actually LACP should be multicast pkt, and using
   // OutOfPacket will actually send the packet to unicast queue.
-  sw_->sendNetworkControlPacketAsync(std::move(pkt), PortDescriptor(portID));
+  pendingTx_.emplace_back(std::move(pkt), portID);
+  if (!flushTransmissionsCallback_.isLoopCallbackScheduled()) {
+    sw_->getLacpEvb()->runInLoop(&flushTransmissionsCallback_);
+  }
 
   return true;
 }
 
+void LinkAggregationManager::flushPendingTransmissions() {
+  std::vector<std::pair<std::unique_ptr<TxPacket>, PortID>> pkts;
+  pkts.swap(pendingTx_);
+  sw_->sendNetworkControlPacketsAsync(std::move(pkts));
+}
+
 void LinkAggregationManager::enableForwardingAndSetPartnerState(
     PortID portID,
     AggregatePortID aggPortID,
@@ -387,6 +416,15 @@ void LinkAggregationManager::recordLacpMismatchPduTeardown() {
   sw_->stats()->LacpMismatchPduTeardown();
 }
 
+void LinkAggregationManager::recordLacpPeriodicTransmission(
+    std::chrono::milliseconds lateness,
+    std::optional<std::chrono::milliseconds> jitter) {
+  sw_->stats()->LacpTxLateness(lateness.count());
+  if (jitter) {
+    sw_->stats()->LacpTxJitter(jitter->count());
+  }
+}
+
 std::vector<std::shared_ptr<LacpController>>
 LinkAggregationManager::getControllersFor(
     folly::Range<std::vector<PortID>::const_iterator> ports) {
@@ -415,6 +453,12 @@ LinkAggregationManager::~LinkAggregationManager() {
   for (auto controller : portToController_) {
     controller.second->stopMachines();
   }
+  // Like the LACPDUs they send, the flush callback is only ever touched from
+  // the LACP thread
+  sw_->getLacpEvb()->runInEventBaseThreadAndWait([this]() {
+    flushTransmissionsCallback_.cancelLoopCallback();
+    pendingTx_.clear();
+  });
 }
 
 } // namespace facebook::fboss
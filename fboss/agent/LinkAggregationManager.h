@@ -11,15 +11,23 @@
 
 #include "fboss/agent/LacpTypes.h"
 #include "fboss/agent/StateObserver.h"
+#include "fboss/agent/TxPacket.h"
+#include "fboss/agent/TxPacketTemplate.h"
 #include "fboss/agent/state/AggregatePort.h"
 #include "fboss/agent/types.h"
 
 #include <boost/container/flat_map.hpp>
 
 #include <folly/SharedMutex.h>
+#include <folly/Synchronized.h>
 #include <folly/io/Cursor.h>
+#include <folly/io/async/EventBase.h>
 
+#include <chrono>
+#include <map>
 #include <memory>
+#include <optional>
+#include <utility>
 #include <vector>
 
 namespace facebook::fboss {
@@ -45,6 +53,10 @@ struct LacpServicerIf {
       const ParticipantInfo& partnerState) = 0;
   virtual void recordLacpTimeout() = 0;
   virtual void recordLacpMismatchPduTeardown() = 0;
+  // jitter is only known when the previous period ran to completion
+  virtual void recordLacpPeriodicTransmission(
+      std::chrono::milliseconds lateness,
+      std::optional<std::chrono::milliseconds> jitter) = 0;
   // If Selector was a static member of LinkAggregationManager, this wouldn't be
   // necessary
   virtual std::vector<std::shared_ptr<LacpController>> getControllersFor(
@@ -91,6 +103,9 @@ class LinkAggregationManager : public AutoRegisterStateObserver,
       const ParticipantInfo& partnerState) override;
   void recordLacpTimeout() override;
   void recordLacpMismatchPduTeardown() override;
+  void recordLacpPeriodicTransmission(
+      std::chrono::milliseconds lateness,
+      std::optional<std::chrono::milliseconds> jitter) override;
   std::vector<std::shared_ptr<LacpController>> getControllersFor(
       folly::Range<std::vector<PortID>::const_iterator> ports) override;
 
@@ -116,6 +131,8 @@ class LinkAggregationManager : public AutoRegisterStateObserver,
       const std::shared_ptr<AggregatePort>& oldAggPort,
       const std::shared_ptr<AggregatePort>& newAggPort);
 
+  void flushPendingTransmissions();
+
   // Forbidden copy constructor and assignment operator
   LinkAggregationManager(LinkAggregationManager const&) = delete;
   LinkAggregationManager& operator=(LinkAggregationManager const&) = delete;
@@ -126,9 +143,37 @@ class LinkAggregationManager : public AutoRegisterStateObserver,
       std::ostream& out,
       const PortIDToController::iterator& it);
 
+  class FlushTransmissionsCallback : public folly::EventBase::LoopCallback {
+   public:
+    explicit FlushTransmissionsCallback(LinkAggregationManager* manager)
+        : manager_(manager) {}
+
+    void runLoopCallback() noexcept override {
+      manager_->flushPendingTransmissions();
+    }
+
+   private:
+    LinkAggregationManager* manager_;
+  };
+
+  struct SentLacpdu {
+    VlanID vlan{0};
+    ParticipantInfo actorInfo;
+    ParticipantInfo partnerInfo;
+    LACPDU::Delay maxDelay{0};
+    std::shared_ptr<const TxPacketTemplate> frame;
+  };
+
   PortIDToController portToController_;
   mutable folly::SharedMutexWritePriority controllersLock_;
   SwSwitch* sw_{nullptr};
+  // The last LACPDU sent out of each port. Sent from the LACP thread, and
+  // erased from the update thread when the port's controller is removed.
+  folly::Synchronized<std::map<PortID, SentLacpdu>> lastSentLacpdus_;
+  // LACPDUs transmitted in the current loop of the LACP thread, which all the
+  // periodic transmissions of a scheduler tick are, sent as one batch
+  std::vector<std::pair<std::unique_ptr<TxPacket>, PortID>> pendingTx_;
+  FlushTransmissionsCallback flushTransmissionsCallback_{this};
 };
 
 } // namespace facebook::fboss
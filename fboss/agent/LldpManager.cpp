@@ -16,6 +16,8 @@
 #include <folly/io/Cursor.h>
 #include <folly/logging/xlog.h>
 #include <unistd.h>
+#include <utility>
+#include <vector>
 #include "fboss/agent/RxPacket.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/SwitchStats.h"
@@ -151,14 +153,18 @@ void LldpManager::timeoutExpired() noexcept {
 void LldpManager::sendLldpOnAllPorts() {
   // send lldp frames through all the ports here.
   std::shared_ptr<SwitchState> state = sw_->getState();
+  auto hostname = getHostname();
+  std::vector<std::pair<std::unique_ptr<TxPacket>, PortID>> pkts;
   for (const auto& port : *state->getPorts()) {
     if (port->isPortUp()) {
-      sendLldpInfo(port);
+      pkts.emplace_back(createLldpPktForPort(port, hostname), port->getID());
     } else {
       XLOG(DBG5) << "Skipping LLDP send as this port is disabled "
                  << port->getID();
     }
   }
+  // these LLDP packets HAVE to exit out of the ports they are paired with.
+  sw_->sendNetworkControlPacketsAsync(std::move(pkts));
 }
 
 uint16_t tlvHeader(uint16_t type, uint16_t length) {
@@ -252,27 +258,30 @@ uint32_t LldpManager::LldpPktSize(
       + 2;
 }
 
-std::unique_ptr<TxPacket> LldpManager::createLldpPkt(
-    SwSwitch* sw,
+namespace {
+
+void writeLldpPkt(
+    RWPrivateCursor* cursor,
     const MacAddress macaddr,
     VlanID vlanid,
     const std::string& hostname,
     const std::string& portname,
     const std::string& portdesc,
+    const std::string& sysDesc,
     const uint16_t ttl,
     const uint16_t capabilities) {
-  static std::string lldpSysDescStr("FBOSS");
-  uint32_t frameLen = LldpPktSize(hostname, portname, portdesc, lldpSysDescStr);
-
-  auto pkt = sw->allocatePacket(frameLen);
-  RWPrivateCursor cursor(pkt->buf());
-  pkt->writeEthHeader(&cursor, LLDP_DEST_MAC, macaddr, vlanid, ETHERTYPE_LLDP);
+  TxPacket::writeEthHeader(
+      cursor,
+      LldpManager::LLDP_DEST_MAC,
+      macaddr,
+      vlanid,
+      LldpManager::ETHERTYPE_LLDP);
   // now write chassis ID TLV
   writeTlv(
       LldpTlvType::CHASSIS,
       LldpChassisIdType::MAC_ADDRESS,
       ByteRange(macaddr.bytes(), 6),
-      &cursor);
+      cursor);
 
   // now write port ID TLV
   /* using StringPiece here to bridge chars in string to unsigned chars in
@@ -282,41 +291,66 @@ std::unique_ptr<TxPacket> LldpManager::createLldpPkt(
       LldpTlvType::PORT,
       LldpPortIdType::INTERFACE_NAME,
       StringPiece(portname),
-      &cursor);
+      cursor);
 
   // now write TTL TLV
-  writeTlv(LldpTlvType::TTL, ttl, &cursor);
+  writeTlv(LldpTlvType::TTL, ttl, cursor);
 
   // now write optional TLVs
   // system name TLV
   if (hostname.size() > 0) {
-    writeTlv(LldpTlvType::SYSTEM_NAME, StringPiece(hostname), &cursor);
+    writeTlv(LldpTlvType::SYSTEM_NAME, StringPiece(hostname), cursor);
   }
 
   // Port description
-  writeTlv(LldpTlvType::PORT_DESC, StringPiece(portdesc), &cursor);
+  writeTlv(LldpTlvType::PORT_DESC, StringPiece(portdesc), cursor);
 
   // system description TLV
-  writeTlv(
-      LldpTlvType::SYSTEM_DESCRIPTION, StringPiece(lldpSysDescStr), &cursor);
+  writeTlv(LldpTlvType::SYSTEM_DESCRIPTION, StringPiece(sysDesc), cursor);
 
   // system capability TLV
   uint32_t enabledCapabilities = (capabilities << 16) | capabilities;
-  writeTlv(LldpTlvType::SYSTEM_CAPABILITY, enabledCapabilities, &cursor);
+  writeTlv(LldpTlvType::SYSTEM_CAPABILITY, enabledCapabilities, cursor);
 
   // now write PDU End TLV
-  writeTl(LldpTlvType::PDU_END, PDU_END_TLV_LENGTH, &cursor);
+  writeTl(LldpTlvType::PDU_END, LldpManager::PDU_END_TLV_LENGTH, cursor);
 
   // Fill the padding with 0s
-  memset(cursor.writableData(), 0, cursor.length());
+  memset(cursor->writableData(), 0, cursor->length());
+}
+
+const std::string kLldpSysDescStr("FBOSS");
+
+} // namespace
+
+std::unique_ptr<TxPacket> LldpManager::createLldpPkt(
+    SwSwitch* sw,
+    const MacAddress macaddr,
+    VlanID vlanid,
+    const std::string& hostname,
+    const std::string& portname,
+    const std::string& portdesc,
+    const uint16_t ttl,
+    const uint16_t capabilities) {
+  uint32_t frameLen =
+      LldpPktSize(hostname, portname, portdesc, kLldpSysDescStr);
 
+  auto pkt = sw->allocatePacket(frameLen);
+  RWPrivateCursor cursor(pkt->buf());
+  writeLldpPkt(
+      &cursor,
+      macaddr,
+      vlanid,
+      hostname,
+      portname,
+      portdesc,
+      kLldpSysDescStr,
+      ttl,
+      capabilities);
   return pkt;
 }
 
-void LldpManager::sendLldpInfo(const std::shared_ptr<Port>& port) {
-  MacAddress cpuMac = sw_->getPlatform()->getLocalMac();
-  PortID thisPortID = port->getID();
-
+std::string LldpManager::getHostname() {
   const size_t kMaxLen = 64;
   std::array<char, kMaxLen> hostname;
   if (0 == gethostname(hostname.data(), kMaxLen)) {
@@ -325,25 +359,49 @@ void LldpManager::sendLldpInfo(const std::shared_ptr<Port>& port) {
   } else {
     hostname[0] = '\0';
   }
+  return std::string(hostname.data());
+}
 
-  auto pkt = LldpManager::createLldpPkt(
-      sw_,
-      cpuMac,
-      port->getIngressVlan(),
-      std::string(hostname.data()),
-      port->getName(),
-      port->getDescription(),
-      TTL_TLV_VALUE,
-      SYSTEM_CAPABILITY_ROUTER);
-
-  // this LLDP packet HAS to exit out of the port specified here.
-  sw_->sendNetworkControlPacketAsync(
-      std::move(pkt), PortDescriptor(thisPortID));
-
-  XLOG(DBG4) << "sent LLDP "
+std::unique_ptr<TxPacket> LldpManager::createLldpPktForPort(
+    const std::shared_ptr<Port>& port,
+    const std::string& hostname) {
+  MacAddress cpuMac = sw_->getPlatform()->getLocalMac();
+  // A port's frame only changes with its config, so it is serialized once
+  // and copied on every send after that
+  auto frame = frames_.get(
+      LldpFrameKey(
+          port->getID(),
+          port->getIngressVlan(),
+          cpuMac,
+          hostname,
+          port->getName(),
+          port->getDescription()),
+      [&]() {
+        return std::make_shared<const TxPacketTemplate>(
+            LldpPktSize(
+                hostname,
+                port->getName(),
+                port->getDescription(),
+                kLldpSysDescStr),
+            [&](RWPrivateCursor* cursor) {
+              writeLldpPkt(
+                  cursor,
+                  cpuMac,
+                  port->getIngressVlan(),
+                  hostname,
+                  port->getName(),
+                  port->getDescription(),
+                  kLldpSysDescStr,
+                  TTL_TLV_VALUE,
+                  SYSTEM_CAPABILITY_ROUTER);
+            });
+      });
+
+  XLOG(DBG4) << "sending LLDP "
              << " on port " << port->getID() << " with CPU MAC "
              << cpuMac.toString() << " port id " << port->getName()
              << " and vlan " << port->getIngressVlan();
+  return frame->allocatePacket(sw_);
 }
 
 } // namespace facebook::fboss
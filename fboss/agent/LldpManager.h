@@ -11,8 +11,11 @@
 #pragma once
 #include <folly/io/async/AsyncTimeout.h>
 #include <memory>
+#include <string>
+#include <tuple>
 #include <unordered_map>
 #include "fboss/agent/Platform.h"
+#include "fboss/agent/TxPacketTemplate.h"
 #include "fboss/agent/lldp/LinkNeighborDB.h"
 #include "fboss/agent/state/Port.h"
 #include "fboss/agent/state/PortMap.h"
@@ -112,12 +115,25 @@ class LldpManager : private folly::AsyncTimeout {
       const std::string& sysDesc);
 
  private:
+  using LldpFrameKey = std::tuple<
+      PortID,
+      VlanID,
+      folly::MacAddress,
+      std::string,
+      std::string,
+      std::string>;
+
   void timeoutExpired() noexcept override;
-  void sendLldpInfo(const std::shared_ptr<Port>& port);
+  static std::string getHostname();
+  std::unique_ptr<TxPacket> createLldpPktForPort(
+      const std::shared_ptr<Port>& port,
+      const std::string& hostname);
 
   SwSwitch* sw_{nullptr};
   std::chrono::milliseconds intervalMsecs_;
   LinkNeighborDB db_;
+  // Serialized LLDP frame of each port, keyed by what goes into it
+  TxPacketTemplateCache<LldpFrameKey, TxPacketTemplate> frames_{4096};
 };
 
 } // namespace facebook::fboss
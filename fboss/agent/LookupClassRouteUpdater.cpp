@@ -29,14 +29,43 @@ namespace facebook::fboss {
 
 // Helper methods
 
-void LookupClassRouteUpdater::reAddAllRoutes(const StateDelta& stateDelta) {
+void LookupClassRouteUpdater::reAddRoutesForNewSubnets(
+    const StateDelta& stateDelta) {
+  if (vlan2SubnetsCache_.empty() || newlyCachedSubnets_.empty()) {
+    newlyCachedSubnets_.clear();
+    return;
+  }
+  auto& newState = stateDelta.newState();
+  if (!routeIndexBuilt_) {
+    buildRouteIndex(newState);
+  }
+
+  // Collect routes with a nexthop in any of the newly cached subnets
+  std::set<RidAndCidr> affectedRoutes;
+  for (const auto& [vlanID, subnet] : newlyCachedSubnets_) {
+    auto vlanIter = vlan2NextHop2Routes_.find(vlanID);
+    if (vlanIter == vlan2NextHop2Routes_.end()) {
+      continue;
+    }
+    for (const auto& [nextHop, routes] : vlanIter->second) {
+      if (nextHop.inSubnet(subnet.first, subnet.second)) {
+        affectedRoutes.insert(routes.begin(), routes.end());
+      }
+    }
+  }
+  newlyCachedSubnets_.clear();
+
   auto addRoute = [&stateDelta, this](RouterID rid, const auto& route) {
-    if (!route->getClassID().has_value()) {
+    if (route && !route->getClassID().has_value()) {
       processRouteAdded(stateDelta, rid, route);
     }
   };
-  if (!vlan2SubnetsCache_.empty()) {
-    forAllRoutes(stateDelta.newState(), addRoute);
+  for (const auto& [rid, cidr] : affectedRoutes) {
+    if (cidr.first.isV6()) {
+      addRoute(rid, findRoute<folly::IPAddressV6>(rid, cidr, newState));
+    } else {
+      addRoute(rid, findRoute<folly::IPAddressV4>(rid, cidr, newState));
+    }
   }
 }
 
@@ -116,7 +145,7 @@ bool LookupClassRouteUpdater::belongsToSubnetInCache(
     const folly::IPAddress& ipToSearch) {
   auto it = vlan2SubnetsCache_.find(vlanID);
   if (it != vlan2SubnetsCache_.end()) {
-    auto subnetsCache = it->second;
+    const auto& subnetsCache = it->second;
     for (const auto& [ipAddress, mask] : subnetsCache) {
       if (ipToSearch.inSubnet(ipAddress, mask)) {
         return true;
@@ -133,7 +162,6 @@ void LookupClassRouteUpdater::updateSubnetsCache(
     bool reAddAllRoutesEnabled) {
   auto& newState = stateDelta.newState();
 
-  bool subnetCacheUpdated = false;
   for (const auto& [vlanID, vlanInfo] : port->getVlans()) {
     std::ignore = vlanInfo;
     auto vlan = newState->getVlans()->getVlanIf(vlanID);
@@ -146,22 +174,115 @@ void LookupClassRouteUpdater::updateSubnetsCache(
         newState->getInterfaces()->getInterfaceIf(vlan->getInterfaceID());
     if (interface) {
       for (auto address : interface->getAddresses()) {
-        subnetCacheUpdated = subnetsCache.insert(address).second;
+        if (subnetsCache.insert(address).second) {
+          newlyCachedSubnets_.emplace_back(vlanID, address);
+        }
       }
     }
   }
-  if (subnetCacheUpdated && reAddAllRoutesEnabled) {
+  if (reAddAllRoutesEnabled) {
     /*
      * When a new subnet is added to the cache, the nextHops of existing
      * routes may become eligible for caching in
      * nextHopAndVlan2Prefixes_. Furthermore, such a nextHop may have
      * classID associated with it, and in that case, the corresponding
-     * route could inherit that classID. Thus, re-add all the routes.
+     * route could inherit that classID. Thus, re-add the routes with
+     * nextHops in the new subnets.
      */
-    reAddAllRoutes(stateDelta);
+    reAddRoutesForNewSubnets(stateDelta);
+  }
+}
+
+// Methods for dealing with vlan2NextHop2Routes_
+
+template <typename RouteT>
+void LookupClassRouteUpdater::indexRoute(
+    const std::shared_ptr<SwitchState>& switchState,
+    RouterID rid,
+    const std::shared_ptr<RouteT>& route,
+    bool add) {
+  // Same filter as processRouteAdded
+  if (!route->isResolved() || route->isToCPU()) {
+    return;
+  }
+  auto ridAndCidr = std::make_pair(
+      rid, folly::CIDRNetwork{route->prefix().network, route->prefix().mask});
+  for (const auto& nextHop : route->getForwardInfo().getNextHopSet()) {
+    auto interface =
+        switchState->getInterfaces()->getInterfaceIf(nextHop.intf());
+    if (!interface) {
+      continue;
+    }
+    auto vlanID = interface->getVlanID();
+    if (add) {
+      vlan2NextHop2Routes_[vlanID][nextHop.addr()].insert(ridAndCidr);
+      continue;
+    }
+    auto vlanIter = vlan2NextHop2Routes_.find(vlanID);
+    if (vlanIter == vlan2NextHop2Routes_.end()) {
+      continue;
+    }
+    auto nextHopIter = vlanIter->second.find(nextHop.addr());
+    if (nextHopIter == vlanIter->second.end()) {
+      continue;
+    }
+    nextHopIter->second.erase(ridAndCidr);
+    if (nextHopIter->second.empty()) {
+      vlanIter->second.erase(nextHopIter);
+    }
   }
 }
 
+void LookupClassRouteUpdater::buildRouteIndex(
+    const std::shared_ptr<SwitchState>& switchState) {
+  vlan2NextHop2Routes_.clear();
+  auto addRoute = [&switchState, this](RouterID rid, const auto& route) {
+    indexRoute(switchState, rid, route, true /* add */);
+  };
+  forAllRoutes(switchState, addRoute);
+  routeIndexBuilt_ = true;
+}
+
+template <typename AddrT>
+void LookupClassRouteUpdater::updateRouteIndex(const StateDelta& stateDelta) {
+  auto& oldState = stateDelta.oldState();
+  auto& newState = stateDelta.newState();
+  auto changedFn =
+      [&oldState, &newState, this](
+          RouterID rid, const auto& oldRoute, const auto& newRoute) {
+        if (oldRoute->isResolved() == newRoute->isResolved() &&
+            oldRoute->isToCPU() == newRoute->isToCPU() &&
+            oldRoute->getForwardInfo().getNextHopSet() ==
+                newRoute->getForwardInfo().getNextHopSet()) {
+          return;
+        }
+        indexRoute(oldState, rid, oldRoute, false /* remove */);
+        indexRoute(newState, rid, newRoute, true /* add */);
+      };
+  auto addedFn = [&newState, this](RouterID rid, const auto& newRoute) {
+    indexRoute(newState, rid, newRoute, true /* add */);
+  };
+  auto removedFn = [&oldState, this](RouterID rid, const auto& oldRoute) {
+    indexRoute(oldState, rid, oldRoute, false /* remove */);
+  };
+  forEachChangedRoute<AddrT>(stateDelta, changedFn, addedFn, removedFn);
+}
+
+std::set<LookupClassRouteUpdater::RidAndCidr>
+LookupClassRouteUpdater::getIndexedRoutes(
+    VlanID vlanID,
+    const folly::IPAddress& nextHop) const {
+  auto vlanIter = vlan2NextHop2Routes_.find(vlanID);
+  if (vlanIter == vlan2NextHop2Routes_.end()) {
+    return {};
+  }
+  auto nextHopIter = vlanIter->second.find(nextHop);
+  if (nextHopIter == vlanIter->second.end()) {
+    return {};
+  }
+  return nextHopIter->second;
+}
+
 // Methods for handling port updates
 
 void LookupClassRouteUpdater::processPortAdded(
@@ -296,7 +417,7 @@ void LookupClassRouteUpdater::processInterfaceAdded(
     processPortAdded(stateDelta, port, false /* don't re-add all routes */);
   }
 
-  reAddAllRoutes(stateDelta);
+  reAddRoutesForNewSubnets(stateDelta);
 }
 
 void LookupClassRouteUpdater::processInterfaceRemoved(
@@ -800,6 +921,15 @@ void LookupClassRouteUpdater::stateUpdated(const StateDelta& stateDelta) {
     inited_ = true;
   }
 
+  /*
+   * Keep the route index in sync with newState before port and interface
+   * processing, which may look routes up through it.
+   */
+  if (routeIndexBuilt_) {
+    updateRouteIndex<folly::IPAddressV6>(stateDelta);
+    updateRouteIndex<folly::IPAddressV4>(stateDelta);
+  }
+
   /*
    * If vlan2SubnetsCache_ is updated after routes are added, every update to
    * vlan2SubnetsCache_ must check if the nextHops of previously processed
@@ -813,12 +943,21 @@ void LookupClassRouteUpdater::stateUpdated(const StateDelta& stateDelta) {
 
   processInterfaceUpdates(stateDelta);
 
+  /*
+   * Subnets cached for ports added in this update need no re-processing of
+   * existing routes, see processPortUpdates.
+   */
+  newlyCachedSubnets_.clear();
+
   /*
    * Only RSWs connected to MH-NIC (e.g. Yosemite) need queue-per-host fix, and
    * thus have non-empty vlan2SubnetsCache_ (populated by processPortUpdates).
-   * Skip the processing on other setups.
+   * Skip the processing on other setups, and don't keep the route index
+   * up to date for them either.
    */
   if (vlan2SubnetsCache_.empty()) {
+    vlan2NextHop2Routes_.clear();
+    routeIndexBuilt_ = false;
     return;
   }
 
@@ -25,9 +25,22 @@ class LookupClassRouteUpdater : public AutoRegisterStateObserver {
 
   void stateUpdated(const StateDelta& stateDelta) override;
 
+  using RidAndCidr = std::pair<RouterID, folly::CIDRNetwork>;
+
+  /*
+   * For testing purpose: vlan2NextHop2Routes_ lookups. Only call these from
+   * the update thread.
+   */
+  bool isRouteIndexBuilt() const {
+    return routeIndexBuilt_;
+  }
+  std::set<RidAndCidr> getIndexedRoutes(
+      VlanID vlanID,
+      const folly::IPAddress& nextHop) const;
+
  private:
   // Helper methods
-  void reAddAllRoutes(const StateDelta& stateDelta);
+  void reAddRoutesForNewSubnets(const StateDelta& stateDelta);
 
   bool vlanHasOtherPortsWithClassIDs(
       const std::shared_ptr<SwitchState>& switchState,
@@ -49,6 +62,17 @@ class LookupClassRouteUpdater : public AutoRegisterStateObserver {
       std::shared_ptr<Port> port,
       bool reAddAllRoutesEnabled);
 
+  // Methods for dealing with vlan2NextHop2Routes_
+  template <typename RouteT>
+  void indexRoute(
+      const std::shared_ptr<SwitchState>& switchState,
+      RouterID rid,
+      const std::shared_ptr<RouteT>& route,
+      bool add);
+  void buildRouteIndex(const std::shared_ptr<SwitchState>& switchState);
+  template <typename AddrT>
+  void updateRouteIndex(const StateDelta& stateDelta);
+
   std::optional<cfg::AclLookupClass> getClassIDForNeighbor(
       const std::shared_ptr<SwitchState>& switchState,
       VlanID vlanID,
@@ -136,7 +160,6 @@ class LookupClassRouteUpdater : public AutoRegisterStateObserver {
   template <typename AddrT>
   void processRouteUpdates(const StateDelta& stateDelta);
 
-  using RidAndCidr = std::pair<RouterID, folly::CIDRNetwork>;
   using NextHopAndVlan = std::pair<folly::IPAddress, VlanID>;
   using WithAndWithoutClassIDPrefixes =
       std::pair<std::set<RidAndCidr>, std::set<RidAndCidr>>;
@@ -169,6 +192,13 @@ class LookupClassRouteUpdater : public AutoRegisterStateObserver {
   boost::container::flat_map<VlanID, folly::F14FastSet<folly::CIDRNetwork>>
       vlan2SubnetsCache_;
 
+  /*
+   * Subnets added to vlan2SubnetsCache_ during the current state update.
+   * Routes with nexthops in these subnets are re-processed, since their
+   * nexthops just became eligible for classID.
+   */
+  std::vector<std::pair<VlanID, folly::CIDRNetwork>> newlyCachedSubnets_;
+
   /*
    * Route inherits classID of one of its reachable next hops.
    *
@@ -241,6 +271,24 @@ class LookupClassRouteUpdater : public AutoRegisterStateObserver {
   folly::F14FastMap<NextHopAndVlan, WithAndWithoutClassIDPrefixes>
       nextHopAndVlan2Prefixes_;
 
+  /*
+   * Resolved routes indexed by Vlan and nexthop, for all nexthops (not just
+   * the ones in vlan2SubnetsCache_).
+   *
+   * When a subnet is added to vlan2SubnetsCache_, only routes with nexthops
+   * in that subnet need to be re-processed. This index lets us find them
+   * without walking every route in every FIB.
+   *
+   * Built on first use and maintained incrementally from route deltas for as
+   * long as vlan2SubnetsCache_ is non-empty, so setups that don't need
+   * queue-per-host don't pay for it.
+   */
+  boost::container::flat_map<
+      VlanID,
+      folly::F14FastMap<folly::IPAddress, std::set<RidAndCidr>>>
+      vlan2NextHop2Routes_;
+  bool routeIndexBuilt_{false};
+
   /*
    * Set of prefixes with classID (from any [nexthop + vlan]).
    */
@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace facebook::fboss {
+
+/*
+ * Approximate memory used by a set of objects. The byte counts are estimates
+ * from object and container entry sizes: allocator overhead and memory
+ * owned by the objects' own members (strings, vectors...) are not included.
+ */
+struct MemoryUsage {
+  uint64_t bytes{0};
+  uint64_t objects{0};
+
+  MemoryUsage& operator+=(const MemoryUsage& other) {
+    bytes += other.bytes;
+    objects += other.objects;
+    return *this;
+  }
+};
+
+// Memory usage broken down by subtree or object type
+using MemoryUsageByType = std::map<std::string, MemoryUsage>;
+
+// Size of the shared_ptr control block make_shared allocates with an object
+constexpr size_t kSharedPtrControlBlockBytes = 16;
+
+/*
+ * Memory usage of the entries of a container, with each entry counting as
+ * an object.
+ */
+template <typename Container>
+MemoryUsage containerMemoryUsage(const Container& container) {
+  return MemoryUsage{
+      container.size() * sizeof(typename Container::value_type),
+      container.size()};
+}
+
+} // namespace facebook::fboss
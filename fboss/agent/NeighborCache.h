@@ -85,6 +85,11 @@ class NeighborCache {
     return impl_->template getCacheData<NeighborEntryThrift>(ip);
   }
 
+  MemoryUsage getMemoryUsage() {
+    std::lock_guard<std::mutex> g(cacheLock_);
+    return impl_->getMemoryUsage();
+  }
+
   void setTimeout(std::chrono::seconds timeout) {
     timeout_ = timeout;
   }
@@ -215,6 +220,17 @@ class NeighborCache {
     return impl_->processEntry(ip);
   }
 
+  // This should only be called by a NeighborCacheEntry whose timeout expired
+  void entryExpired(AddressType ip) {
+    std::lock_guard<std::mutex> g(cacheLock_);
+    impl_->entryExpired(ip);
+  }
+
+  NeighborExpiryBatcher::RemoveFn processExpiredEntries() {
+    std::lock_guard<std::mutex> g(cacheLock_);
+    return impl_->processExpiredEntries();
+  }
+
   // Has the entry corresponding to ip has been hit in hw
   bool isHit(AddressType ip) {
     return sw_->getAndClearNeighborHit(RouterID(0), ip);
@@ -11,6 +11,7 @@
 
 #include "fboss/agent/AddressUtil.h"
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/NeighborTimerWheel.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/state/NeighborEntry.h"
 #include "fboss/agent/state/PortDescriptor.h"
@@ -19,6 +20,7 @@
 #include <folly/IPAddress.h>
 #include <folly/MacAddress.h>
 #include <folly/Random.h>
+#include <folly/io/async/HHWheelTimer.h>
 #include <chrono>
 
 /**
@@ -52,9 +54,11 @@
  * UNINITIALIZED - Placeholder on startup.
  *
  * Once an entry is created, it is responsible for scheduling the timeout for
- * its next update. When that timeout expires, the state machine is run and the
- * next update is scheduled. If the entry ever transitions to the EXPIRED state,
- * we do not schedule another update and the cache will flush the entry.
+ * its next update on the timer wheel of the neighbor cache thread. When that
+ * timeout expires, the cache runs the state machine of every entry that
+ * expired in the same bucket of the wheel, which schedules their next update.
+ * If an entry ever transitions to the EXPIRED state, we do not schedule
+ * another update and the cache will flush the entry.
  *
  * There is no locking in this class. Instead, the class relies on the
  * synchronization provided by NeighborCache, which should lock around all calls
@@ -78,7 +82,7 @@ template <typename NTable>
 class NeighborCache;
 
 template <typename NTable>
-class NeighborCacheEntry : private folly::AsyncTimeout {
+class NeighborCacheEntry : private folly::HHWheelTimer::Callback {
  public:
   typedef typename NTable::Entry::AddressType AddressType;
   typedef NeighborCache<NTable> Cache;
@@ -89,8 +93,7 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
       folly::EventBase* evb,
       Cache* cache,
       NeighborEntryState state)
-      : AsyncTimeout(evb),
-        fields_(fields),
+      : fields_(fields),
         cache_(cache),
         evb_(evb),
         probesLeft_(cache_->getMaxNeighborProbes()) {
@@ -227,10 +230,20 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
   /*
    * We tell the cache that this entry needs to be processed. The cache is
    * responsible for serializing this with other flush or rx events to prevent
-   * races.
+   * races, and processes it along with the other entries expiring now.
    */
   void timeoutExpired() noexcept override {
-    cache_->processEntry(getIP());
+    cache_->entryExpired(getIP());
+  }
+
+  void callbackCanceled() noexcept override {
+    // The timer wheel is going away with the neighbor cache thread, there is
+    // nothing left to process
+  }
+
+  std::chrono::milliseconds scheduleTimeout(
+      std::chrono::milliseconds timeout) {
+    return scheduleNeighborTimeout(evb_, this, timeout);
   }
 
   /*
@@ -244,9 +257,8 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
     std::chrono::milliseconds lifetime;
     switch (state_) {
       case NeighborEntryState::REACHABLE:
-        lifetime = calculateLifetime();
+        lifetime = scheduleTimeout(calculateLifetime());
         expireTime_ = std::chrono::steady_clock::now() + lifetime;
-        scheduleTimeout(lifetime);
         break;
       case NeighborEntryState::STALE:
         scheduleTimeout(std::chrono::seconds(cache_->getStaleEntryInterval()));
@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <folly/Conv.h>
 #include <folly/IPAddress.h>
 #include <folly/MacAddress.h>
 #include <folly/futures/Future.h>
@@ -145,7 +146,9 @@ void NeighborCacheImpl<NTable>::programPendingEntry(Entry* entry, bool force) {
 }
 
 template <typename NTable>
-NeighborCacheImpl<NTable>::~NeighborCacheImpl() {}
+NeighborCacheImpl<NTable>::~NeighborCacheImpl() {
+  expiryBatcher_->cancel(&expiredEntriesClient_);
+}
 
 template <typename NTable>
 void NeighborCacheImpl<NTable>::repopulate(std::shared_ptr<NTable> table) {
@@ -248,9 +251,7 @@ NeighborCacheEntry<NTable>* NeighborCacheImpl<NTable>::setEntryInternal(
     entry->updateState(state);
     return changed ? entry : nullptr;
   } else if (add) {
-    auto to_store = std::make_shared<Entry>(fields, evb_, cache_, state);
-    entry = to_store.get();
-    setCacheEntry(std::move(to_store));
+    entry = entries_.emplace(fields.ip, fields, evb_, cache_, state);
   }
   return entry;
 }
@@ -284,31 +285,51 @@ void NeighborCacheImpl<NTable>::processEntry(AddressType ip) {
 }
 
 template <typename NTable>
-NeighborCacheEntry<NTable>* NeighborCacheImpl<NTable>::getCacheEntry(
-    AddressType ip) const {
-  auto it = entries_.find(ip);
-  if (it != entries_.end()) {
-    return it->second.get();
+void NeighborCacheImpl<NTable>::entryExpired(AddressType ip) {
+  expiredEntries_.push_back(ip);
+  expiryBatcher_->entriesExpired(&expiredEntriesClient_);
+}
+
+template <typename NTable>
+NeighborExpiryBatcher::RemoveFn
+NeighborCacheImpl<NTable>::processExpiredEntries() {
+  std::vector<AddressType> expired;
+  expired.swap(expiredEntries_);
+
+  std::vector<AddressType> removed;
+  for (const auto& ip : expired) {
+    auto entry = getCacheEntry(ip);
+    if (entry) {
+      entry->process();
+      if (entry->getState() == NeighborEntryState::EXPIRED &&
+          removeEntry(ip)) {
+        removed.push_back(ip);
+      }
+    }
   }
-  return nullptr;
+  if (removed.empty()) {
+    return nullptr;
+  }
+
+  return [this, removed = std::move(removed)](
+             std::shared_ptr<SwitchState>* state) {
+    bool flushed = false;
+    for (const auto& ip : removed) {
+      flushed |= flushEntryFromSwitchState(state, ip);
+    }
+    return flushed;
+  };
 }
 
 template <typename NTable>
-void NeighborCacheImpl<NTable>::setCacheEntry(std::shared_ptr<Entry> entry) {
-  const auto& ip = entry->getIP();
-  entries_[ip] = std::move(entry);
+NeighborCacheEntry<NTable>* NeighborCacheImpl<NTable>::getCacheEntry(
+    AddressType ip) const {
+  return entries_.find(ip);
 }
 
 template <typename NTable>
 bool NeighborCacheImpl<NTable>::removeEntry(AddressType ip) {
-  auto it = entries_.find(ip);
-  if (it == entries_.end()) {
-    return false;
-  }
-
-  entries_.erase(it);
-
-  return true;
+  return entries_.erase(ip);
 }
 
 template <typename NTable>
@@ -378,11 +399,14 @@ NeighborCacheImpl<NTable>::cloneEntryFields(AddressType ip) {
 
 template <typename NTable>
 void NeighborCacheImpl<NTable>::portDown(PortDescriptor port) {
-  for (auto item : entries_) {
-    if (item.second->getPort() != port) {
-      continue;
+  std::vector<AddressType> entriesOnPort;
+  entries_.forEach([&](const Entry& entry) {
+    if (entry.getPort() == port) {
+      entriesOnPort.push_back(entry.getIP());
     }
+  });
 
+  for (const auto& ip : entriesOnPort) {
     // TODO(aeckert): It would be nicer if we could just mark this
     // entry stale on port down so we don't need to unprogram the
     // entry (for fast port flaps).  However, we have seen packet
@@ -391,19 +415,18 @@ void NeighborCacheImpl<NTable>::portDown(PortDescriptor port) {
     // programmed. Also we need to notify the HwSwitch for ECMP expand
     // when the port comes back up and changing an entry from pending
     // to reachable is how we currently do this.
-    setPendingEntry(item.second->getIP(), true);
+    setPendingEntry(ip, true);
   }
 }
 
 template <typename NTable>
 void NeighborCacheImpl<NTable>::portFlushEntries(PortDescriptor port) {
   std::vector<AddressType> entriesToFlush;
-  for (auto item : entries_) {
-    if (item.second->getPort() != port) {
-      continue;
+  entries_.forEach([&](const Entry& entry) {
+    if (entry.getPort() == port) {
+      entriesToFlush.push_back(entry.getIP());
     }
-    entriesToFlush.push_back(item.second->getIP());
-  }
+  });
 
   for (const auto& ip : entriesToFlush) {
     XLOG(DBG2) << "Flush neighbor entry " << ip.str() << " on port " << port;
@@ -415,11 +438,11 @@ template <typename NTable>
 template <typename NeighborEntryThrift>
 std::list<NeighborEntryThrift> NeighborCacheImpl<NTable>::getCacheData() const {
   std::list<NeighborEntryThrift> thriftEntries;
-  for (const auto& item : entries_) {
+  entries_.forEach([&](const Entry& entry) {
     NeighborEntryThrift thriftEntry;
-    item.second->populateThriftEntry(thriftEntry);
-    thriftEntries.push_back(thriftEntry);
-  }
+    entry.populateThriftEntry(thriftEntry);
+    thriftEntries.push_back(std::move(thriftEntry));
+  });
   return thriftEntries;
 }
 
@@ -10,7 +10,9 @@
 #pragma once
 
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/MemoryUsage.h"
 #include "fboss/agent/NeighborCacheEntry.h"
+#include "fboss/agent/NeighborEntryStore.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/state/NeighborEntry.h"
 #include "fboss/agent/state/PortDescriptor.h"
@@ -18,9 +20,11 @@
 
 #include <folly/IPAddress.h>
 #include <folly/Random.h>
+#include <folly/io/async/EventBase.h>
 #include <list>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -64,7 +68,9 @@ class NeighborCacheImpl {
         vlanID_(vlanID),
         vlanName_(vlanName),
         intfID_(intfID),
-        evb_(sw->getNeighborCacheEvb()) {}
+        evb_(sw->getNeighborCacheEvb()),
+        expiryBatcher_(sw->getNeighborExpiryBatcher()),
+        expiredEntriesClient_(cache) {}
 
   // Methods useful for subclasses
   void setPendingEntry(AddressType ip, bool force = false);
@@ -126,6 +132,11 @@ class NeighborCacheImpl {
   template <typename NeighborEntryThrift>
   std::optional<NeighborEntryThrift> getCacheData(AddressType ip) const;
 
+  // Memory allocated for the cache entries
+  MemoryUsage getMemoryUsage() const {
+    return MemoryUsage{entries_.getAllocatedMemorySize(), entries_.size()};
+  }
+
  private:
   // These are used to program entries into the SwitchState
   void programEntry(Entry* entry);
@@ -133,6 +144,15 @@ class NeighborCacheImpl {
 
   void processEntry(AddressType ip);
 
+  /*
+   * Entries whose timeout expired are queued and processed by the
+   * NeighborExpiryBatcher, together with the entries of the other caches
+   * expiring in the same bucket: their probes go out back to back and the
+   * expired ones are removed from the SwitchState with a single update.
+   */
+  void entryExpired(AddressType ip);
+  NeighborExpiryBatcher::RemoveFn processExpiredEntries();
+
   // Pass in a non-null flushed if you care whether an entry
   // was actually flushed from the switch state
   void flushEntry(AddressType ip, bool* flushed = nullptr);
@@ -142,7 +162,6 @@ class NeighborCacheImpl {
       AddressType ip);
 
   Entry* getCacheEntry(AddressType ip) const;
-  void setCacheEntry(std::shared_ptr<Entry> entry);
   bool removeEntry(AddressType ip);
 
   Entry* setEntryInternal(
@@ -154,15 +173,33 @@ class NeighborCacheImpl {
   NeighborCacheImpl(NeighborCacheImpl const&) = delete;
   NeighborCacheImpl& operator=(NeighborCacheImpl const&) = delete;
 
+  class ExpiredEntriesClient : public NeighborExpiryBatcher::Client {
+   public:
+    explicit ExpiredEntriesClient(NeighborCache<NTable>* cache)
+        : cache_(cache) {}
+
+    NeighborExpiryBatcher::RemoveFn processExpiredEntries() override {
+      return cache_->processExpiredEntries();
+    }
+
+   private:
+    NeighborCache<NTable>* cache_;
+  };
+
   NeighborCache<NTable>* cache_;
   SwSwitch* sw_;
   VlanID vlanID_;
   std::string vlanName_;
   InterfaceID intfID_;
   folly::EventBase* evb_;
+  NeighborExpiryBatcher* expiryBatcher_;
+
+  // All entries, by IP
+  NeighborEntryStore<AddressType, Entry> entries_;
 
-  // Map of all entries
-  std::unordered_map<AddressType, std::shared_ptr<Entry>> entries_;
+  // Entries whose timeout expired, waiting for expiryBatcher_
+  std::vector<AddressType> expiredEntries_;
+  ExpiredEntriesClient expiredEntriesClient_;
 };
 
 } // namespace facebook::fboss
@@ -0,0 +1,231 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <folly/lang/Bits.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * Storage for the entries of a neighbor cache, keyed by IP.
+ *
+ * Entries are constructed in place in slabs and never move, since the timer
+ * wheel holds pointers to them. The first slab holds kFirstSlabEntries
+ * entries and each following one twice as many as the one before it, so a
+ * cache with a handful of neighbors only allocates room for a handful.
+ * erase() frees the slot and emplace() reuses the lowest free one, which
+ * drains the last slab first; once it is empty it is released.
+ *
+ * The index from IP to slot is an F14 open addressing map of 32 bit slot
+ * numbers, and forEach() walks the slabs in order rather than chasing a node
+ * per entry.
+ */
+template <typename AddressType, typename Entry, size_t kFirstSlabEntries = 4>
+class NeighborEntryStore {
+  static_assert(
+      kFirstSlabEntries > 0 &&
+          (kFirstSlabEntries & (kFirstSlabEntries - 1)) == 0,
+      "kFirstSlabEntries must be a power of two");
+
+ public:
+  NeighborEntryStore() = default;
+  ~NeighborEntryStore() {
+    clear();
+  }
+
+  Entry* find(const AddressType& ip) const {
+    auto it = index_.find(ip);
+    return it == index_.end() ? nullptr : slot(it->second);
+  }
+
+  // Construct a new entry for ip, replacing any existing one
+  template <typename... Args>
+  Entry* emplace(const AddressType& ip, Args&&... args) {
+    erase(ip);
+    bool reused = !freeSlots_.empty();
+    uint32_t slotId = reused ? freeSlots_.front() : numSlots_;
+    if (!reused && numSlots_ == capacity()) {
+      slabs_.push_back(std::make_unique<Slab>(slabEntries(slabs_.size())));
+    }
+    auto [slabId, offset] = locate(slotId);
+    auto& slab = *slabs_[slabId];
+    auto entry = new (&slab.entries[offset]) Entry(std::forward<Args>(args)...);
+    // Only take the slot once the entry is constructed
+    if (reused) {
+      std::pop_heap(freeSlots_.begin(), freeSlots_.end(), std::greater<>());
+      freeSlots_.pop_back();
+    } else {
+      ++numSlots_;
+    }
+    slab.used[offset] = true;
+    ++slab.numUsed;
+    index_.emplace(ip, slotId);
+    return entry;
+  }
+
+  bool erase(const AddressType& ip) {
+    auto it = index_.find(ip);
+    if (it == index_.end()) {
+      return false;
+    }
+    auto slotId = it->second;
+    index_.erase(it);
+    auto [slabId, offset] = locate(slotId);
+    auto& slab = *slabs_[slabId];
+    DCHECK(slab.used[offset]);
+    slab.used[offset] = false;
+    --slab.numUsed;
+    entryAt(slab, offset)->~Entry();
+    freeSlots_.push_back(slotId);
+    std::push_heap(freeSlots_.begin(), freeSlots_.end(), std::greater<>());
+    releaseEmptySlabs();
+    return true;
+  }
+
+  void clear() {
+    for (auto& slab : slabs_) {
+      for (size_t offset = 0; offset < slab->used.size(); ++offset) {
+        if (slab->used[offset]) {
+          slab->used[offset] = false;
+          entryAt(*slab, offset)->~Entry();
+        }
+      }
+    }
+    slabs_.clear();
+    freeSlots_.clear();
+    index_.clear();
+    numSlots_ = 0;
+  }
+
+  /*
+   * Call fn on every entry, in slot order. fn may modify the entries but not
+   * add or remove any.
+   */
+  template <typename Fn>
+  void forEach(Fn&& fn) const {
+    for (const auto& slab : slabs_) {
+      if (slab->numUsed == 0) {
+        continue;
+      }
+      for (size_t offset = 0; offset < slab->used.size(); ++offset) {
+        if (slab->used[offset]) {
+          fn(*entryAt(*slab, offset));
+        }
+      }
+    }
+  }
+
+  size_t size() const {
+    return index_.size();
+  }
+
+  bool empty() const {
+    return index_.empty();
+  }
+
+  // Number of entries the allocated slabs can hold
+  size_t capacity() const {
+    return kFirstSlabEntries * ((size_t(1) << slabs_.size()) - 1);
+  }
+
+  // Bytes allocated for the slabs and the index
+  size_t getAllocatedMemorySize() const {
+    return capacity() * sizeof(Storage) + slabs_.size() * sizeof(Slab) +
+        capacity() / 8 + index_.getAllocatedMemorySize() +
+        freeSlots_.capacity() * sizeof(uint32_t) +
+        slabs_.capacity() * sizeof(std::unique_ptr<Slab>);
+  }
+
+ private:
+  using Storage = std::aligned_storage_t<sizeof(Entry), alignof(Entry)>;
+
+  struct Slab {
+    explicit Slab(size_t size) : entries(new Storage[size]), used(size) {}
+
+    std::unique_ptr<Storage[]> entries;
+    std::vector<bool> used;
+    size_t numUsed{0};
+  };
+
+  static size_t slabEntries(size_t slabId) {
+    return kFirstSlabEntries << slabId;
+  }
+
+  // Slab slabId starts at slot kFirstSlabEntries * (2^slabId - 1)
+  static std::pair<size_t, size_t> locate(uint32_t slotId) {
+    size_t slabId = folly::findLastSet(slotId / kFirstSlabEntries + 1) - 1;
+    size_t offset = slotId - kFirstSlabEntries * ((size_t(1) << slabId) - 1);
+    return {slabId, offset};
+  }
+
+  static Entry* entryAt(Slab& slab, size_t offset) {
+    return std::launder(reinterpret_cast<Entry*>(&slab.entries[offset]));
+  }
+
+  Entry* slot(uint32_t slotId) const {
+    auto [slabId, offset] = locate(slotId);
+    return entryAt(*slabs_[slabId], offset);
+  }
+
+  /*
+   * Entries can't be moved to compact the slabs, so memory is only given back
+   * by releasing the last slab once it is empty. It is kept while the slab
+   * before it is more than half full, so that a cache hovering around a slab
+   * boundary doesn't allocate and free the same slab over and over.
+   */
+  void releaseEmptySlabs() {
+    if (index_.empty()) {
+      clear();
+      return;
+    }
+    bool released = false;
+    while (slabs_.size() > 1 && slabs_.back()->numUsed == 0) {
+      const auto& previous = *slabs_[slabs_.size() - 2];
+      if (previous.numUsed * 2 > previous.used.size()) {
+        break;
+      }
+      slabs_.pop_back();
+      released = true;
+    }
+    if (!released) {
+      return;
+    }
+    numSlots_ = capacity();
+    freeSlots_.erase(
+        std::remove_if(
+            freeSlots_.begin(),
+            freeSlots_.end(),
+            [this](uint32_t slotId) { return slotId >= numSlots_; }),
+        freeSlots_.end());
+    std::make_heap(freeSlots_.begin(), freeSlots_.end(), std::greater<>());
+  }
+
+  // Forbidden copy constructor and assignment operator
+  NeighborEntryStore(NeighborEntryStore const&) = delete;
+  NeighborEntryStore& operator=(NeighborEntryStore const&) = delete;
+
+  std::vector<std::unique_ptr<Slab>> slabs_;
+  // Slots below numSlots_ that are not in use, as a min heap
+  std::vector<uint32_t> freeSlots_;
+  uint32_t numSlots_{0};
+  folly::F14FastMap<AddressType, uint32_t> index_;
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/NeighborResolutionLimiter.h"
+
+#include <folly/hash/Hash.h>
+
+#include <algorithm>
+
+DEFINE_int32(
+    neighbor_resolution_interval_ms,
+    1000,
+    "Send at most one ARP request or neighbor solicitation per this many "
+    "milliseconds for packets punted to the same unresolved destination. "
+    "0 disables the deduplication.");
+DEFINE_int32(
+    neighbor_resolution_cache_size,
+    16384,
+    "Number of recently resolved destinations remembered for "
+    "--neighbor_resolution_interval_ms");
+DEFINE_int32(
+    neighbor_resolution_rate,
+    2000,
+    "Maximum number of ARP requests and neighbor solicitations per second "
+    "sent for punted packets, per address family. 0 disables the limit.");
+DEFINE_int32(
+    neighbor_resolution_burst,
+    500,
+    "Burst size for --neighbor_resolution_rate");
+
+namespace facebook::fboss {
+
+size_t NeighborResolutionLimiter::KeyHash::operator()(const Key& key) const {
+  return folly::hash::hash_combine(
+      static_cast<uint16_t>(key.first), key.second.hash());
+}
+
+NeighborResolutionLimiter::NeighborResolutionLimiter()
+    : interval_(FLAGS_neighbor_resolution_interval_ms),
+      lastResolved_(
+          std::in_place,
+          std::max(FLAGS_neighbor_resolution_cache_size, 1)) {
+  if (FLAGS_neighbor_resolution_rate > 0) {
+    bucket_.emplace(
+        FLAGS_neighbor_resolution_rate,
+        std::max(FLAGS_neighbor_resolution_burst, 1));
+  }
+}
+
+NeighborResolutionLimiter::Result NeighborResolutionLimiter::shouldResolve(
+    VlanID vlan,
+    const folly::IPAddress& ip,
+    Clock::time_point now) {
+  Key key(vlan, ip);
+  // Hold the lock until the destination is recorded, so that concurrent
+  // callers for the same destination can't both resolve it
+  auto lastResolved = lastResolved_.lock();
+  if (interval_.count() > 0) {
+    auto it = lastResolved->find(key);
+    if (it != lastResolved->end() && now - it->second < interval_) {
+      return Result::DEDUPED;
+    }
+  }
+
+  if (bucket_) {
+    auto seconds = std::chrono::duration<double>(now.time_since_epoch());
+    if (!bucket_->consume(1, seconds.count())) {
+      return Result::RATE_LIMITED;
+    }
+  }
+
+  if (interval_.count() > 0) {
+    lastResolved->set(key, now);
+  }
+  return Result::RESOLVE;
+}
+
+size_t NeighborResolutionLimiter::getNumTracked() const {
+  return lastResolved_.lock()->size();
+}
+
+} // namespace facebook::fboss
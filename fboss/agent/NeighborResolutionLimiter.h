@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/types.h"
+
+#include <folly/IPAddress.h>
+#include <folly/Synchronized.h>
+#include <folly/TokenBucket.h>
+#include <folly/container/EvictingCacheMap.h>
+#include <gflags/gflags.h>
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+DECLARE_int32(neighbor_resolution_interval_ms);
+DECLARE_int32(neighbor_resolution_cache_size);
+DECLARE_int32(neighbor_resolution_rate);
+DECLARE_int32(neighbor_resolution_burst);
+
+namespace facebook::fboss {
+
+/*
+ * Sits in front of the ARP requests and neighbor solicitations sent for
+ * punted packets to unresolved destinations.
+ *
+ * Until the pending entry created by the first resolution shows up in the
+ * SwitchState, every packet punted for the same destination would send
+ * another probe and queue another pending entry. Each destination is only
+ * resolved once per FLAGS_neighbor_resolution_interval_ms, tracked in an LRU
+ * of FLAGS_neighbor_resolution_cache_size destinations. A token bucket of
+ * FLAGS_neighbor_resolution_rate resolutions per second then caps the total,
+ * for floods to many different destinations.
+ *
+ * This class is thread safe.
+ */
+class NeighborResolutionLimiter {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  enum class Result {
+    RESOLVE,
+    // The destination was resolved less than an interval ago
+    DEDUPED,
+    // Over the global resolution rate
+    RATE_LIMITED,
+  };
+
+  NeighborResolutionLimiter();
+
+  Result shouldResolve(
+      VlanID vlan,
+      const folly::IPAddress& ip,
+      Clock::time_point now = Clock::now());
+
+  // For testing purpose
+  size_t getNumTracked() const;
+
+ private:
+  using Key = std::pair<VlanID, folly::IPAddress>;
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+  using LastResolved = folly::EvictingCacheMap<Key, Clock::time_point, KeyHash>;
+
+  // Forbidden copy constructor and assignment operator
+  NeighborResolutionLimiter(NeighborResolutionLimiter const&) = delete;
+  NeighborResolutionLimiter& operator=(NeighborResolutionLimiter const&) =
+      delete;
+
+  const std::chrono::milliseconds interval_;
+  folly::Synchronized<LastResolved, std::mutex> lastResolved_;
+  std::optional<folly::TokenBucket> bucket_;
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/NeighborTimerWheel.h"
+
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <folly/Conv.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+
+DEFINE_int32(
+    neighbor_timer_bucket_ms,
+    100,
+    "Round the deadlines of neighbor cache entries and next hop probes up "
+    "to multiples of this many milliseconds, so the ones expiring close "
+    "together are processed as one batch. 0 disables the rounding.");
+
+namespace facebook::fboss {
+
+std::chrono::milliseconds neighborTimerBucketTimeout(
+    std::chrono::steady_clock::time_point now,
+    std::chrono::milliseconds timeout) {
+  std::chrono::milliseconds bucket(FLAGS_neighbor_timer_bucket_ms);
+  if (bucket.count() <= 0) {
+    return timeout;
+  }
+  auto deadline = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      now.time_since_epoch()) +
+      timeout;
+  auto remainder = deadline % bucket;
+  if (remainder.count() > 0) {
+    timeout += bucket - remainder;
+  }
+  return timeout;
+}
+
+std::chrono::milliseconds scheduleNeighborTimeout(
+    folly::EventBase* evb,
+    folly::HHWheelTimer::Callback* callback,
+    std::chrono::milliseconds timeout) {
+  DCHECK(evb->isInEventBaseThread());
+  timeout =
+      neighborTimerBucketTimeout(std::chrono::steady_clock::now(), timeout);
+  evb->timer().scheduleTimeout(callback, timeout);
+  return timeout;
+}
+
+NeighborExpiryBatcher::NeighborExpiryBatcher(
+    SwSwitch* sw,
+    folly::EventBase* evb)
+    : sw_(sw), evb_(evb) {}
+
+NeighborExpiryBatcher::~NeighborExpiryBatcher() {
+  cancelTimeout();
+}
+
+void NeighborExpiryBatcher::entriesExpired(Client* client) {
+  DCHECK(evb_->isInEventBaseThread());
+  if (std::find(pending_.begin(), pending_.end(), client) == pending_.end()) {
+    pending_.push_back(client);
+  }
+  if (!isScheduled()) {
+    evb_->timer().scheduleTimeout(this, evb_->timer().getTickInterval());
+  }
+}
+
+void NeighborExpiryBatcher::cancel(Client* client) {
+  pending_.erase(
+      std::remove(pending_.begin(), pending_.end(), client), pending_.end());
+  if (pending_.empty()) {
+    cancelTimeout();
+  }
+}
+
+void NeighborExpiryBatcher::timeoutExpired() noexcept {
+  std::vector<Client*> clients;
+  clients.swap(pending_);
+
+  std::vector<RemoveFn> removals;
+  for (auto* client : clients) {
+    if (auto removeFn = client->processExpiredEntries()) {
+      removals.push_back(std::move(removeFn));
+    }
+  }
+  if (removals.empty()) {
+    return;
+  }
+
+  auto name = folly::to<std::string>(
+      "remove expired neighbor entries of ", removals.size(), " caches");
+  auto updateFn = [removals = std::move(removals)](
+                      const std::shared_ptr<SwitchState>& state)
+      -> std::shared_ptr<SwitchState> {
+    std::shared_ptr<SwitchState> newState{state};
+    bool removed = false;
+    for (const auto& removeFn : removals) {
+      removed |= removeFn(&newState);
+    }
+    return removed ? newState : nullptr;
+  };
+  sw_->updateState(name, std::move(updateFn));
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/io/async/EventBase.h>
+#include <folly/io/async/HHWheelTimer.h>
+#include <gflags/gflags.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+DECLARE_int32(neighbor_timer_bucket_ms);
+
+namespace facebook::fboss {
+
+class SwSwitch;
+class SwitchState;
+
+/*
+ * Neighbor cache entries and resolved next hop probes don't each get their
+ * own AsyncTimeout (and so their own libevent timer). Their timeouts go in
+ * the hierarchical timer wheel of the EventBase they run on.
+ *
+ * Deadlines are rounded up to the next multiple of
+ * FLAGS_neighbor_timer_bucket_ms, so all the timeouts falling in the same
+ * bucket expire in the same tick of the wheel and can be handled as a batch.
+ */
+
+/*
+ * The timeout to use instead of timeout, given the current time, so that it
+ * expires at the end of its bucket.
+ */
+std::chrono::milliseconds neighborTimerBucketTimeout(
+    std::chrono::steady_clock::time_point now,
+    std::chrono::milliseconds timeout);
+
+/*
+ * Schedule callback on the timer wheel of evb, which must be running in the
+ * current thread. Returns the timeout actually used.
+ */
+std::chrono::milliseconds scheduleNeighborTimeout(
+    folly::EventBase* evb,
+    folly::HHWheelTimer::Callback* callback,
+    std::chrono::milliseconds timeout);
+
+/*
+ * Removes the neighbor entries expiring in the same bucket from the
+ * SwitchState with a single update, across the ARP and NDP caches of all
+ * VLANs.
+ *
+ * Caches report that some of their entries expired with entriesExpired().
+ * One tick of the timer wheel later, once all the timeouts of the bucket have
+ * fired, each of these caches processes its expired entries and hands back
+ * the function removing them from the SwitchState, and all of them are
+ * applied in one update. Waiting for the next tick rather than the end of
+ * the loop iteration absorbs the rounding of the wheel, which can put
+ * deadlines of the same bucket in two adjacent ticks.
+ *
+ * This class is only used from the thread of the neighbor cache EventBase.
+ */
+class NeighborExpiryBatcher : private folly::HHWheelTimer::Callback {
+ public:
+  // Removes entries from the state, returns whether anything was removed
+  using RemoveFn = std::function<bool(std::shared_ptr<SwitchState>*)>;
+
+  class Client {
+   public:
+    virtual ~Client() = default;
+
+    /*
+     * Process the entries which expired since the last batch, and remove the
+     * ones that are now EXPIRED from the cache. Returns the function
+     * removing them from the SwitchState, or nullptr if there are none.
+     */
+    virtual RemoveFn processExpiredEntries() = 0;
+  };
+
+  NeighborExpiryBatcher(SwSwitch* sw, folly::EventBase* evb);
+  ~NeighborExpiryBatcher() override;
+
+  void entriesExpired(Client* client);
+
+  // Must be called before a client with expired entries is destroyed
+  void cancel(Client* client);
+
+ private:
+  void timeoutExpired() noexcept override;
+
+  // Forbidden copy constructor and assignment operator
+  NeighborExpiryBatcher(NeighborExpiryBatcher const&) = delete;
+  NeighborExpiryBatcher& operator=(NeighborExpiryBatcher const&) = delete;
+
+  SwSwitch* sw_;
+  folly::EventBase* evb_;
+  // Clients with expired entries in the current batch
+  std::vector<Client*> pending_;
+};
+
+} // namespace facebook::fboss
@@ -84,6 +84,15 @@ std::list<NdpEntryThrift> NeighborUpdaterImpl::getNdpCacheData() {
   return entries;
 }
 
+MemoryUsageByType NeighborUpdaterImpl::getCacheMemoryUsage() {
+  MemoryUsageByType usage;
+  for (const auto& [vlan, caches] : caches_) {
+    usage["arp"] += caches->arpCache->getMemoryUsage();
+    usage["ndp"] += caches->ndpCache->getMemoryUsage();
+  }
+  return usage;
+}
+
 shared_ptr<ArpCache> NeighborUpdaterImpl::getArpCacheInternal(VlanID vlan) {
   auto res = caches_.find(vlan);
   if (res == caches_.end()) {
@@ -22,8 +22,7 @@ ResolvedNextHopProbe::ResolvedNextHopProbe(
     SwSwitch* sw,
     folly::EventBase* evb,
     ResolvedNextHop nexthop)
-    : folly::AsyncTimeout(evb),
-      sw_(sw),
+    : sw_(sw),
       evb_(evb),
       nexthop_(nexthop),
       backoff_(kInitialBackoff, kMaximumBackoff) {}
@@ -69,7 +68,7 @@ void ResolvedNextHopProbe::timeoutExpired() noexcept {
   auto backoff = backoff_.getTimeRemainingUntilRetry();
   auto timeout = backoff.count() +
       (folly::Random::rand32() % (backoff.count() * kJitterPct / 100));
-  scheduleTimeout(timeout);
+  scheduleNeighborTimeout(evb_, this, std::chrono::milliseconds(timeout));
 }
 
 } // namespace facebook::fboss
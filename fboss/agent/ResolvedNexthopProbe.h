@@ -2,17 +2,23 @@
 
 #pragma once
 
+#include "fboss/agent/NeighborTimerWheel.h"
 #include "fboss/agent/state/RouteNextHop.h"
 #include "fboss/lib/ExponentialBackoff.h"
 
-#include <folly/io/async/AsyncTimeout.h>
 #include <folly/io/async/EventBase.h>
+#include <folly/io/async/HHWheelTimer.h>
 
 namespace facebook::fboss {
 
 class SwSwitch;
 
-class ResolvedNextHopProbe : public folly::AsyncTimeout {
+/*
+ * Probes are scheduled on the timer wheel of the event base, rounded to the
+ * same buckets as the neighbor cache entries, so that the probes expiring
+ * together are sent back to back.
+ */
+class ResolvedNextHopProbe : public folly::HHWheelTimer::Callback {
  public:
   ResolvedNextHopProbe(
       SwSwitch* sw,
@@ -33,7 +39,8 @@ class ResolvedNextHopProbe : public folly::AsyncTimeout {
 
  private:
   void _start() {
-    scheduleTimeout(backoff_.getTimeRemainingUntilRetry());
+    scheduleNeighborTimeout(
+        evb_, this, backoff_.getTimeRemainingUntilRetry());
   }
 
   void _stop() {
@@ -41,6 +48,7 @@ class ResolvedNextHopProbe : public folly::AsyncTimeout {
     backoff_.reportSuccess();
   }
   void timeoutExpired() noexcept override;
+  void callbackCanceled() noexcept override {}
 
   SwSwitch* sw_;
   folly::EventBase* evb_;
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RouteChangeTracker.h"
+
+#include "fboss/agent/FibHelpers.h"
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <folly/Random.h>
+
+#include <limits>
+
+DEFINE_int32(
+    route_change_history_size,
+    100000,
+    "Number of route changes remembered to serve getRouteTableChangesSince. "
+    "Clients asking for changes older than that need a full route table sync");
+
+namespace facebook::fboss {
+
+RouteChangeTracker::RouteChangeTracker(SwSwitch* sw)
+    : AutoRegisterStateObserver(sw, "RouteChangeTracker"),
+      // Never 0, which is what clients without a cursor send
+      runId_(folly::Random::rand64(1, std::numeric_limits<int64_t>::max())) {}
+
+RouteChangeTracker::~RouteChangeTracker() {}
+
+void RouteChangeTracker::stateUpdated(const StateDelta& delta) {
+  int64_t generation = delta.newState()->getGeneration();
+  std::vector<RouteChange> changes;
+  auto recordChange = [&changes, generation](
+                          RouterID rid, const auto& route) {
+    changes.push_back(RouteChange{
+        generation,
+        rid,
+        folly::CIDRNetwork(route->prefix().network, route->prefix().mask)});
+  };
+  forEachChangedRoute(
+      delta,
+      [&](RouterID rid, const auto& /*oldRoute*/, const auto& newRoute) {
+        recordChange(rid, newRoute);
+      },
+      [&](RouterID rid, const auto& newRoute) { recordChange(rid, newRoute); },
+      [&](RouterID rid, const auto& oldRoute) { recordChange(rid, oldRoute); });
+
+  auto history = history_.wlock();
+  if (!history->minGeneration) {
+    // Routes in the state before we started tracking are unaccounted for
+    history->minGeneration = delta.oldState()->getGeneration();
+  }
+  history->state = delta.newState();
+  history->changes.insert(
+      history->changes.end(), changes.begin(), changes.end());
+  while (history->changes.size() >
+         static_cast<size_t>(FLAGS_route_change_history_size)) {
+    // Changes up to and including this generation are no longer complete
+    history->minGeneration = history->changes.front().generation;
+    history->changes.pop_front();
+  }
+}
+
+RouteChangeTracker::Changes RouteChangeTracker::getChangesSince(
+    int64_t runId,
+    int64_t generation) const {
+  auto history = history_.rlock();
+  Changes result;
+  result.state = history->state;
+  if (runId != runId_ || !history->minGeneration ||
+      generation < *history->minGeneration ||
+      generation > history->state->getGeneration()) {
+    return result;
+  }
+  result.prefixes = RoutePrefixes();
+  // The log is ordered by generation, walk back to the requested one
+  for (auto it = history->changes.rbegin(); it != history->changes.rend();
+       ++it) {
+    if (it->generation <= generation) {
+      break;
+    }
+    result.prefixes->emplace(it->rid, it->prefix);
+  }
+  return result;
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/StateObserver.h"
+#include "fboss/agent/types.h"
+
+#include <folly/IPAddress.h>
+#include <folly/Synchronized.h>
+#include <gflags/gflags.h>
+
+#include <deque>
+#include <memory>
+#include <optional>
+#include <set>
+#include <utility>
+
+DECLARE_int32(route_change_history_size);
+
+namespace facebook::fboss {
+
+class StateDelta;
+class SwSwitch;
+class SwitchState;
+
+/*
+ * Keeps a bounded log of the route prefixes added, changed or removed by
+ * each SwitchState generation, so that clients can fetch only the routes
+ * changed since a generation they already have instead of the full table.
+ */
+class RouteChangeTracker : public AutoRegisterStateObserver {
+ public:
+  using RoutePrefixes = std::set<std::pair<RouterID, folly::CIDRNetwork>>;
+
+  struct Changes {
+    // Latest state seen by the tracker, the prefixes should be looked up
+    // in this state to find their current route (if any).
+    std::shared_ptr<SwitchState> state;
+    // Not set if the changes since the requested generation are unknown
+    std::optional<RoutePrefixes> prefixes;
+  };
+
+  explicit RouteChangeTracker(SwSwitch* sw);
+  ~RouteChangeTracker() override;
+
+  void stateUpdated(const StateDelta& delta) override;
+
+  /*
+   * Random ID of this agent run. SwitchState generations restart from 0
+   * when the agent restarts, so a generation alone can't tell whether a
+   * client's cursor is from this run.
+   */
+  int64_t getRunId() const {
+    return runId_;
+  }
+
+  // Changes are unknown if runId is not getRunId()
+  Changes getChangesSince(int64_t runId, int64_t generation) const;
+
+ private:
+  struct RouteChange {
+    int64_t generation;
+    RouterID rid;
+    folly::CIDRNetwork prefix;
+  };
+
+  struct History {
+    std::deque<RouteChange> changes;
+    std::shared_ptr<SwitchState> state;
+    // Changes after this generation are all in the log
+    std::optional<int64_t> minGeneration;
+  };
+
+  const int64_t runId_;
+  folly::Synchronized<History> history_;
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,121 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/state/ForwardingInformationBase.h"
+#include "fboss/agent/state/ForwardingInformationBaseContainer.h"
+#include "fboss/agent/state/ForwardingInformationBaseMap.h"
+#include "fboss/agent/state/Route.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/types.h"
+
+#include <folly/IPAddress.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * Walks the routes of a SwitchState snapshot a few routes at a time, in the
+ * same order as forAllRoutes(). The snapshot is held for the lifetime of the
+ * pager, so consecutive pages are consistent with each other irrespective of
+ * route updates happening in between.
+ */
+class RouteTablePager {
+ public:
+  RouteTablePager(
+      std::shared_ptr<SwitchState> state,
+      std::optional<RouterID> vrf,
+      std::optional<folly::CIDRNetwork> prefix)
+      : state_(std::move(state)), prefix_(std::move(prefix)) {
+    for (const auto& fibContainer : *state_->getFibs()) {
+      if (!vrf || fibContainer->getID() == *vrf) {
+        fibs_.push_back(fibContainer);
+      }
+    }
+  }
+
+  const std::shared_ptr<SwitchState>& getState() const {
+    return state_;
+  }
+
+  /*
+   * Whether network/mask is the same as or a subnet of prefix
+   */
+  static bool contains(
+      const folly::CIDRNetwork& prefix,
+      const folly::IPAddress& network,
+      uint8_t mask) {
+    return network.family() == prefix.first.family() &&
+        mask >= prefix.second && network.inSubnet(prefix.first, prefix.second);
+  }
+
+  /*
+   * Call fn(rid, route) on the following routes matching the prefix filter,
+   * until it has returned true (i.e. the route was consumed) 'count' times.
+   * Returns false once all routes have been visited.
+   */
+  template <typename Fn>
+  bool visitNext(size_t count, Fn fn) {
+    size_t consumed = 0;
+    while (consumed < count && fibIdx_ < fibs_.size()) {
+      const auto& fibContainer = fibs_[fibIdx_];
+      auto rid = fibContainer->getID();
+      if (!v4_) {
+        consumed += visitFib(
+            rid, *fibContainer->getFibV6(), count - consumed, fn);
+        if (routeIdx_ == fibContainer->getFibV6()->size()) {
+          v4_ = true;
+          routeIdx_ = 0;
+        }
+      } else {
+        consumed += visitFib(
+            rid, *fibContainer->getFibV4(), count - consumed, fn);
+        if (routeIdx_ == fibContainer->getFibV4()->size()) {
+          v4_ = false;
+          routeIdx_ = 0;
+          ++fibIdx_;
+        }
+      }
+    }
+    return fibIdx_ < fibs_.size();
+  }
+
+ private:
+  template <typename FibT, typename Fn>
+  size_t visitFib(RouterID rid, const FibT& fib, size_t count, Fn& fn) {
+    size_t consumed = 0;
+    const auto& routes = fib.getAllNodes();
+    for (; routeIdx_ < routes.size() && consumed < count; ++routeIdx_) {
+      const auto& route = routes.nth(routeIdx_)->second;
+      if (matches(route->prefix().network, route->prefix().mask) &&
+          fn(rid, route)) {
+        ++consumed;
+      }
+    }
+    return consumed;
+  }
+
+  bool matches(const folly::IPAddress& network, uint8_t mask) const {
+    return !prefix_ || contains(*prefix_, network, mask);
+  }
+
+  std::shared_ptr<SwitchState> state_;
+  std::optional<folly::CIDRNetwork> prefix_;
+  std::vector<std::shared_ptr<ForwardingInformationBaseContainer>> fibs_;
+  // Position of the next route to visit: v6 routes of a VRF come first
+  size_t fibIdx_{0};
+  bool v4_{false};
+  size_t routeIdx_{0};
+};
+
+} // namespace facebook::fboss
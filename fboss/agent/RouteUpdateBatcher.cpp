@@ -0,0 +1,148 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RouteUpdateBatcher.h"
+
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
+#include "fboss/agent/Utils.h"
+
+#include <folly/logging/xlog.h>
+
+#include <map>
+#include <set>
+#include <utility>
+
+namespace facebook::fboss {
+
+RouteUpdateBatcher::RouteUpdateBatcher(SwSwitch* sw)
+    : sw_(sw), thread_(std::make_unique<std::thread>([this] {
+        initThread("fbossRouteBatch");
+        eventBase_.loopForever();
+      })) {}
+
+RouteUpdateBatcher::~RouteUpdateBatcher() {
+  eventBase_.runInEventBaseThread([this] { eventBase_.terminateLoopSoon(); });
+  thread_->join();
+}
+
+folly::Future<folly::Unit> RouteUpdateBatcher::addRoutes(
+    RouterID vrf,
+    ClientID client,
+    std::vector<UnicastRoute> routes) {
+  return enqueue(Update{vrf, client, std::move(routes), {}, {}});
+}
+
+folly::Future<folly::Unit> RouteUpdateBatcher::delRoutes(
+    RouterID vrf,
+    ClientID client,
+    std::vector<IpPrefix> prefixes) {
+  return enqueue(Update{vrf, client, {}, std::move(prefixes), {}});
+}
+
+folly::Future<folly::Unit> RouteUpdateBatcher::enqueue(Update update) {
+  auto future = update.promise.getFuture();
+  updatesQueued_.fetch_add(1, std::memory_order_relaxed);
+  bool schedule = false;
+  {
+    auto pending = pending_.wlock();
+    pending->updates.push_back(std::move(update));
+    if (!pending->programming) {
+      pending->programming = true;
+      schedule = true;
+    }
+  }
+  if (schedule) {
+    eventBase_.runInEventBaseThread([this] { programPending(); });
+  }
+  return future;
+}
+
+void RouteUpdateBatcher::programPending() {
+  while (true) {
+    std::vector<Update> batch;
+    {
+      auto pending = pending_.wlock();
+      if (pending->updates.empty()) {
+        pending->programming = false;
+        return;
+      }
+      batch = takeBatch(pending->updates);
+    }
+    XLOG(DBG2) << "Programming " << batch.size() << " route updates together";
+    program(batch);
+    batchesProgrammed_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+std::vector<RouteUpdateBatcher::Update> RouteUpdateBatcher::takeBatch(
+    std::deque<Update>& updates) {
+  std::set<std::pair<RouterID, ClientID>> inBatch;
+  std::vector<Update> batch;
+  std::deque<Update> remaining;
+  for (auto& update : updates) {
+    if (inBatch.emplace(update.vrf, update.client).second) {
+      batch.push_back(std::move(update));
+    } else {
+      remaining.push_back(std::move(update));
+    }
+  }
+  updates.swap(remaining);
+  return batch;
+}
+
+void RouteUpdateBatcher::program(std::vector<Update>& batch) {
+  // The RIB updates each VRF on its own and only rolls back the VRF that
+  // failed, so program them separately to know which updates to retry.
+  std::map<RouterID, std::vector<Update>> vrfToUpdates;
+  for (auto& update : batch) {
+    vrfToUpdates[update.vrf].push_back(std::move(update));
+  }
+  for (auto& [vrf, updates] : vrfToUpdates) {
+    programVrf(updates);
+  }
+}
+
+void RouteUpdateBatcher::programVrf(std::vector<Update>& updates) {
+  auto updater = sw_->getRouteUpdater();
+  for (const auto& update : updates) {
+    for (const auto& route : update.toAdd) {
+      updater.addRoute(update.vrf, update.client, route);
+    }
+    for (const auto& prefix : update.toDel) {
+      updater.delRoute(update.vrf, prefix, update.client);
+    }
+  }
+  try {
+    updater.program();
+  } catch (const std::exception& ex) {
+    if (updates.size() == 1) {
+      updates.front().promise.setException(
+          folly::exception_wrapper(std::current_exception(), ex));
+      return;
+    }
+    // The VRF was rolled back to what made it to the hardware. Program its
+    // updates one by one so that only the callers whose routes failed see
+    // an error.
+    XLOG(WARNING) << "Failed to program " << updates.size()
+                  << " route updates together in VRF " << updates.front().vrf
+                  << ", retrying them one by one: " << ex.what();
+    for (auto& update : updates) {
+      std::vector<Update> single;
+      single.push_back(std::move(update));
+      programVrf(single);
+    }
+    return;
+  }
+  for (auto& update : updates) {
+    update.promise.setValue();
+  }
+}
+
+} // namespace facebook::fboss
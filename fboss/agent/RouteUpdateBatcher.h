@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/if/gen-cpp2/ctrl_types.h"
+#include "fboss/agent/types.h"
+
+#include <folly/Synchronized.h>
+#include <folly/futures/Future.h>
+#include <folly/io/async/EventBase.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace facebook::fboss {
+
+class SwSwitch;
+
+/*
+ * Queues route updates from route clients and programs them on a dedicated
+ * thread, so that callers don't hold a thread for the whole RIB and
+ * hardware update. Updates queued while a batch is being programmed are
+ * merged into the next one, which resolves and programs the FIB once per
+ * VRF for all the clients in it. A VRF that fails to program doesn't affect
+ * the updates of other VRFs in the batch.
+ *
+ * A batch holds at most one update per (VRF, client). The RIB doesn't order
+ * the adds and deletes of a client within an update, so later updates of the
+ * same client wait for the next batch.
+ */
+class RouteUpdateBatcher {
+ public:
+  explicit RouteUpdateBatcher(SwSwitch* sw);
+  ~RouteUpdateBatcher();
+
+  folly::Future<folly::Unit>
+  addRoutes(RouterID vrf, ClientID client, std::vector<UnicastRoute> routes);
+  folly::Future<folly::Unit>
+  delRoutes(RouterID vrf, ClientID client, std::vector<IpPrefix> prefixes);
+
+  uint64_t getUpdatesQueued() const {
+    return updatesQueued_.load(std::memory_order_relaxed);
+  }
+  uint64_t getBatchesProgrammed() const {
+    return batchesProgrammed_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Update {
+    RouterID vrf;
+    ClientID client;
+    std::vector<UnicastRoute> toAdd;
+    std::vector<IpPrefix> toDel;
+    folly::Promise<folly::Unit> promise;
+  };
+
+  struct PendingUpdates {
+    std::deque<Update> updates;
+    // programPending() is scheduled or running
+    bool programming{false};
+  };
+
+  folly::Future<folly::Unit> enqueue(Update update);
+  void programPending();
+  static std::vector<Update> takeBatch(std::deque<Update>& updates);
+  void program(std::vector<Update>& batch);
+  void programVrf(std::vector<Update>& updates);
+
+  // Forbidden copy constructor and assignment operator
+  RouteUpdateBatcher(RouteUpdateBatcher const&) = delete;
+  RouteUpdateBatcher& operator=(RouteUpdateBatcher const&) = delete;
+
+  SwSwitch* sw_;
+  folly::Synchronized<PendingUpdates> pending_;
+  folly::EventBase eventBase_;
+  std::unique_ptr<std::thread> thread_;
+
+  std::atomic<uint64_t> updatesQueued_{0};
+  std::atomic<uint64_t> batchesProgrammed_{0};
+};
+
+} // namespace facebook::fboss
@@ -12,46 +12,50 @@
 #include "fboss/agent/FibHelpers.h"
 #include "fboss/agent/state/DeltaFunctions.h"
 
+#include <set>
+
 namespace facebook::fboss {
 
 namespace {
 template <typename AddrT>
-void handleChangedRoute(
-    const RouteUpdateLoggingPrefixTracker& tracker,
-    const std::unique_ptr<RouteLogger<AddrT>>& logger,
-    RouterID /*rid*/,
-    const std::shared_ptr<Route<AddrT>>& oldRoute,
-    const std::shared_ptr<Route<AddrT>>& newRoute) {
-  std::vector<std::string> matchedIdentifiers;
-  auto prefix = oldRoute->prefix();
-  if (tracker.tracking(prefix, matchedIdentifiers)) {
-    logger->logChangedRoute(oldRoute, newRoute, matchedIdentifiers);
-  }
-}
-
-template <typename AddrT>
-void handleRemovedRoute(
+void collectRouteChanges(
+    const StateDelta& delta,
     const RouteUpdateLoggingPrefixTracker& tracker,
-    const std::unique_ptr<RouteLogger<AddrT>>& logger,
-    RouterID /*rid*/,
-    const std::shared_ptr<Route<AddrT>>& oldRoute) {
+    std::vector<RouteChangeRecord<Route<AddrT>>>& records) {
   std::vector<std::string> matchedIdentifiers;
-  auto prefix = oldRoute->prefix();
-  if (tracker.tracking(prefix, matchedIdentifiers)) {
-    logger->logRemovedRoute(oldRoute, matchedIdentifiers);
-  }
+  auto record = [&](const std::shared_ptr<Route<AddrT>>& oldRoute,
+                    const std::shared_ptr<Route<AddrT>>& newRoute) {
+    auto prefix = oldRoute ? oldRoute->prefix() : newRoute->prefix();
+    if (tracker.tracking(prefix, matchedIdentifiers)) {
+      records.push_back({oldRoute, newRoute, std::move(matchedIdentifiers)});
+    }
+  };
+  forEachChangedRoute<AddrT>(
+      delta,
+      [&](RouterID /*rid*/, const auto& oldRoute, const auto& newRoute) {
+        record(oldRoute, newRoute);
+      },
+      [&](RouterID /*rid*/, const auto& newRoute) {
+        record(nullptr, newRoute);
+      },
+      [&](RouterID /*rid*/, const auto& oldRoute) {
+        record(oldRoute, nullptr);
+      });
 }
 
-template <typename AddrT>
-void handleAddedRoute(
-    const RouteUpdateLoggingPrefixTracker& tracker,
-    const std::unique_ptr<RouteLogger<AddrT>>& logger,
-    RouterID /*rid*/,
-    const std::shared_ptr<Route<AddrT>>& newRoute) {
-  std::vector<std::string> matchedIdentifiers;
-  auto prefix = newRoute->prefix();
-  if (tracker.tracking(prefix, matchedIdentifiers)) {
-    logger->logAddedRoute(newRoute, matchedIdentifiers);
+template <typename RouteT, typename LoggerT>
+void logRouteChanges(
+    LoggerT* logger,
+    const std::vector<RouteChangeRecord<RouteT>>& records) {
+  for (const auto& record : records) {
+    if (!record.oldRoute) {
+      logger->logAddedRoute(record.newRoute, record.identifiers);
+    } else if (!record.newRoute) {
+      logger->logRemovedRoute(record.oldRoute, record.identifiers);
+    } else {
+      logger->logChangedRoute(
+          record.oldRoute, record.newRoute, record.identifiers);
+    }
   }
 }
 } // anonymous namespace
@@ -72,62 +76,72 @@ RouteUpdateLogger::RouteUpdateLogger(
       swSwitch_(sw),
       routeLoggerV4_(std::move(routeLoggerV4)),
       routeLoggerV6_(std::move(routeLoggerV6)),
-      mplsRouteLogger_(std::move(mplsRouteLogger)) {}
+      mplsRouteLogger_(std::move(mplsRouteLogger)),
+      loggingThread_(std::make_unique<folly::ScopedEventBaseThread>(
+          "RouteUpdateLogger")) {}
+
+RouteUpdateLogger::~RouteUpdateLogger() {
+  // Log whatever is still pending before the loggers go away
+  flush();
+  loggingThread_.reset();
+}
+
+void RouteUpdateLogger::flush() {
+  loggingThread_->getEventBase()->runInEventBaseThreadAndWait([] {});
+}
 
 void RouteUpdateLogger::stateUpdated(const StateDelta& delta) {
-  forEachChangedRoute<folly::IPAddressV4>(
-      delta,
-      &handleChangedRoute<folly::IPAddressV4>,
-      &handleAddedRoute<folly::IPAddressV4>,
-      &handleRemovedRoute<folly::IPAddressV4>,
-      prefixTracker_,
-      routeLoggerV4_);
-  forEachChangedRoute<folly::IPAddressV6>(
-      delta,
-      &handleChangedRoute<folly::IPAddressV6>,
-      &handleAddedRoute<folly::IPAddressV6>,
-      &handleRemovedRoute<folly::IPAddressV6>,
-      prefixTracker_,
-      routeLoggerV6_);
+  // Only matching against tracked prefixes and labels happens here, on the
+  // update thread. Stringifying routes and writing them out is left to the
+  // logging thread.
+  std::vector<RouteChangeRecord<Route<folly::IPAddressV4>>> v4Records;
+  std::vector<RouteChangeRecord<Route<folly::IPAddressV6>>> v6Records;
+  std::vector<RouteChangeRecord<LabelForwardingEntry>> mplsRecords;
+  collectRouteChanges<folly::IPAddressV4>(delta, prefixTracker_, v4Records);
+  collectRouteChanges<folly::IPAddressV6>(delta, prefixTracker_, v6Records);
+
+  {
+    const auto labelTracker = labelTracker_.rlock();
+    auto record = [&labelTracker, &mplsRecords](
+                      const std::shared_ptr<LabelForwardingEntry>& oldEntry,
+                      const std::shared_ptr<LabelForwardingEntry>& newEntry) {
+      std::set<std::string> identifiers;
+      labelTracker->getIdentifiersForLabel(
+          oldEntry ? oldEntry->getID() : newEntry->getID(), identifiers);
+      if (identifiers.empty()) {
+        return;
+      }
+      mplsRecords.push_back(
+          {oldEntry,
+           newEntry,
+           std::vector<std::string>(identifiers.begin(), identifiers.end())});
+    };
+    DeltaFunctions::forEachChanged(
+        delta.getLabelForwardingInformationBaseDelta(),
+        [&record](const auto& oldEntry, const auto& newEntry) {
+          record(oldEntry, newEntry);
+        },
+        [&record](const auto& addedEntry) { record(nullptr, addedEntry); },
+        [&record](const auto& removedEntry) { record(removedEntry, nullptr); });
+  }
 
+  if (v4Records.empty() && v6Records.empty() && mplsRecords.empty()) {
+    return;
+  }
+  auto* routeLoggerV4 = routeLoggerV4_.get();
+  auto* routeLoggerV6 = routeLoggerV6_.get();
   auto* mplsRouteLogger = mplsRouteLogger_.get();
   CHECK(mplsRouteLogger);
-  const auto labelTracker = labelTracker_.rlock();
-
-  DeltaFunctions::forEachChanged(
-      delta.getLabelForwardingInformationBaseDelta(),
-      [mplsRouteLogger, &labelTracker](
-          const auto& oldEntry, const auto& newEntry) {
-        std::set<std::string> identifiers;
-        labelTracker->getIdentifiersForLabel(oldEntry->getID(), identifiers);
-        if (identifiers.empty()) {
-          return;
-        }
-        mplsRouteLogger->logChangedRoute(
-            oldEntry,
-            newEntry,
-            std::vector<std::string>(identifiers.begin(), identifiers.end()));
-      },
-      [mplsRouteLogger, &labelTracker](const auto& addedEntry) {
-        std::set<std::string> identifiers;
-        labelTracker->getIdentifiersForLabel(addedEntry->getID(), identifiers);
-        if (identifiers.empty()) {
-          return;
-        }
-        mplsRouteLogger->logAddedRoute(
-            addedEntry,
-            std::vector<std::string>(identifiers.begin(), identifiers.end()));
-      },
-      [mplsRouteLogger, &labelTracker](const auto& removedEntry) {
-        std::set<std::string> identifiers;
-        labelTracker->getIdentifiersForLabel(
-            removedEntry->getID(), identifiers);
-        if (identifiers.empty()) {
-          return;
-        }
-        mplsRouteLogger->logRemovedRoute(
-            removedEntry,
-            std::vector<std::string>(identifiers.begin(), identifiers.end()));
+  loggingThread_->getEventBase()->runInEventBaseThread(
+      [routeLoggerV4,
+       routeLoggerV6,
+       mplsRouteLogger,
+       v4Records = std::move(v4Records),
+       v6Records = std::move(v6Records),
+       mplsRecords = std::move(mplsRecords)]() {
+        logRouteChanges(routeLoggerV4, v4Records);
+        logRouteChanges(routeLoggerV6, v6Records);
+        logRouteChanges(mplsRouteLogger, mplsRecords);
       });
 }
 
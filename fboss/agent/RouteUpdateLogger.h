@@ -10,6 +10,7 @@
 #pragma once
 
 #include <folly/IPAddress.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
 #include <folly/logging/xlog.h>
 #include "fboss/agent/RouteUpdateLoggingPrefixTracker.h"
 #include "fboss/agent/StateObserver.h"
@@ -145,12 +146,26 @@ class LabelsTracker {
   Label2Ids label2Ids_;
 };
 
+/*
+ * A tracked route (or label fib entry) change, handed off to the logging
+ * thread. oldRoute is null for additions and newRoute is null for removals.
+ * Route nodes are immutable once published, so holding on to them is enough
+ * to defer formatting to the logging thread.
+ */
+template <typename RouteT>
+struct RouteChangeRecord {
+  std::shared_ptr<RouteT> oldRoute;
+  std::shared_ptr<RouteT> newRoute;
+  std::vector<std::string> identifiers;
+};
+
 /*
  * Log changes to the routes in SwitchState.
  * Allow subscription to a prefix. When a route to a subscribed prefix
  * (or more specific location with that prefix) is added, removed, or
  * changes, log that information. The logger is pluggable, but by default
- * we use GLOG.
+ * we use GLOG. Loggers are invoked on a dedicated logging thread, so that
+ * formatting and writing out updates does not hold up the update thread.
  */
 class RouteUpdateLogger : public AutoRegisterStateObserver {
   // TODO(pshaikh): rename RouteUpdateLogger to FibUpdateObserver
@@ -162,9 +177,11 @@ class RouteUpdateLogger : public AutoRegisterStateObserver {
       std::unique_ptr<RouteLogger<folly::IPAddressV6>> routeLoggerV6,
       std::unique_ptr<MplsRouteLogger> mplsRouteLogger);
 
-  ~RouteUpdateLogger() override = default;
+  ~RouteUpdateLogger() override;
 
   void stateUpdated(const StateDelta& delta) override;
+  // Block until all updates seen so far have been handed to the loggers
+  void flush();
   void startLoggingForPrefix(const RouteUpdateLoggingInstance& req);
   void stopLoggingForPrefix(
       const folly::IPAddress& network,
@@ -201,6 +218,7 @@ class RouteUpdateLogger : public AutoRegisterStateObserver {
   std::unique_ptr<RouteLogger<folly::IPAddressV4>> routeLoggerV4_;
   std::unique_ptr<RouteLogger<folly::IPAddressV6>> routeLoggerV6_;
   std::unique_ptr<MplsRouteLogger> mplsRouteLogger_;
+  std::unique_ptr<folly::ScopedEventBaseThread> loggingThread_;
 };
 
 } // namespace facebook::fboss
@@ -9,6 +9,7 @@
  */
 
 #include "RouteUpdateLoggingPrefixTracker.h"
+#include <boost/container/flat_set.hpp>
 #include <folly/logging/xlog.h>
 
 namespace facebook::fboss {
@@ -27,14 +28,18 @@ std::string RouteUpdateLoggingInstance::str() const {
 void RouteUpdateLoggingPrefixTracker::track(
     const RouteUpdateLoggingInstance& req) {
   XLOG(INFO) << "Tracking " << req.str();
-  SYNCHRONIZED(trackedPrefixes_) {
-    auto found = trackedPrefixes_[req.identifier].insert(
-        req.prefix.network, req.prefix.mask, req);
+  auto trackedPrefixes = trackedPrefixes_.wlock();
+  auto itr = trackedPrefixes->exactMatch(req.prefix.network, req.prefix.mask);
+  if (itr == trackedPrefixes->end()) {
+    trackedPrefixes->insert(
+        req.prefix.network,
+        req.prefix.mask,
+        TrackingIdentifiers{{req.identifier, req.exact}});
+  } else {
     // Use the most recently set configuration
-    if (!found.second) {
-      found.first.value() = req;
-    }
+    itr->value()[req.identifier] = req.exact;
   }
+  updateNumTracked(*trackedPrefixes);
 }
 
 // stop tracking a particular requested prefix
@@ -42,40 +47,68 @@ void RouteUpdateLoggingPrefixTracker::stopTracking(
     const RoutePrefix<folly::IPAddress>& prefix,
     const std::string& identifier) {
   XLOG(INFO) << "Stop tracking " << prefix.str() << " " << identifier;
-  SYNCHRONIZED(trackedPrefixes_) {
-    auto itr = trackedPrefixes_.find(identifier);
-    if (itr == trackedPrefixes_.end()) {
-      return;
-    }
-    itr->second.erase(prefix.network, prefix.mask);
+  auto trackedPrefixes = trackedPrefixes_.wlock();
+  auto itr = trackedPrefixes->exactMatch(prefix.network, prefix.mask);
+  if (itr == trackedPrefixes->end()) {
+    return;
+  }
+  itr->value().erase(identifier);
+  if (itr->value().empty()) {
+    trackedPrefixes->erase(prefix.network, prefix.mask);
   }
+  updateNumTracked(*trackedPrefixes);
 }
 
 // stop tracking all the routes with the given identifier
 void RouteUpdateLoggingPrefixTracker::stopTracking(
     const std::string& identifier) {
   XLOG(INFO) << "Stop tracking all prefixes for " << identifier;
-  SYNCHRONIZED(trackedPrefixes_) {
-    trackedPrefixes_.erase(identifier);
+  auto trackedPrefixes = trackedPrefixes_.wlock();
+  std::vector<RoutePrefix<folly::IPAddress>> toErase;
+  for (auto& itr : *trackedPrefixes) {
+    itr.value().erase(identifier);
+    if (itr.value().empty()) {
+      toErase.push_back({itr.ipAddress(), itr.masklen()});
+    }
+  }
+  for (const auto& prefix : toErase) {
+    trackedPrefixes->erase(prefix.network, prefix.mask);
   }
+  updateNumTracked(*trackedPrefixes);
+}
+
+void RouteUpdateLoggingPrefixTracker::updateNumTracked(
+    const network::RadixTree<folly::IPAddress, TrackingIdentifiers>&
+        trackedPrefixes) {
+  numTracked_ = trackedPrefixes.size();
 }
 
 bool RouteUpdateLoggingPrefixTracker::trackingImpl(
     const RoutePrefix<folly::IPAddress>& prefix,
     std::vector<std::string>& identifiers) const {
+  using Tree = network::RadixTree<folly::IPAddress, TrackingIdentifiers>;
   identifiers.clear();
-  SYNCHRONIZED_CONST(trackedPrefixes_) {
-    for (const auto& prefixes : trackedPrefixes_) {
-      const auto match =
-          prefixes.second.longestMatch(prefix.network, prefix.mask);
-      if (match != prefixes.second.end()) {
-        if (!match.value().exact) {
-          identifiers.push_back(prefixes.first);
-          continue;
-        }
-        if (match.value().prefix == prefix) {
-          identifiers.push_back(prefixes.first);
-        }
+  auto trackedPrefixes = trackedPrefixes_.rlock();
+  Tree::VecConstIterators trail;
+  auto match = trackedPrefixes->longestMatchWithTrail(
+      prefix.network, prefix.mask, trail);
+  if (match == trackedPrefixes->end()) {
+    return false;
+  }
+  // Walk from the most to the least specific covering prefix. For each
+  // identifier, only its most specific tracked prefix decides whether the
+  // route is logged, same as a per identifier longest match would.
+  boost::container::flat_set<std::string> seen;
+  for (auto itr = trail.rbegin(); itr != trail.rend(); ++itr) {
+    if (itr->masklen() > prefix.mask) {
+      continue;
+    }
+    for (const auto& [identifier, exact] : itr->value()) {
+      if (!seen.insert(identifier).second) {
+        continue;
+      }
+      if (!exact || itr->masklen() == prefix.mask) {
+        identifiers.push_back(identifier);
       }
     }
   }
@@ -85,11 +118,11 @@ bool RouteUpdateLoggingPrefixTracker::trackingImpl(
 std::vector<RouteUpdateLoggingInstance>
 RouteUpdateLoggingPrefixTracker::getTrackedPrefixes() const {
   std::vector<RouteUpdateLoggingInstance> allPrefixes;
-  SYNCHRONIZED_CONST(trackedPrefixes_) {
-    for (const auto& prefixes : trackedPrefixes_) {
-      for (const auto& itr : prefixes.second) {
-        allPrefixes.push_back(itr->value());
-      }
+  auto trackedPrefixes = trackedPrefixes_.rlock();
+  for (const auto& itr : *trackedPrefixes) {
+    RoutePrefix<folly::IPAddress> prefix{itr.ipAddress(), itr.masklen()};
+    for (const auto& [identifier, exact] : itr.value()) {
+      allPrefixes.emplace_back(prefix, identifier, exact);
     }
   }
   return allPrefixes;
@@ -9,12 +9,13 @@
  */
 #pragma once
 
+#include <boost/container/flat_map.hpp>
 #include <folly/Synchronized.h>
 #include "fboss/agent/state/RouteTypes.h"
 #include "fboss/lib/RadixTree.h"
 
+#include <atomic>
 #include <memory>
-#include <unordered_map>
 #include <vector>
 
 namespace facebook::fboss {
@@ -42,6 +43,10 @@ struct RouteUpdateLoggingInstance {
  * Keep track of network prefixes that the agent will
  * log route updates for.
  *
+ * Tracked prefixes of all identifiers share a single radix tree, so checking
+ * a route costs one longest match walk (O(prefix length)) regardless of how
+ * many identifiers or prefixes are tracked.
+ *
  * All the methods in this class are thread safe.
  */
 class RouteUpdateLoggingPrefixTracker {
@@ -69,19 +74,30 @@ class RouteUpdateLoggingPrefixTracker {
   bool tracking(
       const RoutePrefix<AddrT>& prefix,
       std::vector<std::string>& identifiers) const {
+    identifiers.clear();
+    if (numTracked_.load(std::memory_order_relaxed) == 0) {
+      return false;
+    }
     folly::IPAddress addr{prefix.network};
     RoutePrefix<folly::IPAddress> p{addr, prefix.mask};
     return trackingImpl(p, identifiers);
   }
 
  private:
+  // identifier -> exact match required
+  using TrackingIdentifiers = boost::container::flat_map<std::string, bool>;
+
   bool trackingImpl(
       const RoutePrefix<folly::IPAddress>& prefix,
       std::vector<std::string>& identifiers) const;
-  folly::Synchronized<std::unordered_map<
-      std::string,
-      network::RadixTree<folly::IPAddress, RouteUpdateLoggingInstance>>>
+  void updateNumTracked(
+      const network::RadixTree<folly::IPAddress, TrackingIdentifiers>&
+          trackedPrefixes);
+
+  folly::Synchronized<network::RadixTree<folly::IPAddress, TrackingIdentifiers>>
       trackedPrefixes_;
+  // Lets the common case of nothing being tracked skip locking entirely
+  std::atomic<size_t> numTracked_{0};
 };
 
 } // namespace facebook::fboss
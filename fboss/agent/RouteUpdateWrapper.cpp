@@ -118,17 +118,23 @@ void RouteUpdateWrapper::programStandAloneRib(const SyncFibFor& syncFibFor) {
         *fibUpdateFn_,
         fibUpdateCookie_);
   }
-  for (auto [ridClientId, addDelRoutes] : ribRoutesToAddDel_) {
-    auto stats = getRib()->update(
-        ridClientId.first,
+  // Clients updating the same VRF share a single resolution and FIB update
+  std::map<
+      RouterID,
+      std::map<ClientID, RoutingInformationBase::ClientRouteUpdate>>
+      vrfToClientUpdates;
+  for (const auto& [ridClientId, addDelRoutes] : ribRoutesToAddDel_) {
+    vrfToClientUpdates[ridClientId.first].emplace(
         ridClientId.second,
-        clientIdToAdminDistance(ridClientId.second),
-        addDelRoutes.toAdd,
-        addDelRoutes.toDel,
-        syncFibFor.find(ridClientId) != syncFibFor.end(),
-        "RIB update",
-        *fibUpdateFn_,
-        fibUpdateCookie_);
+        RoutingInformationBase::ClientRouteUpdate{
+            addDelRoutes.toAdd,
+            addDelRoutes.toDel,
+            clientIdToAdminDistance(ridClientId.second),
+            syncFibFor.find(ridClientId) != syncFibFor.end()});
+  }
+  for (const auto& [rid, clientUpdates] : vrfToClientUpdates) {
+    auto stats = getRib()->update(
+        rid, clientUpdates, "RIB update", *fibUpdateFn_, fibUpdateCookie_);
     printStats(stats);
     updateStats(stats);
   }
@@ -0,0 +1,53 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/StateUpdateTracer.h"
+
+DEFINE_int32(
+    state_update_trace_history_size,
+    1000,
+    "Number of most recent state updates whose latency breakdown is kept "
+    "for getStateUpdateTraces");
+
+namespace facebook::fboss {
+
+StateUpdateTrace StateUpdateTracer::Trace::toThrift() const {
+  StateUpdateTrace trace;
+  *trace.name_ref() = name;
+  *trace.endTimeMs_ref() =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          endTime.time_since_epoch())
+          .count();
+  *trace.queueWaitUs_ref() = queueWait.count();
+  *trace.applyUs_ref() = apply.count();
+  *trace.hwProgramUs_ref() = hwProgram.count();
+  *trace.observersUs_ref() = observers.count();
+  *trace.completionUs_ref() = completion.count();
+  *trace.batchSize_ref() = batchSize;
+  *trace.generation_ref() = generation;
+  *trace.failed_ref() = failed;
+  return trace;
+}
+
+StateUpdateTracer::StateUpdateTracer(size_t historySize)
+    : traces_(boost::circular_buffer<Trace>(historySize)) {}
+
+void StateUpdateTracer::record(std::vector<Trace> traces) {
+  auto lockedTraces = traces_.wlock();
+  for (auto& trace : traces) {
+    lockedTraces->push_back(std::move(trace));
+  }
+}
+
+std::vector<StateUpdateTracer::Trace> StateUpdateTracer::getTraces() const {
+  auto lockedTraces = traces_.rlock();
+  return std::vector<Trace>(lockedTraces->begin(), lockedTraces->end());
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/if/gen-cpp2/ctrl_types.h"
+
+#include <boost/circular_buffer.hpp>
+#include <folly/Synchronized.h>
+#include <gflags/gflags.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+DECLARE_int32(state_update_trace_history_size);
+
+namespace facebook::fboss {
+
+/*
+ * Remembers where the time went for the last few StateUpdates applied by
+ * SwSwitch: waiting in the pending updates queue, running the update
+ * function, programming the HwSwitch, notifying state observers and running
+ * the update's completion callback.
+ *
+ * Updates coalesced into the same SwitchState change share the HW
+ * programming and observer notification, their traces carry the time of the
+ * whole batch.
+ */
+class StateUpdateTracer {
+ public:
+  struct Trace {
+    std::string name;
+    std::chrono::system_clock::time_point endTime;
+    std::chrono::microseconds queueWait{0};
+    std::chrono::microseconds apply{0};
+    std::chrono::microseconds hwProgram{0};
+    std::chrono::microseconds observers{0};
+    std::chrono::microseconds completion{0};
+    // Number of updates applied together, including this one
+    size_t batchSize{1};
+    // Generation of the SwitchState the update resulted in, 0 if the update
+    // did not change the state
+    int64_t generation{0};
+    bool failed{false};
+
+    StateUpdateTrace toThrift() const;
+  };
+
+  explicit StateUpdateTracer(size_t historySize);
+
+  void record(std::vector<Trace> traces);
+
+  // Oldest trace first
+  std::vector<Trace> getTraces() const;
+
+ private:
+  // Forbidden copy constructor and assignment operator
+  StateUpdateTracer(StateUpdateTracer const&) = delete;
+  StateUpdateTracer& operator=(StateUpdateTracer const&) = delete;
+
+  folly::Synchronized<boost::circular_buffer<Trace>> traces_;
+};
+
+} // namespace facebook::fboss
@@ -33,6 +33,7 @@
 #include "fboss/agent/MPLSHandler.h"
 #include "fboss/agent/MacTableManager.h"
 #include "fboss/agent/MirrorManager.h"
+#include "fboss/agent/NeighborTimerWheel.h"
 #include "fboss/agent/NeighborUpdater.h"
 #include "fboss/agent/PhySnapshotManager.h"
 #include "fboss/agent/Platform.h"
@@ -41,6 +42,7 @@
 #include "fboss/agent/ResolvedNexthopMonitor.h"
 #include "fboss/agent/ResolvedNexthopProbeScheduler.h"
 #include "fboss/agent/RestartTimeTracker.h"
+#include "fboss/agent/RouteChangeTracker.h"
 #include "fboss/agent/RouteUpdateLogger.h"
 #include "fboss/agent/RxPacket.h"
 #include "fboss/agent/StaticL2ForNeighborObserver.h"
@@ -124,6 +126,12 @@ DEFINE_int32(
     64,
     "Expected minimum ethernet packet length");
 
+DEFINE_int32(
+    memory_accounting_interval_s,
+    300,
+    "How often to publish the memory used by the SwitchState, RIB and HW "
+    "object caches to fb303. 0 disables it.");
+
 namespace {
 
 /**
@@ -167,6 +175,22 @@ facebook::fboss::PortStatus fillInPortStatus(
 }
 
 auto constexpr kHwUpdateFailures = "hw_update_failures";
+auto constexpr kOldSwitchStateGenerations = "old_switch_state_generations";
+
+// TODO(joseph5wu): Control this by distinguishing the highest priority
+// queue from the config.
+constexpr uint8_t kNCStrictPriorityQueue = 7;
+
+std::map<std::string, facebook::fboss::MemoryUsageThrift> memoryUsageToThrift(
+    const facebook::fboss::MemoryUsageByType& usage) {
+  std::map<std::string, facebook::fboss::MemoryUsageThrift> thriftUsage;
+  for (const auto& [type, typeUsage] : usage) {
+    auto& thrift = thriftUsage[type];
+    *thrift.bytes_ref() = typeUsage.bytes;
+    *thrift.objects_ref() = typeUsage.objects;
+  }
+  return thriftUsage;
+}
 
 } // anonymous namespace
 
@@ -175,6 +199,8 @@ namespace facebook::fboss {
 SwSwitch::SwSwitch(std::unique_ptr<Platform> platform)
     : hw_(platform->getHwSwitch()),
       platform_(std::move(platform)),
+      neighborExpiryBatcher_(
+          new NeighborExpiryBatcher(this, &neighborCacheEventBase_)),
       arp_(new ArpHandler(this)),
       ipv4_(new IPv4Handler(this)),
       ipv6_(new IPv6Handler(this)),
@@ -183,6 +209,9 @@ SwSwitch::SwSwitch(std::unique_ptr<Platform> platform)
       mirrorManager_(new MirrorManager(this)),
       mplsHandler_(new MPLSHandler(this)),
       routeUpdateLogger_(new RouteUpdateLogger(this)),
+      routeChangeTracker_(new RouteChangeTracker(this)),
+      stateUpdateTracer_(
+          new StateUpdateTracer(FLAGS_state_update_trace_history_size)),
       resolvedNexthopMonitor_(new ResolvedNexthopMonitor(this)),
       resolvedNexthopProbeScheduler_(new ResolvedNexthopProbeScheduler(this)),
       portUpdateHandler_(new PortUpdateHandler(this)),
@@ -252,6 +281,7 @@ void SwSwitch::stop() {
   ipv6_.reset();
 
   routeUpdateLogger_.reset();
+  routeChangeTracker_.reset();
 
   heartbeatWatchdog_->stop();
   heartbeatWatchdog_.reset();
@@ -393,10 +423,18 @@ void SwSwitch::updateLldpStats() {
   stats()->LldpNeighborsSize(lldpManager_->getDB()->pruneExpiredNeighbors());
 }
 
+void SwSwitch::flushBatchedRxStats() {
+  for (SwitchStats& switchStats : getAllThreadsSwitchStats()) {
+    switchStats.flushBatchedRxStats();
+  }
+}
+
 void SwSwitch::updateStats() {
+  flushBatchedRxStats();
   updateRouteStats();
   updatePortInfo();
   updateLldpStats();
+  updateMemoryStats();
   try {
     getHw()->updateStats(stats());
   } catch (const std::exception& ex) {
@@ -406,6 +444,51 @@ void SwSwitch::updateStats() {
   phySnapshotManager_->updateIPhyInfo(getHw()->updateIPhyInfo());
 }
 
+MemoryUsageReport SwSwitch::getMemoryUsage() {
+  MemoryUsageReport report;
+  *report.switchState_ref() = memoryUsageToThrift(getState()->getMemoryUsage());
+  if (rib_) {
+    *report.rib_ref() = memoryUsageToThrift(rib_->getMemoryUsage());
+  }
+  *report.neighborCaches_ref() =
+      memoryUsageToThrift(nUpdater_->getCacheMemoryUsage().get());
+  *report.hwSwitch_ref() = memoryUsageToThrift(hw_->getMemoryUsage());
+  // Not counting the current state
+  auto publishedStates = SwitchState::getNumPublishedStates();
+  *report.oldSwitchStateGenerations_ref() =
+      publishedStates > 0 ? publishedStates - 1 : 0;
+  return report;
+}
+
+void SwSwitch::updateMemoryStats() {
+  auto publishedStates = SwitchState::getNumPublishedStates();
+  fb303::fbData->setCounter(
+      kOldSwitchStateGenerations,
+      publishedStates > 0 ? publishedStates - 1 : 0);
+
+  if (FLAGS_memory_accounting_interval_s <= 0) {
+    return;
+  }
+  auto now = steady_clock::now();
+  if (now - lastMemoryAccounting_ <
+      seconds(FLAGS_memory_accounting_interval_s)) {
+    return;
+  }
+  lastMemoryAccounting_ = now;
+  auto report = getMemoryUsage();
+  auto publish = [](folly::StringPiece section, const auto& usage) {
+    for (const auto& [type, typeUsage] : usage) {
+      auto prefix = folly::to<std::string>("memory.", section, ".", type);
+      fb303::fbData->setCounter(prefix + ".bytes", *typeUsage.bytes_ref());
+      fb303::fbData->setCounter(prefix + ".objects", *typeUsage.objects_ref());
+    }
+  };
+  publish("switch_state", *report.switchState_ref());
+  publish("rib", *report.rib_ref());
+  publish("neighbor_cache", *report.neighborCaches_ref());
+  publish("hw", *report.hwSwitch_ref());
+}
+
 void SwSwitch::registerNeighborListener(
     std::function<void(
         const std::vector<std::string>& added,
@@ -706,6 +789,7 @@ bool SwSwitch::updateState(unique_ptr<StateUpdate> update) {
                << " since exit already started";
     return false;
   }
+  update->queuedTime_ = std::chrono::steady_clock::now();
   {
     std::unique_lock guard(pendingUpdatesLock_);
     pendingUpdates_.push_back(*update.release());
@@ -818,6 +902,13 @@ void SwSwitch::handlePendingUpdates() {
   // not initialized yet
   DCHECK(isInitialized());
 
+  // Traces of the updates still in the list, in the same order
+  std::vector<StateUpdateTracer::Trace> traces;
+  // Traces of the updates already done with
+  std::vector<StateUpdateTracer::Trace> doneTraces;
+  auto batchSize = updates.size();
+  auto dequeueTime = std::chrono::steady_clock::now();
+
   // Call all of the update functions to prepare the new SwitchState
   auto oldAppliedState = getState();
   // We start with the old state, and apply state updates one at a time.
@@ -827,17 +918,34 @@ void SwSwitch::handlePendingUpdates() {
     StateUpdate* update = &(*iter);
     ++iter;
 
+    StateUpdateTracer::Trace trace;
+    trace.name = update->getName();
+    trace.batchSize = batchSize;
+    trace.queueWait = std::chrono::duration_cast<std::chrono::microseconds>(
+        dequeueTime - update->queuedTime_);
+    auto applyStart = std::chrono::steady_clock::now();
     shared_ptr<SwitchState> intermediateState;
     XLOG(INFO) << "preparing state update " << update->getName();
     try {
       intermediateState = update->applyUpdate(newDesiredState);
     } catch (const std::exception& ex) {
+      auto applyEnd = std::chrono::steady_clock::now();
+      trace.apply = std::chrono::duration_cast<std::chrono::microseconds>(
+          applyEnd - applyStart);
       // Call the update's onError() function, and then immediately delete
       // it (therefore removing it from the intrusive list).  This way we won't
       // call it's onSuccess() function later.
       update->onError(ex);
       delete update;
+      trace.completion = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - applyEnd);
+      trace.failed = true;
+      doneTraces.push_back(std::move(trace));
+      continue;
     }
+    trace.apply = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - applyStart);
+    traces.push_back(std::move(trace));
     // We have applied the update to software switch state, so call success
     // on the update.
     if (intermediateState) {
@@ -853,13 +961,20 @@ void SwSwitch::handlePendingUpdates() {
   // Start newAppliedState as equal to newDesiredState unless
   // we learn otherwise
   auto newAppliedState = newDesiredState;
+  // HW programming and observer notification time, shared by the batch
+  StateUpdateTracer::Trace batchTrace;
   // Now apply the update and notify subscribers
   if (newDesiredState != oldAppliedState) {
     auto isTransaction = updates.begin()->hwFailureProtected() &&
         getHw()->transactionsSupported();
     // There was some change during these state updates
-    newAppliedState =
-        applyUpdate(oldAppliedState, newDesiredState, isTransaction);
+    newAppliedState = applyUpdate(
+        oldAppliedState, newDesiredState, isTransaction, &batchTrace);
+    for (auto& trace : traces) {
+      trace.hwProgram = batchTrace.hwProgram;
+      trace.observers = batchTrace.observers;
+      trace.generation = batchTrace.generation;
+    }
     if (newDesiredState != newAppliedState) {
       if (isExiting()) {
         /*
@@ -882,6 +997,7 @@ void SwSwitch::handlePendingUpdates() {
       } else if (updates.size() == 1 && updates.begin()->hwFailureProtected()) {
         fb303::fbData->incrementCounter(kHwUpdateFailures);
         unique_ptr<StateUpdate> update(&updates.front());
+        auto completionStart = std::chrono::steady_clock::now();
         try {
           throw FbossHwUpdateError(
               newDesiredState,
@@ -893,6 +1009,13 @@ void SwSwitch::handlePendingUpdates() {
         } catch (const std::exception& ex) {
           update->onError(ex);
         }
+        auto& trace = traces.front();
+        trace.completion =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - completionStart);
+        trace.failed = true;
+        doneTraces.push_back(std::move(trace));
+        recordStateUpdateTraces(std::move(doneTraces));
         return;
       } else {
         XLOG(FATAL)
@@ -903,11 +1026,28 @@ void SwSwitch::handlePendingUpdates() {
   }
 
   // Notify all of the updates of success and delete them.
+  auto trace = traces.begin();
   while (!updates.empty()) {
     unique_ptr<StateUpdate> update(&updates.front());
     updates.pop_front();
+    auto completionStart = std::chrono::steady_clock::now();
     update->onSuccess();
+    trace->completion = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - completionStart);
+    doneTraces.push_back(std::move(*trace++));
   }
+  recordStateUpdateTraces(std::move(doneTraces));
+}
+
+void SwSwitch::recordStateUpdateTraces(
+    std::vector<StateUpdateTracer::Trace> traces) {
+  for (auto& trace : traces) {
+    trace.endTime = std::chrono::system_clock::now();
+    stats()->stateUpdateQueueWait(trace.queueWait);
+    stats()->stateUpdateApply(trace.apply);
+    stats()->stateUpdateCompletion(trace.completion);
+  }
+  stateUpdateTracer_->record(std::move(traces));
 }
 
 void SwSwitch::setStateInternal(std::shared_ptr<SwitchState> newAppliedState) {
@@ -922,7 +1062,8 @@ void SwSwitch::setStateInternal(std::shared_ptr<SwitchState> newAppliedState) {
 std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
     const shared_ptr<SwitchState>& oldState,
     const shared_ptr<SwitchState>& newState,
-    bool isTransaction) {
+    bool isTransaction,
+    StateUpdateTracer::Trace* batchTrace) {
   // Check that we are starting from what has been already applied
   DCHECK_EQ(oldState, getAppliedState());
 
@@ -953,6 +1094,7 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
   // take a non-trivial amount of time, and blocking other users seems
   // undesirable.  So far I don't think this brief discrepancy should cause
   // major issues.
+  auto hwStart = std::chrono::steady_clock::now();
   try {
     newAppliedState = isTransaction ? hw_->stateChangedTransaction(delta)
                                     : hw_->stateChanged(delta);
@@ -969,12 +1111,25 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
                 << folly::exceptionStr(ex);
   }
 
+  auto hwEnd = std::chrono::steady_clock::now();
+
   setStateInternal(newAppliedState);
 
   // Notifies all observers of the current state update.
   notifyStateObservers(StateDelta(oldState, newAppliedState));
 
   auto end = std::chrono::steady_clock::now();
+  auto hwProgram =
+      std::chrono::duration_cast<std::chrono::microseconds>(hwEnd - hwStart);
+  auto observers =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - hwEnd);
+  stats()->stateUpdateHwProgram(hwProgram);
+  stats()->stateUpdateObservers(observers);
+  if (batchTrace) {
+    batchTrace->hwProgram = hwProgram;
+    batchTrace->observers = observers;
+    batchTrace->generation = newAppliedState->getGeneration();
+  }
   auto duration =
       std::chrono::duration_cast<std::chrono::microseconds>(end - start);
   stats()->stateUpdate(duration);
@@ -1346,9 +1501,6 @@ void SwSwitch::sendNetworkControlPacketAsync(
     std::unique_ptr<TxPacket> pkt,
     std::optional<PortDescriptor> port) noexcept {
   if (port) {
-    // TODO(joseph5wu): Control this by distinguishing the highest priority
-    // queue from the config.
-    static const uint8_t kNCStrictPriorityQueue = 7;
     auto portVal = *port;
     switch (portVal.type()) {
       case PortDescriptor::PortType::PHYSICAL:
@@ -1365,6 +1517,32 @@ void SwSwitch::sendNetworkControlPacketAsync(
   }
 }
 
+void SwSwitch::sendNetworkControlPacketsAsync(
+    std::vector<std::pair<std::unique_ptr<TxPacket>, PortID>> pkts) noexcept {
+  auto state = getState();
+  std::vector<std::pair<std::unique_ptr<TxPacket>, PortID>> toSend;
+  toSend.reserve(pkts.size());
+  for (auto& pktAndPort : pkts) {
+    if (!state->getPorts()->getPortIf(pktAndPort.second)) {
+      XLOG(ERR) << "SendNetworkControlPacketsAsync: dropping packet to "
+                << "unexpected port " << pktAndPort.second;
+      stats()->pktDropped();
+      continue;
+    }
+    pcapMgr_->packetSent(pktAndPort.first.get());
+    toSend.push_back(std::move(pktAndPort));
+  }
+
+  auto numPkts = toSend.size();
+  auto numSent =
+      hw_->sendPacketsOutOfPortAsync(std::move(toSend), kNCStrictPriorityQueue);
+  if (numSent != numPkts) {
+    // As for single packets, all we can do about send failures is log them
+    XLOG(ERR) << "failed to send " << numPkts - numSent << " of " << numPkts
+              << " network control packets";
+  }
+}
+
 void SwSwitch::sendPacketOutOfPortAsync(
     std::unique_ptr<TxPacket> pkt,
     PortID portID,
@@ -1626,9 +1804,19 @@ void SwSwitch::applyConfig(
   updateStateBlocking(
       reason,
       [&](const shared_ptr<SwitchState>& state) -> shared_ptr<SwitchState> {
-        auto newState = rib_
-            ? applyThriftConfig(state, &newConfig, getPlatform(), &routeUpdater)
-            : applyThriftConfig(state, &newConfig, getPlatform());
+        auto newState = rib_ ? applyThriftConfig(
+                                   state,
+                                   &newConfig,
+                                   getPlatform(),
+                                   &routeUpdater,
+                                   &appliedConfigSections_)
+                             : applyThriftConfig(
+                                   state,
+                                   &newConfig,
+                                   getPlatform(),
+                                   static_cast<RoutingInformationBase*>(
+                                       nullptr),
+                                   &appliedConfigSections_);
 
         if (newState && !isValidStateUpdate(StateDelta(state, newState))) {
           throw FbossError("Invalid config passed in, skipping");
@@ -9,8 +9,10 @@
  */
 #pragma once
 
+#include "fboss/agent/ApplyThriftConfig.h"
 #include "fboss/agent/HwSwitch.h"
 #include "fboss/agent/RestartTimeTracker.h"
+#include "fboss/agent/StateUpdateTracer.h"
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
 #include "fboss/agent/ThreadHeartbeat.h"
 #include "fboss/agent/Utils.h"
@@ -34,6 +36,8 @@
 #include <mutex>
 #include <thread>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -53,7 +57,9 @@ class RxPacket;
 class SwitchState;
 class SwitchStats;
 class StateDelta;
+class NeighborExpiryBatcher;
 class NeighborUpdater;
+class RouteChangeTracker;
 class RouteUpdateLogger;
 class StateObserver;
 class TunManager;
@@ -189,6 +195,12 @@ class SwSwitch : public HwSwitch::Callback {
 
   void updateStats();
 
+  /*
+   * Approximate memory used by the SwitchState, RIB, neighbor caches and
+   * HwSwitch object caches. Walks the whole SwitchState.
+   */
+  MemoryUsageReport getMemoryUsage();
+
   folly::dynamic gracefulExitState() const;
 
   /*
@@ -354,6 +366,12 @@ class SwSwitch : public HwSwitch::Callback {
     return stats_.accessAllThreads();
   }
 
+  /*
+   * Add the counters batched on the packet RX path by every thread to their
+   * timeseries
+   */
+  void flushBatchedRxStats();
+
   /*
    * Construct and destroy a client to dump packets to the packet distribution
    * service.
@@ -439,6 +457,14 @@ class SwSwitch : public HwSwitch::Callback {
     return &neighborCacheEventBase_;
   }
 
+  /*
+   * Batches the removal of expired neighbor entries from all the Arp/Ndp
+   * caches. Only used from the neighbor cache thread.
+   */
+  NeighborExpiryBatcher* getNeighborExpiryBatcher() {
+    return neighborExpiryBatcher_.get();
+  }
+
   /**
    * Do the packet received callback, and throw exception if there is an error
    * in the handling of packet.
@@ -487,6 +513,13 @@ class SwSwitch : public HwSwitch::Callback {
       std::unique_ptr<TxPacket> pkt,
       std::optional<PortDescriptor> port) noexcept;
 
+  /**
+   * Send network control packets, each out of the physical port paired
+   * with it, handing them to the HwSwitch as one batch.
+   */
+  void sendNetworkControlPacketsAsync(
+      std::vector<std::pair<std::unique_ptr<TxPacket>, PortID>> pkts) noexcept;
+
   void sendPacketOutOfPortAsync(
       std::unique_ptr<TxPacket> pkt,
       PortID portID,
@@ -593,6 +626,20 @@ class SwSwitch : public HwSwitch::Callback {
     return routeUpdateLogger_.get();
   }
 
+  /*
+   * Get the RouteChangeTracker object
+   */
+  const RouteChangeTracker* getRouteChangeTracker() const {
+    return routeChangeTracker_.get();
+  }
+
+  /*
+   * Get the StateUpdateTracer object
+   */
+  const StateUpdateTracer* getStateUpdateTracer() const {
+    return stateUpdateTracer_.get();
+  }
+
   LinkAggregationManager* getLagManager() {
     return lagManager_.get();
   }
@@ -742,6 +789,7 @@ class SwSwitch : public HwSwitch::Callback {
   void publishInitTimes(std::string name, const float& time);
   void updatePortInfo();
   void updateRouteStats();
+  void updateMemoryStats();
   void publishSwitchInfo(const HwInitResult& hwInitRet);
   void setSwitchRunState(SwitchRunState desiredState);
   SwitchStats* createSwitchStats();
@@ -752,7 +800,9 @@ class SwSwitch : public HwSwitch::Callback {
   std::shared_ptr<SwitchState> applyUpdate(
       const std::shared_ptr<SwitchState>& oldState,
       const std::shared_ptr<SwitchState>& newState,
-      bool isTransaction);
+      bool isTransaction,
+      StateUpdateTracer::Trace* batchTrace = nullptr);
+  void recordStateUpdateTraces(std::vector<StateUpdateTracer::Trace> traces);
 
   void startThreads();
   void stopThreads();
@@ -796,6 +846,9 @@ class SwSwitch : public HwSwitch::Callback {
 
   std::string curConfigStr_;
   cfg::SwitchConfig curConfig_;
+  // Sections of the config applied to the state, only accessed from the
+  // update thread
+  AppliedConfigSections appliedConfigSections_;
 
   // The HwSwitch object.  This object is owned by the Platform.
   HwSwitch* hw_;
@@ -874,6 +927,7 @@ class SwSwitch : public HwSwitch::Callback {
   std::unique_ptr<std::thread> neighborCacheThread_;
   folly::EventBase neighborCacheEventBase_;
   std::shared_ptr<ThreadHeartbeat> neighborCacheThreadHeartbeat_;
+  std::unique_ptr<NeighborExpiryBatcher> neighborExpiryBatcher_;
 
   /*
    * A thread dedicated to monitor above thread heartbeats
@@ -904,6 +958,9 @@ class SwSwitch : public HwSwitch::Callback {
   std::unique_ptr<MirrorManager> mirrorManager_;
   std::unique_ptr<MPLSHandler> mplsHandler_;
   std::unique_ptr<RouteUpdateLogger> routeUpdateLogger_;
+  std::unique_ptr<RouteChangeTracker> routeChangeTracker_;
+  std::unique_ptr<StateUpdateTracer> stateUpdateTracer_;
+  std::chrono::steady_clock::time_point lastMemoryAccounting_;
   std::unique_ptr<LinkAggregationManager> lagManager_;
   std::unique_ptr<ResolvedNexthopMonitor> resolvedNexthopMonitor_;
   std::unique_ptr<ResolvedNexthopProbeScheduler> resolvedNexthopProbeScheduler_;
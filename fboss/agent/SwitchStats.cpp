@@ -12,6 +12,12 @@
 #include <folly/Memory.h>
 #include "fboss/agent/PortStats.h"
 
+DEFINE_int32(
+    rx_stats_batch_size,
+    64,
+    "Number of trapped packets a thread receives before adding the counters "
+    "bumped for every packet to their timeseries");
+
 using facebook::fb303::AVG;
 using facebook::fb303::RATE;
 using facebook::fb303::SUM;
@@ -42,8 +48,28 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
       arpRequestsTx_(map, kCounterPrefix + "arp.request.tx", SUM, RATE),
       arpRepliesTx_(map, kCounterPrefix + "arp.reply.tx", SUM, RATE),
       arpBadOp_(map, kCounterPrefix + "arp.bad_op", SUM, RATE),
+      arpRequestsDeduped_(
+          map,
+          kCounterPrefix + "arp.request.deduped",
+          SUM,
+          RATE),
+      arpRequestsRateLimited_(
+          map,
+          kCounterPrefix + "arp.request.rate_limited",
+          SUM,
+          RATE),
       trapPktNdp_(map, kCounterPrefix + "trapped.ndp", SUM, RATE),
       ipv6NdpBad_(map, kCounterPrefix + "ipv6.ndp.bad", SUM, RATE),
+      ndpSolicitationsDeduped_(
+          map,
+          kCounterPrefix + "ndp.solicitation.deduped",
+          SUM,
+          RATE),
+      ndpSolicitationsRateLimited_(
+          map,
+          kCounterPrefix + "ndp.solicitation.rate_limited",
+          SUM,
+          RATE),
       ipv4Rx_(map, kCounterPrefix + "trapped.ipv4", SUM, RATE),
       ipv4TooSmall_(map, kCounterPrefix + "ipv4.too_small", SUM, RATE),
       ipv4WrongVer_(map, kCounterPrefix + "ipv4.wrong_version", SUM, RATE),
@@ -79,6 +105,51 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
           SUM,
           RATE),
       updateState_(map, kCounterPrefix + "state_update.us", 50000, 0, 1000000),
+      updateStateQueueWait_(
+          map,
+          kCounterPrefix + "state_update.queue_wait.us",
+          1000,
+          0,
+          1000000,
+          AVG,
+          50,
+          99),
+      updateStateApply_(
+          map,
+          kCounterPrefix + "state_update.apply.us",
+          1000,
+          0,
+          1000000,
+          AVG,
+          50,
+          99),
+      updateStateHwProgram_(
+          map,
+          kCounterPrefix + "state_update.hw_program.us",
+          1000,
+          0,
+          1000000,
+          AVG,
+          50,
+          99),
+      updateStateObservers_(
+          map,
+          kCounterPrefix + "state_update.observers.us",
+          1000,
+          0,
+          1000000,
+          AVG,
+          50,
+          99),
+      updateStateCompletion_(
+          map,
+          kCounterPrefix + "state_update.completion.us",
+          1000,
+          0,
+          1000000,
+          AVG,
+          50,
+          99),
       routeUpdate_(map, kCounterPrefix + "route_update.us", 50, 0, 500),
       bgHeartbeatDelay_(
           map,
@@ -191,6 +262,24 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
           map,
           kCounterPrefix + "lacp.mismatched_pdu_teardown",
           SUM),
+      LacpTxLateness_(
+          map,
+          kCounterPrefix + "lacp.tx_lateness.ms",
+          10,
+          0,
+          5000,
+          AVG,
+          50,
+          100),
+      LacpTxJitter_(
+          map,
+          kCounterPrefix + "lacp.tx_jitter.ms",
+          10,
+          0,
+          5000,
+          AVG,
+          50,
+          100),
       MkPduRecvdPkts_(map, kCounterPrefix + "mkpdu.recvd", SUM, RATE),
       MkPduSendPkts_(map, kCounterPrefix + "mkpdu.send", SUM, RATE),
       MkPduSendFailure_(
@@ -227,6 +316,24 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
           kCounterPrefix + "pfc_deadlock_recovery",
           SUM) {}
 
+SwitchStats::~SwitchStats() {
+  flushBatchedRxStats();
+}
+
+void SwitchStats::flushBatchedRxStats() {
+  auto fold = [](BatchedCounter& batched, TLTimeseries& timeseries) {
+    if (auto value = batched.takeUnfolded()) {
+      timeseries.addValue(value);
+    }
+  };
+  fold(batchedTrapPkts_, trapPkts_);
+  fold(batchedTrapPktToHost_, trapPktToHost_);
+  fold(batchedTrapPktToHostBytes_, trapPktToHostBytes_);
+  fold(batchedTrapPktArp_, trapPktArp_);
+  fold(batchedTrapPktNdp_, trapPktNdp_);
+  fold(batchedIpv4Rx_, ipv4Rx_);
+}
+
 PortStats* FOLLY_NULLABLE SwitchStats::port(PortID portID) {
   auto it = ports_.find(portID);
   if (it != ports_.end()) {
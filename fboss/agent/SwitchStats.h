@@ -12,15 +12,51 @@
 #include <boost/container/flat_map.hpp>
 #include <boost/noncopyable.hpp>
 #include <fb303/ThreadCachedServiceData.h>
+#include <gflags/gflags.h>
+#include <atomic>
 #include <chrono>
 #include "fboss/agent/AggregatePortStats.h"
 #include "fboss/agent/PortStats.h"
 #include "fboss/agent/types.h"
 
+DECLARE_int32(rx_stats_batch_size);
+
 namespace facebook::fboss {
 
 class PortStats;
 
+/*
+ * A counter incremented only by the thread owning it, without any locking or
+ * atomic read-modify-write, whose increments are later added to a timeseries
+ * in one go. Folding is lock free and may be done from any thread: whoever
+ * advances folded_ up to total_ adds the difference.
+ */
+class BatchedCounter {
+ public:
+  void add(uint64_t value) {
+    total_.store(
+        total_.load(std::memory_order_relaxed) + value,
+        std::memory_order_relaxed);
+  }
+
+  // Increments not folded yet, which are now considered folded
+  uint64_t takeUnfolded() {
+    auto folded = folded_.load(std::memory_order_relaxed);
+    auto total = total_.load(std::memory_order_relaxed);
+    while (total > folded) {
+      if (folded_.compare_exchange_weak(
+              folded, total, std::memory_order_relaxed)) {
+        return total - folded;
+      }
+    }
+    return 0;
+  }
+
+ private:
+  std::atomic<uint64_t> total_{0};
+  std::atomic<uint64_t> folded_{0};
+};
+
 typedef boost::container::flat_map<PortID, std::unique_ptr<PortStats>>
     PortStatsMap;
 using AggregatePortStatsMap = boost::container::
@@ -34,6 +70,7 @@ class SwitchStats : public boost::noncopyable {
   static std::string kCounterPrefix;
 
   SwitchStats();
+  ~SwitchStats();
 
   /*
    * Return the PortStats object for the given PortID.
@@ -63,9 +100,22 @@ class SwitchStats : public boost::noncopyable {
     ports_.erase(portID);
   }
 
+  /*
+   * The counters bumped for every trapped packet are batched: they are added
+   * to their timeseries every FLAGS_rx_stats_batch_size packets received by
+   * the thread, and by flushBatchedRxStats(), which SwSwitch calls for all
+   * threads each time it updates its stats.
+   */
   void trappedPkt() {
-    trapPkts_.addValue(1);
+    batchedTrapPkts_.add(1);
+    if (++pktsSinceFlush_ >= FLAGS_rx_stats_batch_size) {
+      pktsSinceFlush_ = 0;
+      flushBatchedRxStats();
+    }
   }
+  // Thread-safe
+  void flushBatchedRxStats();
+
   void pktDropped() {
     trapPktDrops_.addValue(1);
   }
@@ -82,8 +132,8 @@ class SwitchStats : public boost::noncopyable {
     trapPktDrops_.addValue(1);
   }
   void pktToHost(uint32_t bytes) {
-    trapPktToHost_.addValue(1);
-    trapPktToHostBytes_.addValue(bytes);
+    batchedTrapPktToHost_.add(1);
+    batchedTrapPktToHostBytes_.add(bytes);
   }
   void pktFromHost(uint32_t bytes) {
     pktFromHost_.addValue(1);
@@ -91,7 +141,7 @@ class SwitchStats : public boost::noncopyable {
   }
 
   void arpPkt() {
-    trapPktArp_.addValue(1);
+    batchedTrapPktArp_.add(1);
   }
   void arpUnsupported() {
     arpUnsupported_.addValue(1);
@@ -117,14 +167,26 @@ class SwitchStats : public boost::noncopyable {
     arpBadOp_.addValue(1);
     trapPktDrops_.addValue(1);
   }
+  void arpRequestDeduped() {
+    arpRequestsDeduped_.addValue(1);
+  }
+  void arpRequestRateLimited() {
+    arpRequestsRateLimited_.addValue(1);
+  }
 
   void ipv6NdpPkt() {
-    trapPktNdp_.addValue(1);
+    batchedTrapPktNdp_.add(1);
   }
   void ipv6NdpBad() {
     ipv6NdpBad_.addValue(1);
     trapPktDrops_.addValue(1);
   }
+  void ndpSolicitationDeduped() {
+    ndpSolicitationsDeduped_.addValue(1);
+  }
+  void ndpSolicitationRateLimited() {
+    ndpSolicitationsRateLimited_.addValue(1);
+  }
 
   void dhcpV4Pkt() {
     dhcpV4Pkt_.addValue(1);
@@ -135,7 +197,7 @@ class SwitchStats : public boost::noncopyable {
   }
 
   void ipv4Rx() {
-    ipv4Rx_.addValue(1);
+    batchedIpv4Rx_.add(1);
   }
   void ipv4TooSmall() {
     ipv4TooSmall_.addValue(1);
@@ -226,6 +288,22 @@ class SwitchStats : public boost::noncopyable {
     updateState_.addValue(us.count());
   }
 
+  void stateUpdateQueueWait(std::chrono::microseconds us) {
+    updateStateQueueWait_.addValue(us.count());
+  }
+  void stateUpdateApply(std::chrono::microseconds us) {
+    updateStateApply_.addValue(us.count());
+  }
+  void stateUpdateHwProgram(std::chrono::microseconds us) {
+    updateStateHwProgram_.addValue(us.count());
+  }
+  void stateUpdateObservers(std::chrono::microseconds us) {
+    updateStateObservers_.addValue(us.count());
+  }
+  void stateUpdateCompletion(std::chrono::microseconds us) {
+    updateStateCompletion_.addValue(us.count());
+  }
+
   void routeUpdate(std::chrono::microseconds us, uint64_t routes) {
     // As syncFib() could include no routes.
     if (routes == 0) {
@@ -308,6 +386,12 @@ class SwitchStats : public boost::noncopyable {
   void LacpMismatchPduTeardown() {
     LacpMismatchPduTeardown_.addValue(1);
   }
+  void LacpTxLateness(int ms) {
+    LacpTxLateness_.addValue(ms);
+  }
+  void LacpTxJitter(int ms) {
+    LacpTxJitter_.addValue(ms);
+  }
 
   void MkPduRecvdPkt() {
     MkPduRecvdPkts_.addValue(1);
@@ -350,6 +434,17 @@ class SwitchStats : public boost::noncopyable {
 
   explicit SwitchStats(ThreadLocalStatsMap* map);
 
+  // Increments of trapPkts_, trapPktToHost_, trapPktToHostBytes_,
+  // trapPktArp_, trapPktNdp_ and ipv4Rx_ not added to them yet
+  BatchedCounter batchedTrapPkts_;
+  BatchedCounter batchedTrapPktToHost_;
+  BatchedCounter batchedTrapPktToHostBytes_;
+  BatchedCounter batchedTrapPktArp_;
+  BatchedCounter batchedTrapPktNdp_;
+  BatchedCounter batchedIpv4Rx_;
+  // Only accessed by the thread owning these stats
+  int32_t pktsSinceFlush_{0};
+
   // Total number of trapped packets
   TLTimeseries trapPkts_;
   // Number of trapped packets that were intentionally dropped.
@@ -386,10 +481,19 @@ class SwitchStats : public boost::noncopyable {
   TLTimeseries arpRepliesTx_;
   // ARP packets with an unknown op field
   TLTimeseries arpBadOp_;
+  // ARP requests not sent for punted packets, since one was sent for the
+  // same destination recently
+  TLTimeseries arpRequestsDeduped_;
+  // ARP requests not sent for punted packets, over the resolution rate
+  TLTimeseries arpRequestsRateLimited_;
 
   // IPv6 Neighbor Discovery Protocol packets
   TLTimeseries trapPktNdp_;
   TLTimeseries ipv6NdpBad_;
+  // Same as arpRequestsDeduped_ and arpRequestsRateLimited_, for neighbor
+  // solicitations
+  TLTimeseries ndpSolicitationsDeduped_;
+  TLTimeseries ndpSolicitationsRateLimited_;
 
   // IPv4 Packets
   TLTimeseries ipv4Rx_;
@@ -448,6 +552,17 @@ class SwitchStats : public boost::noncopyable {
    */
   TLHistogram updateState_;
 
+  /**
+   * Histograms for the stages of a state update (in microsecond): time
+   * spent queued, in the update function, programming the HW, notifying
+   * state observers and in the update's completion callback
+   */
+  TLHistogram updateStateQueueWait_;
+  TLHistogram updateStateApply_;
+  TLHistogram updateStateHwProgram_;
+  TLHistogram updateStateObservers_;
+  TLHistogram updateStateCompletion_;
+
   /**
    * Histogram for time used for route update (in microsecond)
    */
@@ -527,6 +642,11 @@ class SwitchStats : public boost::noncopyable {
   TLTimeseries LacpRxTimeouts_;
   // Number of LACP session teardown due to mismatching PDUs
   TLTimeseries LacpMismatchPduTeardown_;
+  // How late periodic LACPDUs were sent, in milliseconds
+  TLHistogram LacpTxLateness_;
+  // Deviation of the interval between periodic LACPDUs from their period, in
+  // milliseconds
+  TLHistogram LacpTxJitter_;
   // Number of MkPdu Received.
   TLTimeseries MkPduRecvdPkts_;
   // Number of MkPdu Send.
@@ -19,7 +19,10 @@
 #include "fboss/agent/LinkAggregationManager.h"
 #include "fboss/agent/LldpManager.h"
 #include "fboss/agent/NeighborUpdater.h"
+#include "fboss/agent/RouteChangeTracker.h"
+#include "fboss/agent/RouteTablePager.h"
 #include "fboss/agent/RouteUpdateLogger.h"
+#include "fboss/agent/StateUpdateTracer.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
 #include "fboss/agent/SwitchStats.h"
@@ -65,8 +68,12 @@
 #include <folly/io/IOBuf.h>
 #include <folly/json_pointer.h>
 #include <folly/logging/xlog.h>
+#if FOLLY_HAS_COROUTINES
+#include <folly/experimental/coro/AsyncGenerator.h>
+#endif
 #include <thrift/lib/cpp/util/EnumUtils.h>
 #include <thrift/lib/cpp2/async/DuplexChannel.h>
+#include <thrift/lib/cpp2/async/ServerStream.h>
 #include <memory>
 
 #include <limits>
@@ -537,6 +544,147 @@ PortLoopbackMode toThriftLoopbackMode(cfg::PortLoopbackMode mode) {
   }
   throw FbossError("Bogus loopback mode: ", mode);
 }
+
+// Routes per page for the route table streams if the client doesn't pick one
+constexpr size_t kDefaultRoutePageSize = 1000;
+
+template <typename RouteT>
+std::optional<UnicastRoute> toUnicastRoute(
+    const std::shared_ptr<RouteT>& route) {
+  if (!route->isResolved()) {
+    XLOG(INFO) << "Skipping unresolved route: " << route->toFollyDynamic();
+    return std::nullopt;
+  }
+  UnicastRoute tempRoute;
+  auto fwdInfo = route->getForwardInfo();
+  tempRoute.dest_ref()->ip_ref() = toBinaryAddress(route->prefix().network);
+  tempRoute.dest_ref()->prefixLength_ref() = route->prefix().mask;
+  tempRoute.nextHopAddrs_ref() = util::fromFwdNextHops(fwdInfo.getNextHopSet());
+  tempRoute.nextHops_ref() =
+      util::fromRouteNextHopSet(fwdInfo.normalizedNextHops());
+  if (fwdInfo.getCounterID().has_value()) {
+    tempRoute.counterID_ref() = *fwdInfo.getCounterID();
+  }
+  return tempRoute;
+}
+
+template <typename RouteT>
+std::optional<UnicastRoute> toUnicastRoute(
+    const std::shared_ptr<RouteT>& route,
+    ClientID client) {
+  auto entry = route->getEntryForClient(client);
+  if (not entry) {
+    return std::nullopt;
+  }
+  UnicastRoute tempRoute;
+  tempRoute.dest_ref()->ip_ref() = toBinaryAddress(route->prefix().network);
+  tempRoute.dest_ref()->prefixLength_ref() = route->prefix().mask;
+  tempRoute.nextHops_ref() = util::fromRouteNextHopSet(entry->getNextHopSet());
+  if (entry->getCounterID().has_value()) {
+    tempRoute.counterID_ref() = *entry->getCounterID();
+  }
+  for (const auto& nh : *tempRoute.nextHops_ref()) {
+    tempRoute.nextHopAddrs_ref()->emplace_back(*nh.address_ref());
+  }
+  return tempRoute;
+}
+
+template <typename RouteT>
+bool matchesClient(
+    const std::shared_ptr<RouteT>& route,
+    const RouteTableFilter& filter) {
+  return !filter.clientId_ref() ||
+      route->getEntryForClient(ClientID(*filter.clientId_ref()));
+}
+
+std::optional<RouterID> getFilterVrf(const RouteTableFilter& filter) {
+  if (filter.vrf_ref()) {
+    return RouterID(*filter.vrf_ref());
+  }
+  return std::nullopt;
+}
+
+std::optional<folly::CIDRNetwork> getFilterPrefix(
+    const RouteTableFilter& filter) {
+  if (filter.prefix_ref()) {
+    return folly::CIDRNetwork(
+        toIPAddress(*filter.prefix_ref()->ip_ref()),
+        *filter.prefix_ref()->prefixLength_ref());
+  }
+  return std::nullopt;
+}
+
+RouteTablePager makeRouteTablePager(
+    std::shared_ptr<SwitchState> state,
+    const RouteTableFilter& filter) {
+  return RouteTablePager(
+      std::move(state), getFilterVrf(filter), getFilterPrefix(filter));
+}
+
+/*
+ * Fill the next page of routes. Returns false if there are no routes left
+ * after this page.
+ */
+template <typename PageT, typename AppendFn>
+bool nextRoutePage(
+    RouteTablePager& pager,
+    size_t pageSize,
+    int64_t runId,
+    AppendFn& append,
+    PageT& page) {
+  page.generation_ref() = pager.getState()->getGeneration();
+  page.runId_ref() = runId;
+  return pager.visitNext(pageSize, [&](RouterID rid, const auto& route) {
+    return append(*page.routes_ref(), rid, route);
+  });
+}
+
+#if FOLLY_HAS_COROUTINES
+template <typename PageT, typename AppendFn>
+folly::coro::AsyncGenerator<PageT&&>
+routePageGenerator(
+    RouteTablePager pager,
+    size_t pageSize,
+    int64_t runId,
+    AppendFn append) {
+  bool first = true;
+  bool more = true;
+  while (more) {
+    PageT page;
+    more = nextRoutePage(pager, pageSize, runId, append, page);
+    if (first || !page.routes_ref()->empty()) {
+      first = false;
+      co_yield std::move(page);
+    }
+  }
+}
+#endif
+
+/*
+ * Stream the routes of the pager's snapshot, pageSize routes at a time.
+ * append(routes, rid, route) converts the route and adds it to the page,
+ * returning false if the route should be skipped.
+ */
+template <typename PageT, typename AppendFn>
+apache::thrift::ServerStream<PageT>
+streamRoutePages(
+    RouteTablePager pager,
+    int32_t pageSize,
+    int64_t runId,
+    AppendFn append) {
+#if FOLLY_HAS_COROUTINES
+  size_t size = pageSize > 0 ? pageSize : kDefaultRoutePageSize;
+  // Pages are only built as the client consumes them
+  return routePageGenerator<PageT>(
+      std::move(pager), size, runId, std::move(append));
+#else
+  // Without coroutines the whole table would have to be built up front,
+  // which is what paging is meant to avoid
+  throw FbossError(
+      "Route table streaming is not supported by this build, "
+      "use getRouteTableChangesSince or getRouteTable instead");
+#endif
+}
 } // namespace
 
 namespace facebook::fboss {
@@ -566,6 +714,7 @@ class RouteUpdateStats {
 
 ThriftHandler::ThriftHandler(SwSwitch* sw) : FacebookBase2("FBOSS"), sw_(sw) {
   if (sw) {
+    routeUpdateBatcher_ = std::make_unique<RouteUpdateBatcher>(sw);
     sw->registerNeighborListener([=](const std::vector<std::string>& added,
                                      const std::vector<std::string>& deleted) {
       for (auto& listener : listeners_.accessAllThreads()) {
@@ -659,7 +808,7 @@ void ThriftHandler::addUnicastRoutesInVrf(
   auto clientName = apache::thrift::util::enumNameSafe(ClientID(client));
   auto log = LOG_THRIFT_CALL(DBG1, clientName);
   ensureConfigured(__func__);
-  updateUnicastRoutesImpl(vrf, client, routes, "addUnicastRoutesInVrf", false);
+  addUnicastRoutesAsync(client, std::move(routes), vrf).get();
 }
 
 void ThriftHandler::addUnicastRoutes(
@@ -684,14 +833,7 @@ void ThriftHandler::deleteUnicastRoutesInVrf(
   auto clientName = apache::thrift::util::enumNameSafe(ClientID(client));
   auto log = LOG_THRIFT_CALL(DBG1, clientName);
   ensureConfigured(__func__);
-
-  auto updater = sw_->getRouteUpdater();
-  auto routerID = RouterID(vrf);
-  auto clientID = ClientID(client);
-  for (const auto& prefix : *prefixes) {
-    updater.delRoute(routerID, prefix, clientID);
-  }
-  updater.program();
+  deleteUnicastRoutesAsync(client, std::move(prefixes), vrf).get();
 }
 
 void ThriftHandler::deleteUnicastRoutes(
@@ -743,6 +885,102 @@ void ThriftHandler::syncFib(
   syncFibInVrf(client, std::move(routes), 0);
 }
 
+void ThriftHandler::async_tm_addUnicastRoutes(
+    ThriftCallback<void> callback,
+    int16_t client,
+    std::unique_ptr<std::vector<UnicastRoute>> routes) {
+  async_tm_addUnicastRoutesInVrf(
+      std::move(callback), client, std::move(routes), 0);
+}
+
+void ThriftHandler::async_tm_deleteUnicastRoutes(
+    ThriftCallback<void> callback,
+    int16_t client,
+    std::unique_ptr<std::vector<IpPrefix>> prefixes) {
+  async_tm_deleteUnicastRoutesInVrf(
+      std::move(callback), client, std::move(prefixes), 0);
+}
+
+void ThriftHandler::async_tm_addUnicastRoutesInVrf(
+    ThriftCallback<void> callback,
+    int16_t client,
+    std::unique_ptr<std::vector<UnicastRoute>> routes,
+    int32_t vrf) {
+  auto clientName = apache::thrift::util::enumNameSafe(ClientID(client));
+  auto log = LOG_THRIFT_CALL(DBG1, clientName);
+  try {
+    ensureConfigured(__func__);
+  } catch (const std::exception&) {
+    if (log) {
+      log->markFailed();
+    }
+    callback->exception(std::current_exception());
+    return;
+  }
+  // Log and time the call until the routes are programmed, not until the
+  // request is queued
+  completeRouteUpdate(
+      std::move(callback),
+      wrapFuture(
+          std::move(log),
+          addUnicastRoutesAsync(client, std::move(routes), vrf)));
+}
+
+void ThriftHandler::async_tm_deleteUnicastRoutesInVrf(
+    ThriftCallback<void> callback,
+    int16_t client,
+    std::unique_ptr<std::vector<IpPrefix>> prefixes,
+    int32_t vrf) {
+  auto clientName = apache::thrift::util::enumNameSafe(ClientID(client));
+  auto log = LOG_THRIFT_CALL(DBG1, clientName);
+  try {
+    ensureConfigured(__func__);
+  } catch (const std::exception&) {
+    if (log) {
+      log->markFailed();
+    }
+    callback->exception(std::current_exception());
+    return;
+  }
+  completeRouteUpdate(
+      std::move(callback),
+      wrapFuture(
+          std::move(log),
+          deleteUnicastRoutesAsync(client, std::move(prefixes), vrf)));
+}
+
+folly::Future<folly::Unit> ThriftHandler::addUnicastRoutesAsync(
+    int16_t client,
+    std::unique_ptr<std::vector<UnicastRoute>> routes,
+    int32_t vrf) {
+  return routeUpdateBatcher_
+      ->addRoutes(RouterID(vrf), ClientID(client), std::move(*routes))
+      .thenError(
+          folly::tag_t<FbossHwUpdateError>{},
+          [](const FbossHwUpdateError& ex) { translateToFibError(ex); });
+}
+
+folly::Future<folly::Unit> ThriftHandler::deleteUnicastRoutesAsync(
+    int16_t client,
+    std::unique_ptr<std::vector<IpPrefix>> prefixes,
+    int32_t vrf) {
+  return routeUpdateBatcher_->delRoutes(
+      RouterID(vrf), ClientID(client), std::move(*prefixes));
+}
+
+void ThriftHandler::completeRouteUpdate(
+    ThriftCallback<void> callback,
+    folly::Future<folly::Unit> update) {
+  std::move(update).thenTry(
+      [callback = std::move(callback)](folly::Try<folly::Unit>&& result) {
+        if (result.hasException()) {
+          callback->exception(std::move(result.exception()));
+        } else {
+          callback->done();
+        }
+      });
+}
+
 void ThriftHandler::updateUnicastRoutesImpl(
     int32_t vrf,
     int16_t client,
@@ -1057,8 +1295,12 @@ void ThriftHandler::getCurrentStateJSON(
   if (!jsonPtr) {
     throw FbossError("Malformed JSON Pointer");
   }
-  auto swState = sw_->getState()->toFollyDynamic();
-  auto dyn = swState.get_ptr(jsonPtr.value());
+  // Only serialize the addressed subtree, not the entire state
+  auto dyn =
+      sw_->getState()->toFollyDynamicAt(folly::range(jsonPtr.value().tokens()));
+  if (!dyn) {
+    throw FbossError("JSON Pointer does not address proper object");
+  }
   ret = folly::json::serialize(*dyn, folly::json::serialization_opts{});
 }
 
@@ -1074,16 +1316,12 @@ void ThriftHandler::patchCurrentStateJSON(
   if (!jsonPtr) {
     throw FbossError("Malformed JSON Pointer");
   }
+  auto patch = folly::parseJson(*jsonPatchStr);
   // OK to capture by reference because the update call below is blocking
   auto updateFn = [&](const shared_ptr<SwitchState>& oldState) {
-    auto fullDynamic = oldState->toFollyDynamic();
-    auto* partialDynamic = fullDynamic.get_ptr(jsonPtr.value());
-    if (!partialDynamic) {
-      throw FbossError("JSON Pointer does not address proper object");
-    }
-    // mutates in place, i.e. modifies fullDynamic too
-    partialDynamic->merge_patch(folly::parseJson(*jsonPatchStr));
-    return SwitchState::fromFollyDynamic(fullDynamic);
+    // Only clones the nodes along the path, the rest is shared with oldState
+    return oldState->mergePatchAt(
+        folly::range(jsonPtr.value().tokens()), patch);
   };
   sw_->updateStateBlocking("JSON patch", std::move(updateFn));
 }
@@ -1357,22 +1595,9 @@ void ThriftHandler::getRouteTable(std::vector<UnicastRoute>& routes) {
   ensureConfigured(__func__);
   auto state = sw_->getState();
   forAllRoutes(state, [&routes](RouterID /*rid*/, const auto& route) {
-    UnicastRoute tempRoute;
-    if (!route->isResolved()) {
-      XLOG(INFO) << "Skipping unresolved route: " << route->toFollyDynamic();
-      return;
-    }
-    auto fwdInfo = route->getForwardInfo();
-    tempRoute.dest_ref()->ip_ref() = toBinaryAddress(route->prefix().network);
-    tempRoute.dest_ref()->prefixLength_ref() = route->prefix().mask;
-    tempRoute.nextHopAddrs_ref() =
-        util::fromFwdNextHops(fwdInfo.getNextHopSet());
-    tempRoute.nextHops_ref() =
-        util::fromRouteNextHopSet(fwdInfo.normalizedNextHops());
-    if (fwdInfo.getCounterID().has_value()) {
-      tempRoute.counterID_ref() = *fwdInfo.getCounterID();
+    if (auto tempRoute = toUnicastRoute(route)) {
+      routes.emplace_back(std::move(*tempRoute));
     }
-    routes.emplace_back(std::move(tempRoute));
   });
 }
 
@@ -1383,22 +1608,9 @@ void ThriftHandler::getRouteTableByClient(
   ensureConfigured(__func__);
   auto state = sw_->getState();
   forAllRoutes(state, [&routes, client](RouterID /*rid*/, const auto& route) {
-    auto entry = route->getEntryForClient(ClientID(client));
-    if (not entry) {
-      return;
-    }
-    UnicastRoute tempRoute;
-    tempRoute.dest_ref()->ip_ref() = toBinaryAddress(route->prefix().network);
-    tempRoute.dest_ref()->prefixLength_ref() = route->prefix().mask;
-    tempRoute.nextHops_ref() =
-        util::fromRouteNextHopSet(entry->getNextHopSet());
-    if (entry->getCounterID().has_value()) {
-      tempRoute.counterID_ref() = *entry->getCounterID();
+    if (auto tempRoute = toUnicastRoute(route, ClientID(client))) {
+      routes.emplace_back(std::move(*tempRoute));
     }
-    for (const auto& nh : *tempRoute.nextHops_ref()) {
-      tempRoute.nextHopAddrs_ref()->emplace_back(*nh.address_ref());
-    }
-    routes.emplace_back(std::move(tempRoute));
   });
 }
 
@@ -1410,6 +1622,97 @@ void ThriftHandler::getRouteTableDetails(std::vector<RouteDetails>& routes) {
   });
 }
 
+apache::thrift::ServerStream<UnicastRoutePage> ThriftHandler::streamRouteTable(
+    std::unique_ptr<RouteTableFilter> filter,
+    int32_t pageSize) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  std::optional<ClientID> client;
+  if (filter->clientId_ref()) {
+    client = ClientID(*filter->clientId_ref());
+  }
+  return streamRoutePages<UnicastRoutePage>(
+      makeRouteTablePager(sw_->getState(), *filter),
+      pageSize,
+      sw_->getRouteChangeTracker()->getRunId(),
+      [client](auto& routes, RouterID /*rid*/, const auto& route) {
+        auto tempRoute =
+            client ? toUnicastRoute(route, *client) : toUnicastRoute(route);
+        if (!tempRoute) {
+          return false;
+        }
+        routes.emplace_back(std::move(*tempRoute));
+        return true;
+      });
+}
+
+apache::thrift::ServerStream<RouteDetailsPage>
+ThriftHandler::streamRouteTableDetails(
+    std::unique_ptr<RouteTableFilter> filter,
+    int32_t pageSize) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  return streamRoutePages<RouteDetailsPage>(
+      makeRouteTablePager(sw_->getState(), *filter),
+      pageSize,
+      sw_->getRouteChangeTracker()->getRunId(),
+      [filter = *filter](auto& routes, RouterID /*rid*/, const auto& route) {
+        if (!matchesClient(route, filter)) {
+          return false;
+        }
+        routes.emplace_back(route->toRouteDetails(true));
+        return true;
+      });
+}
+
+void ThriftHandler::getRouteTableChangesSince(
+    RouteTableChanges& changes,
+    int64_t generation,
+    std::unique_ptr<RouteTableFilter> filter,
+    int64_t runId) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  auto tracker = sw_->getRouteChangeTracker();
+  auto tracked = tracker->getChangesSince(runId, generation);
+  auto state = tracked.state ? tracked.state : sw_->getState();
+  changes.generation_ref() = state->getGeneration();
+  changes.runId_ref() = tracker->getRunId();
+  if (!tracked.prefixes) {
+    changes.fullSyncRequired_ref() = true;
+    return;
+  }
+  changes.fullSyncRequired_ref() = false;
+  auto vrf = getFilterVrf(*filter);
+  auto filterPrefix = getFilterPrefix(*filter);
+  for (const auto& [rid, prefix] : *tracked.prefixes) {
+    if (vrf && rid != *vrf) {
+      continue;
+    }
+    if (filterPrefix &&
+        !RouteTablePager::contains(
+            *filterPrefix, prefix.first, prefix.second)) {
+      continue;
+    }
+    // Routes no longer in the filtered table (e.g. the client's entry was
+    // removed but others remain) are reported as removed.
+    auto addRoute = [&](const auto& route) {
+      if (route && matchesClient(route, *filter)) {
+        changes.changedRoutes_ref()->emplace_back(route->toRouteDetails(true));
+      } else {
+        IpPrefix removed;
+        removed.ip_ref() = toBinaryAddress(prefix.first);
+        removed.prefixLength_ref() = prefix.second;
+        changes.removedRoutes_ref()->emplace_back(std::move(removed));
+      }
+    };
+    if (prefix.first.isV4()) {
+      addRoute(findRoute<folly::IPAddressV4>(rid, prefix, state));
+    } else {
+      addRoute(findRoute<folly::IPAddressV6>(rid, prefix, state));
+    }
+  }
+}
+
 void ThriftHandler::getIpRoute(
     UnicastRoute& route,
     std::unique_ptr<Address> addr,
@@ -2134,6 +2437,21 @@ void ThriftHandler::getHwDebugDump(std::string& out) {
   out = sw_->getHw()->getDebugDump();
 }
 
+void ThriftHandler::getStateUpdateTraces(
+    std::vector<StateUpdateTrace>& traces) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  for (const auto& trace : sw_->getStateUpdateTracer()->getTraces()) {
+    traces.push_back(trace.toThrift());
+  }
+}
+
+void ThriftHandler::getAgentMemoryUsage(MemoryUsageReport& report) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  report = sw_->getMemoryUsage();
+}
+
 void ThriftHandler::getPlatformMapping(cfg::PlatformMapping& ret) {
   ret = sw_->getPlatform()->getPlatformMapping()->toThrift();
 }
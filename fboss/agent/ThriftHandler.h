@@ -16,6 +16,7 @@
 
 #include "common/fb303/cpp/FacebookBase2.h"
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/RouteUpdateBatcher.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/if/gen-cpp2/FbossCtrl.h"
 #include "fboss/agent/if/gen-cpp2/NeighborListenerClient.h"
@@ -97,6 +98,30 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
       std::unique_ptr<std::vector<UnicastRoute>> routes,
       int32_t vrf) override;
 
+  /*
+   * Route updates complete once programmed, without holding a Thrift
+   * thread meanwhile. Updates from concurrent clients are programmed
+   * together, see RouteUpdateBatcher.
+   */
+  void async_tm_addUnicastRoutes(
+      ThriftCallback<void> callback,
+      int16_t client,
+      std::unique_ptr<std::vector<UnicastRoute>> routes) override;
+  void async_tm_deleteUnicastRoutes(
+      ThriftCallback<void> callback,
+      int16_t client,
+      std::unique_ptr<std::vector<IpPrefix>> prefixes) override;
+  void async_tm_addUnicastRoutesInVrf(
+      ThriftCallback<void> callback,
+      int16_t client,
+      std::unique_ptr<std::vector<UnicastRoute>> routes,
+      int32_t vrf) override;
+  void async_tm_deleteUnicastRoutesInVrf(
+      ThriftCallback<void> callback,
+      int16_t client,
+      std::unique_ptr<std::vector<IpPrefix>> prefixes,
+      int32_t vrf) override;
+
   /* MPLS routes */
   void addMplsRoutes(
       int16_t clientId,
@@ -123,6 +148,10 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
     return sw_;
   }
 
+  const RouteUpdateBatcher* getRouteUpdateBatcher() const {
+    return routeUpdateBatcher_.get();
+  }
+
   void sendPkt(
       int32_t port,
       int32_t vlan,
@@ -165,6 +194,17 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
       std::vector<UnicastRoute>& routeTable,
       int16_t clientId) override;
   void getRouteTableDetails(std::vector<RouteDetails>& routeTable) override;
+  apache::thrift::ServerStream<UnicastRoutePage> streamRouteTable(
+      std::unique_ptr<RouteTableFilter> filter,
+      int32_t pageSize) override;
+  apache::thrift::ServerStream<RouteDetailsPage> streamRouteTableDetails(
+      std::unique_ptr<RouteTableFilter> filter,
+      int32_t pageSize) override;
+  void getRouteTableChangesSince(
+      RouteTableChanges& changes,
+      int64_t generation,
+      std::unique_ptr<RouteTableFilter> filter,
+      int64_t runId) override;
 
   void getPortStatus(
       std::map<int32_t, PortStatus>& status,
@@ -325,6 +365,8 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
       override;
 
   void getHwDebugDump(std::string& out) override;
+  void getStateUpdateTraces(std::vector<StateUpdateTrace>& traces) override;
+  void getAgentMemoryUsage(MemoryUsageReport& report) override;
   void listHwObjects(
       std::string& out,
       std::unique_ptr<std::vector<HwObjectType>> hwObjects,
@@ -362,6 +404,17 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
       ThreadLocalListener* info,
       std::vector<std::string> added,
       std::vector<std::string> deleted);
+  folly::Future<folly::Unit> addUnicastRoutesAsync(
+      int16_t client,
+      std::unique_ptr<std::vector<UnicastRoute>> routes,
+      int32_t vrf);
+  folly::Future<folly::Unit> deleteUnicastRoutesAsync(
+      int16_t client,
+      std::unique_ptr<std::vector<IpPrefix>> prefixes,
+      int32_t vrf);
+  void completeRouteUpdate(
+      ThriftCallback<void> callback,
+      folly::Future<folly::Unit> update);
   void updateUnicastRoutesImpl(
       int32_t vrf,
       int16_t client,
@@ -401,6 +454,8 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
   apache::thrift::SSLPolicy sslPolicy_;
 
   std::unordered_set<uint16_t> syncedFibClients;
+
+  std::unique_ptr<RouteUpdateBatcher> routeUpdateBatcher_;
 };
 
 } // namespace facebook::fboss
@@ -0,0 +1,39 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/TxPacketTemplate.h"
+
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/TxPacket.h"
+
+#include <cstring>
+
+namespace facebook::fboss {
+
+std::unique_ptr<TxPacket> TxPacketTemplate::allocatePacket(
+    SwSwitch* sw) const {
+  auto pkt = sw->allocatePacket(bytes_.size());
+  if (!pkt) {
+    return pkt;
+  }
+  CHECK_GE(pkt->buf()->length(), bytes_.size());
+  memcpy(pkt->buf()->writableData(), bytes_.data(), bytes_.size());
+  return pkt;
+}
+
+void TxPacketTemplate::patch(
+    TxPacket* pkt,
+    uint32_t offset,
+    folly::ByteRange bytes) {
+  auto buf = pkt->buf();
+  CHECK_LE(offset + bytes.size(), buf->length());
+  memcpy(buf->writableData() + offset, bytes.data(), bytes.size());
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/Synchronized.h>
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace facebook::fboss {
+
+class SwSwitch;
+class TxPacket;
+
+/*
+ * The serialized bytes of a packet that is sent over and over with only a
+ * few fields changing, e.g. the target address of ARP requests.
+ *
+ * Sending one copies the bytes into a new TxPacket and patches the fields
+ * that change, instead of writing every header field by field.
+ */
+class TxPacketTemplate {
+ public:
+  /*
+   * Create a template of the given length, written by calling
+   * serialize(folly::io::RWPrivateCursor*). Bytes it doesn't write are 0.
+   */
+  template <typename SerializeFn>
+  TxPacketTemplate(uint32_t length, SerializeFn&& serialize)
+      : bytes_(length, 0) {
+    auto buf = folly::IOBuf::wrapBufferAsValue(bytes_.data(), bytes_.size());
+    folly::io::RWPrivateCursor cursor(&buf);
+    serialize(&cursor);
+  }
+
+  /*
+   * Allocate a packet holding a copy of the template, or nullptr if no
+   * packet could be allocated.
+   */
+  std::unique_ptr<TxPacket> allocatePacket(SwSwitch* sw) const;
+
+  /*
+   * Overwrite the bytes at offset in a packet allocated from a template.
+   */
+  static void patch(TxPacket* pkt, uint32_t offset, folly::ByteRange bytes);
+
+  folly::ByteRange bytes() const {
+    return folly::ByteRange(bytes_.data(), bytes_.size());
+  }
+
+  uint32_t length() const {
+    return bytes_.size();
+  }
+
+ private:
+  std::vector<uint8_t> bytes_;
+};
+
+/*
+ * Templates of one kind of packet, keyed by the values they are built from
+ * (VLAN, source addresses, ...). This can be used from any thread.
+ *
+ * Templates aren't expired one by one: the cache is emptied once it holds
+ * maxSize of them, which only happens when the values they are built from
+ * keep changing.
+ */
+template <typename Key, typename Template>
+class TxPacketTemplateCache {
+ public:
+  explicit TxPacketTemplateCache(size_t maxSize = 1024) : maxSize_(maxSize) {}
+
+  /*
+   * Get the template for key, calling create() to build it on a miss.
+   */
+  template <typename CreateFn>
+  std::shared_ptr<const Template> get(const Key& key, CreateFn&& create) {
+    {
+      auto templates = templates_.rlock();
+      auto it = templates->find(key);
+      if (it != templates->end()) {
+        return it->second;
+      }
+    }
+    std::shared_ptr<const Template> tmpl = create();
+    auto templates = templates_.wlock();
+    if (templates->size() >= maxSize_) {
+      templates->clear();
+    }
+    templates->emplace(key, tmpl);
+    return tmpl;
+  }
+
+  void clear() {
+    templates_.wlock()->clear();
+  }
+
+  size_t size() const {
+    return templates_.rlock()->size();
+  }
+
+ private:
+  const size_t maxSize_;
+  folly::Synchronized<std::map<Key, std::shared_ptr<const Template>>>
+      templates_;
+};
+
+} // namespace facebook::fboss
@@ -278,6 +278,17 @@ void BcmAclEntry::createAclQualifiers() {
 }
 
 void BcmAclEntry::createAclActions() {
+  programAclActions();
+  auto action = acl_->getAclAction();
+  if (action) {
+    if (action.value().getTrafficCounter()) {
+      createAclStat();
+    }
+    applyAclMirrorAction(this, action);
+  }
+}
+
+void BcmAclEntry::programAclActions() {
   int rv;
   const auto& act = acl_->getActionType();
   // add action to the entry
@@ -324,13 +335,80 @@ void BcmAclEntry::createAclActions() {
           hw_->getUnit(), handle_, bcmFieldActionDscpNew, dscpValue, 0);
       bcmCheckError(rv, "failed to add set dscp field action");
     }
-    if (action.value().getTrafficCounter()) {
-      createAclStat();
+  }
+}
+
+/*
+ * Undo programAclActions(). The params of each action must match the ones
+ * it was added with.
+ */
+void BcmAclEntry::removeAclActions() {
+  int rv;
+  if (acl_->getActionType() == cfg::AclActionType::DENY) {
+    rv = bcm_field_action_delete(
+        hw_->getUnit(), handle_, bcmFieldActionDrop, 0, 0);
+    bcmCheckError(rv, "failed to delete drop field action");
+  }
+
+  auto action = acl_->getAclAction();
+  if (!action) {
+    return;
+  }
+  if (action.value().getSendToQueue()) {
+    auto [queueMatchAction, sendToCPU] =
+        action.value().getSendToQueue().value();
+    bcm_field_action_t actionToDelete = bcmFieldActionCosQNew;
+    if (sendToCPU) {
+      rv = bcm_field_action_delete(
+          hw_->getUnit(), handle_, bcmFieldActionCopyToCpu, 0, 0);
+      bcmCheckError(rv, "failed to delete send to CPU action");
+      actionToDelete = bcmFieldActionCosQCpuNew;
     }
-    applyAclMirrorAction(this, action);
+    rv = bcm_field_action_delete(
+        hw_->getUnit(),
+        handle_,
+        actionToDelete,
+        *queueMatchAction.queueId_ref(),
+        0);
+    bcmCheckError(rv, "failed to delete set queue field action");
+  }
+  if (action.value().getSetDscp()) {
+    const int dscpValue =
+        *action.value().getSetDscp().value().dscpValue_ref();
+    rv = bcm_field_action_delete(
+        hw_->getUnit(), handle_, bcmFieldActionDscpNew, dscpValue, 0);
+    bcmCheckError(rv, "failed to delete set dscp field action");
   }
 }
 
+void BcmAclEntry::updateAclActions(const std::shared_ptr<AclEntry>& newAcl) {
+  CHECK(acl_->hasSameMatchers(*newAcl));
+  auto getCounter = [](const std::shared_ptr<AclEntry>& acl) {
+    auto action = acl->getAclAction();
+    return action ? action->getTrafficCounter() : std::nullopt;
+  };
+  bool sameCounter = getCounter(acl_) == getCounter(newAcl);
+
+  // Action and stat changes only take effect when the entry is reinstalled,
+  // so traffic keeps hitting the old actions until then. BcmMirror installs
+  // mirror changes right away.
+  removeAclMirrorActions();
+  if (!sameCounter) {
+    removeAclStat();
+  }
+  removeAclActions();
+
+  acl_ = newAcl;
+  programAclActions();
+  if (!sameCounter) {
+    createAclStat();
+  }
+  applyAclMirrorAction(this, acl_->getAclAction());
+
+  auto rv = bcm_field_entry_reinstall(hw_->getUnit(), handle_);
+  bcmCheckError(rv, "failed to reinstall acl entry ", acl_->getID());
+}
+
 void BcmAclEntry::createAclStat() {
   auto action = acl_->getAclAction();
   if (!action || !action->getTrafficCounter()) {
@@ -400,11 +478,18 @@ BcmAclEntry::BcmAclEntry(
 }
 
 BcmAclEntry::~BcmAclEntry() {
-  int rv;
-  auto aclTable = hw_->writableAclTable();
+  // Remove any mirroring action. This must be done before destroying the ACL.
+  removeAclMirrorActions();
+  // Detach and remove the stat. This must be done before destroying the ACL.
+  removeAclStat();
+
+  // Destroy the ACL entry
+  auto rv = bcm_field_entry_destroy(hw_->getUnit(), handle_);
+  bcmLogFatal(rv, hw_, "failed to destroy the acl entry");
+}
 
+void BcmAclEntry::removeAclMirrorActions() {
   auto action = acl_->getAclAction();
-  // Remove any mirroring action. This must be done before destroying the ACL.
   if (action && action.value().getEgressMirror()) {
     applyMirrorAction(
         action.value().getEgressMirror().value(),
@@ -417,17 +502,18 @@ BcmAclEntry::~BcmAclEntry() {
         MirrorAction::STOP,
         MirrorDirection::INGRESS);
   }
-  // Detach and remove the stat. This must be done before destroying the ACL.
-  if (action && action.value().getTrafficCounter()) {
-    auto counterName = *action->getTrafficCounter()->name_ref();
-    auto aclStat = aclTable->getAclStat(counterName);
-    aclStat->detach(handle_);
-    aclTable->derefBcmAclStat(counterName);
-  }
+}
 
-  // Destroy the ACL entry
-  rv = bcm_field_entry_destroy(hw_->getUnit(), handle_);
-  bcmLogFatal(rv, hw_, "failed to destroy the acl entry");
+void BcmAclEntry::removeAclStat() {
+  auto action = acl_->getAclAction();
+  if (!action || !action->getTrafficCounter()) {
+    return;
+  }
+  auto aclTable = hw_->writableAclTable();
+  auto counterName = *action->getTrafficCounter()->name_ref();
+  auto aclStat = aclTable->getAclStat(counterName);
+  aclStat->detach(handle_);
+  aclTable->derefBcmAclStat(counterName);
 }
 
 bool BcmAclEntry::isStateSame(
@@ -51,11 +51,23 @@ class BcmAclEntry {
       MirrorAction action,
       MirrorDirection direction);
 
+  /*
+   * Reprogram the actions, counter and mirrors of the installed entry to the
+   * ones of newAcl, which must have the same matchers and priority. The
+   * entry keeps matching traffic throughout, and an unchanged counter keeps
+   * its value.
+   */
+  void updateAclActions(const std::shared_ptr<AclEntry>& newAcl);
+
  private:
   void createNewAclEntry();
   void createAclQualifiers();
   void createAclActions();
+  void programAclActions();
+  void removeAclActions();
   void createAclStat();
+  void removeAclStat();
+  void removeAclMirrorActions();
 
   BcmSwitch* hw_;
   int gid_;
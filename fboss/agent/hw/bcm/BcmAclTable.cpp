@@ -53,6 +53,33 @@ void BcmAclTable::processRemovedAcl(const std::shared_ptr<AclEntry>& acl) {
   }
 }
 
+void BcmAclTable::processChangedAcl(
+    const int groupId,
+    const std::shared_ptr<AclEntry>& oldAcl,
+    const std::shared_ptr<AclEntry>& newAcl) {
+  auto iter = aclEntryMap_.find(oldAcl->getPriority());
+  if (iter == aclEntryMap_.end()) {
+    throw FbossError("ACL=", oldAcl->getID(), " does not exist");
+  }
+  if (oldAcl->hasSameMatchers(*newAcl)) {
+    iter->second->updateAclActions(newAcl);
+    return;
+  }
+
+  if (oldAcl->getPriority() == newAcl->getPriority()) {
+    // The old entry is only destroyed once the new one is installed
+    iter->second = std::make_unique<BcmAclEntry>(hw_, groupId, newAcl);
+    return;
+  }
+  if (aclEntryMap_.find(newAcl->getPriority()) != aclEntryMap_.end()) {
+    throw FbossError("ACL=", newAcl->getID(), " already exists");
+  }
+  aclEntryMap_.emplace(
+      newAcl->getPriority(),
+      std::make_unique<BcmAclEntry>(hw_, groupId, newAcl));
+  aclEntryMap_.erase(oldAcl->getPriority());
+}
+
 BcmAclEntry* FOLLY_NULLABLE BcmAclTable::getAclIf(int priority) const {
   auto iter = aclEntryMap_.find(priority);
   if (iter == aclEntryMap_.end()) {
@@ -33,6 +33,15 @@ class BcmAclTable {
   ~BcmAclTable() {}
   void processAddedAcl(const int groupId, const std::shared_ptr<AclEntry>& acl);
   void processRemovedAcl(const std::shared_ptr<AclEntry>& acl);
+  /*
+   * Entries that only change actions are updated in place. Otherwise the new
+   * entry is installed before the old one is destroyed, so matching traffic
+   * always hits one of them.
+   */
+  void processChangedAcl(
+      const int groupId,
+      const std::shared_ptr<AclEntry>& oldAcl,
+      const std::shared_ptr<AclEntry>& newAcl);
   void releaseAcls();
 
   // Throw exception if not found
@@ -15,7 +15,9 @@
 
 #include <fcntl.h>
 #include <ifaddrs.h>
+#include <sys/socket.h>
 
+#include <fb303/ServiceData.h>
 #include <folly/Range.h>
 #include <folly/logging/xlog.h>
 #include <glog/logging.h>
@@ -24,10 +26,34 @@
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/Utils.h"
+
+DEFINE_int32(
+    sflow_export_queue_size,
+    4096,
+    "Number of sFlow samples that can be queued for export before new "
+    "samples are dropped");
+DEFINE_int32(
+    sflow_samples_per_datagram,
+    1,
+    "Max number of sFlow samples to pack in a single datagram. Values "
+    "greater than 1 export SflowPacketInfoBatch instead of SflowPacketInfo");
 
 using namespace std;
 
 namespace {
+// Max samples drained from the queue in one pass of the export thread
+constexpr size_t kMaxSamplesPerExport = 256;
+// Stay well clear of IP fragmentation towards remote collectors
+constexpr size_t kMaxSflowDatagramBytes = 1400;
+// Serialized SflowPacketInfo size, not counting the packet data
+constexpr size_t kSflowSampleOverheadBytes = 64;
+
+constexpr auto kSflowSamplesExported = "sflow.samples_exported";
+constexpr auto kSflowSamplesDropped = "sflow.samples_dropped";
+constexpr auto kSflowDatagramsSent = "sflow.datagrams_sent";
+constexpr auto kSflowSendErrors = "sflow.send_errors";
+
 std::optional<folly::IPAddress> getLocalIPv6FromWhoAmI() {
   const std::string whoAmIFn = "/etc/fbwhoami";
   const std::string key = "DEVICE_PRIMARY_IPV6";
@@ -163,6 +189,8 @@ BcmSflowExporter::BcmSflowExporter(const folly::SocketAddress& address)
         ": ",
         folly::errnoStr(errno));
   }
+
+  addrLen_ = address_.getAddress(&addrStorage_);
 }
 
 ssize_t BcmSflowExporter::sendUDPDatagram(iovec* vec, const size_t iovec_len) {
@@ -189,26 +217,69 @@ ssize_t BcmSflowExporter::sendUDPDatagram(iovec* vec, const size_t iovec_len) {
   return ret;
 }
 
+int BcmSflowExporter::sendUDPDatagrams(std::vector<iovec>& vecs) {
+  XLOG(DBG4) << "Sending " << vecs.size() << " sFlow packets to "
+             << address_.describe();
+
+  std::vector<mmsghdr> msgs(vecs.size());
+  for (size_t i = 0; i < vecs.size(); ++i) {
+    auto& msg = msgs[i].msg_hdr;
+    msg.msg_name = reinterpret_cast<void*>(&addrStorage_);
+    msg.msg_namelen = addrLen_;
+    msg.msg_iov = &vecs[i];
+    msg.msg_iovlen = 1;
+  }
+  auto ret = ::sendmmsg(socket_, msgs.data(), msgs.size(), 0);
+  if (ret < 0) {
+    XLOG(DBG1) << "Failed sending sFlow packets to " << address_.describe()
+               << " reason: " << folly::errnoStr(errno);
+  }
+  XLOG(DBG4) << "Sent " << ret << " sFlow packets to " << address_.describe();
+  return ret;
+}
+
 BcmSflowExporter::~BcmSflowExporter() {
   if (socket_ != -1) {
     close(socket_);
   }
 }
 
+BcmSflowExporterTable::BcmSflowExporterTable()
+    : queue_(FLAGS_sflow_export_queue_size) {}
+
+BcmSflowExporterTable::~BcmSflowExporterTable() {
+  if (!exportThread_) {
+    return;
+  }
+  exiting_ = true;
+  // Wake up the export thread in case it is waiting on an empty queue
+  queue_.blockingWrite(SflowPacketInfo());
+  exportThread_->join();
+}
+
 bool BcmSflowExporterTable::contains(
     const shared_ptr<SflowCollector>& c) const {
-  auto iter = map_.find(c->getID());
-  return iter != map_.end();
+  auto map = map_.rlock();
+  return map->find(c->getID()) != map->end();
 }
 
 size_t BcmSflowExporterTable::size() const {
-  return map_.size();
+  return map_.rlock()->size();
 }
 
 void BcmSflowExporterTable::addExporter(const shared_ptr<SflowCollector>& c) {
   try {
-    auto exporter = make_unique<BcmSflowExporter>(c->getAddress());
-    map_.emplace(c->getID(), move(exporter));
+    auto exporter = make_shared<BcmSflowExporter>(c->getAddress());
+    auto map = map_.wlock();
+    map->emplace(c->getID(), move(exporter));
+    // Only switches with sFlow configured pay for the export thread
+    if (!exportThread_) {
+      exportThread_ = std::make_unique<std::thread>([this]() {
+        initThread("fbossSflowExport");
+        exportLoop();
+      });
+    }
+    numExporters_ = map->size();
   } catch (const fboss::thrift::FbossBaseError& ex) {
     XLOG(ERR) << "Could not add exporter: "
               << c->getAddress().getFullyQualified()
@@ -222,7 +293,9 @@ void BcmSflowExporterTable::addExporter(const shared_ptr<SflowCollector>& c) {
 
 void BcmSflowExporterTable::removeExporter(const std::string& id) {
   XLOG(INFO) << "Removed sFlow exporter " << id;
-  map_.erase(id);
+  auto map = map_.wlock();
+  map->erase(id);
+  numExporters_ = map->size();
 }
 
 void BcmSflowExporterTable::updateSamplingRates(
@@ -241,31 +314,125 @@ void BcmSflowExporterTable::updateSamplingRates(
   localIP_ = getLocalIPv6();
 }
 
-void BcmSflowExporterTable::sendToAll(const SflowPacketInfo& info) {
-  if (map_.empty()) {
+void BcmSflowExporterTable::sendToAll(SflowPacketInfo info) {
+  if (numExporters_.load(std::memory_order_relaxed) == 0) {
     XLOG(DBG1)
         << "zero sFlow collectors with sflow enabled, skipping sample export";
     return;
   }
-  // Serialize info to a string and wrap it in an IOBuf for sending
-  string output;
-  apache::thrift::BinarySerializer::serialize(info, &output);
-  auto buf = folly::IOBuf::wrapBuffer(output.data(), output.length());
-
-  // Map the IOBuf to a Linux iovec like a champ
-  iovec vec[16] = {};
-  size_t iovec_len = buf->fillIov(vec, sizeof(vec) / sizeof(vec[0])).numIovecs;
-  if (UNLIKELY(iovec_len == 0)) {
-    buf->coalesce();
-    vec[0].iov_base = const_cast<uint8_t*>(buf->data());
-    vec[0].iov_len = buf->length();
-    iovec_len = 1;
+  if (!queue_.write(std::move(info))) {
+    XLOG_EVERY_MS(DBG1, 1000) << "sFlow export queue full, dropping sample";
+    samplesDropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void BcmSflowExporterTable::exportLoop() {
+  std::vector<SflowPacketInfo> samples;
+  samples.reserve(kMaxSamplesPerExport);
+  while (true) {
+    SflowPacketInfo info;
+    queue_.blockingRead(info);
+    if (exiting_) {
+      break;
+    }
+    samples.push_back(std::move(info));
+    // Drain whatever else is already queued, so that a burst of samples
+    // goes out in as few datagrams and syscalls as possible.
+    while (samples.size() < kMaxSamplesPerExport && queue_.read(info)) {
+      samples.push_back(std::move(info));
+    }
+    exportSamples(samples);
+    samples.clear();
+  }
+}
+
+void BcmSflowExporterTable::serializeSamples(
+    std::vector<SflowPacketInfo>& samples,
+    std::vector<std::string>& datagrams) const {
+  size_t maxSamplesPerDatagram =
+      std::max(1, FLAGS_sflow_samples_per_datagram);
+  if (maxSamplesPerDatagram == 1) {
+    for (const auto& sample : samples) {
+      datagrams.emplace_back();
+      apache::thrift::BinarySerializer::serialize(sample, &datagrams.back());
+    }
+    return;
+  }
+
+  SflowPacketInfoBatch batch;
+  size_t batchBytes = 0;
+  auto flushBatch = [&]() {
+    if (batch.samples_ref()->empty()) {
+      return;
+    }
+    datagrams.emplace_back();
+    apache::thrift::BinarySerializer::serialize(batch, &datagrams.back());
+    batch.samples_ref()->clear();
+    batchBytes = 0;
+  };
+  for (auto& sample : samples) {
+    auto sampleBytes =
+        sample.packetData_ref()->size() + kSflowSampleOverheadBytes;
+    if (batch.samples_ref()->size() == maxSamplesPerDatagram ||
+        batchBytes + sampleBytes > kMaxSflowDatagramBytes) {
+      flushBatch();
+    }
+    batch.samples_ref()->push_back(std::move(sample));
+    batchBytes += sampleBytes;
   }
+  flushBatch();
+}
 
-  for (const auto& c : map_) {
-    // TODO: prob need to handle ret code?
-    c.second->sendUDPDatagram(vec, iovec_len);
+void BcmSflowExporterTable::exportSamples(
+    std::vector<SflowPacketInfo>& samples) {
+  auto numSamples = samples.size();
+  std::vector<std::string> datagrams;
+  serializeSamples(samples, datagrams);
+
+  // Don't hold the lock across the sends, or config changes adding and
+  // removing collectors would wait on the socket
+  std::vector<std::shared_ptr<BcmSflowExporter>> exporters;
+  {
+    auto map = map_.rlock();
+    exporters.reserve(map->size());
+    for (const auto& c : *map) {
+      exporters.push_back(c.second);
+    }
+  }
+  if (exporters.empty()) {
+    return;
   }
+  std::vector<iovec> vecs(datagrams.size());
+  for (const auto& exporter : exporters) {
+    // sendmmsg() may send only a subset of the datagrams, e.g. if the socket
+    // buffer fills up. Retry the remainder once before giving up.
+    size_t sent = 0;
+    for (auto attempt = 0; attempt < 2 && sent < datagrams.size(); ++attempt) {
+      vecs.resize(datagrams.size() - sent);
+      for (size_t i = 0; i < vecs.size(); ++i) {
+        auto& datagram = datagrams[sent + i];
+        vecs[i].iov_base = datagram.data();
+        vecs[i].iov_len = datagram.size();
+      }
+      auto ret = exporter->sendUDPDatagrams(vecs);
+      if (ret <= 0) {
+        break;
+      }
+      sent += ret;
+    }
+    datagramsSent_.fetch_add(sent, std::memory_order_relaxed);
+    if (sent < datagrams.size()) {
+      sendErrors_.fetch_add(datagrams.size() - sent, std::memory_order_relaxed);
+    }
+  }
+  samplesExported_.fetch_add(numSamples, std::memory_order_relaxed);
+}
+
+void BcmSflowExporterTable::publishStats() const {
+  fb303::fbData->setCounter(kSflowSamplesExported, getSamplesExported());
+  fb303::fbData->setCounter(kSflowSamplesDropped, getSamplesDropped());
+  fb303::fbData->setCounter(kSflowDatagramsSent, getDatagramsSent());
+  fb303::fbData->setCounter(kSflowSendErrors, getSendErrors());
 }
 
 } // namespace facebook::fboss
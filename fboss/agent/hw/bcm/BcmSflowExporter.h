@@ -9,15 +9,24 @@
  */
 #pragma once
 
+#include <atomic>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include <folly/IPAddress.h>
+#include <folly/MPMCQueue.h>
 #include <folly/SocketAddress.h>
+#include <folly/Synchronized.h>
+#include <gflags/gflags.h>
 
 #include "fboss/agent/if/gen-cpp2/sflow_types.h"
 #include "fboss/agent/state/SflowCollector.h"
 #include "fboss/agent/types.h"
 
+DECLARE_int32(sflow_export_queue_size);
+DECLARE_int32(sflow_samples_per_datagram);
+
 namespace facebook::fboss {
 
 class BcmSflowExporter {
@@ -35,19 +44,35 @@ class BcmSflowExporter {
    */
   ssize_t sendUDPDatagram(iovec* vec, const size_t iovec_len);
 
+  /*
+   * Send out multiple datagrams, one per iovec, with a single sendmmsg()
+   * call. Returns the number of datagrams sent, or -1 on error.
+   */
+  int sendUDPDatagrams(std::vector<iovec>& vecs);
+
  private:
   // no copy or assignment
   BcmSflowExporter(BcmSflowExporter const&) = delete;
   BcmSflowExporter& operator=(BcmSflowExporter const&) = delete;
 
   const folly::SocketAddress address_;
+  sockaddr_storage addrStorage_;
+  socklen_t addrLen_{0};
   int socket_{-1};
 };
 
+/*
+ * Samples are handed off from the RX thread to a dedicated export thread
+ * through a bounded queue, so that serializing and sending sFlow datagrams
+ * never runs in the packet RX path. If the export thread falls behind, new
+ * samples are dropped and accounted for in getSamplesDropped(). The export
+ * thread is started when the first collector is added.
+ */
+
 class BcmSflowExporterTable {
  public:
-  BcmSflowExporterTable() = default;
-  ~BcmSflowExporterTable() = default;
+  BcmSflowExporterTable();
+  ~BcmSflowExporterTable();
 
   bool contains(const std::shared_ptr<SflowCollector>& collector) const;
   size_t size() const;
@@ -56,14 +81,57 @@ class BcmSflowExporterTable {
 
   void updateSamplingRates(PortID id, int64_t inRate, int64_t outRate);
 
-  void sendToAll(const SflowPacketInfo& info);
+  /*
+   * Queue a sample for export to all collectors. Never blocks, safe to call
+   * from the RX thread.
+   */
+  void sendToAll(SflowPacketInfo info);
+
+  uint64_t getSamplesExported() const {
+    return samplesExported_.load(std::memory_order_relaxed);
+  }
+  uint64_t getSamplesDropped() const {
+    return samplesDropped_.load(std::memory_order_relaxed);
+  }
+  uint64_t getDatagramsSent() const {
+    return datagramsSent_.load(std::memory_order_relaxed);
+  }
+  uint64_t getSendErrors() const {
+    return sendErrors_.load(std::memory_order_relaxed);
+  }
+
+  void publishStats() const;
 
  private:
   // no copy or assignment
   BcmSflowExporterTable(BcmSflowExporterTable const&) = delete;
   BcmSflowExporterTable& operator=(BcmSflowExporterTable const&) = delete;
 
-  std::unordered_map<std::string, std::unique_ptr<BcmSflowExporter>> map_;
+  friend class BcmSflowExporterTableTest;
+
+  void exportLoop();
+  void exportSamples(std::vector<SflowPacketInfo>& samples);
+  void serializeSamples(
+      std::vector<SflowPacketInfo>& samples,
+      std::vector<std::string>& datagrams) const;
+
+  // Exporters are shared with the export thread, which sends to a snapshot
+  // of them without holding the lock
+  folly::Synchronized<
+      std::unordered_map<std::string, std::shared_ptr<BcmSflowExporter>>>
+      map_;
+  std::atomic<size_t> numExporters_{0};
+
+  folly::MPMCQueue<SflowPacketInfo> queue_;
+  std::atomic<bool> exiting_{false};
+  // Only accessed with map_ locked, or on destruction
+  std::unique_ptr<std::thread> exportThread_;
+
+  std::atomic<uint64_t> samplesExported_{0};
+  std::atomic<uint64_t> samplesDropped_{0};
+  std::atomic<uint64_t> datagramsSent_{0};
+  std::atomic<uint64_t> sendErrors_{0};
+
   std::unordered_map<
       PortID,
       std::pair<int64_t /* ingress rate */, int64_t /* egress rate */>>
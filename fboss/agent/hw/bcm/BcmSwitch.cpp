@@ -139,7 +139,9 @@ using std::chrono::seconds;
 
 using facebook::fboss::DeltaFunctions::forEachAdded;
 using facebook::fboss::DeltaFunctions::forEachChanged;
+using facebook::fboss::DeltaFunctions::forEachChangedInDeltas;
 using facebook::fboss::DeltaFunctions::forEachRemoved;
+using facebook::fboss::DeltaFunctions::onDelta;
 
 using folly::IPAddress;
 using folly::IPAddressV4;
@@ -1727,30 +1729,71 @@ bool BcmSwitch::isRouteUpdateValid(const StateDelta& delta) const {
 bool BcmSwitch::isValidStateUpdate(const StateDelta& delta) const {
   auto newState = delta.newState();
   auto isValid = true;
+  auto ignore = [](const auto&...) {};
+
+  // Validate the changed nodes of all the maps in one walk
+  forEachChangedInDeltas(
+      onDelta(
+          delta.getPortsDelta(),
+          [&](const shared_ptr<Port>& oldPort,
+              const shared_ptr<Port>& newPort) {
+            if (isValid && !isValidPortUpdate(oldPort, newPort, newState)) {
+              isValid = false;
+            }
+          },
+          ignore,
+          ignore),
+      onDelta(
+          delta.getMirrorsDelta(),
+          [&](const shared_ptr<Mirror>& /* oldMirror */,
+              const shared_ptr<Mirror>& newMirror) {
+            if (newMirror->getTruncate() &&
+                !getPlatform()->getAsic()->isSupported(
+                    HwAsic::Feature::MIRROR_PACKET_TRUNCATION)) {
+              XLOG(ERR) << "Mirror packet truncation is not supported on "
+                           "this platform";
+              isValid = false;
+            }
+          },
+          ignore,
+          ignore),
+      onDelta(
+          delta.getQosPoliciesDelta(),
+          [&](const std::shared_ptr<QosPolicy>& /* oldQosPolicy */,
+              const std::shared_ptr<QosPolicy>& newQosPolicy) {
+            isValid = isValid && BcmQosPolicyTable::isValid(newQosPolicy);
+          },
+          [&](const std::shared_ptr<QosPolicy>& qosPolicy) {
+            isValid = isValid && BcmQosPolicyTable::isValid(qosPolicy);
+          },
+          ignore),
+      onDelta(
+          delta.getLabelForwardingInformationBaseDelta(),
+          [&](const std::shared_ptr<LabelForwardingEntry>& /*oldEntry*/,
+              const std::shared_ptr<LabelForwardingEntry>& newEntry) {
+            isValid = isValid && isValidLabelForwardingEntry(newEntry.get());
+          },
+          [&](const std::shared_ptr<LabelForwardingEntry>& newEntry) {
+            isValid = isValid && isValidLabelForwardingEntry(newEntry.get());
+          },
+          ignore),
+      // Stopping at an invalid ACL doesn't stop the walk over other deltas
+      onDelta(
+          delta.getAclsDelta(),
+          [&](const shared_ptr<AclEntry>& /* oldAcl */,
+              const shared_ptr<AclEntry>& newAcl) {
+            isValid = isValid && hasValidAclMatcher(newAcl);
+            return isValid ? LoopAction::CONTINUE : LoopAction::BREAK;
+          },
+          [&](const shared_ptr<AclEntry>& addAcl) {
+            isValid = isValid && hasValidAclMatcher(addAcl);
+            return isValid ? LoopAction::CONTINUE : LoopAction::BREAK;
+          },
+          ignore));
 
-  forEachChanged(
-      delta.getPortsDelta(),
-      [&](const shared_ptr<Port>& oldPort, const shared_ptr<Port>& newPort) {
-        if (isValid && !isValidPortUpdate(oldPort, newPort, newState)) {
-          isValid = false;
-        }
-      });
   isValid = isValid &&
       (newState->getMirrors()->size() <= platform_->getAsic()->getMaxMirrors());
 
-  forEachChanged(
-      delta.getMirrorsDelta(),
-      [&](const shared_ptr<Mirror>& /* oldMirror */,
-          const shared_ptr<Mirror>& newMirror) {
-        if (newMirror->getTruncate() &&
-            !getPlatform()->getAsic()->isSupported(
-                HwAsic::Feature::MIRROR_PACKET_TRUNCATION)) {
-          XLOG(ERR)
-              << "Mirror packet truncation is not supported on this platform";
-          isValid = false;
-        }
-      });
-
   int sflowMirrorCount = 0;
   for (const auto& mirror : *(newState->getMirrors())) {
     if (mirror->type() == Mirror::Type::SFLOW) {
@@ -1762,50 +1805,10 @@ bool BcmSwitch::isValidStateUpdate(const StateDelta& delta) const {
     XLOG(ERR) << "More than one sflow mirrors configured";
     isValid = false;
   }
-  forEachAdded(
-      delta.getQosPoliciesDelta(),
-      [&](const std::shared_ptr<QosPolicy>& qosPolicy) {
-        isValid = isValid && BcmQosPolicyTable::isValid(qosPolicy);
-      });
-
-  forEachChanged(
-      delta.getQosPoliciesDelta(),
-      [&](const std::shared_ptr<QosPolicy>& oldQosPolicy,
-          const std::shared_ptr<QosPolicy>& newQosPolicy) {
-        isValid = isValid && BcmQosPolicyTable::isValid(newQosPolicy);
-      });
-
-  forEachChanged(
-      delta.getLabelForwardingInformationBaseDelta(),
-      [&](const std::shared_ptr<LabelForwardingEntry>& /*oldEntry*/,
-          const std::shared_ptr<LabelForwardingEntry>& newEntry) {
-        // changed Fn
-        isValid = isValid && isValidLabelForwardingEntry(newEntry.get());
-      },
-      [&](const std::shared_ptr<LabelForwardingEntry>& newEntry) {
-        // added Fn
-        isValid = isValid && isValidLabelForwardingEntry(newEntry.get());
-      },
-      [](const std::shared_ptr<LabelForwardingEntry>& /*oldEntry*/) {
-        // removed Fn
-      });
 
   isValid = isValid && isRouteUpdateValid<folly::IPAddressV4>(delta);
   isValid = isValid && isRouteUpdateValid<folly::IPAddressV6>(delta);
 
-  forEachChanged(
-      delta.getAclsDelta(),
-      [&](const shared_ptr<AclEntry>& /* oldAcl */,
-          const shared_ptr<AclEntry>& newAcl) {
-        isValid = isValid && hasValidAclMatcher(newAcl);
-        return isValid ? LoopAction::CONTINUE : LoopAction::BREAK;
-      },
-      [&](const shared_ptr<AclEntry>& addAcl) {
-        isValid = isValid && hasValidAclMatcher(addAcl);
-        return isValid ? LoopAction::CONTINUE : LoopAction::BREAK;
-      },
-      [&](const shared_ptr<AclEntry>& /* delAcl */) {});
-
   if (getPlatform()->getAsic()->isSupported(
           HwAsic::Feature::INGRESS_L3_INTERFACE)) {
     // default vlan l3 interface should not be created from port vlan config
@@ -2569,6 +2572,7 @@ void BcmSwitch::updateGlobalStats() {
   portTable_->updatePortStats();
   trunkTable_->updateStats();
   bcmStatUpdater_->updateStats();
+  sFlowExporterTable_->publishStats();
 
   auto now =
       std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
@@ -2587,6 +2591,17 @@ uint64_t BcmSwitch::getDeviceWatermarkBytes() const {
   return bstStatsMgr_->getDeviceWatermarkBytes();
 }
 
+MemoryUsageByType BcmSwitch::getMemoryUsage() {
+  std::lock_guard<std::mutex> g(lock_);
+  MemoryUsageByType usage;
+  if (warmBootCache_) {
+    for (const auto& [type, typeUsage] : warmBootCache_->getMemoryUsage()) {
+      usage["warmBootCache." + type] = typeUsage;
+    }
+  }
+  return usage;
+}
+
 bcm_if_t BcmSwitch::getDropEgressId() const {
   return platform_->getAsic()->getDefaultDropEgressID();
 }
@@ -3116,7 +3131,7 @@ bool BcmSwitch::handleSflowPacket(BcmPacketT& bcmPacket) noexcept {
              << *info.vlan_ref() << ',' << info.packetData_ref()->length()
              << ")\n";
 
-  sFlowExporterTable_->sendToAll(info);
+  sFlowExporterTable_->sendToAll(std::move(info));
 
   // If it is only here because of sFlow, we're done
   if (sampleOnly) {
@@ -3230,10 +3245,9 @@ void BcmSwitch::fetchL2Table(std::vector<L2EntryThrift>* l2Table) const {
 void BcmSwitch::processChangedAcl(
     const std::shared_ptr<AclEntry>& oldAcl,
     const std::shared_ptr<AclEntry>& newAcl) {
-  // Unfortunately, we cannot modify a field entry due to BCM limitation
   XLOG(DBG3) << "processChangedAcl, ACL=" << oldAcl->getID();
-  processRemovedAcl(oldAcl);
-  processAddedAcl(newAcl);
+  aclTable_->processChangedAcl(
+      platform_->getAsic()->getDefaultACLGroupID(), oldAcl, newAcl);
 }
 
 void BcmSwitch::processRemovedAcl(const std::shared_ptr<AclEntry>& acl) {
@@ -381,6 +381,8 @@ class BcmSwitch : public BcmSwitchIf {
 
   uint64_t getDeviceWatermarkBytes() const override;
 
+  MemoryUsageByType getMemoryUsage() override;
+
   /*
    * Wrapper functions to register and unregister a BCM event callbacks.  These
    * just forward the call.
@@ -740,6 +740,33 @@ std::string BcmWarmBootCache::toEgressId2WeightStr(
   return ss.str();
 }
 
+MemoryUsageByType BcmWarmBootCache::getMemoryUsage() const {
+  MemoryUsageByType usage;
+  usage["vlan"] = containerMemoryUsage(vlan2VlanInfo_);
+  usage["station"] = containerMemoryUsage(vlan2Station_);
+  usage["intf"] = containerMemoryUsage(vlanAndMac2Intf_);
+  usage["host"] = containerMemoryUsage(vrfIp2Host_);
+  usage["route"] = containerMemoryUsage(vrfPrefix2Route_);
+  usage["route"] += containerMemoryUsage(vrfAndIP2Route_);
+  usage["egress"] = containerMemoryUsage(egressId2Egress_);
+  usage["ecmp"] = containerMemoryUsage(egressIds2Ecmp_);
+  usage["tunnel"] = containerMemoryUsage(labelStackKey2TunnelId_);
+  usage["labelAction"] = containerMemoryUsage(label2LabelActions_);
+  usage["acl"] = containerMemoryUsage(priority2BcmAclEntryHandle_);
+  usage["aclStat"] = containerMemoryUsage(aclEntry2AclStat_);
+  usage["mirror"] = containerMemoryUsage(mirrorEgressPath2Handle_);
+  usage["mirror"] += containerMemoryUsage(mirroredPort2Handle_);
+  usage["mirror"] += containerMemoryUsage(mirroredAcl2Handle_);
+  usage["qosMap"] = containerMemoryUsage(qosMapKey2QosMapId_);
+  usage["qosMap"] += containerMemoryUsage(qosMapId2QosMap_);
+  usage["routeCounter"] = containerMemoryUsage(routeCounterIDs_);
+  if (dumpedSwSwitchState_) {
+    // The SwitchState dumped for warm boot is dropped once FIB is synced
+    usage["dumpedSwitchState"] = dumpedSwSwitchState_->getSubtreeMemoryUsage();
+  }
+  return usage;
+}
+
 void BcmWarmBootCache::clear() {
   // Get rid of all unclaimed entries. The order is important here
   // since we want to delete entries only after there are no more
@@ -32,6 +32,7 @@ extern "C" {
 #include <string>
 #include <vector>
 
+#include "fboss/agent/MemoryUsage.h"
 #include "fboss/agent/hw/bcm/BcmMirror.h"
 #include "fboss/agent/hw/bcm/BcmQosMap.h"
 #include "fboss/agent/hw/bcm/BcmRouteCounter.h"
@@ -516,6 +517,12 @@ class BcmWarmBootCache {
    * from hw that had owner as their only remaining owner
    */
   void clear();
+  /*
+   * Approximate memory used by the cached HW entries, keyed by entry type.
+   * Entries are removed as they get claimed, so this should drop to 0 once
+   * warm boot completes.
+   */
+  MemoryUsageByType getMemoryUsage() const;
   bool fillVlanPortInfo(Vlan* vlan);
   /*
    * Serialize to folly::dynamic
@@ -0,0 +1,176 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/bcm/BcmSflowExporter.h"
+#include "fboss/agent/state/SflowCollector.h"
+
+#include <folly/SocketAddress.h>
+#include <folly/String.h>
+#include <folly/dynamic.h>
+#include <folly/init/Init.h>
+#include <folly/json.h>
+#include <folly/logging/xlog.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+DEFINE_bool(json, true, "Output in json form");
+DEFINE_int32(num_samples, 1000000, "Number of sFlow samples to export");
+DEFINE_int32(sample_size, 128, "Size of the sampled packet data in bytes");
+
+namespace facebook::fboss {
+
+namespace {
+/*
+ * UDP collector on the loopback interface, counting received datagrams and
+ * the samples in them on its own thread.
+ */
+class LoopbackCollector {
+ public:
+  LoopbackCollector() {
+    socket_ = ::socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    CHECK_NE(socket_, -1) << folly::errnoStr(errno);
+    int rcvBuf = 64 * 1024 * 1024;
+    setsockopt(socket_, SOL_SOCKET, SO_RCVBUF, &rcvBuf, sizeof(rcvBuf));
+    timeval timeout{0, 100000};
+    setsockopt(socket_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    folly::SocketAddress addr("::1", 0);
+    sockaddr_storage addrStorage;
+    auto len = addr.getAddress(&addrStorage);
+    CHECK_EQ(bind(socket_, reinterpret_cast<sockaddr*>(&addrStorage), len), 0)
+        << folly::errnoStr(errno);
+    address_.setFromLocalAddress(socket_);
+
+    thread_ = std::thread([this]() {
+      std::array<char, 65536> buf;
+      while (!done_) {
+        auto len = ::recv(socket_, buf.data(), buf.size(), 0);
+        if (len > 0) {
+          received_++;
+          samplesReceived_ += countSamples(folly::ByteRange(
+              reinterpret_cast<const uint8_t*>(buf.data()), len));
+        }
+      }
+    });
+  }
+
+  ~LoopbackCollector() {
+    done_ = true;
+    thread_.join();
+    close(socket_);
+  }
+
+  uint16_t getPort() const {
+    return address_.getPort();
+  }
+
+  uint64_t getReceived() const {
+    return received_;
+  }
+
+  uint64_t getSamplesReceived() const {
+    return samplesReceived_;
+  }
+
+ private:
+  static size_t countSamples(folly::ByteRange datagram) {
+    if (FLAGS_sflow_samples_per_datagram <= 1) {
+      return 1;
+    }
+    SflowPacketInfoBatch batch;
+    apache::thrift::BinarySerializer::deserialize(datagram, batch);
+    return batch.samples_ref()->size();
+  }
+
+  int socket_{-1};
+  folly::SocketAddress address_;
+  std::atomic<bool> done_{false};
+  std::atomic<uint64_t> received_{0};
+  std::atomic<uint64_t> samplesReceived_{0};
+  std::thread thread_;
+};
+} // namespace
+
+void runSflowExportBenchmark() {
+  // Unless asked otherwise, queue all the samples, so that this measures how
+  // fast they are exported rather than how many are dropped
+  if (gflags::GetCommandLineFlagInfoOrDie("sflow_export_queue_size")
+          .is_default) {
+    FLAGS_sflow_export_queue_size = FLAGS_num_samples;
+  }
+  LoopbackCollector collector;
+  BcmSflowExporterTable exporterTable;
+  exporterTable.addExporter(
+      std::make_shared<SflowCollector>("::1", collector.getPort()));
+  CHECK_EQ(exporterTable.size(), 1);
+
+  SflowPacketInfo info;
+  *info.ingressSampled_ref() = true;
+  info.srcPort_ref() = 1;
+  info.dstPort_ref() = 2;
+  info.vlan_ref() = 1;
+  *info.packetData_ref() = std::string(FLAGS_sample_size, 'x');
+
+  auto timeBefore = std::chrono::steady_clock::now();
+  for (auto i = 0; i < FLAGS_num_samples; ++i) {
+    exporterTable.sendToAll(info);
+  }
+  // Wait for the export thread to drain the queue
+  while (exporterTable.getSamplesExported() +
+             exporterTable.getSamplesDropped() <
+         FLAGS_num_samples) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  auto timeAfter = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::milli> durationMillseconds =
+      timeAfter - timeBefore;
+  // Give the collector a chance to catch up on the last datagrams
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  // Only count the samples that made it to the collector
+  uint64_t samplesPerSec =
+      (static_cast<double>(collector.getSamplesReceived()) /
+       durationMillseconds.count()) *
+      1000;
+  if (FLAGS_json) {
+    folly::dynamic sflowJson = folly::dynamic::object;
+    sflowJson["sflow_samples_per_sec"] = samplesPerSec;
+    sflowJson["sflow_samples_exported"] = exporterTable.getSamplesExported();
+    sflowJson["sflow_samples_dropped"] = exporterTable.getSamplesDropped();
+    sflowJson["sflow_datagrams_sent"] = exporterTable.getDatagramsSent();
+    sflowJson["sflow_datagrams_received"] = collector.getReceived();
+    sflowJson["sflow_samples_received"] = collector.getSamplesReceived();
+    sflowJson["sflow_send_errors"] = exporterTable.getSendErrors();
+    std::cout << toPrettyJson(sflowJson) << std::endl;
+  } else {
+    XLOG(INFO) << " Samples exported: " << exporterTable.getSamplesExported()
+               << " dropped: " << exporterTable.getSamplesDropped()
+               << " datagrams sent: " << exporterTable.getDatagramsSent()
+               << " received: " << collector.getReceived()
+               << " samples received: " << collector.getSamplesReceived()
+               << " interval ms: " << durationMillseconds.count()
+               << " samples per sec: " << samplesPerSec;
+  }
+}
+} // namespace facebook::fboss
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv, true);
+  facebook::fboss::runSflowExportBenchmark();
+  return 0;
+}
@@ -0,0 +1,256 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/bcm/BcmSflowExporter.h"
+#include "fboss/agent/state/SflowCollector.h"
+
+#include <fb303/ServiceData.h>
+#include <folly/SocketAddress.h>
+#include <folly/String.h>
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+namespace facebook::fboss {
+
+namespace {
+// Samples the export thread takes off the queue in one pass
+constexpr int kMaxSamplesPerExport = 256;
+
+SflowPacketInfo makeSample(size_t dataBytes) {
+  SflowPacketInfo info;
+  *info.ingressSampled_ref() = true;
+  info.srcPort_ref() = 1;
+  info.dstPort_ref() = 2;
+  info.vlan_ref() = 1;
+  *info.packetData_ref() = std::string(dataBytes, 'x');
+  return info;
+}
+
+/*
+ * UDP collector on the loopback interface
+ */
+class LoopbackCollector {
+ public:
+  LoopbackCollector() {
+    socket_ = ::socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    CHECK_NE(socket_, -1) << folly::errnoStr(errno);
+    timeval timeout{1, 0};
+    setsockopt(socket_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    folly::SocketAddress addr("::1", 0);
+    sockaddr_storage addrStorage;
+    auto len = addr.getAddress(&addrStorage);
+    CHECK_EQ(bind(socket_, reinterpret_cast<sockaddr*>(&addrStorage), len), 0)
+        << folly::errnoStr(errno);
+    address_.setFromLocalAddress(socket_);
+  }
+
+  ~LoopbackCollector() {
+    close(socket_);
+  }
+
+  std::shared_ptr<SflowCollector> getCollector() const {
+    return std::make_shared<SflowCollector>("::1", address_.getPort());
+  }
+
+  /*
+   * Receive a single datagram, returns std::nullopt on timeout
+   */
+  std::optional<std::string> receive() {
+    std::array<char, 65536> buf;
+    auto len = ::recv(socket_, buf.data(), buf.size(), 0);
+    if (len <= 0) {
+      return std::nullopt;
+    }
+    return std::string(buf.data(), len);
+  }
+
+ private:
+  int socket_{-1};
+  folly::SocketAddress address_;
+};
+} // namespace
+
+class BcmSflowExporterTableTest : public ::testing::Test {
+ protected:
+  std::vector<std::string> serializeSamples(
+      const BcmSflowExporterTable& table,
+      std::vector<SflowPacketInfo> samples) const {
+    std::vector<std::string> datagrams;
+    table.serializeSamples(samples, datagrams);
+    return datagrams;
+  }
+
+  /*
+   * While the returned lock is held the export thread can't get at the
+   * collectors, so it stops draining the queue after its current pass.
+   */
+  auto lockExporters(BcmSflowExporterTable& table) const {
+    return table.map_.wlock();
+  }
+
+  std::vector<size_t> batchSizes(
+      const std::vector<std::string>& datagrams) const {
+    std::vector<size_t> sizes;
+    for (const auto& datagram : datagrams) {
+      SflowPacketInfoBatch batch;
+      apache::thrift::BinarySerializer::deserialize(datagram, batch);
+      sizes.push_back(batch.samples_ref()->size());
+    }
+    return sizes;
+  }
+
+  void waitForExport(const BcmSflowExporterTable& table, uint64_t numSamples)
+      const {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (table.getSamplesExported() + table.getSamplesDropped() <
+               numSamples &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  gflags::FlagSaver flagSaver_;
+};
+
+TEST_F(BcmSflowExporterTableTest, QueueFullDropsSamples) {
+  FLAGS_sflow_export_queue_size = 4;
+  LoopbackCollector collector;
+  BcmSflowExporterTable table;
+  table.addExporter(collector.getCollector());
+
+  // The export thread holds at most one pass worth of samples and the queue
+  // the rest, anything beyond that has to be dropped.
+  constexpr int kExtraSamples = 10;
+  constexpr int kNumSamples =
+      kMaxSamplesPerExport + 4 /* queue size */ + kExtraSamples;
+  {
+    auto locked = lockExporters(table);
+    for (auto i = 0; i < kNumSamples; ++i) {
+      table.sendToAll(makeSample(64));
+    }
+    EXPECT_GE(table.getSamplesDropped(), kExtraSamples);
+    EXPECT_EQ(table.getSamplesExported(), 0);
+  }
+  waitForExport(table, kNumSamples);
+  EXPECT_EQ(
+      table.getSamplesExported() + table.getSamplesDropped(), kNumSamples);
+
+  table.publishStats();
+  EXPECT_EQ(
+      fb303::fbData->getCounter("sflow.samples_dropped"),
+      table.getSamplesDropped());
+  EXPECT_EQ(
+      fb303::fbData->getCounter("sflow.samples_exported"),
+      table.getSamplesExported());
+}
+
+TEST_F(BcmSflowExporterTableTest, NoCollectorsNoDrops) {
+  FLAGS_sflow_export_queue_size = 4;
+  BcmSflowExporterTable table;
+  for (auto i = 0; i < 10; ++i) {
+    table.sendToAll(makeSample(64));
+  }
+  EXPECT_EQ(table.getSamplesDropped(), 0);
+  EXPECT_EQ(table.getSamplesExported(), 0);
+}
+
+TEST_F(BcmSflowExporterTableTest, OneSamplePerDatagram) {
+  BcmSflowExporterTable table;
+  std::vector<SflowPacketInfo> samples;
+  for (auto i = 0; i < 3; ++i) {
+    samples.push_back(makeSample(64));
+  }
+  auto datagrams = serializeSamples(table, samples);
+  ASSERT_EQ(datagrams.size(), 3);
+  for (const auto& datagram : datagrams) {
+    SflowPacketInfo info;
+    apache::thrift::BinarySerializer::deserialize(datagram, info);
+    EXPECT_EQ(info, samples.front());
+  }
+}
+
+TEST_F(BcmSflowExporterTableTest, BatchFlushedAtSampleCount) {
+  FLAGS_sflow_samples_per_datagram = 4;
+  BcmSflowExporterTable table;
+  std::vector<SflowPacketInfo> samples;
+  for (auto i = 0; i < 10; ++i) {
+    samples.push_back(makeSample(64));
+  }
+  auto datagrams = serializeSamples(table, samples);
+  EXPECT_EQ(batchSizes(datagrams), (std::vector<size_t>{4, 4, 2}));
+}
+
+TEST_F(BcmSflowExporterTableTest, BatchFlushedAtDatagramSize) {
+  FLAGS_sflow_samples_per_datagram = 100;
+  BcmSflowExporterTable table;
+  // Only two of these fit under the 1400 byte datagram limit
+  std::vector<SflowPacketInfo> samples;
+  for (auto i = 0; i < 5; ++i) {
+    samples.push_back(makeSample(500));
+  }
+  auto datagrams = serializeSamples(table, samples);
+  EXPECT_EQ(batchSizes(datagrams), (std::vector<size_t>{2, 2, 1}));
+  for (const auto& datagram : datagrams) {
+    EXPECT_LE(datagram.size(), 1400);
+  }
+}
+
+TEST_F(BcmSflowExporterTableTest, OversizedSampleSentAlone) {
+  FLAGS_sflow_samples_per_datagram = 100;
+  BcmSflowExporterTable table;
+  std::vector<SflowPacketInfo> samples;
+  samples.push_back(makeSample(64));
+  samples.push_back(makeSample(2000));
+  samples.push_back(makeSample(64));
+  auto datagrams = serializeSamples(table, samples);
+  EXPECT_EQ(batchSizes(datagrams), (std::vector<size_t>{1, 1, 1}));
+}
+
+TEST_F(BcmSflowExporterTableTest, BatchesReachCollector) {
+  FLAGS_sflow_samples_per_datagram = 4;
+  LoopbackCollector collector;
+  BcmSflowExporterTable table;
+  table.addExporter(collector.getCollector());
+
+  constexpr int kNumSamples = 10;
+  for (auto i = 0; i < kNumSamples; ++i) {
+    table.sendToAll(makeSample(64));
+  }
+  waitForExport(table, kNumSamples);
+  ASSERT_EQ(table.getSamplesExported(), kNumSamples);
+  EXPECT_EQ(table.getSendErrors(), 0);
+
+  size_t samplesReceived = 0;
+  std::vector<std::string> datagrams;
+  while (samplesReceived < kNumSamples) {
+    auto datagram = collector.receive();
+    ASSERT_TRUE(datagram.has_value());
+    SflowPacketInfoBatch batch;
+    apache::thrift::BinarySerializer::deserialize(*datagram, batch);
+    EXPECT_LE(batch.samples_ref()->size(), 4);
+    samplesReceived += batch.samples_ref()->size();
+    datagrams.push_back(std::move(*datagram));
+  }
+  EXPECT_EQ(samplesReceived, kNumSamples);
+  EXPECT_EQ(table.getDatagramsSent(), datagrams.size());
+}
+
+} // namespace facebook::fboss
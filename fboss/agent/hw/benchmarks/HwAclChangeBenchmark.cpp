@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/hw/test/HwSwitchEnsemble.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
+#include "fboss/agent/hw/test/HwTestAclUtils.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Format.h>
+
+namespace facebook::fboss {
+
+namespace {
+constexpr int kNumAcls = 2000;
+// Every 10th ACL changes
+constexpr int kChangeEvery = 10;
+
+enum class AclChange { NONE, ACTION, MATCHER };
+
+cfg::SwitchConfig aclScaleConfig(HwSwitchEnsemble* ensemble, AclChange change) {
+  auto config = utility::onePortPerVlanConfig(
+      ensemble->getHwSwitch(), ensemble->masterLogicalPortIds());
+  for (auto i = 0; i < kNumAcls; ++i) {
+    bool changed = change != AclChange::NONE && i % kChangeEvery == 0;
+    auto aclName = folly::sformat("acl{}", i);
+    auto acl = utility::addAcl(
+        &config,
+        aclName,
+        changed && change == AclChange::ACTION ? cfg::AclActionType::DENY
+                                               : cfg::AclActionType::PERMIT);
+    acl->dstIp_ref() = folly::sformat("2401:db00:{:x}::/48", i);
+    acl->l4DstPort_ref() = changed && change == AclChange::MATCHER ? 80 : 443;
+    utility::addAclStat(
+        &config, aclName, folly::sformat("{}-stats", aclName));
+  }
+  return config;
+}
+
+/*
+ * Reload a config in which 10% of 2K ACLs change, either only their action
+ * or one of their matchers. Each changed ACL keeps its counter.
+ */
+void aclChangeBenchmark(AclChange change) {
+  folly::BenchmarkSuspender suspender;
+  auto ensemble = createHwEnsemble(HwSwitchEnsemble::getAllFeatures());
+  ensemble->applyInitialConfig(
+      aclScaleConfig(ensemble.get(), AclChange::NONE));
+  auto newConfig = aclScaleConfig(ensemble.get(), change);
+  suspender.dismiss();
+  ensemble->applyNewConfig(newConfig);
+  suspender.rehire();
+}
+} // namespace
+
+BENCHMARK(HwAclActionChange) {
+  aclChangeBenchmark(AclChange::ACTION);
+}
+
+BENCHMARK(HwAclMatcherChange) {
+  aclChangeBenchmark(AclChange::MATCHER);
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,50 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/test/HwSwitchEnsemble.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
+#include "fboss/agent/hw/test/ProdConfigFactory.h"
+
+#include <folly/Benchmark.h>
+#include <gflags/gflags.h>
+
+DECLARE_bool(parallel_config_sections);
+
+namespace facebook::fboss {
+
+namespace {
+/*
+ * Reload a prod RSW config in which only a scalar setting changed, so every
+ * other section is the same as the one already applied.
+ */
+void prodConfigReloadBenchmark(bool parallel) {
+  folly::BenchmarkSuspender suspender;
+  gflags::FlagSaver flagSaver;
+  FLAGS_parallel_config_sections = parallel;
+  auto ensemble = createHwEnsemble(HwSwitchEnsemble::getAllFeatures());
+  auto config = utility::createProdRswConfig(
+      ensemble->getHwSwitch(), ensemble->masterLogicalPortIds());
+  ensemble->applyInitialConfig(config);
+  config.arpAgerInterval_ref() = *config.arpAgerInterval_ref() + 1;
+  suspender.dismiss();
+  ensemble->applyNewConfig(config);
+  suspender.rehire();
+}
+} // namespace
+
+BENCHMARK(HwProdConfigReload) {
+  prodConfigReloadBenchmark(true);
+}
+
+BENCHMARK(HwProdConfigReloadSerial) {
+  prodConfigReloadBenchmark(false);
+}
+
+} // namespace facebook::fboss
@@ -9,6 +9,8 @@
  */
 
 #include "fboss/agent/Platform.h"
+#include "fboss/agent/RxPacket.h"
+#include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/hw/test/ConfigFactory.h"
 #include "fboss/agent/hw/test/HwSwitchEnsemble.h"
 #include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
@@ -22,6 +24,7 @@
 #include "fboss/agent/hw/test/HwTestPacketTrapEntry.h"
 
 #include <folly/IPAddress.h>
+#include <folly/ThreadLocal.h>
 #include <folly/dynamic.h>
 #include <folly/init/Init.h>
 #include <folly/json.h>
@@ -39,6 +42,36 @@ namespace facebook::fboss {
 
 const std::string kDstIp = "2620:0:1cfe:face:b00c::4";
 
+/*
+ * Account for every trapped packet in SwitchStats the way SwSwitch does, so
+ * that the cost of the stats on the RX path is part of the measurement. Run
+ * with --rx_stats_batch_size=1 to add them to their timeseries for every
+ * packet instead of batching them.
+ */
+class RxStatsObserver : public HwSwitchEnsemble::HwSwitchEventObserverIf {
+ public:
+  explicit RxStatsObserver(HwSwitchEnsemble* ensemble) : ensemble_(ensemble) {
+    ensemble_->addHwEventObserver(this);
+  }
+  ~RxStatsObserver() override {
+    ensemble_->removeHwEventObserver(this);
+  }
+
+  void packetReceived(RxPacket* pkt) noexcept override {
+    stats_->trappedPkt();
+    stats_->pktToHost(pkt->getLength());
+  }
+
+ private:
+  void linkStateChanged(PortID /*port*/, bool /*up*/) override {}
+  void l2LearningUpdateReceived(
+      L2Entry /*l2Entry*/,
+      L2EntryUpdateType /*l2EntryUpdateType*/) override {}
+
+  HwSwitchEnsemble* ensemble_;
+  folly::ThreadLocal<SwitchStats> stats_;
+};
+
 void runRxSlowPathBenchmark() {
   constexpr int kEcmpWidth = 1;
   auto ensemble = createHwEnsemble(HwSwitchEnsemble::getAllFeatures());
@@ -49,6 +82,7 @@ void runRxSlowPathBenchmark() {
   // capture packet exiting port 0 (entering due to loopback)
   auto trapDstIp = folly::CIDRNetwork{kDstIp, 128};
   auto packetCapture = HwTestPacketTrapEntry(hwSwitch, trapDstIp);
+  RxStatsObserver rxStats(ensemble.get());
   auto dstMac = utility::getInterfaceMac(
       ensemble->getProgrammedState(), utility::firstVlanID(config));
   auto ecmpHelper =
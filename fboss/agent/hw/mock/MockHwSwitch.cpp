@@ -84,6 +84,13 @@ bool MockHwSwitch::sendPacketOutOfPortAsync(
   return true;
 }
 
+size_t MockHwSwitch::sendPacketsOutOfPortAsync(
+    std::vector<std::pair<std::unique_ptr<TxPacket>, PortID>> pkts,
+    std::optional<uint8_t> queue) noexcept {
+  sendPacketsOutOfPortAsync_(pkts.size(), queue);
+  return HwSwitch::sendPacketsOutOfPortAsync(std::move(pkts), queue);
+}
+
 bool MockHwSwitch::sendPacketSwitchedSync(
     std::unique_ptr<TxPacket> pkt) noexcept {
   TxPacket* raw(pkt.release());
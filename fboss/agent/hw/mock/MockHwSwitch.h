@@ -52,6 +52,14 @@ class MockHwSwitch : public HwSwitch {
       std::unique_ptr<TxPacket> pkt,
       facebook::fboss::PortID portID,
       std::optional<uint8_t> queue = std::nullopt) noexcept override;
+  // Called with the size of each batch, whose packets then go through
+  // sendPacketOutOfPortAsync_ one by one
+  MOCK_METHOD2(
+      sendPacketsOutOfPortAsync_,
+      void(size_t numPkts, std::optional<uint8_t> queue));
+  size_t sendPacketsOutOfPortAsync(
+      std::vector<std::pair<std::unique_ptr<TxPacket>, PortID>> pkts,
+      std::optional<uint8_t> queue = std::nullopt) noexcept override;
   MOCK_METHOD1(sendPacketSwitchedSync_, bool(TxPacket*));
   bool sendPacketSwitchedSync(std::unique_ptr<TxPacket> pkt) noexcept override;
 
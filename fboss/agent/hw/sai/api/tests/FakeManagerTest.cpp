@@ -0,0 +1,169 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/api/NextHopGroupApi.h"
+#include "fboss/agent/hw/sai/fake/FakeManager.h"
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+
+struct FakeObject {
+  explicit FakeObject(int value) : value(value) {}
+  int value;
+  sai_object_id_t id;
+};
+
+struct FakeEntry {
+  explicit FakeEntry(int value) : value(value) {}
+  int value;
+};
+
+struct FakeGroupMember {
+  explicit FakeGroupMember(sai_object_id_t groupId) : groupId(groupId) {}
+  sai_object_id_t groupId;
+  sai_object_id_t id;
+};
+
+struct FakeGroup {
+  FakeGroup() {}
+  sai_object_id_t id;
+  FakeManager<sai_object_id_t, FakeGroupMember>& fm() {
+    return fm_;
+  }
+  const FakeManager<sai_object_id_t, FakeGroupMember>& fm() const {
+    return fm_;
+  }
+
+ private:
+  FakeManager<sai_object_id_t, FakeGroupMember> fm_;
+};
+
+using ObjectManager = FakeManager<sai_object_id_t, FakeObject, 10>;
+using EntryManager = FakeManager<int, FakeEntry>;
+using GroupManager = FakeManagerWithMembers<FakeGroup, FakeGroupMember>;
+
+} // namespace
+
+TEST(FakeManagerTest, allocateIds) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_fake_sai_reuse_object_ids = false;
+  ObjectManager fm;
+  fm.clear();
+
+  EXPECT_EQ(10, fm.create(1));
+  EXPECT_EQ(11, fm.create(2));
+  EXPECT_EQ(12, fm.create(3));
+  EXPECT_EQ(2, fm.get(11).value);
+  EXPECT_EQ(11, fm.get(11).id);
+  EXPECT_EQ(3, fm.map().size());
+
+  // Without reuse, removed ids are never handed out again
+  EXPECT_EQ(1, fm.remove(11));
+  EXPECT_EQ(0, fm.remove(11));
+  EXPECT_FALSE(fm.exists(11));
+  EXPECT_EQ(13, fm.create(4));
+
+  // Clearing starts allocating from the first id again
+  fm.clear();
+  EXPECT_EQ(0, fm.map().size());
+  EXPECT_EQ(10, fm.create(5));
+}
+
+TEST(FakeManagerTest, reuseIds) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_fake_sai_reuse_object_ids = true;
+  ObjectManager fm;
+  fm.clear();
+
+  for (int i = 0; i < 5; ++i) {
+    fm.create(i);
+  }
+  fm.remove(11);
+  fm.remove(13);
+  // Recycled last in, first out, before any new id
+  EXPECT_EQ(13, fm.create(6));
+  EXPECT_EQ(11, fm.create(7));
+  EXPECT_EQ(15, fm.create(8));
+  EXPECT_EQ(7, fm.get(11).value);
+}
+
+TEST(FakeManagerTest, referencesStayValid) {
+  ObjectManager fm;
+  fm.clear();
+  auto id = fm.create(42);
+  auto& object = fm.get(id);
+  for (int i = 0; i < 10000; ++i) {
+    fm.create(i);
+  }
+  EXPECT_EQ(&object, &fm.get(id));
+  EXPECT_EQ(42, object.value);
+}
+
+TEST(FakeManagerTest, createExistingEntry) {
+  EntryManager fm;
+  fm.create(1, 10);
+  EXPECT_THROW(fm.create(1, 20), std::runtime_error);
+  EXPECT_EQ(10, fm.get(1).value);
+  EXPECT_THROW(fm.get(2), std::out_of_range);
+}
+
+TEST(FakeManagerTest, members) {
+  GroupManager fm;
+  fm.clearWithMembers();
+  auto group1 = fm.create();
+  auto group2 = fm.create();
+  auto member1 = fm.createMember(group1, group1);
+  auto member2 = fm.createMember(group2, group2);
+  // Members of different groups never share an id
+  EXPECT_NE(member1, member2);
+  EXPECT_EQ(group1, fm.getMember(member1).groupId);
+  EXPECT_EQ(group2, fm.getMember(member2).groupId);
+
+  EXPECT_EQ(1, fm.removeMember(member1));
+  EXPECT_EQ(0, fm.get(group1).fm().map().size());
+  EXPECT_EQ(1, fm.get(group2).fm().map().size());
+
+  fm.clearWithMembers();
+  EXPECT_EQ(0, fm.map().size());
+}
+
+TEST(FakeManagerTest, concurrentApiCalls) {
+  auto fs = FakeSai::getInstance();
+  sai_api_initialize(0, nullptr);
+  NextHopGroupApi nextHopGroupApi;
+  auto numGroups = fs->nextHopGroupManager.map().size();
+
+  // SaiApi serializes the calls into the fake
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&nextHopGroupApi]() {
+      for (int i = 0; i < 1000; ++i) {
+        auto groupId = nextHopGroupApi.create<SaiNextHopGroupTraits>(
+            {SAI_NEXT_HOP_GROUP_TYPE_ECMP}, 0);
+        auto memberId = nextHopGroupApi.create<SaiNextHopGroupMemberTraits>(
+            {groupId, 42, 1}, 0);
+        nextHopGroupApi.remove(memberId);
+        nextHopGroupApi.remove(groupId);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(numGroups, fs->nextHopGroupManager.map().size());
+}
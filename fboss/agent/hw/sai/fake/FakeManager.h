@@ -9,10 +9,14 @@
  */
 #pragma once
 
+#include <folly/container/F14Map.h>
 #include <folly/logging/xlog.h>
+#include <folly/portability/GFlags.h>
 
+#include <chrono>
 #include <stdexcept>
-#include <unordered_map>
+#include <type_traits>
+#include <vector>
 
 extern "C" {
 #include <sai.h>
@@ -20,16 +24,61 @@ extern "C" {
 
 #include "fboss/agent/hw/sai/api/SaiVersion.h"
 
+DECLARE_int32(fake_sai_create_latency_us);
+DECLARE_int32(fake_sai_remove_latency_us);
+DECLARE_bool(fake_sai_reuse_object_ids);
+
 namespace facebook::fboss {
 
+namespace detail {
+/*
+ * Busy wait for the given number of microseconds, to model the time an SDK
+ * spends programming the ASIC. Sleeping is too coarse for the few
+ * microseconds a typical SAI call takes.
+ */
+inline void fakeSaiModelLatency(int32_t latencyUs) {
+  if (latencyUs <= 0) {
+    return;
+  }
+  auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::microseconds(latencyUs);
+  while (std::chrono::steady_clock::now() < deadline) {
+  }
+}
+} // namespace detail
+
+/*
+ * Storage for fake SAI objects of one type.
+ *
+ * Objects live in a node map, so references returned by get() stay valid
+ * until the object is removed, while lookups stay cheap at scale (millions
+ * of routes, neighbors or FDB entries). Each object is its own allocation:
+ * this is not an arena, which would need the fakes to hand out handles
+ * instead of references.
+ *
+ * Object ids are allocated in O(1) from a counter shared by all managers of
+ * the same type (so members of different groups never share an id). With
+ * --fake_sai_reuse_object_ids, removed ids are recycled LIFO, as ASIC SDKs
+ * do, which keeps ids dense during long running scale benchmarks.
+ *
+ * Like an SDK that is not thread safe, the fake does no locking of its own:
+ * SaiApi serializes all SAI calls under SaiApiLock, and that lock is what
+ * makes using the objects returned by get() and map() safe when the fake is
+ * driven from several threads. Creates and removes can optionally be slowed
+ * down to model the latency of a real ASIC, see
+ * --fake_sai_create_latency_us and --fake_sai_remove_latency_us.
+ */
 template <typename K, typename T, size_t count = 0>
 class FakeManager {
  public:
+  using MapType = folly::F14NodeMap<K, T>;
+
   template <typename E = K, typename... Args>
   typename std::
       enable_if<std::is_same<E, sai_object_id_t>::value, sai_object_id_t>::type
       create(Args&&... args) {
-    sai_object_id_t id = static_cast<sai_object_id_t>(count_++);
+    detail::fakeSaiModelLatency(FLAGS_fake_sai_create_latency_us);
+    sai_object_id_t id = allocateId();
     auto ins = map_.emplace(id, T{std::forward<Args>(args)...});
     ins.first->second.id = id;
     return id;
@@ -38,15 +87,22 @@ class FakeManager {
   template <typename E = K, typename... Args>
   typename std::enable_if<!std::is_same<E, sai_object_id_t>::value, void>::type
   create(const K& k, Args&&... args) {
+    detail::fakeSaiModelLatency(FLAGS_fake_sai_create_latency_us);
     auto ins = map_.emplace(k, T{std::forward<Args>(args)...});
     if (!ins.second) {
       throw std::runtime_error("Object already exists, create failed");
     }
-    count_++;
   }
 
   size_t remove(const K& k) {
-    return map_.erase(k);
+    detail::fakeSaiModelLatency(FLAGS_fake_sai_remove_latency_us);
+    auto removed = map_.erase(k);
+    if constexpr (std::is_same<K, sai_object_id_t>::value) {
+      if (removed) {
+        releaseId(k);
+      }
+    }
+    return removed;
   }
 
   T& get(const K& k) {
@@ -56,15 +112,17 @@ class FakeManager {
     return map_.at(k);
   }
 
-  std::unordered_map<K, T>& map() {
+  MapType& map() {
     return map_;
   }
-  const std::unordered_map<K, T>& map() const {
+  const MapType& map() const {
     return map_;
   }
 
   void clear() {
-    count_ = count;
+    auto& allocator = idAllocator();
+    allocator.next = count;
+    allocator.freeIds.clear();
     map_.clear();
   }
 
@@ -73,12 +131,36 @@ class FakeManager {
   }
 
  private:
-  static size_t count_;
-  std::unordered_map<K, T> map_;
+  struct IdAllocator {
+    size_t next{count};
+    std::vector<sai_object_id_t> freeIds;
+  };
+
+  static IdAllocator& idAllocator() {
+    static IdAllocator allocator;
+    return allocator;
+  }
+
+  static sai_object_id_t allocateId() {
+    auto& allocator = idAllocator();
+    if (!allocator.freeIds.empty()) {
+      auto id = allocator.freeIds.back();
+      allocator.freeIds.pop_back();
+      return id;
+    }
+    return static_cast<sai_object_id_t>(allocator.next++);
+  }
+
+  static void releaseId(sai_object_id_t id) {
+    if (!FLAGS_fake_sai_reuse_object_ids) {
+      return;
+    }
+    idAllocator().freeIds.push_back(id);
+  }
+
+  MapType map_;
 };
 
-template <typename K, typename T, size_t count>
-size_t FakeManager<K, T, count>::count_ = count;
 /*
  * For managing fakes of sai apis that have a membership concept, we will
  * nest fake managers. In this class template, GroupT denotes an owning "group"
@@ -112,8 +194,8 @@ class FakeManagerWithMembers : public FakeManager<sai_object_id_t, GroupT> {
     return group.fm().get(memberId);
   }
   void clearWithMembers() {
-    for (auto entry : memberToGroupMap_) {
-      GroupT& group = this->get(memberToGroupMap_.at(entry.first));
+    for (const auto& entry : memberToGroupMap_) {
+      GroupT& group = this->get(entry.second);
       group.fm().clear();
     }
     memberToGroupMap_.clear();
@@ -121,7 +203,7 @@ class FakeManagerWithMembers : public FakeManager<sai_object_id_t, GroupT> {
   }
 
  private:
-  std::unordered_map<sai_object_id_t, sai_object_id_t> memberToGroupMap_;
+  folly::F14FastMap<sai_object_id_t, sai_object_id_t> memberToGroupMap_;
 };
 
 } // namespace facebook::fboss
@@ -14,6 +14,19 @@
 
 #include <folly/logging/xlog.h>
 
+DEFINE_int32(
+    fake_sai_create_latency_us,
+    0,
+    "Modeled latency of creating an object in the fake SAI, in microseconds");
+DEFINE_int32(
+    fake_sai_remove_latency_us,
+    0,
+    "Modeled latency of removing an object in the fake SAI, in microseconds");
+DEFINE_bool(
+    fake_sai_reuse_object_ids,
+    false,
+    "Recycle the ids of removed objects in the fake SAI, like ASIC SDKs do");
+
 namespace {
 struct singleton_tag_type {};
 } // namespace
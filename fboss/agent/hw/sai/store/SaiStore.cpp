@@ -126,6 +126,16 @@ void SaiStore::printWarmbootHandles() const {
       [](const auto& store) { store.printWarmBootHandles(); }, stores_);
 }
 
+MemoryUsageByType SaiStore::getMemoryUsage() const {
+  MemoryUsageByType usage;
+  tupleForEach(
+      [&usage](const auto& store) {
+        usage[store.objectTypeName().str()] += store.getMemoryUsage();
+      },
+      stores_);
+  return usage;
+}
+
 void SaiStore::removeUnexpectedUnclaimedWarmbootHandles() {
   tupleForEach(
       [](auto& store) { store.removeUnexpectedUnclaimedWarmbootHandles(); },
@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include "fboss/agent/MemoryUsage.h"
 #include "fboss/agent/hw/sai/api/AdapterKeySerializers.h"
 #include "fboss/agent/hw/sai/api/LoggingUtil.h"
 #include "fboss/agent/hw/sai/api/SaiApiTable.h"
@@ -293,6 +294,19 @@ class SaiObjectStore {
   uint64_t size() const {
     return objects_.size();
   }
+
+  MemoryUsage getMemoryUsage() const {
+    using MapType = typename UnorderedRefMap<
+        typename SaiObjectTraits::AdapterHostKey,
+        ObjectType>::MapType;
+    return MemoryUsage{
+        objects_.size() *
+                (sizeof(typename MapType::value_type) + sizeof(ObjectType) +
+                 kSharedPtrControlBlockBytes) +
+            warmBootHandles_.size() *
+                sizeof(typename decltype(warmBootHandles_)::value_type),
+        objects_.size()};
+  }
   typename UnorderedRefMap<
       typename SaiObjectTraits::AdapterHostKey,
       ObjectType>::MapType::const_iterator
@@ -501,6 +515,11 @@ class SaiStore {
 
   void printWarmbootHandles() const;
 
+  /*
+   * Approximate memory used by each object store, keyed by object type
+   */
+  MemoryUsageByType getMemoryUsage() const;
+
  private:
   sai_object_id_t switchId_{};
   std::tuple<
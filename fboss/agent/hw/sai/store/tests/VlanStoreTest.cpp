@@ -106,3 +106,23 @@ TEST_F(VlanStoreTest, toStrVlanMemberStore) {
   std::ignore = createVlanMember(vlanId, 10);
   verifyToStr<SaiVlanMemberTraits>();
 }
+
+TEST_F(VlanStoreTest, memoryUsage) {
+  std::ignore = createVlan(42);
+  SaiStore s(0);
+  s.reload();
+  auto before = s.getMemoryUsage()["vlan"];
+  EXPECT_GE(before.objects, 1);
+  EXPECT_GT(before.bytes, 0);
+
+  {
+    SaiVlanTraits::CreateAttributes c{400};
+    SaiVlanTraits::AdapterHostKey k{400};
+    auto vlan = s.get<SaiVlanTraits>().setObject(k, c);
+    auto usage = s.getMemoryUsage()["vlan"];
+    EXPECT_EQ(before.objects + 1, usage.objects);
+    EXPECT_GT(usage.bytes, before.bytes);
+  }
+  // Released objects are no longer accounted for
+  EXPECT_EQ(before.objects, s.getMemoryUsage()["vlan"].objects);
+}
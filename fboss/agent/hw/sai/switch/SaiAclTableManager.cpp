@@ -22,10 +22,48 @@
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 
 #include <folly/MacAddress.h>
+#include <algorithm>
 #include <chrono>
+#include <utility>
 
 using namespace std::chrono;
 
+namespace {
+
+template <typename AttrT>
+bool clearsAttribute(const AttrT& /*oldAttr*/, const AttrT& /*newAttr*/) {
+  return false;
+}
+
+template <typename AttrT>
+bool clearsAttribute(
+    const std::optional<AttrT>& oldAttr,
+    const std::optional<AttrT>& newAttr) {
+  return oldAttr.has_value() && !newAttr.has_value();
+}
+
+template <typename AttrsT, size_t... I>
+bool clearsAnyAttribute(
+    const AttrsT& oldAttrs,
+    const AttrsT& newAttrs,
+    std::index_sequence<I...>) {
+  return (clearsAttribute(std::get<I>(oldAttrs), std::get<I>(newAttrs)) || ...);
+}
+
+/*
+ * SaiObject::setAttributes() can't reset an optional attribute that goes
+ * from set to unset, such changes need the object to be recreated.
+ */
+template <typename AttrsT>
+bool clearsAnyAttribute(const AttrsT& oldAttrs, const AttrsT& newAttrs) {
+  return clearsAnyAttribute(
+      oldAttrs,
+      newAttrs,
+      std::make_index_sequence<std::tuple_size_v<AttrsT>>{});
+}
+
+} // namespace
+
 namespace facebook::fboss {
 
 sai_u32_range_t SaiAclTableManager::getFdbDstUserMetaDataRange() const {
@@ -421,6 +459,13 @@ SaiAclTableManager::addAclCounter(
 AclEntrySaiId SaiAclTableManager::addAclEntry(
     const std::shared_ptr<AclEntry>& addedAclEntry,
     const std::string& aclTableName) {
+  return programAclEntry(addedAclEntry, aclTableName, nullptr);
+}
+
+AclEntrySaiId SaiAclTableManager::programAclEntry(
+    const std::shared_ptr<AclEntry>& addedAclEntry,
+    const std::string& aclTableName,
+    SaiAclEntryHandle* replacedAclEntry) {
   // If we attempt to add entry to a table that does not exist, fail.
   auto aclTableHandle = getAclTableHandle(aclTableName);
   if (!aclTableHandle) {
@@ -432,7 +477,7 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
   // If we already store a handle for this this Acl Entry, fail to add new one.
   auto aclEntryHandle =
       getAclEntryHandle(aclTableHandle, addedAclEntry->getPriority());
-  if (aclEntryHandle) {
+  if (aclEntryHandle && aclEntryHandle != replacedAclEntry) {
     throw FbossError(
         "attempted to add a duplicate aclEntry: ", addedAclEntry->getID());
   }
@@ -883,7 +928,24 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
       aclActionMacsecFlow,
   };
 
-  auto saiAclEntry = aclEntryStore.setObject(adapterHostKey, attributes);
+  std::shared_ptr<SaiAclEntry> saiAclEntry;
+  if (replacedAclEntry &&
+      clearsAnyAttribute(
+          replacedAclEntry->aclEntry->attributes(), attributes)) {
+    // The old entry has to go before an entry with the same key is created
+    auto replacedAttributes = replacedAclEntry->aclEntry->attributes();
+    replacedAclEntry->aclEntry.reset();
+    try {
+      saiAclEntry = aclEntryStore.setObject(adapterHostKey, attributes);
+    } catch (const std::exception&) {
+      // Put the old entry back, its handle is still in the table
+      replacedAclEntry->aclEntry =
+          aclEntryStore.setObject(adapterHostKey, replacedAttributes);
+      throw;
+    }
+  } else {
+    saiAclEntry = aclEntryStore.setObject(adapterHostKey, attributes);
+  }
   auto entryHandle = std::make_unique<SaiAclEntryHandle>();
   entryHandle->aclEntry = saiAclEntry;
   entryHandle->aclCounter = saiAclCounter;
@@ -891,8 +953,11 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
   entryHandle->ingressMirror = ingressMirror;
   entryHandle->egressMirror = egressMirror;
   auto [it, inserted] = aclTableHandle->aclTableMembers.emplace(
-      addedAclEntry->getPriority(), std::move(entryHandle));
-  CHECK(inserted);
+      addedAclEntry->getPriority(), nullptr);
+  CHECK(inserted || replacedAclEntry);
+  // Only now is the replaced handle released, along with the counter and
+  // mirrors the new entry no longer uses
+  it->second = std::move(entryHandle);
 
   XLOG(INFO) << "added acl entry " << addedAclEntry->getID() << " priority "
              << addedAclEntry->getPriority();
@@ -943,13 +1008,53 @@ void SaiAclTableManager::changedAclEntry(
     const std::shared_ptr<AclEntry>& oldAclEntry,
     const std::shared_ptr<AclEntry>& newAclEntry,
     const std::string& aclTableName) {
-  /*
-   * ASIC/SAI implementation typically does not allow modifying an ACL entry.
-   * Thus, remove and re-add.
-   */
+  auto aclTableHandle = getAclTableHandle(aclTableName);
+  if (!aclTableHandle) {
+    throw FbossError(
+        "attempted to change AclEntry in a AclTable that does not exist: ",
+        aclTableName);
+  }
+  auto itr = aclTableHandle->aclTableMembers.find(oldAclEntry->getPriority());
+  if (itr == aclTableHandle->aclTableMembers.end()) {
+    throw FbossError(
+        "attempted to change aclEntry which does not exist: ",
+        oldAclEntry->getID());
+  }
   XLOG(INFO) << "changing acl entry " << oldAclEntry->getID();
-  removeAclEntry(oldAclEntry, aclTableName);
-  addAclEntry(newAclEntry, aclTableName);
+
+  if (oldAclEntry->getPriority() == newAclEntry->getPriority()) {
+    /*
+     * The store keys entries by table and priority. Point at the old entry
+     * so that only the changed attributes are set on it, which keeps the
+     * entry matching traffic throughout. Its handle stays in the table until
+     * the new one is programmed, so a failure leaves the old entry in place.
+     */
+    programAclEntry(newAclEntry, aclTableName, itr->second.get());
+  } else {
+    // Make before break: traffic hits the old entry until the new one is in
+    addAclEntry(newAclEntry, aclTableName);
+    aclTableHandle->aclTableMembers.erase(oldAclEntry->getPriority());
+  }
+
+  // Stats of a counter the new entry still uses were kept by addAclCounter()
+  auto oldAction = oldAclEntry->getAclAction();
+  if (!oldAction || !oldAction->getTrafficCounter()) {
+    return;
+  }
+  const auto& oldCounter = oldAction->getTrafficCounter().value();
+  auto newAction = newAclEntry->getAclAction();
+  auto newCounter = newAction ? newAction->getTrafficCounter() : std::nullopt;
+  for (const auto& counterType : *oldCounter.types_ref()) {
+    if (newCounter && *newCounter->name_ref() == *oldCounter.name_ref() &&
+        std::find(
+            newCounter->types_ref()->begin(),
+            newCounter->types_ref()->end(),
+            counterType) != newCounter->types_ref()->end()) {
+      continue;
+    }
+    aclStats_.removeStat(utility::statNameFromCounterType(
+        *oldCounter.name_ref(), counterType));
+  }
 }
 
 const SaiAclEntryHandle* FOLLY_NULLABLE SaiAclTableManager::getAclEntryHandle(
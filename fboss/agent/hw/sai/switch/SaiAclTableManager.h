@@ -193,6 +193,17 @@ class SaiAclTableManager {
       sai_uint32_t dstUserMetaDataRangeMin,
       sai_uint32_t dstUserMetaDataRangeMax) const;
 
+  /*
+   * If replacedAclEntry is the handle of an entry with the same priority,
+   * the store sets the changed fields and actions on that entry instead of
+   * creating a new one. The replaced handle is swapped out of the table once
+   * the new entry is programmed.
+   */
+  AclEntrySaiId programAclEntry(
+      const std::shared_ptr<AclEntry>& addedAclEntry,
+      const std::string& aclTableName,
+      SaiAclEntryHandle* replacedAclEntry);
+
   void programMirror(
       const SaiAclEntryHandle* aclEntryHandle,
       MirrorDirection direction,
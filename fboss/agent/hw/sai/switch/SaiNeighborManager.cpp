@@ -185,6 +185,15 @@ SaiNeighborHandle* SaiNeighborManager::getNeighborHandleImpl(
   return subscriber->getHandle();
 }
 
+std::optional<SaiPortDescriptor> SaiNeighborManager::getNeighborPort(
+    const SaiNeighborTraits::NeighborEntry& saiEntry) const {
+  auto itr = managedNeighbors_.find(saiEntry);
+  if (itr == managedNeighbors_.end()) {
+    return std::nullopt;
+  }
+  return itr->second->getPort();
+}
+
 bool SaiNeighborManager::isLinkUp(SaiPortDescriptor port) {
   if (port.isPhysicalPort()) {
     auto portHandle =
@@ -21,6 +21,7 @@
 
 #include <memory>
 #include <mutex>
+#include <optional>
 
 namespace facebook::fboss {
 
@@ -74,6 +75,10 @@ class ManagedNeighbor : public SaiObjectEventAggregateSubscriber<
     return handle_.get();
   }
 
+  SaiPortDescriptor getPort() const {
+    return port_;
+  }
+
   void notifySubscribers() const;
 
  private:
@@ -115,6 +120,10 @@ class SaiNeighborManager {
   const SaiNeighborHandle* getNeighborHandle(
       const SaiNeighborTraits::NeighborEntry& entry) const;
 
+  // Port (or aggregate port) the neighbor is resolved over, if known
+  std::optional<SaiPortDescriptor> getNeighborPort(
+      const SaiNeighborTraits::NeighborEntry& entry) const;
+
   void clear();
 
   std::shared_ptr<SaiNeighbor> createSaiObject(
@@ -91,6 +91,75 @@ std::shared_ptr<SaiNextHopGroupMember> SaiNextHopGroupManager::createSaiObject(
   return store.setObject(key, attributes);
 }
 
+std::optional<SaiPortDescriptor> SaiNextHopGroupManager::addMemberToPortIndex(
+    ManagedNextHopGroupMemberPtr member,
+    const SaiNeighborTraits::NeighborEntry& neighborEntry) {
+  auto port = managerTable_->neighborManager().getNeighborPort(neighborEntry);
+  if (port) {
+    portToMembers_[*port].insert(member);
+  }
+  return port;
+}
+
+void SaiNextHopGroupManager::removeMemberFromPortIndex(
+    ManagedNextHopGroupMemberPtr member,
+    SaiPortDescriptor port) {
+  auto itr = portToMembers_.find(port);
+  if (itr == portToMembers_.end()) {
+    return;
+  }
+  itr->second.erase(member);
+  if (itr->second.empty()) {
+    portToMembers_.erase(itr);
+  }
+}
+
+void SaiNextHopGroupManager::removeMemberFromPrunedIndex(
+    ManagedNextHopGroupMemberPtr member,
+    SaiPortDescriptor port) {
+  auto itr = portToPrunedMembers_.find(port);
+  if (itr == portToPrunedMembers_.end()) {
+    return;
+  }
+  itr->second.erase(member);
+  if (itr->second.empty()) {
+    portToPrunedMembers_.erase(itr);
+  }
+}
+
+void SaiNextHopGroupManager::handleLinkDown(SaiPortDescriptor port) {
+  auto itr = portToMembers_.find(port);
+  if (itr == portToMembers_.end()) {
+    return;
+  }
+  // Members remove themselves from the index, so detach the set first
+  auto members = std::move(itr->second);
+  portToMembers_.erase(itr);
+  XLOG(DBG2) << "Link down on " << port.str() << ", removing "
+             << members.size() << " next hop group members";
+  for (auto member : members) {
+    std::visit(
+        [port](auto managedMember) { managedMember->handleLinkDown(port); },
+        member);
+  }
+  portToPrunedMembers_[port].insert(members.begin(), members.end());
+}
+
+void SaiNextHopGroupManager::handleLinkUp(SaiPortDescriptor port) {
+  auto itr = portToPrunedMembers_.find(port);
+  if (itr == portToPrunedMembers_.end()) {
+    return;
+  }
+  auto members = std::move(itr->second);
+  portToPrunedMembers_.erase(itr);
+  XLOG(DBG2) << "Link up on " << port.str() << ", restoring up to "
+             << members.size() << " next hop group members";
+  for (auto member : members) {
+    std::visit(
+        [](auto managedMember) { managedMember->handleLinkUp(); }, member);
+  }
+}
+
 NextHopGroupMember::NextHopGroupMember(
     SaiNextHopGroupManager* manager,
     SaiNextHopGroupTraits::AdapterKey nexthopGroupId,
@@ -127,9 +196,68 @@ void ManagedSaiNextHopGroupMember<NextHopTraits>::createObject(
 
   auto object = manager_->createSaiObject(adapterHostKey, createAttributes);
   this->setObject(object);
+  forgetPrunedPort();
+  port_ = manager_->addMemberToPortIndex(
+      this, managedNextHop_->getNeighborEntry());
   XLOG(DBG2) << "ManagedSaiNextHopGroupMember::createObject: " << toString();
 }
 
+template <typename NextHopTraits>
+ManagedSaiNextHopGroupMember<NextHopTraits>::~ManagedSaiNextHopGroupMember() {
+  forgetPrunedPort();
+  removeMemberObject();
+}
+
+template <typename NextHopTraits>
+void ManagedSaiNextHopGroupMember<NextHopTraits>::removeObject(
+    size_t /*index*/,
+    PublisherObjects /*removed*/) {
+  XLOG(DBG2) << "ManagedSaiNextHopGroupMember::removeObject: " << toString();
+  /* remove nexthop group member if next hop is removed */
+  removeMemberObject();
+}
+
+template <typename NextHopTraits>
+void ManagedSaiNextHopGroupMember<NextHopTraits>::handleLinkDown(
+    SaiPortDescriptor port) {
+  XLOG(DBG2) << "ManagedSaiNextHopGroupMember::handleLinkDown: " << toString();
+  /*
+   * shrink the group right away rather than waiting for the link down to
+   * remove the next hop. member is created again on link up if the next hop
+   * survived, or else once the next hop is.
+   */
+  removeMemberObject();
+  prunedPort_ = port;
+}
+
+template <typename NextHopTraits>
+void ManagedSaiNextHopGroupMember<NextHopTraits>::handleLinkUp() {
+  // the manager already dropped the member from its pruned index
+  prunedPort_.reset();
+  if (this->isAlive() || !this->allPublishedObjectsAlive()) {
+    return;
+  }
+  XLOG(DBG2) << "ManagedSaiNextHopGroupMember::handleLinkUp: " << toString();
+  createObject(std::make_tuple(this->getPublisherObject()));
+}
+
+template <typename NextHopTraits>
+void ManagedSaiNextHopGroupMember<NextHopTraits>::forgetPrunedPort() {
+  if (prunedPort_) {
+    manager_->removeMemberFromPrunedIndex(this, *prunedPort_);
+    prunedPort_.reset();
+  }
+}
+
+template <typename NextHopTraits>
+void ManagedSaiNextHopGroupMember<NextHopTraits>::removeMemberObject() {
+  if (port_) {
+    manager_->removeMemberFromPortIndex(this, *port_);
+    port_.reset();
+  }
+  this->resetObject();
+}
+
 size_t SaiNextHopGroupHandle::nextHopGroupSize() const {
   return std::count_if(
       std::begin(members_), std::end(members_), [](auto member) {
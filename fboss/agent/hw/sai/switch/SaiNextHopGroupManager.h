@@ -21,6 +21,8 @@
 #include "fboss/lib/RefMap.h"
 
 #include <memory>
+#include <optional>
+#include <variant>
 #include "folly/container/F14Map.h"
 #include "folly/container/F14Set.h"
 
@@ -70,36 +72,44 @@ class ManagedSaiNextHopGroupMember
         nexthopGroupId_(nexthopGroupId),
         weight_(weight) {}
 
-  ~ManagedSaiNextHopGroupMember() {
-    this->resetObject();
-  }
+  ~ManagedSaiNextHopGroupMember();
 
   void createObject(PublisherObjects added);
 
-  void removeObject(size_t /*index*/, PublisherObjects /*removed*/) {
-    XLOG(DBG2) << "ManagedSaiNextHopGroupMember::removeObject: " << toString();
-    /* remove nexthop group member if next hop is removed */
-    this->resetObject();
-  }
+  void removeObject(size_t /*index*/, PublisherObjects /*removed*/);
 
+  // next hops don't publish link down, see
+  // SaiNextHopGroupManager::handleLinkDown
   void handleLinkDown() {}
 
+  // invoked by SaiNextHopGroupManager for members over a port
+  void handleLinkDown(SaiPortDescriptor port);
+  void handleLinkUp();
+
  private:
   std::string toString() const;
+  void removeMemberObject();
+  void forgetPrunedPort();
 
   SaiNextHopGroupManager* manager_;
   std::shared_ptr<ManagedNextHop<NextHopTraits>> managedNextHop_;
   SaiNextHopGroupTraits::AdapterKey nexthopGroupId_;
   NextHopWeight weight_;
+  // Port the next hop resolves over, while the member is programmed
+  std::optional<SaiPortDescriptor> port_;
+  // Port whose link down removed the member, until it is programmed again
+  std::optional<SaiPortDescriptor> prunedPort_;
 };
 
+using ManagedIpNextHopGroupMember =
+    ManagedSaiNextHopGroupMember<SaiIpNextHopTraits>;
+using ManagedMplsNextHopGroupMember =
+    ManagedSaiNextHopGroupMember<SaiMplsNextHopTraits>;
+using ManagedNextHopGroupMemberPtr = std::
+    variant<ManagedIpNextHopGroupMember*, ManagedMplsNextHopGroupMember*>;
+
 class NextHopGroupMember {
  public:
-  using ManagedIpNextHopGroupMember =
-      ManagedSaiNextHopGroupMember<SaiIpNextHopTraits>;
-  using ManagedMplsNextHopGroupMember =
-      ManagedSaiNextHopGroupMember<SaiMplsNextHopTraits>;
-
   NextHopGroupMember(
       SaiNextHopGroupManager* manager,
       SaiNextHopGroupTraits::AdapterKey nexthopGroupId,
@@ -145,10 +155,42 @@ class SaiNextHopGroupManager {
       const typename SaiNextHopGroupMemberTraits::AdapterHostKey& key,
       const typename SaiNextHopGroupMemberTraits::CreateAttributes& attributes);
 
+  /*
+   * Programmed members are indexed by the port their next hop's neighbor
+   * is resolved over, so that link down can prune them from all next hop
+   * groups in one pass, ahead of the fdb -> neighbor -> next hop cascade.
+   */
+  std::optional<SaiPortDescriptor> addMemberToPortIndex(
+      ManagedNextHopGroupMemberPtr member,
+      const SaiNeighborTraits::NeighborEntry& neighborEntry);
+  void removeMemberFromPortIndex(
+      ManagedNextHopGroupMemberPtr member,
+      SaiPortDescriptor port);
+  /*
+   * Members removed by a link down are remembered per port, so that link up
+   * can program again the ones whose next hop is still there. The others
+   * come back along with their next hop.
+   */
+  void removeMemberFromPrunedIndex(
+      ManagedNextHopGroupMemberPtr member,
+      SaiPortDescriptor port);
+
+  void handleLinkDown(SaiPortDescriptor port);
+  void handleLinkUp(SaiPortDescriptor port);
+
  private:
   SaiStore* saiStore_;
   SaiManagerTable* managerTable_;
   const SaiPlatform* platform_;
+  // Declared ahead of the members, which remove themselves on destruction
+  folly::F14FastMap<
+      SaiPortDescriptor,
+      folly::F14FastSet<ManagedNextHopGroupMemberPtr>>
+      portToMembers_;
+  folly::F14FastMap<
+      SaiPortDescriptor,
+      folly::F14FastSet<ManagedNextHopGroupMemberPtr>>
+      portToPrunedMembers_;
   // TODO(borisb): improve SaiObject/SaiStore to the point where they
   // support the next hop group use case correctly, rather than this
   // abomination of multiple levels of RefMaps :(
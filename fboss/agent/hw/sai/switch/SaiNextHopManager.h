@@ -72,6 +72,10 @@ class ManagedNextHop : public SaiObjectEventAggregateSubscriber<
     return key_;
   }
 
+  SaiNeighborTraits::NeighborEntry getNeighborEntry() const {
+    return this->getPublisherKey();
+  }
+
  private:
   std::string toString() const;
 
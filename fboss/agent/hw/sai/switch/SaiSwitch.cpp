@@ -303,6 +303,13 @@ void SaiSwitch::processLinkStateChangeDelta(
           platformPort->linkStatusChanged(
               newPort->isUp(), newPort->isEnabled());
         }
+        if (operStateChanged && newPort->isUp()) {
+          // next hop group members pruned on link down in the fast path
+          // are restored here, queued behind the link up like the
+          // neighbor updates that expand the groups
+          managerTable_->nextHopGroupManager().handleLinkUp(
+              SaiPortDescriptor(id));
+        }
       });
 }
 
@@ -497,6 +504,11 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImpl(
           const std::shared_ptr<AggregatePort>& newAggPort) {
         [[maybe_unused]] const auto& lock = lockPolicy.lock();
         managerTable_->lagManager().changeBridgePort(oldAggPort, newAggPort);
+        auto aggPortID = newAggPort->getID();
+        if (managerTable_->lagManager().isMinimumLinkMet(aggPortID)) {
+          managerTable_->nextHopGroupManager().handleLinkUp(
+              SaiPortDescriptor(aggPortID));
+        }
       });
 
   DeltaFunctions::forEachAdded(
@@ -763,6 +775,11 @@ uint64_t SaiSwitch::getDeviceWatermarkBytesLocked(
   return managerTable_->bufferManager().getDeviceWatermarkBytes();
 }
 
+MemoryUsageByType SaiSwitch::getMemoryUsage() {
+  std::lock_guard<std::mutex> lock(saiSwitchMutex_);
+  return saiStore_->getMemoryUsage();
+}
+
 folly::F14FastMap<std::string, HwPortStats> SaiSwitch::getPortStats() const {
   std::lock_guard<std::mutex> lock(saiSwitchMutex_);
   return getPortStatsLocked(lock);
@@ -932,12 +949,16 @@ void SaiSwitch::linkStateChangedCallbackBottomHalf(
         // once link comes back up LACP engine in SwSwitch will bundle it again
         managerTable_->lagManager().disableMember(swAggPort.value(), swPortId);
         if (!managerTable_->lagManager().isMinimumLinkMet(swAggPort.value())) {
-          // remove fdb entries on LAG, this would remove neighbors, next hops
-          // will point to drop and next hop group will shrink.
+          // shrink next hop groups right away, then remove fdb entries on
+          // LAG, this would remove neighbors and next hops will point to drop.
+          managerTable_->nextHopGroupManager().handleLinkDown(
+              SaiPortDescriptor(swAggPort.value()));
           managerTable_->fdbManager().handleLinkDown(
               SaiPortDescriptor(swAggPort.value()));
         }
       }
+      managerTable_->nextHopGroupManager().handleLinkDown(
+          SaiPortDescriptor(swPortId));
       managerTable_->fdbManager().handleLinkDown(SaiPortDescriptor(swPortId));
     }
     swPortId2Status[swPortId] = up;
@@ -102,6 +102,8 @@ class SaiSwitch : public HwSwitch {
 
   uint64_t getDeviceWatermarkBytes() const override;
 
+  MemoryUsageByType getMemoryUsage() override;
+
   void fetchL2Table(std::vector<L2EntryThrift>* l2Table) const override;
 
   void gracefulExit(folly::dynamic& switchState) override;
@@ -204,3 +204,74 @@ TEST_F(NextHopGroupManagerTest, testNextHopGroupMemberWeights) {
       SaiNextHopGroupMemberTraits::Attributes::Weight{});
   EXPECT_EQ(weight, 42);
 }
+
+TEST_F(NextHopGroupManagerTest, linkDown) {
+  auto arpEntry0 = resolveArp(intf0.id, h0);
+  auto arpEntry1 = resolveArp(intf1.id, h1);
+  ResolvedNextHop nh1{h0.ip, InterfaceID(intf0.id), ECMP_WEIGHT};
+  ResolvedNextHop nh2{h1.ip, InterfaceID(intf1.id), 2};
+  RouteNextHopEntry::NextHopSet swNextHops{nh1, nh2};
+  RouteNextHopEntry::NextHopSet swNextHops2{nh2};
+  auto saiNextHopGroupHandle =
+      saiManagerTable->nextHopGroupManager().incRefOrAddNextHopGroup(
+          swNextHops);
+  auto saiNextHopGroupHandle2 =
+      saiManagerTable->nextHopGroupManager().incRefOrAddNextHopGroup(
+          swNextHops2);
+  checkNextHopGroup(saiNextHopGroupHandle->adapterKey(), {h0.ip, h1.ip});
+  checkNextHopGroup(saiNextHopGroupHandle2->adapterKey(), {h1.ip});
+
+  // members over h1's port are pruned from every group
+  saiManagerTable->nextHopGroupManager().handleLinkDown(
+      SaiPortDescriptor(PortID(h1.port.id)));
+  checkNextHopGroup(saiNextHopGroupHandle->adapterKey(), {h0.ip});
+  checkNextHopGroup(saiNextHopGroupHandle2->adapterKey(), {});
+  EXPECT_EQ(saiNextHopGroupHandle->nextHopGroupSize(), 1);
+
+  // cascading link down through fdb entries is a no-op for pruned members
+  saiManagerTable->fdbManager().handleLinkDown(
+      SaiPortDescriptor(PortID(h1.port.id)));
+  checkNextHopGroup(saiNextHopGroupHandle->adapterKey(), {h0.ip});
+
+  saiManagerTable->nextHopGroupManager().handleLinkDown(
+      SaiPortDescriptor(PortID(h0.port.id)));
+  checkNextHopGroup(saiNextHopGroupHandle->adapterKey(), {});
+}
+
+TEST_F(NextHopGroupManagerTest, linkUp) {
+  auto arpEntry0 = resolveArp(intf0.id, h0);
+  auto arpEntry1 = resolveArp(intf1.id, h1);
+  ResolvedNextHop nh1{h0.ip, InterfaceID(intf0.id), ECMP_WEIGHT};
+  ResolvedNextHop nh2{h1.ip, InterfaceID(intf1.id), ECMP_WEIGHT};
+  RouteNextHopEntry::NextHopSet swNextHops{nh1, nh2};
+  auto saiNextHopGroupHandle =
+      saiManagerTable->nextHopGroupManager().incRefOrAddNextHopGroup(
+          swNextHops);
+  checkNextHopGroup(saiNextHopGroupHandle->adapterKey(), {h0.ip, h1.ip});
+
+  // link flaps before the fdb entries are removed, the next hop is still
+  // there and the member is programmed again on link up
+  saiManagerTable->nextHopGroupManager().handleLinkDown(
+      SaiPortDescriptor(PortID(h1.port.id)));
+  checkNextHopGroup(saiNextHopGroupHandle->adapterKey(), {h0.ip});
+  saiManagerTable->nextHopGroupManager().handleLinkUp(
+      SaiPortDescriptor(PortID(h1.port.id)));
+  checkNextHopGroup(saiNextHopGroupHandle->adapterKey(), {h0.ip, h1.ip});
+  EXPECT_EQ(saiNextHopGroupHandle->nextHopGroupSize(), 2);
+
+  // link up on another port doesn't restore anything
+  saiManagerTable->nextHopGroupManager().handleLinkDown(
+      SaiPortDescriptor(PortID(h0.port.id)));
+  saiManagerTable->nextHopGroupManager().handleLinkUp(
+      SaiPortDescriptor(PortID(h1.port.id)));
+  checkNextHopGroup(saiNextHopGroupHandle->adapterKey(), {h1.ip});
+
+  // once the cascade removed the next hop, link up alone can't restore the
+  // member, it comes back with the next hop
+  saiManagerTable->fdbManager().handleLinkDown(
+      SaiPortDescriptor(PortID(h0.port.id)));
+  saiManagerTable->nextHopGroupManager().handleLinkUp(
+      SaiPortDescriptor(PortID(h0.port.id)));
+  checkNextHopGroup(saiNextHopGroupHandle->adapterKey(), {h1.ip});
+  EXPECT_EQ(saiNextHopGroupHandle->nextHopGroupSize(), 1);
+}
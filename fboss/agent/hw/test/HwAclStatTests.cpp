@@ -406,6 +406,43 @@ TEST_F(HwAclStatTest, AclStatModify) {
   verifyAcrossWarmBoots(setup, verify, setupPostWB, verify);
 }
 
+TEST_F(HwAclStatTest, AclStatKeptOnActionChange) {
+  auto setup = [=]() {
+    auto newCfg = initialConfig();
+    addDscpAcl(&newCfg, "acl0");
+    utility::addAclStat(&newCfg, "acl0", "stat0");
+    applyNewConfig(newCfg);
+  };
+
+  auto verify = [=]() {
+    utility::checkAclEntryAndStatCount(
+        getHwSwitch(), /* ACLs */ 1, /* Stats */ 1, /*counters*/ 1);
+    utility::checkAclStat(
+        getHwSwitch(), getProgrammedState(), {"acl0"}, "stat0");
+  };
+
+  auto setupPostWB = [=]() {
+    // Same matchers and priority, so the entry is changed in place
+    auto newCfg = initialConfig();
+    addDscpAcl(&newCfg, "acl0");
+    utility::addAclStat(&newCfg, "acl0", "stat0");
+    cfg::QueueMatchAction queueAction;
+    *queueAction.queueId_ref() = 0;
+    cfg::MatchAction matchAction = cfg::MatchAction();
+    matchAction.sendToQueue_ref() = queueAction;
+    cfg::MatchToAction action = cfg::MatchToAction();
+    *action.matcher_ref() = "acl0";
+    *action.action_ref() = matchAction;
+    newCfg.dataPlaneTrafficPolicy_ref()->matchToAction_ref()->push_back(action);
+    applyNewConfig(newCfg);
+    // The stat was never removed
+    EXPECT_TRUE(facebook::fb303::fbData->getStatMap()->contains(
+        utility::statNameFromCounterType("stat0", cfg::CounterType::PACKETS)));
+  };
+
+  verifyAcrossWarmBoots(setup, verify, setupPostWB, verify);
+}
+
 TEST_F(HwAclStatTest, AclStatShuffle) {
   auto setup = [=]() {
     auto newCfg = initialConfig();
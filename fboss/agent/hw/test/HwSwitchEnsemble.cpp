@@ -114,12 +114,20 @@ std::shared_ptr<SwitchState> HwSwitchEnsemble::applyNewConfig(
   if (routingInformationBase_) {
     auto routeUpdater = getRouteUpdater();
     applyNewState(applyThriftConfig(
-        getProgrammedState(), &config, getPlatform(), &routeUpdater));
+        getProgrammedState(),
+        &config,
+        getPlatform(),
+        &routeUpdater,
+        &appliedConfigSections_));
     routeUpdater.program();
     return getProgrammedState();
   }
-  return applyNewState(
-      applyThriftConfig(getProgrammedState(), &config, getPlatform()));
+  return applyNewState(applyThriftConfig(
+      getProgrammedState(),
+      &config,
+      getPlatform(),
+      static_cast<RoutingInformationBase*>(nullptr),
+      &appliedConfigSections_));
 }
 
 std::shared_ptr<SwitchState> HwSwitchEnsemble::applyNewStateImpl(
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include "fboss/agent/ApplyThriftConfig.h"
 #include "fboss/agent/HwSwitch.h"
 #include "fboss/agent/L2Entry.h"
 #include "fboss/agent/hw/gen-cpp2/hardware_stats_types.h"
@@ -231,6 +232,7 @@ class HwSwitchEnsemble : public HwSwitch::Callback {
 
   std::shared_ptr<SwitchState> programmedState_{nullptr};
   std::unique_ptr<RoutingInformationBase> routingInformationBase_;
+  AppliedConfigSections appliedConfigSections_;
   std::unique_ptr<HwLinkStateToggler> linkToggler_;
   std::unique_ptr<Platform> platform_;
   const Features featuresDesired_;
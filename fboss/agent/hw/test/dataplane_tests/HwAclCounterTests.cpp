@@ -61,6 +61,58 @@ class HwAclCounterTest : public HwLinkStateDependentTest {
     verifyAcrossWarmBoots(setup, verify);
   }
 
+  // Changing the ACL action in place keeps the counts of its counter
+  void counterKeptOnAclChangeHelper(bool frontPanel) {
+    auto setup = [this]() {
+      applyNewState(helper_->resolveNextHops(getProgrammedState(), 2));
+      helper_->programRoutes(getRouteUpdater(), kEcmpWidth);
+      auto newCfg{initialConfig()};
+      addTtlAclStat(&newCfg);
+      applyNewConfig(newCfg);
+    };
+
+    auto verify = [this, frontPanel]() {
+      auto statBefore = utility::getAclInOutPackets(
+          getHwSwitch(), getProgrammedState(), kAclName, kCounterName);
+      sendPacket(frontPanel, 200);
+      auto statAfterHit = utility::getAclInOutPackets(
+          getHwSwitch(), getProgrammedState(), kAclName, kCounterName);
+      EXPECT_EQ(statBefore + 2, statAfterHit);
+
+      // Same matchers and priority, only another action
+      auto newCfg{initialConfig()};
+      addTtlAclStat(&newCfg);
+      cfg::QueueMatchAction queueAction;
+      *queueAction.queueId_ref() = 0;
+      cfg::MatchAction matchAction;
+      matchAction.sendToQueue_ref() = queueAction;
+      cfg::MatchToAction action;
+      *action.matcher_ref() = kAclName;
+      *action.action_ref() = matchAction;
+      newCfg.dataPlaneTrafficPolicy_ref()->matchToAction_ref()->push_back(
+          action);
+      applyNewConfig(newCfg);
+      EXPECT_EQ(
+          statAfterHit,
+          utility::getAclInOutPackets(
+              getHwSwitch(), getProgrammedState(), kAclName, kCounterName));
+
+      // And the changed entry keeps counting
+      sendPacket(frontPanel, 200);
+      EXPECT_EQ(
+          statAfterHit + 2,
+          utility::getAclInOutPackets(
+              getHwSwitch(), getProgrammedState(), kAclName, kCounterName));
+
+      // Back to the initial config for the next verify
+      auto initialCfg{initialConfig()};
+      addTtlAclStat(&initialCfg);
+      applyNewConfig(initialCfg);
+    };
+
+    verifyAcrossWarmBoots(setup, verify);
+  }
+
  private:
   void sendPacket(bool frontPanel, uint8_t ttl) {
     auto vlanId = VlanID(*initialConfig().vlanPorts_ref()[0].vlanID_ref());
@@ -138,4 +190,14 @@ TEST_F(HwAclCounterTest, VerifyCounterNoHitNoBumpCpu) {
   counterBumpOnHitHelper(false /* no hit, no bump */, false /* cpu port */);
 }
 
+// Verify that changing the ACL action does not reset its counter.
+TEST_F(HwAclCounterTest, VerifyCounterKeptOnAclChangeFrontPanel) {
+  counterKeptOnAclChangeHelper(true /* front panel port */);
+}
+
+// Verify that changing the ACL action does not reset its counter.
+TEST_F(HwAclCounterTest, VerifyCounterKeptOnAclChangeCpu) {
+  counterKeptOnAclChangeHelper(false /* cpu port */);
+}
+
 } // namespace facebook::fboss
@@ -120,6 +120,51 @@ struct RouteDetails {
   9: optional RouteCounterID counterID;
 }
 
+/*
+ * Restricts the routes returned by the route table streaming and
+ * incremental APIs. Unset fields match all routes.
+ */
+struct RouteTableFilter {
+  1: optional i32 vrf;
+  // Only routes contained in this prefix (including the prefix itself)
+  2: optional IpPrefix prefix;
+  // Only routes with an entry from this client
+  3: optional i16 clientId;
+}
+
+struct UnicastRoutePage {
+  1: list<UnicastRoute> routes;
+  // SwitchState generation of the snapshot the stream is served from
+  2: i64 generation;
+  // Agent run the generation belongs to
+  3: i64 runId;
+}
+
+struct RouteDetailsPage {
+  1: list<RouteDetails> routes;
+  // SwitchState generation of the snapshot the stream is served from
+  2: i64 generation;
+  // Agent run the generation belongs to
+  3: i64 runId;
+}
+
+struct RouteTableChanges {
+  // SwitchState generation the changes were computed against. Pass it to
+  // the next getRouteTableChangesSince call.
+  1: i64 generation;
+  // Changes since the requested generation are no longer tracked (or the
+  // generation is from another agent run), the full route table needs to
+  // be fetched again. changedRoutes/removedRoutes are empty.
+  2: bool fullSyncRequired;
+  // Routes added or modified since the requested generation
+  3: list<RouteDetails> changedRoutes;
+  // Routes deleted since the requested generation
+  4: list<IpPrefix> removedRoutes;
+  // Agent run the generation belongs to. Pass it to the next
+  // getRouteTableChangesSince call along with the generation.
+  5: i64 runId;
+}
+
 struct MplsRouteDetails {
   1: mpls.MplsLabel topLabel;
   2: string action;
@@ -577,6 +622,51 @@ struct ClientInformation {
   2: optional fbstring hostname;
 }
 
+/*
+ * Latency breakdown of a SwitchState update. Updates coalesced into one
+ * SwitchState change report the HW programming and observer notification
+ * time of the whole batch.
+ */
+struct StateUpdateTrace {
+  1: string name;
+  // Time the update completed, in ms since epoch
+  2: i64 endTimeMs;
+  // Time spent in the pending updates queue
+  3: i64 queueWaitUs;
+  // Time spent in the update function
+  4: i64 applyUs;
+  5: i64 hwProgramUs;
+  6: i64 observersUs;
+  // Time spent in the update's completion (success or error) callback
+  7: i64 completionUs;
+  8: i32 batchSize;
+  // Generation of the resulting SwitchState, 0 if the state did not change
+  9: i64 generation;
+  10: bool failed;
+}
+
+struct MemoryUsageThrift {
+  1: i64 bytes;
+  2: i64 objects;
+}
+
+/*
+ * Approximate memory used by the agent's main data structures. Byte counts
+ * are estimated from object sizes, allocator overhead is not included.
+ */
+struct MemoryUsageReport {
+  // Subtrees of the current SwitchState
+  1: map<string, MemoryUsageThrift> switchState;
+  // RIB radix trees. The routes are shared with the FIBs in switchState.
+  2: map<string, MemoryUsageThrift> rib;
+  // ARP and NDP caches
+  3: map<string, MemoryUsageThrift> neighborCaches;
+  // Software copies of HW objects kept by the HwSwitch, by object type
+  4: map<string, MemoryUsageThrift> hwSwitch;
+  // Published SwitchState generations still alive besides the current one
+  5: i64 oldSwitchStateGenerations;
+}
+
 enum HwObjectType {
   PORT = 0,
   LAG = 1,
@@ -787,6 +877,37 @@ service FbossCtrl extends fb303.FacebookService {
   list<RouteDetails> getRouteTableDetailsByClients(
     1: list<i16> clientId,
   ) throws (1: fboss.FbossBaseError error);
+
+  /*
+   * Streaming variants of getRouteTable/getRouteTableDetails. Routes are
+   * served from a single SwitchState snapshot, in pages of up to pageSize
+   * routes (a default page size is used if pageSize <= 0). The first page is
+   * always sent, even if empty, to convey the snapshot generation.
+   * With filter.clientId set, streamRouteTable returns the client's
+   * next hops, like getRouteTableByClient.
+   * Agents built without coroutine support reject these calls.
+   */
+  stream<UnicastRoutePage> streamRouteTable(
+    1: RouteTableFilter filter,
+    2: i32 pageSize,
+  ) throws (1: fboss.FbossBaseError error);
+  stream<RouteDetailsPage> streamRouteTableDetails(
+    1: RouteTableFilter filter,
+    2: i32 pageSize,
+  ) throws (1: fboss.FbossBaseError error);
+
+  /*
+   * Routes added, changed or removed after SwitchState generation
+   * 'generation', e.g. as returned by a previous call or by the route
+   * table stream. Generations are only meaningful within one agent run:
+   * 'runId' is the run they were returned with, and a full sync is required
+   * if it is not the current one (e.g. after an agent restart).
+   */
+  RouteTableChanges getRouteTableChangesSince(
+    1: i64 generation,
+    2: RouteTableFilter filter,
+    3: i64 runId,
+  ) throws (1: fboss.FbossBaseError error);
   InterfaceDetail getInterfaceDetail(1: i32 interfaceId) throws (
     1: fboss.FbossBaseError error,
   );
@@ -944,6 +1065,21 @@ service FbossCtrl extends fb303.FacebookService {
    * on a box
    */
   string getHwDebugDump();
+
+  /*
+   * Latency breakdown of the most recent SwitchState updates, oldest first
+   */
+  list<StateUpdateTrace> getStateUpdateTraces() throws (
+    1: fboss.FbossBaseError error,
+  );
+
+  /*
+   * Memory used by the SwitchState, RIB, neighbor caches and HW object
+   * caches. Walks all of them, so not meant to be polled frequently.
+   */
+  MemoryUsageReport getAgentMemoryUsage() throws (
+    1: fboss.FbossBaseError error,
+  );
   /*
    * String formatted information of givens Hw Objects.
    */
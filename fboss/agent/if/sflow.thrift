@@ -32,3 +32,11 @@ struct SflowPacketInfo {
   // Payload removed
   9: i32 payloadRemoved
 }
+
+//
+// Multiple samples packed into a single datagram. Only sent when the exporter
+// is configured to pack more than one sample per datagram.
+//
+struct SflowPacketInfoBatch {
+  1: list<SflowPacketInfo> samples
+}
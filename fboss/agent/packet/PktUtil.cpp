@@ -9,6 +9,7 @@
  */
 #include "fboss/agent/packet/PktUtil.h"
 
+#include <folly/Bits.h>
 #include <folly/Format.h>
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
@@ -16,6 +17,14 @@
 #include <folly/io/Cursor.h>
 #include "fboss/agent/FbossError.h"
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+
 using folly::ByteRange;
 using folly::IOBuf;
 using folly::IPAddressV4;
@@ -26,6 +35,73 @@ using folly::io::Appender;
 using folly::io::Cursor;
 using std::string;
 
+namespace {
+
+/*
+ * Sum of the 16 bit words in [data, data + length) read in host byte order,
+ * without folding the carries. An odd last byte is padded with a zero byte.
+ *
+ * By RFC 1071 section 2 (B), summing 32 bit words instead of 16 bit ones
+ * yields the same one's complement sum once folded, which lets the vector
+ * loops add whole lanes into 64 bit accumulators that can't overflow.
+ */
+uint64_t onesComplementSum(const uint8_t* data, size_t length) {
+  uint64_t sum = 0;
+#if defined(__AVX2__)
+  if (length >= 32) {
+    const auto zero = _mm256_setzero_si256();
+    auto acc = _mm256_setzero_si256();
+    for (; length >= 32; data += 32, length -= 32) {
+      auto words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+      acc = _mm256_add_epi64(acc, _mm256_unpacklo_epi32(words, zero));
+      acc = _mm256_add_epi64(acc, _mm256_unpackhi_epi32(words, zero));
+    }
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    sum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  }
+#elif defined(__SSE2__)
+  if (length >= 16) {
+    const auto zero = _mm_setzero_si128();
+    auto acc = _mm_setzero_si128();
+    for (; length >= 16; data += 16, length -= 16) {
+      auto words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+      acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(words, zero));
+      acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(words, zero));
+    }
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    sum += lanes[0] + lanes[1];
+  }
+#endif
+  for (; length >= 4; data += 4, length -= 4) {
+    sum += folly::loadUnaligned<uint32_t>(data);
+  }
+  if (length >= 2) {
+    sum += folly::loadUnaligned<uint16_t>(data);
+    data += 2;
+    length -= 2;
+  }
+  if (length) {
+    // Bytes are interpreted in n/w byte order, so this last octet is the
+    // first byte of a 16 bit word whose second byte is zero.
+    const uint8_t last[2] = {*data, 0};
+    sum += folly::loadUnaligned<uint16_t>(last);
+  }
+  return sum;
+}
+
+// Fold a sum from onesComplementSum() to the 16 bit sum of the words read in
+// n/w byte order
+uint16_t foldWordSum(uint64_t sum) {
+  while (sum >> 16) {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+  return folly::Endian::big(static_cast<uint16_t>(sum));
+}
+
+} // namespace
+
 namespace facebook::fboss {
 
 MacAddress PktUtil::readMac(Cursor* cursor) {
@@ -68,8 +144,7 @@ uint16_t PktUtil::internetChecksum(folly::io::Cursor start, uint64_t length) {
 }
 
 uint16_t PktUtil::internetChecksum(const uint8_t* buffer, uint32_t size) {
-  auto buf = IOBuf(IOBuf::WRAP_BUFFER, buffer, size);
-  return finalizeChecksum(Cursor(&buf), size, 0);
+  return finalizeChecksum(foldWordSum(onesComplementSum(buffer, size)));
 }
 
 uint16_t PktUtil::internetChecksum(const IOBuf* buf) {
@@ -80,20 +155,30 @@ uint32_t PktUtil::partialChecksumImpl(
     folly::io::Cursor cursor,
     uint64_t length,
     uint32_t value) {
-  // Checksum all the pairs of bytes first
-  while (length > 1) {
-    value += cursor.readBE<uint16_t>();
-    length -= 2;
+  // Sum each contiguous segment of the chain directly
+  uint64_t sum = value;
+  bool oddOffset = false;
+  while (length > 0) {
+    auto segment = cursor.peekBytes();
+    if (segment.empty()) {
+      // Throws std::out_of_range, like reading past the end would
+      cursor.skip(length);
+    }
+    auto segmentLength = std::min<uint64_t>(segment.size(), length);
+    auto segmentSum = foldWordSum(
+        onesComplementSum(segment.data(), segmentLength));
+    // A segment starting at an odd offset has its bytes summed in the wrong
+    // halves of the 16 bit words. The byte order independence of the sum
+    // (RFC 1071 section 2 (B)) means swapping its bytes fixes that.
+    sum += oddOffset ? folly::Endian::swap(segmentSum) : segmentSum;
+    oddOffset ^= (segmentLength & 1);
+    cursor.skip(segmentLength);
+    length -= segmentLength;
   }
-  if (length) {
-    // Bytes are interpreted in n/w byte order
-    // so this last octet represents the 8 MSbits
-    // of the last 16 bit number in this buffer.
-    uint16_t last = cursor.read<uint8_t>();
-    value += (last << 8);
-    --length;
+  while (sum >> 32) {
+    sum = (sum & 0xffffffff) + (sum >> 32);
   }
-  return value;
+  return sum;
 }
 
 uint32_t PktUtil::partialChecksum(
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/packet/PktUtil.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
+
+#include <limits>
+#include <memory>
+
+using namespace facebook::fboss;
+using folly::IOBuf;
+using folly::io::Cursor;
+
+namespace {
+
+std::unique_ptr<IOBuf> randomPacket(size_t size, size_t numSegments) {
+  std::unique_ptr<IOBuf> chain;
+  // Odd sized segments, so that every other one starts at an odd offset
+  auto segmentSize = (size / numSegments) | 1;
+  for (size_t i = 0; i < numSegments; ++i) {
+    auto length = i + 1 == numSegments ? size - i * segmentSize : segmentSize;
+    auto segment = IOBuf::create(length);
+    segment->append(length);
+    for (size_t byte = 0; byte < length; ++byte) {
+      segment->writableData()[byte] =
+          folly::Random::rand32(std::numeric_limits<uint8_t>::max());
+    }
+    if (chain) {
+      chain->prependChain(std::move(segment));
+    } else {
+      chain = std::move(segment);
+    }
+  }
+  return chain;
+}
+
+// The checksum as computed before it was vectorized, 16 bits at a time
+uint16_t cursorChecksum(const IOBuf* buf) {
+  Cursor cursor(buf);
+  auto length = buf->computeChainDataLength();
+  uint32_t sum = 0;
+  while (length > 1) {
+    sum += cursor.readBE<uint16_t>();
+    length -= 2;
+  }
+  if (length) {
+    sum += cursor.read<uint8_t>() << 8;
+  }
+  return PktUtil::finalizeChecksum(sum);
+}
+
+void cursorChecksumBenchmark(uint32_t iters, size_t size) {
+  std::unique_ptr<IOBuf> pkt;
+  BENCHMARK_SUSPEND {
+    pkt = randomPacket(size, 1);
+  }
+  for (uint32_t i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(cursorChecksum(pkt.get()));
+  }
+}
+
+void checksumBenchmark(uint32_t iters, size_t size, size_t numSegments) {
+  std::unique_ptr<IOBuf> pkt;
+  BENCHMARK_SUSPEND {
+    pkt = randomPacket(size, numSegments);
+  }
+  for (uint32_t i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(PktUtil::internetChecksum(pkt.get()));
+  }
+}
+
+void contiguousChecksumBenchmark(uint32_t iters, size_t size) {
+  checksumBenchmark(iters, size, 1);
+}
+
+void chainedChecksumBenchmark(uint32_t iters, size_t size) {
+  checksumBenchmark(iters, size, 3);
+}
+
+} // namespace
+
+BENCHMARK_PARAM(cursorChecksumBenchmark, 64)
+BENCHMARK_RELATIVE_PARAM(contiguousChecksumBenchmark, 64)
+BENCHMARK_RELATIVE_PARAM(chainedChecksumBenchmark, 64)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(cursorChecksumBenchmark, 127)
+BENCHMARK_RELATIVE_PARAM(contiguousChecksumBenchmark, 127)
+BENCHMARK_RELATIVE_PARAM(chainedChecksumBenchmark, 127)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(cursorChecksumBenchmark, 576)
+BENCHMARK_RELATIVE_PARAM(contiguousChecksumBenchmark, 576)
+BENCHMARK_RELATIVE_PARAM(chainedChecksumBenchmark, 576)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(cursorChecksumBenchmark, 1501)
+BENCHMARK_RELATIVE_PARAM(contiguousChecksumBenchmark, 1501)
+BENCHMARK_RELATIVE_PARAM(chainedChecksumBenchmark, 1501)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(cursorChecksumBenchmark, 9000)
+BENCHMARK_RELATIVE_PARAM(contiguousChecksumBenchmark, 9000)
+BENCHMARK_RELATIVE_PARAM(chainedChecksumBenchmark, 9000)
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
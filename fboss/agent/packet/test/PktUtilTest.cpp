@@ -18,6 +18,9 @@
 #include <folly/logging/xlog.h>
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+#include <vector>
+
 using namespace facebook::fboss;
 using folly::IOBuf;
 using folly::IPAddressV4;
@@ -222,3 +225,35 @@ TEST(Checksum, TestKnownOdd) {
   expected = ~expected;
   EXPECT_EQ(expected, PktUtil::internetChecksum(bytes, 9));
 }
+
+TEST(Checksum, TestChainOddSegments) {
+  // Same bytes as TestKnownOdd, split so that segments start at odd offsets
+  uint8_t bytes[] = {0x00, 0x01, 0xf2, 0x03, 0xf4, 0xf5, 0xf6, 0xf7, 0x01};
+  auto chain = IOBuf::copyBuffer(bytes, 1);
+  chain->prependChain(IOBuf::copyBuffer(bytes + 1, 4));
+  chain->prependChain(IOBuf::create(0));
+  chain->prependChain(IOBuf::copyBuffer(bytes + 5, 3));
+  chain->prependChain(IOBuf::copyBuffer(bytes + 8, 1));
+  uint16_t expected = 0xdef2;
+  expected = ~expected;
+  EXPECT_EQ(expected, PktUtil::internetChecksum(chain.get()));
+  EXPECT_EQ(expected, PktUtil::internetChecksum(Cursor(chain.get()), 9));
+  EXPECT_THROW(
+      PktUtil::internetChecksum(Cursor(chain.get()), 10), std::out_of_range);
+}
+
+TEST(Checksum, TestChainMatchesFlat) {
+  // Long enough to go through the vectorized loops
+  std::vector<uint8_t> bytes(1500);
+  for (auto& byte : bytes) {
+    byte = Random::rand32(std::numeric_limits<uint8_t>::max());
+  }
+  auto expected = PktUtil::internetChecksum(bytes.data(), bytes.size());
+  for (auto split : {1, 31, 64, 333, 1499}) {
+    auto chain = IOBuf::copyBuffer(bytes.data(), split);
+    chain->prependChain(
+        IOBuf::copyBuffer(bytes.data() + split, bytes.size() - split));
+    EXPECT_EQ(expected, PktUtil::internetChecksum(chain.get()))
+        << "split at " << split;
+  }
+}
@@ -80,6 +80,74 @@ void reconstructRibFromFib(
             route->prefix().network, route->prefix().mask, route);
       });
 }
+std::vector<RibRouteUpdater::RouteEntry> toRouteEntries(
+    const std::vector<UnicastRoute>& toAdd,
+    AdminDistance adminDistanceFromClientID,
+    RoutingInformationBase::UpdateStatistics& stats) {
+  std::vector<RibRouteUpdater::RouteEntry> toAddRoutes;
+  toAddRoutes.reserve(toAdd.size());
+
+  std::for_each(
+      toAdd.begin(),
+      toAdd.end(),
+      [adminDistanceFromClientID, &stats, &toAddRoutes](const auto& route) {
+        auto network =
+            facebook::network::toIPAddress(*route.dest_ref()->ip_ref());
+        auto mask = static_cast<uint8_t>(*route.dest_ref()->prefixLength_ref());
+        std::optional<RouteCounterID> counterID;
+        if (route.counterID_ref().has_value()) {
+          counterID = route.counterID_ref().value();
+        }
+        if (network.isV4()) {
+          ++stats.v4RoutesAdded;
+        } else {
+          ++stats.v6RoutesAdded;
+        }
+        toAddRoutes.push_back(
+            {{network, mask},
+             RouteNextHopEntry::from(
+                 route, adminDistanceFromClientID, counterID)});
+      });
+  return toAddRoutes;
+}
+
+std::vector<folly::CIDRNetwork> toPrefixes(
+    const std::vector<IpPrefix>& toDelete,
+    RoutingInformationBase::UpdateStatistics& stats) {
+  std::vector<folly::CIDRNetwork> toDelPrefixes;
+  toDelPrefixes.reserve(toDelete.size());
+  std::for_each(
+      toDelete.begin(),
+      toDelete.end(),
+      [&stats, &toDelPrefixes](const auto& prefix) {
+        auto network = facebook::network::toIPAddress(*prefix.ip_ref());
+        auto mask = static_cast<uint8_t>(*prefix.prefixLength_ref());
+
+        if (network.isV4()) {
+          ++stats.v4RoutesDeleted;
+        } else {
+          ++stats.v6RoutesDeleted;
+        }
+        toDelPrefixes.push_back({network, mask});
+      });
+  return toDelPrefixes;
+}
+
+template <typename TreeNode>
+uint64_t countRadixTreeNodes(const TreeNode* node) {
+  if (!node) {
+    return 0;
+  }
+  return 1 + countRadixTreeNodes(node->left()) +
+      countRadixTreeNodes(node->right());
+}
+
+template <typename Tree>
+MemoryUsage radixTreeMemoryUsage(const Tree& tree) {
+  // Includes the nodes without a route, that only join subtrees
+  auto nodes = countRadixTreeNodes(tree.root());
+  return MemoryUsage{nodes * sizeof(typename Tree::TreeNode), nodes};
+}
 } // namespace
 
 template <typename RibUpdateFn>
@@ -196,6 +264,23 @@ void RibRouteTables::update(
   updateFib(routerID, fibUpdateCallback, cookie);
 }
 
+void RibRouteTables::update(
+    RouterID routerID,
+    const std::map<ClientID, std::vector<RibRouteUpdater::RouteEntry>>&
+        toAddRoutes,
+    const std::map<ClientID, std::vector<folly::CIDRNetwork>>& toDelPrefixes,
+    const std::set<ClientID>& resetClientsRoutesFor,
+    folly::StringPiece updateType,
+    const FibUpdateFunction& fibUpdateCallback,
+    void* cookie) {
+  updateRib(routerID, [&](auto& routeTable) {
+    RibRouteUpdater updater(
+        &(routeTable.v4NetworkToRoute), &(routeTable.v6NetworkToRoute));
+    updater.update(toAddRoutes, toDelPrefixes, resetClientsRoutesFor);
+  });
+  updateFib(routerID, fibUpdateCallback, cookie);
+}
+
 void RibRouteTables::updateFib(
     RouterID vrf,
     const FibUpdateFunction& fibUpdateCallback,
@@ -238,6 +323,16 @@ std::vector<RouterID> RibRouteTables::getVrfList() const {
   return res;
 }
 
+MemoryUsageByType RibRouteTables::getMemoryUsage() const {
+  MemoryUsageByType usage;
+  auto lockedRouteTables = synchronizedRouteTables_.rlock();
+  for (const auto& [vrf, routeTable] : *lockedRouteTables) {
+    usage["v4RadixTree"] += radixTreeMemoryUsage(routeTable.v4NetworkToRoute);
+    usage["v6RadixTree"] += radixTreeMemoryUsage(routeTable.v6NetworkToRoute);
+  }
+  return usage;
+}
+
 void RibRouteTables::setClassID(
     RouterID rid,
     const std::vector<folly::CIDRNetwork>& prefixes,
@@ -379,48 +474,8 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::update(
   Timer updateTimer(&duration);
   std::exception_ptr updateException;
   auto updateFn = [&]() {
-    std::vector<RibRouteUpdater::RouteEntry> toAddRoutes;
-    toAddRoutes.reserve(toAdd.size());
-
-    std::for_each(
-        toAdd.begin(),
-        toAdd.end(),
-        [clientID, adminDistanceFromClientID, &stats, &toAddRoutes](
-            const auto& route) {
-          auto network =
-              facebook::network::toIPAddress(*route.dest_ref()->ip_ref());
-          auto mask =
-              static_cast<uint8_t>(*route.dest_ref()->prefixLength_ref());
-          std::optional<RouteCounterID> counterID;
-          if (route.counterID_ref().has_value()) {
-            counterID = route.counterID_ref().value();
-          }
-          if (network.isV4()) {
-            ++stats.v4RoutesAdded;
-          } else {
-            ++stats.v6RoutesAdded;
-          }
-          toAddRoutes.push_back(
-              {{network, mask},
-               RouteNextHopEntry::from(
-                   route, adminDistanceFromClientID, counterID)});
-        });
-    std::vector<folly::CIDRNetwork> toDelPrefixes;
-    toDelPrefixes.reserve(toDelete.size());
-    std::for_each(
-        toDelete.begin(),
-        toDelete.end(),
-        [&stats, &toDelPrefixes](const auto& prefix) {
-          auto network = facebook::network::toIPAddress(*prefix.ip_ref());
-          auto mask = static_cast<uint8_t>(*prefix.prefixLength_ref());
-
-          if (network.isV4()) {
-            ++stats.v4RoutesDeleted;
-          } else {
-            ++stats.v6RoutesDeleted;
-          }
-          toDelPrefixes.push_back({network, mask});
-        });
+    auto toAddRoutes = toRouteEntries(toAdd, adminDistanceFromClientID, stats);
+    auto toDelPrefixes = toPrefixes(toDelete, stats);
 
     try {
       ribTables_.update(
@@ -445,6 +500,55 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::update(
   return stats;
 }
 
+RoutingInformationBase::UpdateStatistics RoutingInformationBase::update(
+    RouterID routerID,
+    const std::map<ClientID, ClientRouteUpdate>& clientUpdates,
+    folly::StringPiece updateType,
+    FibUpdateFunction fibUpdateCallback,
+    void* cookie) {
+  ensureRunning();
+  UpdateStatistics stats;
+  std::exception_ptr updateException;
+  auto updateFn = [&]() {
+    std::map<ClientID, std::vector<RibRouteUpdater::RouteEntry>> toAddRoutes;
+    std::map<ClientID, std::vector<folly::CIDRNetwork>> toDelPrefixes;
+    std::set<ClientID> resetClientsRoutesFor;
+    for (const auto& [clientID, clientUpdate] : clientUpdates) {
+      toAddRoutes.emplace(
+          clientID,
+          toRouteEntries(
+              clientUpdate.toAdd,
+              clientUpdate.adminDistanceFromClientID,
+              stats));
+      toDelPrefixes.emplace(clientID, toPrefixes(clientUpdate.toDelete, stats));
+      if (clientUpdate.resetClientsRoutes) {
+        resetClientsRoutesFor.insert(clientID);
+      }
+    }
+
+    try {
+      ribTables_.update(
+          routerID,
+          toAddRoutes,
+          toDelPrefixes,
+          resetClientsRoutesFor,
+          updateType,
+          fibUpdateCallback,
+          cookie);
+    } catch (const std::exception& e) {
+      updateException = std::current_exception();
+    }
+  };
+  {
+    Timer updateTimer(&stats.duration);
+    ribUpdateEventBase_.runInEventBaseThreadAndWait(updateFn);
+  }
+  if (updateException) {
+    std::rethrow_exception(updateException);
+  }
+  return stats;
+}
+
 void RoutingInformationBase::setClassIDImpl(
     RouterID rid,
     const std::vector<folly::CIDRNetwork>& prefixes,
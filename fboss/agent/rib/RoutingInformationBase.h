@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include "fboss/agent/MemoryUsage.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/if/gen-cpp2/FbossCtrl.h"
 #include "fboss/agent/rib/NetworkToRouteMap.h"
@@ -18,7 +19,9 @@
 #include <folly/Synchronized.h>
 
 #include <functional>
+#include <map>
 #include <memory>
+#include <set>
 #include <thread>
 #include <vector>
 
@@ -50,6 +53,16 @@ class RibRouteTables {
       folly::StringPiece updateType,
       const FibUpdateFunction& fibUpdateCallback,
       void* cookie);
+  // Update routes of several clients with a single resolution and FIB update
+  void update(
+      RouterID routerID,
+      const std::map<ClientID, std::vector<RibRouteUpdater::RouteEntry>>&
+          toAddRoutes,
+      const std::map<ClientID, std::vector<folly::CIDRNetwork>>& toDelPrefixes,
+      const std::set<ClientID>& resetClientsRoutesFor,
+      folly::StringPiece updateType,
+      const FibUpdateFunction& fibUpdateCallback,
+      void* cookie);
 
   void setClassID(
       RouterID rid,
@@ -95,6 +108,12 @@ class RibRouteTables {
   void ensureVrf(RouterID rid);
   std::vector<RouterID> getVrfList() const;
   std::vector<RouteDetails> getRouteTableDetails(RouterID rid) const;
+  /*
+   * Approximate memory used by the route tables' radix trees. The routes
+   * themselves are shared with the FIBs in the SwitchState and accounted
+   * for there.
+   */
+  MemoryUsageByType getMemoryUsage() const;
 
   template <typename AddressT>
   std::shared_ptr<Route<AddressT>> longestMatch(
@@ -200,6 +219,24 @@ class RoutingInformationBase {
       FibUpdateFunction fibUpdateCallback,
       void* cookie);
 
+  struct ClientRouteUpdate {
+    const std::vector<UnicastRoute>& toAdd;
+    const std::vector<IpPrefix>& toDelete;
+    AdminDistance adminDistanceFromClientID;
+    bool resetClientsRoutes;
+  };
+  /*
+   * Same as above for several clients of a VRF at once. Their routes are
+   * resolved and programmed to the FIB in a single pass instead of one per
+   * client.
+   */
+  UpdateStatistics update(
+      RouterID routerID,
+      const std::map<ClientID, ClientRouteUpdate>& clientUpdates,
+      folly::StringPiece updateType,
+      FibUpdateFunction fibUpdateCallback,
+      void* cookie);
+
   /*
    * VrfAndNetworkToInterfaceRoute is conceptually a mapping from the pair
    * (RouterID, folly::CIDRNetwork) to the pair (Interface(1),
@@ -265,6 +302,9 @@ class RoutingInformationBase {
   std::vector<RouteDetails> getRouteTableDetails(RouterID rid) const {
     return ribTables_.getRouteTableDetails(rid);
   }
+  MemoryUsageByType getMemoryUsage() const {
+    return ribTables_.getMemoryUsage();
+  }
 
   void waitForRibUpdates() {
     ensureRunning();
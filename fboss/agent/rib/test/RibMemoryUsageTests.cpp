@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/Utils.h"
+#include "fboss/agent/rib/FibUpdateHelpers.h"
+#include "fboss/agent/rib/RoutingInformationBase.h"
+
+#include <folly/IPAddress.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace facebook::fboss;
+using folly::IPAddress;
+
+namespace {
+const RouterID kRid0(0);
+
+void updateRib(
+    RoutingInformationBase& rib,
+    const std::vector<UnicastRoute>& toAdd,
+    const std::vector<IpPrefix>& toDelete) {
+  rib.update(
+      kRid0,
+      ClientID::BGPD,
+      AdminDistance::EBGP,
+      toAdd,
+      toDelete,
+      false,
+      "Rib only update",
+      noopFibUpdate,
+      nullptr);
+}
+} // namespace
+
+TEST(RibMemoryUsage, CountsRadixTreeNodes) {
+  RoutingInformationBase rib;
+  rib.ensureVrf(kRid0);
+  auto empty = rib.getMemoryUsage();
+  EXPECT_EQ(0, empty["v4RadixTree"].objects);
+  EXPECT_EQ(0, empty["v6RadixTree"].objects);
+
+  auto prefix4A = IPAddress::createNetwork("10.1.0.0/16");
+  auto prefix4B = IPAddress::createNetwork("10.2.0.0/16");
+  auto prefix6 = IPAddress::createNetwork("2401:db00::/64");
+  updateRib(
+      rib,
+      {makeDropUnicastRoute(prefix4A),
+       makeDropUnicastRoute(prefix4B),
+       makeDropUnicastRoute(prefix6)},
+      {});
+
+  // A node per route, plus the ones joining their subtrees
+  auto usage = rib.getMemoryUsage();
+  EXPECT_GE(usage["v4RadixTree"].objects, 2);
+  EXPECT_EQ(1, usage["v6RadixTree"].objects);
+  EXPECT_GT(usage["v4RadixTree"].bytes, 0);
+  EXPECT_GT(usage["v6RadixTree"].bytes, 0);
+
+  auto v4Nodes = usage["v4RadixTree"].objects;
+  updateRib(rib, {}, {toIpPrefix(prefix4A), toIpPrefix(prefix6)});
+  usage = rib.getMemoryUsage();
+  EXPECT_LT(usage["v4RadixTree"].objects, v4Nodes);
+  EXPECT_GE(usage["v4RadixTree"].objects, 1);
+  EXPECT_EQ(0, usage["v6RadixTree"].objects);
+  EXPECT_EQ(0, usage["v6RadixTree"].bytes);
+}
@@ -145,10 +145,21 @@ class AclEntry : public NodeBaseT<AclEntry, AclEntryFields> {
   }
 
   bool operator==(const AclEntry& acl) const {
-    return getFields()->priority == acl.getPriority() &&
-        getFields()->name == acl.getID() &&
+    return getFields()->name == acl.getID() &&
         getFields()->actionType == acl.getActionType() &&
-        getFields()->aclAction == acl.getAclAction() &&
+        getFields()->aclAction == acl.getAclAction() && hasSameMatchers(acl);
+  }
+
+  bool operator!=(const AclEntry& acl) const {
+    return !(*this == acl);
+  }
+
+  /*
+   * Whether both entries match the same packets at the same priority, i.e.
+   * they can only differ in what is done with the matched packets.
+   */
+  bool hasSameMatchers(const AclEntry& acl) const {
+    return getFields()->priority == acl.getPriority() &&
         getFields()->srcIp == acl.getSrcIp() &&
         getFields()->dstIp == acl.getDstIp() &&
         getFields()->proto == acl.getProto() &&
@@ -171,10 +182,6 @@ class AclEntry : public NodeBaseT<AclEntry, AclEntryFields> {
         getFields()->etherType == acl.getEtherType();
   }
 
-  bool operator!=(const AclEntry& acl) const {
-    return !(*this == acl);
-  }
-
   int getPriority() const {
     return getFields()->priority;
   }
@@ -9,7 +9,10 @@
  */
 #pragma once
 
+#include <array>
 #include <functional>
+#include <memory>
+#include <type_traits>
 
 /*
  * This file contains template helpers for implementing DeltaFunctions.
@@ -128,6 +131,113 @@ template <typename AddRmFn, typename Node, typename... Args>
 using EnableIfAddRmFn =
     std::enable_if_t<IsValidAddRmFn<AddRmFn, Node, Args...>::value, LoopAction>;
 
+/*
+ * Walk the maps of a delta directly, rather than through its iterator, and
+ * call fn(oldNode, newNode) for each difference, until it returns
+ * LoopAction::BREAK. The nodes are pointers to the shared_ptrs held by the
+ * maps, with nullptr for a missing side, so no reference counts are touched.
+ */
+template <typename Delta, typename Fn>
+LoopAction walkDelta(const Delta& delta, Fn&& fn) {
+  using Map =
+      std::remove_const_t<std::remove_pointer_t<decltype(delta.getOld())>>;
+  using Traits = typename Map::Traits;
+  const std::shared_ptr<typename Map::Node>* none = nullptr;
+  const Map* oldMap = delta.getOld();
+  const Map* newMap = delta.getNew();
+  if (oldMap == newMap) {
+    return LoopAction::CONTINUE;
+  }
+  if (!oldMap) {
+    for (const auto& newNode : *newMap) {
+      if (fn(none, &newNode) == LoopAction::BREAK) {
+        return LoopAction::BREAK;
+      }
+    }
+    return LoopAction::CONTINUE;
+  }
+  if (!newMap) {
+    for (const auto& oldNode : *oldMap) {
+      if (fn(&oldNode, none) == LoopAction::BREAK) {
+        return LoopAction::BREAK;
+      }
+    }
+    return LoopAction::CONTINUE;
+  }
+
+  auto oldIt = oldMap->begin();
+  auto newIt = newMap->begin();
+  while (oldIt != oldMap->end() && newIt != newMap->end()) {
+    if (*oldIt == *newIt) {
+      ++oldIt;
+      ++newIt;
+      continue;
+    }
+    auto oldKey = Traits::getKey(*oldIt);
+    auto newKey = Traits::getKey(*newIt);
+    LoopAction action;
+    if (oldKey < newKey) {
+      action = fn(&*oldIt, none);
+      ++oldIt;
+    } else if (newKey < oldKey) {
+      action = fn(none, &*newIt);
+      ++newIt;
+    } else {
+      action = fn(&*oldIt, &*newIt);
+      ++oldIt;
+      ++newIt;
+    }
+    if (action == LoopAction::BREAK) {
+      return LoopAction::BREAK;
+    }
+  }
+  for (; oldIt != oldMap->end(); ++oldIt) {
+    if (fn(&*oldIt, none) == LoopAction::BREAK) {
+      return LoopAction::BREAK;
+    }
+  }
+  for (; newIt != newMap->end(); ++newIt) {
+    if (fn(none, &*newIt) == LoopAction::BREAK) {
+      return LoopAction::BREAK;
+    }
+  }
+  return LoopAction::CONTINUE;
+}
+
+/*
+ * Invoke the functions of one DeltaCallbacks while walking its delta, and
+ * count the nodes visited
+ */
+template <typename Callbacks>
+LoopAction invokeCallbacks(const Callbacks& callbacks, DeltaCounts& counts) {
+  using NodePtr = const std::shared_ptr<typename Callbacks::Node>*;
+  return walkDelta(
+      callbacks.delta,
+      [&callbacks, &counts](NodePtr oldNode, NodePtr newNode) {
+        if (oldNode && newNode) {
+          ++counts.changed;
+          return invokeFn(callbacks.changedFn, *oldNode, *newNode);
+        } else if (oldNode) {
+          ++counts.removed;
+          return invokeFn(callbacks.removedFn, *oldNode);
+        }
+        ++counts.added;
+        return invokeFn(callbacks.addedFn, *newNode);
+      });
+}
+
+template <typename... Callbacks>
+LoopAction forEachChangedInDeltas(
+    std::array<DeltaCounts, sizeof...(Callbacks)>& counts,
+    const Callbacks&... callbacks) {
+  // A LoopAction::BREAK only stops the walk over the delta it came from
+  bool stopped = false;
+  size_t i = 0;
+  ((stopped |= invokeCallbacks(callbacks, counts[i++]) == LoopAction::BREAK),
+   ...);
+  return stopped ? LoopAction::BREAK : LoopAction::CONTINUE;
+}
+
 } // namespace detail
 } // namespace DeltaFunctions
 
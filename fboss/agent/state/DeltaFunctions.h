@@ -9,9 +9,12 @@
  */
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <type_traits>
+#include <utility>
 
 namespace facebook::fboss {
 
@@ -24,6 +27,19 @@ enum class LoopAction : uint32_t {
   CONTINUE,
 };
 
+/*
+ * The number of modified, added and removed nodes in a delta.
+ */
+struct DeltaCounts {
+  size_t changed{0};
+  size_t added{0};
+  size_t removed{0};
+
+  size_t total() const {
+    return changed + added + removed;
+  }
+};
+
 } // namespace facebook::fboss
 
 #include "fboss/agent/state/DeltaFunctions-detail.h"
@@ -154,6 +170,111 @@ bool isEmpty(const Delta& delta) {
   return empty;
 }
 
+/*
+ * Count the modified, added and removed nodes.
+ */
+template <typename Delta>
+DeltaCounts countChanges(const Delta& delta) {
+  DeltaCounts counts;
+  detail::walkDelta(delta, [&counts](const auto* oldNode, const auto* newNode) {
+    if (oldNode && newNode) {
+      ++counts.changed;
+    } else if (newNode) {
+      ++counts.added;
+    } else {
+      ++counts.removed;
+    }
+    return LoopAction::CONTINUE;
+  });
+  return counts;
+}
+
+/*
+ * A delta and the functions to invoke for its modified, added and removed
+ * nodes, for forEachChangedInDeltas(). Use onDelta() to create one.
+ *
+ * DeltaRef is a reference when made from an lvalue delta, and the delta
+ * itself when made from a temporary one.
+ */
+template <
+    typename DeltaRef,
+    typename ChangedFn,
+    typename AddFn,
+    typename RemoveFn>
+struct DeltaCallbacks {
+  using Node = typename std::decay_t<DeltaRef>::Node;
+
+  DeltaRef delta;
+  ChangedFn changedFn;
+  AddFn addedFn;
+  RemoveFn removedFn;
+};
+
+namespace detail {
+template <typename T>
+struct IsDeltaCallbacks : std::false_type {};
+template <
+    typename DeltaRef,
+    typename ChangedFn,
+    typename AddFn,
+    typename RemoveFn>
+struct IsDeltaCallbacks<DeltaCallbacks<DeltaRef, ChangedFn, AddFn, RemoveFn>>
+    : std::true_type {};
+} // namespace detail
+
+template <
+    typename DeltaRef,
+    typename ChangedFn,
+    typename AddFn,
+    typename RemoveFn>
+DeltaCallbacks<DeltaRef, ChangedFn, AddFn, RemoveFn> onDelta(
+    DeltaRef&& delta,
+    ChangedFn changedFn,
+    AddFn addedFn,
+    RemoveFn removedFn) {
+  return DeltaCallbacks<DeltaRef, ChangedFn, AddFn, RemoveFn>{
+      std::forward<DeltaRef>(delta),
+      std::move(changedFn),
+      std::move(addedFn),
+      std::move(removedFn)};
+}
+
+/*
+ * Invoke the functions of several deltas, of any map types, for each of
+ * their modified, added and removed nodes, one delta after the other, in a
+ * single walk over each pair of maps.
+ *
+ * Unlike forEachChanged(), the nodes are passed as references to the
+ * shared_ptrs held by the maps, without copying them through the delta
+ * iterator, and the functions must be callables rather than member function
+ * pointers, so that they can be inlined. A function returning
+ * LoopAction::BREAK stops the walk over its own delta only, the other deltas
+ * are still walked. LoopAction::BREAK is returned if any delta was stopped.
+ */
+template <typename... Callbacks>
+std::enable_if_t<
+    std::conjunction_v<detail::IsDeltaCallbacks<Callbacks>...>,
+    LoopAction>
+forEachChangedInDeltas(const Callbacks&... callbacks) {
+  std::array<DeltaCounts, sizeof...(Callbacks)> counts;
+  return detail::forEachChangedInDeltas(counts, callbacks...);
+}
+
+/*
+ * Same as above, and then call countsFn with a std::array of the
+ * DeltaCounts of each delta, in order. The nodes are counted during the
+ * same walk, so a delta stopped with LoopAction::BREAK only counts the
+ * nodes visited until then.
+ */
+template <typename CountsFn, typename... Callbacks>
+std::enable_if_t<!detail::IsDeltaCallbacks<CountsFn>::value, LoopAction>
+forEachChangedInDeltas(CountsFn countsFn, const Callbacks&... callbacks) {
+  std::array<DeltaCounts, sizeof...(Callbacks)> counts;
+  auto action = detail::forEachChangedInDeltas(counts, callbacks...);
+  countsFn(counts);
+  return action;
+}
+
 } // namespace DeltaFunctions
 
 } // namespace facebook::fboss
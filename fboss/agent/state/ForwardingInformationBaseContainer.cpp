@@ -9,6 +9,7 @@
  */
 #include "fboss/agent/state/ForwardingInformationBaseContainer.h"
 #include "fboss/agent/state/NodeBase-defs.h"
+#include "fboss/agent/state/NodeMap-defs.h"
 #include "fboss/agent/state/SwitchState.h"
 
 #include <folly/logging/xlog.h>
@@ -67,6 +68,37 @@ folly::dynamic ForwardingInformationBaseContainer::toFollyDynamic() const {
   return json;
 }
 
+std::optional<folly::dynamic>
+ForwardingInformationBaseContainer::toFollyDynamicAt(
+    JsonPointerTokens path) const {
+  if (path.size() > 1 && path[0] == kFibV4) {
+    return getFibV4()->toFollyDynamicAt(path.subpiece(1));
+  }
+  if (path.size() > 1 && path[0] == kFibV6) {
+    return getFibV6()->toFollyDynamicAt(path.subpiece(1));
+  }
+  return NodeBaseT::toFollyDynamicAt(path);
+}
+
+std::shared_ptr<ForwardingInformationBaseContainer>
+ForwardingInformationBaseContainer::mergePatchAt(
+    JsonPointerTokens path,
+    const folly::dynamic& patch) const {
+  if (path.size() > 1 && path[0] == kFibV4) {
+    auto newFibContainer = clone();
+    newFibContainer->writableFields()->fibV4 =
+        getFibV4()->mergePatchAt(path.subpiece(1), patch);
+    return newFibContainer;
+  }
+  if (path.size() > 1 && path[0] == kFibV6) {
+    auto newFibContainer = clone();
+    newFibContainer->writableFields()->fibV6 =
+        getFibV6()->mergePatchAt(path.subpiece(1), patch);
+    return newFibContainer;
+  }
+  return NodeBaseT::mergePatchAt(path, patch);
+}
+
 ForwardingInformationBaseContainer* ForwardingInformationBaseContainer::modify(
     std::shared_ptr<SwitchState>* state) {
   if (!isPublished()) {
@@ -68,6 +68,15 @@ class ForwardingInformationBaseContainer
       const folly::dynamic& json);
   folly::dynamic toFollyDynamic() const override;
 
+  /*
+   * Path aware serialization and patching, see NodeBaseT. Paths into
+   * fibV4 or fibV6 only touch the addressed FIB.
+   */
+  std::optional<folly::dynamic> toFollyDynamicAt(JsonPointerTokens path) const;
+  std::shared_ptr<ForwardingInformationBaseContainer> mergePatchAt(
+      JsonPointerTokens path,
+      const folly::dynamic& patch) const;
+
  private:
   // Inherit the constructors required for clone()
   using NodeBaseT::NodeBaseT;
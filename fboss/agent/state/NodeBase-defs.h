@@ -11,6 +11,8 @@
 
 #include "NodeBase.h"
 
+#include "fboss/agent/FbossError.h"
+
 #include <memory>
 
 namespace facebook::fboss {
@@ -29,4 +31,43 @@ void NodeBaseT<NodeT, FieldsT>::publish() {
   NodeBase::publish();
 }
 
+template <typename NodeT, typename FieldsT>
+void NodeBaseT<NodeT, FieldsT>::forEachChildNode(
+    const std::function<void(const NodeBase*)>& fn) const {
+  // Fields::forEachChild() is non const since it is used to publish the
+  // children, it doesn't modify the fields itself.
+  const_cast<Fields&>(fields_).forEachChild([&fn](NodeBase* child) {
+    if (child) {
+      fn(child);
+    }
+  });
+}
+
+template <typename NodeT, typename FieldsT>
+std::optional<folly::dynamic> NodeBaseT<NodeT, FieldsT>::toFollyDynamicAt(
+    JsonPointerTokens path) const {
+  auto json = toFollyDynamic();
+  auto* subtree = resolveJsonPointer(json, path);
+  if (!subtree) {
+    return std::nullopt;
+  }
+  return std::move(*subtree);
+}
+
+template <typename NodeT, typename FieldsT>
+template <typename Node>
+std::shared_ptr<Node> NodeBaseT<NodeT, FieldsT>::mergePatchAt(
+    JsonPointerTokens path,
+    const folly::dynamic& patch) const {
+  auto json = toFollyDynamic();
+  auto* subtree = resolveJsonPointer(json, path);
+  if (!subtree) {
+    throw FbossError("JSON Pointer does not address proper object");
+  }
+  subtree->merge_patch(patch);
+  std::shared_ptr<Node> node = Node::fromFollyDynamic(json);
+  node->inheritGeneration(*this);
+  return node;
+}
+
 } // namespace facebook::fboss
@@ -9,7 +9,11 @@
  */
 #include "fboss/agent/state/NodeBase.h"
 
+#include <folly/Conv.h>
+
+#include <algorithm>
 #include <atomic>
+#include <cctype>
 
 namespace {
 std::atomic<uint64_t> nextNodeID;
@@ -20,4 +24,56 @@ namespace facebook::fboss {
 NodeBase::NodeBase()
     : nodeID_(nextNodeID.fetch_add(1, std::memory_order_relaxed)) {}
 
+MemoryUsage NodeBase::getSubtreeMemoryUsage() const {
+  MemoryUsage usage{getNodeBytes(), 1};
+  forEachChildNode([&usage](const NodeBase* child) {
+    usage += child->getSubtreeMemoryUsage();
+  });
+  return usage;
+}
+
+std::optional<size_t> jsonPointerArrayIndex(const std::string& token) {
+  // Same rules as folly::dynamic::get_ptr(): digits only, no leading zeros
+  if (token.empty() || (token.size() > 1 && token[0] == '0') ||
+      !std::all_of(token.begin(), token.end(), ::isdigit)) {
+    return std::nullopt;
+  }
+  auto index = folly::tryTo<size_t>(token);
+  if (!index.hasValue()) {
+    return std::nullopt;
+  }
+  return index.value();
+}
+
+const folly::dynamic* resolveJsonPointer(
+    const folly::dynamic& json,
+    JsonPointerTokens tokens) {
+  const folly::dynamic* current = &json;
+  for (const auto& token : tokens) {
+    if (current->isObject()) {
+      auto it = current->find(token);
+      if (it == current->items().end()) {
+        return nullptr;
+      }
+      current = &it->second;
+    } else if (current->isArray()) {
+      auto index = jsonPointerArrayIndex(token);
+      if (!index || *index >= current->size()) {
+        return nullptr;
+      }
+      current = &(*current)[*index];
+    } else {
+      return nullptr;
+    }
+  }
+  return current;
+}
+
+folly::dynamic* resolveJsonPointer(
+    folly::dynamic& json,
+    JsonPointerTokens tokens) {
+  return const_cast<folly::dynamic*>(
+      resolveJsonPointer(const_cast<const folly::dynamic&>(json), tokens));
+}
+
 } // namespace facebook::fboss
@@ -9,20 +9,48 @@
  */
 #pragma once
 
+#include "fboss/agent/MemoryUsage.h"
 #include "fboss/agent/Utils.h"
 #include "fboss/agent/types.h"
 
 #include <boost/cast.hpp>
 #include <boost/container/flat_map.hpp>
 #include <glog/logging.h>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <string>
 #include <type_traits>
 
+#include <folly/Range.h>
 #include <folly/dynamic.h>
 #include <folly/json.h>
 
 namespace facebook::fboss {
 
+/*
+ * Tokens of a folly::json_pointer (e.g. folly::range(ptr.tokens())), used to
+ * address a subtree of a node's toFollyDynamic() output.
+ */
+using JsonPointerTokens = folly::Range<const std::string*>;
+
+/*
+ * Resolve JSON pointer tokens against json, with the same semantics as
+ * folly::dynamic::get_ptr(). Returns nullptr if nothing is addressed.
+ */
+const folly::dynamic* resolveJsonPointer(
+    const folly::dynamic& json,
+    JsonPointerTokens tokens);
+folly::dynamic* resolveJsonPointer(
+    folly::dynamic& json,
+    JsonPointerTokens tokens);
+
+/*
+ * Parse a JSON pointer token addressing an array element, std::nullopt if
+ * it is not a valid index.
+ */
+std::optional<size_t> jsonPointerArrayIndex(const std::string& token);
+
 /*
  * NodeBase is the base class for all nodes in our SwitchState tree.
  *
@@ -62,6 +90,25 @@ class NodeBase {
     published_ = true;
   }
 
+  /*
+   * Approximate memory used by this node, not including its children.
+   * Children are visited with forEachChildNode(), see MemoryUsage.h.
+   */
+  virtual size_t getNodeBytes() const {
+    return sizeof(NodeBase);
+  }
+
+  /*
+   * Invoke fn on each child node of this node.
+   */
+  virtual void forEachChildNode(
+      const std::function<void(const NodeBase*)>& /*fn*/) const {}
+
+  /*
+   * Approximate memory used by this node and all of its descendants
+   */
+  MemoryUsage getSubtreeMemoryUsage() const;
+
   /*
    * Get the generation number for this state object.
    *
@@ -199,6 +246,12 @@ class NodeBaseT : public NodeBase {
 
   void publish() override;
 
+  size_t getNodeBytes() const override {
+    return sizeof(NodeT) + kSharedPtrControlBlockBytes;
+  }
+  void forEachChildNode(
+      const std::function<void(const NodeBase*)>& fn) const override;
+
   const Fields* getFields() const {
     return &fields_;
   }
@@ -223,6 +276,30 @@ class NodeBaseT : public NodeBase {
     return folly::toJson(toFollyDynamic());
   }
 
+  /*
+   * Serialize only the subtree of toFollyDynamic() addressed by path, or
+   * std::nullopt if path does not address anything.
+   *
+   * This serializes the whole node and extracts the subtree. Nodes with
+   * children (e.g. NodeMapT, SwitchState) provide their own version which
+   * only serializes the child on the path.
+   */
+  std::optional<folly::dynamic> toFollyDynamicAt(JsonPointerTokens path) const;
+
+  /*
+   * Return a new node with the JSON merge patch applied to the subtree of
+   * toFollyDynamic() addressed by path.  Throws FbossError if path does not
+   * address anything.
+   *
+   * This serializes the whole node, patches it and deserializes it with
+   * NodeT::fromFollyDynamic(). As above, nodes with children provide their
+   * own version, which only clones the nodes along the path.
+   */
+  template <typename Node = NodeT>
+  std::shared_ptr<Node> mergePatchAt(
+      JsonPointerTokens path,
+      const folly::dynamic& patch) const;
+
   template <typename... Args>
   explicit NodeBaseT(Args&&... args) : fields_(std::forward<Args>(args)...) {}
 
@@ -126,4 +126,56 @@ std::shared_ptr<MapTypeT> NodeMapT<MapTypeT, TraitsT>::fromFollyDynamic(
   return nodeMap;
 }
 
+template <typename MapTypeT, typename TraitsT>
+std::optional<folly::dynamic> NodeMapT<MapTypeT, TraitsT>::toFollyDynamicAt(
+    JsonPointerTokens path) const {
+  if (!hasDefaultLayout() || path.empty()) {
+    return Base::toFollyDynamicAt(path);
+  }
+  if (path[0] == kExtraFields) {
+    return Base::toFollyDynamicAt(path);
+  }
+  if (path[0] != kEntries) {
+    return std::nullopt;
+  }
+  if (path.size() == 1) {
+    folly::dynamic nodesJson = folly::dynamic::array;
+    for (const auto& node : *this) {
+      nodesJson.push_back(node->toFollyDynamic());
+    }
+    return nodesJson;
+  }
+  const auto& nodes = getAllNodes();
+  auto index = jsonPointerArrayIndex(path[1]);
+  if (!index || *index >= nodes.size()) {
+    return std::nullopt;
+  }
+  return std::next(nodes.begin(), *index)
+      ->second->toFollyDynamicAt(path.subpiece(2));
+}
+
+template <typename MapTypeT, typename TraitsT>
+template <typename Map>
+std::shared_ptr<Map> NodeMapT<MapTypeT, TraitsT>::mergePatchAt(
+    JsonPointerTokens path,
+    const folly::dynamic& patch) const {
+  if (!hasDefaultLayout() || path.size() < 2 || path[0] != kEntries) {
+    // Patching the whole map, its entries array or extra fields
+    return Base::template mergePatchAt<Map>(path, patch);
+  }
+  const auto& nodes = getAllNodes();
+  auto index = jsonPointerArrayIndex(path[1]);
+  if (!index || *index >= nodes.size()) {
+    throw FbossError("JSON Pointer does not address proper object");
+  }
+  const auto& oldNode = std::next(nodes.begin(), *index)->second;
+  auto newNode = oldNode->mergePatchAt(path.subpiece(2), patch);
+
+  auto newMap = this->clone();
+  // The patch may have changed the key of the node
+  newMap->writableNodes().erase(TraitsT::getKey(oldNode));
+  newMap->addNode(newNode);
+  return newMap;
+}
+
 } // namespace facebook::fboss
@@ -106,6 +106,12 @@ class NodeMapT : public NodeBaseT<MapTypeT, NodeMapFields<TraitsT>> {
     return this->getFields()->nodes.size();
   }
 
+  size_t getNodeBytes() const override {
+    // The container keeps its entries out of line
+    return NodeBaseT<MapTypeT, Fields>::getNodeBytes() +
+        size() * sizeof(typename NodeContainer::value_type);
+  }
+
   const NodeContainer& getAllNodes() const {
     return this->getFields()->nodes;
   }
@@ -149,6 +155,17 @@ class NodeMapT : public NodeBaseT<MapTypeT, NodeMapFields<TraitsT>> {
    */
   folly::dynamic toFollyDynamic() const override;
 
+  /*
+   * Path aware versions of toFollyDynamic() and fromFollyDynamic(), see
+   * NodeBaseT.  Paths into /entries/<index> only serialize, or clone and
+   * patch, the addressed node rather than the whole map.
+   */
+  std::optional<folly::dynamic> toFollyDynamicAt(JsonPointerTokens path) const;
+  template <typename Map = MapTypeT>
+  std::shared_ptr<Map> mergePatchAt(
+      JsonPointerTokens path,
+      const folly::dynamic& patch) const;
+
   /*
    * Serialize to json string
    */
@@ -162,6 +179,19 @@ class NodeMapT : public NodeBaseT<MapTypeT, NodeMapFields<TraitsT>> {
   static std::shared_ptr<MapTypeT> fromFollyDynamic(const folly::dynamic& json);
 
  private:
+  using Base = NodeBaseT<MapTypeT, NodeMapFields<TraitsT>>;
+
+  /*
+   * Maps which override toFollyDynamic() may not use the default
+   * {entries, extraFields} layout, and can only use the NodeBaseT versions
+   * of the path aware methods.
+   */
+  static constexpr bool hasDefaultLayout() {
+    return std::is_same_v<
+        decltype(&MapTypeT::toFollyDynamic),
+        folly::dynamic (NodeMapT::*)() const>;
+  }
+
   // Inherit the constructor required for clone()
   using NodeBaseT<MapTypeT, NodeMapFields<TraitsT>>::NodeBaseT;
   friend class CloneAllocator;
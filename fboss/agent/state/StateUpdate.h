@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <chrono>
 #include <memory>
 
 #include <folly/FBString.h>
@@ -101,6 +102,8 @@ class StateUpdate {
 
   // An intrusive list hook for maintaining the list of pending updates.
   folly::IntrusiveListHook listHook_;
+  // When the update was queued, to trace how long it waited to be applied
+  std::chrono::steady_clock::time_point queuedTime_;
   // The SwSwitch code needs access to our listHook_ member so it can maintain
   // the update list.
   friend class SwSwitch;
@@ -14,13 +14,20 @@
 #include "fboss/agent/state/AclMap.h"
 #include "fboss/agent/state/AggregatePort.h"
 #include "fboss/agent/state/AggregatePortMap.h"
+#include "fboss/agent/state/BufferPoolConfig.h"
 #include "fboss/agent/state/ControlPlane.h"
+#include "fboss/agent/state/ForwardingInformationBaseContainer.h"
 #include "fboss/agent/state/Interface.h"
 #include "fboss/agent/state/InterfaceMap.h"
+#include "fboss/agent/state/LabelForwardingEntry.h"
 #include "fboss/agent/state/LabelForwardingInformationBase.h"
+#include "fboss/agent/state/LoadBalancer.h"
+#include "fboss/agent/state/Mirror.h"
 #include "fboss/agent/state/Port.h"
 #include "fboss/agent/state/PortMap.h"
+#include "fboss/agent/state/QosPolicy.h"
 #include "fboss/agent/state/QosPolicyMap.h"
+#include "fboss/agent/state/SflowCollector.h"
 #include "fboss/agent/state/SflowCollectorMap.h"
 #include "fboss/agent/state/SwitchSettings.h"
 #include "fboss/agent/state/Transceiver.h"
@@ -29,6 +36,7 @@
 #include "fboss/agent/state/VlanMap.h"
 
 #include "fboss/agent/state/NodeBase-defs.h"
+#include "fboss/agent/state/NodeMap-defs.h"
 
 using std::make_shared;
 using std::shared_ptr;
@@ -58,6 +66,53 @@ constexpr auto kQcmCfg = "qcmConfig";
 constexpr auto kBufferPoolCfgs = "bufferPoolConfigs";
 constexpr auto kFibs = "fibs";
 constexpr auto kTransceivers = "transceivers";
+
+/*
+ * Call fn on the child node serialized under name by
+ * SwitchStateFields::toFollyDynamic(), returns false if there is no such
+ * child node.
+ */
+template <typename FieldsT, typename Fn>
+bool visitChild(FieldsT& fields, const std::string& name, Fn fn) {
+  if (name == kInterfaces) {
+    fn(fields.interfaces);
+  } else if (name == kPorts) {
+    fn(fields.ports);
+  } else if (name == kVlans) {
+    fn(fields.vlans);
+  } else if (name == kAcls) {
+    fn(fields.acls);
+  } else if (name == kSflowCollectors) {
+    fn(fields.sFlowCollectors);
+  } else if (name == kControlPlane) {
+    fn(fields.controlPlane);
+  } else if (name == kLoadBalancers) {
+    fn(fields.loadBalancers);
+  } else if (name == kMirrors) {
+    fn(fields.mirrors);
+  } else if (name == kAggregatePorts) {
+    fn(fields.aggPorts);
+  } else if (name == kLabelForwardingInformationBase) {
+    fn(fields.labelFib);
+  } else if (name == kSwitchSettings) {
+    fn(fields.switchSettings);
+  } else if (name == kQcmCfg) {
+    fn(fields.qcmCfg);
+  } else if (name == kBufferPoolCfgs) {
+    fn(fields.bufferPoolCfgs);
+  } else if (name == kDefaultDataplaneQosPolicy) {
+    fn(fields.defaultDataPlaneQosPolicy);
+  } else if (name == kQosPolicies) {
+    fn(fields.qosPolicies);
+  } else if (name == kFibs) {
+    fn(fields.fibs);
+  } else if (name == kTransceivers) {
+    fn(fields.transceivers);
+  } else {
+    return false;
+  }
+  return true;
+}
 } // namespace
 
 // TODO: it might be worth splitting up limits for ecmp/ucmp
@@ -187,7 +242,101 @@ SwitchStateFields SwitchStateFields::fromFollyDynamic(
 
 SwitchState::SwitchState() {}
 
-SwitchState::~SwitchState() {}
+std::optional<folly::dynamic> SwitchState::toFollyDynamicAt(
+    JsonPointerTokens path) const {
+  if (path.empty()) {
+    return toFollyDynamic();
+  }
+  const auto& name = path[0];
+  auto childPath = path.subpiece(1);
+  if (name == kDefaultVlan) {
+    if (!childPath.empty()) {
+      return std::nullopt;
+    }
+    return folly::dynamic(static_cast<uint32_t>(getDefaultVlan()));
+  }
+  std::optional<folly::dynamic> json;
+  visitChild(*getFields(), name, [&](const auto& child) {
+    if (child) {
+      json = child->toFollyDynamicAt(childPath);
+    }
+  });
+  return json;
+}
+
+std::shared_ptr<SwitchState> SwitchState::mergePatchAt(
+    JsonPointerTokens path,
+    const folly::dynamic& patch) const {
+  if (path.empty()) {
+    // Patching the whole state needs a full round trip
+    return NodeBaseT::mergePatchAt(path, patch);
+  }
+  const auto& name = path[0];
+  auto childPath = path.subpiece(1);
+  auto newState = clone();
+  auto* fields = newState->writableFields();
+  if (name == kDefaultVlan && childPath.empty()) {
+    folly::dynamic json = static_cast<uint32_t>(fields->defaultVlan);
+    json.merge_patch(patch);
+    fields->defaultVlan = VlanID(json.asInt());
+    return newState;
+  }
+  auto found = visitChild(*fields, name, [&](auto& child) {
+    if (!child) {
+      throw FbossError("JSON Pointer does not address proper object");
+    }
+    child = child->mergePatchAt(childPath, patch);
+  });
+  if (!found) {
+    throw FbossError("JSON Pointer does not address proper object");
+  }
+  return newState;
+}
+
+std::atomic<uint64_t> SwitchState::numPublishedStates_{0};
+
+SwitchState::~SwitchState() {
+  if (isPublished()) {
+    numPublishedStates_--;
+  }
+}
+
+uint64_t SwitchState::getNumPublishedStates() {
+  return numPublishedStates_.load();
+}
+
+MemoryUsageByType SwitchState::getMemoryUsage() const {
+  MemoryUsageByType usage;
+  usage["switchState"] = MemoryUsage{getNodeBytes(), 1};
+  for (auto name :
+       {kInterfaces,
+        kPorts,
+        kVlans,
+        kAcls,
+        kSflowCollectors,
+        kControlPlane,
+        kLoadBalancers,
+        kMirrors,
+        kAggregatePorts,
+        kLabelForwardingInformationBase,
+        kSwitchSettings,
+        kQcmCfg,
+        kBufferPoolCfgs,
+        kDefaultDataplaneQosPolicy,
+        kQosPolicies,
+        kFibs,
+        kTransceivers}) {
+    visitChild(*getFields(), name, [&](const auto& child) {
+      if (child) {
+        usage[name] = child->getSubtreeMemoryUsage();
+      }
+    });
+  }
+  if (const auto& aclTableGroup = getAclTableGroup()) {
+    usage["aclTableGroup"] = aclTableGroup->getSubtreeMemoryUsage();
+  }
+  return usage;
+}
 
 void SwitchState::modify(std::shared_ptr<SwitchState>* state) {
   if (!(*state)->isPublished()) {
@@ -9,8 +9,10 @@
  */
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <memory>
+#include <optional>
 
 #include <folly/FBString.h>
 #include <folly/Memory.h>
@@ -190,8 +192,32 @@ class SwitchState : public NodeBaseT<SwitchState, SwitchStateFields> {
     return getFields()->toFollyDynamic();
   }
 
+  /*
+   * Path aware serialization and patching, see NodeBaseT.  Only the child
+   * addressed by the path is serialized, and patches only clone the nodes
+   * along the path, leaving the rest of the state shared with this one.
+   */
+  std::optional<folly::dynamic> toFollyDynamicAt(JsonPointerTokens path) const;
+  std::shared_ptr<SwitchState> mergePatchAt(
+      JsonPointerTokens path,
+      const folly::dynamic& patch) const;
+
   static void modify(std::shared_ptr<SwitchState>* state);
 
+  /*
+   * Approximate memory used by each top level subtree of the state, keyed by
+   * its name in toFollyDynamic(). The SwitchState node itself is reported
+   * under "switchState".
+   */
+  MemoryUsageByType getMemoryUsage() const;
+
+  /*
+   * Number of published SwitchState objects still alive. Besides the
+   * current state, these are old generations kept alive by shared_ptr
+   * references to them.
+   */
+  static uint64_t getNumPublishedStates();
+
   template <typename EntryClassT, typename NTableT>
   static void revertNewNeighborEntry(
       const std::shared_ptr<EntryClassT>& newEntry,
@@ -400,6 +426,9 @@ class SwitchState : public NodeBaseT<SwitchState, SwitchStateFields> {
     if (auto bufferPoolCfg = getBufferPoolCfgs()) {
       bufferPoolCfg->publish();
     }
+    if (!isPublished()) {
+      numPublishedStates_++;
+    }
     BaseT::publish();
   }
 
@@ -407,6 +436,8 @@ class SwitchState : public NodeBaseT<SwitchState, SwitchStateFields> {
   // Inherit the constructor required for clone()
   using NodeBaseT::NodeBaseT;
   friend class CloneAllocator;
+
+  static std::atomic<uint64_t> numPublishedStates_;
 };
 
 } // namespace facebook::fboss
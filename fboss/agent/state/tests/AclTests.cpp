@@ -336,6 +336,29 @@ TEST(Acl, aclModifyPublished) {
   EXPECT_NE(aclMap.get(), aclMap->modify(&state));
 }
 
+TEST(Acl, SameMatchers) {
+  auto acl = make_shared<AclEntry>(0, "acl0");
+  acl->setDstIp(folly::IPAddress::createNetwork("2401:db00::/32"));
+  acl->setL4DstPort(443);
+
+  auto newAction = acl->clone();
+  newAction->setActionType(cfg::AclActionType::DENY);
+  MatchAction action;
+  action.setSetDscp(cfg::SetDscpMatchAction());
+  newAction->setAclAction(action);
+  EXPECT_NE(*acl, *newAction);
+  EXPECT_TRUE(acl->hasSameMatchers(*newAction));
+
+  auto newMatcher = acl->clone();
+  newMatcher->setL4DstPort(80);
+  EXPECT_FALSE(acl->hasSameMatchers(*newMatcher));
+
+  auto newPriority = make_shared<AclEntry>(1, "acl0");
+  newPriority->setDstIp(acl->getDstIp());
+  newPriority->setL4DstPort(443);
+  EXPECT_FALSE(acl->hasSameMatchers(*newPriority));
+}
+
 TEST(Acl, AclGeneration) {
   FLAGS_enable_acl_table_group = false;
   auto platform = createMockPlatform();
@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/hw/mock/MockPlatform.h"
+#include "fboss/agent/state/AclEntry.h"
+#include "fboss/agent/state/AclMap.h"
+#include "fboss/agent/state/Port.h"
+#include "fboss/agent/state/PortMap.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+using std::shared_ptr;
+
+namespace {
+
+using Section = AppliedConfigSections::Section;
+
+shared_ptr<SwitchState> applyConfigSections(
+    const shared_ptr<SwitchState>& state,
+    const cfg::SwitchConfig& config,
+    const Platform* platform,
+    AppliedConfigSections* sections) {
+  state->publish();
+  auto newState = applyThriftConfig(
+      state,
+      &config,
+      platform,
+      static_cast<RoutingInformationBase*>(nullptr),
+      sections);
+  return newState ? newState : state;
+}
+
+cfg::AclEntry makeAcl(const std::string& name) {
+  cfg::AclEntry acl;
+  acl.name_ref() = name;
+  acl.actionType_ref() = cfg::AclActionType::DENY;
+  acl.dstIp_ref() = "10.0.0.0/8";
+  return acl;
+}
+
+} // namespace
+
+TEST(AppliedConfigSections, SkipsUnchangedSections) {
+  auto platform = createMockPlatform();
+  AppliedConfigSections sections;
+  auto config = testConfigA();
+  auto stateV1 =
+      applyConfigSections(testStateA(), config, platform.get(), &sections);
+  EXPECT_TRUE(sections.getSkipped().empty());
+
+  config.acls_ref()->push_back(makeAcl("acl1"));
+  auto stateV2 =
+      applyConfigSections(stateV1, config, platform.get(), &sections);
+  ASSERT_NE(nullptr, stateV2->getAcls()->getEntryIf("acl1"));
+  std::set<Section> expected{
+      Section::PORTS,
+      Section::AGGREGATE_PORTS,
+      Section::QOS_POLICIES,
+      Section::VLANS};
+  EXPECT_EQ(expected, sections.getSkipped());
+  EXPECT_EQ(stateV1->getPorts(), stateV2->getPorts());
+
+  // Reloading the same config skips the ACLs too
+  auto stateV3 =
+      applyConfigSections(stateV2, config, platform.get(), &sections);
+  expected.insert(Section::ACLS);
+  EXPECT_EQ(expected, sections.getSkipped());
+  EXPECT_EQ(stateV2->getAcls(), stateV3->getAcls());
+}
+
+TEST(AppliedConfigSections, RevertsRuntimeChanges) {
+  auto platform = createMockPlatform();
+  AppliedConfigSections sections;
+  auto config = testConfigA();
+  auto stateV1 =
+      applyConfigSections(testStateA(), config, platform.get(), &sections);
+  auto adminState = stateV1->getPort(PortID(1))->getAdminState();
+
+  // A change made outside of the config is undone by the next reload
+  auto stateV2 = stateV1;
+  auto port = stateV2->getPorts()->getPort(PortID(1))->modify(&stateV2);
+  port->setAdminState(
+      adminState == cfg::PortState::ENABLED ? cfg::PortState::DISABLED
+                                            : cfg::PortState::ENABLED);
+  auto stateV3 =
+      applyConfigSections(stateV2, config, platform.get(), &sections);
+  EXPECT_EQ(0, sections.getSkipped().count(Section::PORTS));
+  EXPECT_EQ(adminState, stateV3->getPort(PortID(1))->getAdminState());
+}
+
+TEST(AppliedConfigSections, SameStateAsFullApply) {
+  auto platform = createMockPlatform();
+  AppliedConfigSections sections;
+  auto config = testConfigA();
+  auto stateV1 =
+      applyConfigSections(testStateA(), config, platform.get(), &sections);
+
+  config.acls_ref()->push_back(makeAcl("acl1"));
+  config.vlans_ref()[1].name_ref() = "Vlan55-renamed";
+  auto withSections =
+      applyConfigSections(stateV1, config, platform.get(), &sections);
+  auto withoutSections =
+      applyConfigSections(stateV1, config, platform.get(), nullptr);
+  EXPECT_EQ(withoutSections->toFollyDynamic(), withSections->toFollyDynamic());
+}
+
+TEST(AppliedConfigSections, ParallelSectionErrorsPropagate) {
+  auto platform = createMockPlatform();
+  AppliedConfigSections sections;
+  auto config = testConfigA();
+  auto stateV1 =
+      applyConfigSections(testStateA(), config, platform.get(), &sections);
+
+  auto acl = makeAcl("acl1");
+  acl.icmpCode_ref() = 1;
+  config.acls_ref()->push_back(acl);
+  EXPECT_THROW(
+      applyConfigSections(stateV1, config, platform.get(), &sections),
+      FbossError);
+  // The failed config doesn't prevent applying a valid one
+  config.acls_ref()->back().icmpCode_ref().reset();
+  auto stateV2 =
+      applyConfigSections(stateV1, config, platform.get(), &sections);
+  EXPECT_NE(nullptr, stateV2->getAcls()->getEntryIf("acl1"));
+}
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <gflags/gflags.h>
+
+#include "fboss/agent/state/DeltaFunctions.h"
+#include "fboss/agent/state/NodeMapDelta.h"
+#include "fboss/agent/state/Port.h"
+#include "fboss/agent/state/PortMap.h"
+
+#include <memory>
+#include <string>
+
+DEFINE_int32(delta_ports, 4096, "Number of ports in each PortMap");
+DEFINE_int32(
+    delta_changed_every,
+    10,
+    "Modify one port out of this many between the old and new PortMap");
+
+using namespace facebook::fboss;
+using std::shared_ptr;
+
+namespace {
+
+std::shared_ptr<PortMap> oldPorts;
+std::shared_ptr<PortMap> newPorts;
+
+void init() {
+  oldPorts = std::make_shared<PortMap>();
+  newPorts = std::make_shared<PortMap>();
+  for (int i = 1; i <= FLAGS_delta_ports; ++i) {
+    auto id = PortID(i);
+    oldPorts->registerPort(id, "port" + std::to_string(i));
+    if (i % FLAGS_delta_changed_every == 0) {
+      newPorts->registerPort(id, "modified" + std::to_string(i));
+    } else {
+      newPorts->addPort(oldPorts->getPort(id));
+    }
+  }
+}
+
+NodeMapDelta<PortMap> portsDelta() {
+  return NodeMapDelta<PortMap>(oldPorts.get(), newPorts.get());
+}
+
+} // namespace
+
+BENCHMARK(ForEachChanged, numIters) {
+  size_t changed = 0;
+  for (size_t n = 0; n < numIters; ++n) {
+    DeltaFunctions::forEachChanged(
+        portsDelta(),
+        [&](const shared_ptr<Port>&, const shared_ptr<Port>& newPort) {
+          changed += newPort->getID();
+        },
+        [&](const shared_ptr<Port>&) {},
+        [&](const shared_ptr<Port>&) {});
+  }
+  folly::doNotOptimizeAway(changed);
+}
+
+BENCHMARK_RELATIVE(ForEachChangedInDeltas, numIters) {
+  size_t changed = 0;
+  auto ignore = [](const auto&...) {};
+  for (size_t n = 0; n < numIters; ++n) {
+    DeltaFunctions::forEachChangedInDeltas(DeltaFunctions::onDelta(
+        portsDelta(),
+        [&](const shared_ptr<Port>&, const shared_ptr<Port>& newPort) {
+          changed += newPort->getID();
+        },
+        ignore,
+        ignore));
+  }
+  folly::doNotOptimizeAway(changed);
+}
+
+BENCHMARK_RELATIVE(ForEachChangedInDeltasWithCounts, numIters) {
+  size_t changed = 0;
+  size_t counted = 0;
+  auto ignore = [](const auto&...) {};
+  for (size_t n = 0; n < numIters; ++n) {
+    DeltaFunctions::forEachChangedInDeltas(
+        [&](const auto& counts) { counted += counts[0].total(); },
+        DeltaFunctions::onDelta(
+            portsDelta(),
+            [&](const shared_ptr<Port>&, const shared_ptr<Port>& newPort) {
+              changed += newPort->getID();
+            },
+            ignore,
+            ignore));
+  }
+  folly::doNotOptimizeAway(changed);
+  folly::doNotOptimizeAway(counted);
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  init();
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,267 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/state/DeltaFunctions.h"
+#include "fboss/agent/state/NodeMapDelta.h"
+#include "fboss/agent/state/Port.h"
+#include "fboss/agent/state/PortMap.h"
+#include "fboss/agent/state/Vlan.h"
+#include "fboss/agent/state/VlanMap.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+using namespace facebook::fboss;
+using std::make_shared;
+using std::shared_ptr;
+
+namespace {
+
+class DeltaFunctionsTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    // Port 1 is removed, 2 is modified, 3 is unchanged and 4 is added
+    oldPorts_ = make_shared<PortMap>();
+    oldPorts_->registerPort(PortID(1), "port1");
+    oldPorts_->registerPort(PortID(2), "port2");
+    oldPorts_->registerPort(PortID(3), "port3");
+    newPorts_ = make_shared<PortMap>();
+    newPorts_->registerPort(PortID(2), "port2_modified");
+    newPorts_->addPort(oldPorts_->getPort(PortID(3)));
+    newPorts_->registerPort(PortID(4), "port4");
+
+    // VLAN 1 is unchanged and 2 is added
+    oldVlans_ = make_shared<VlanMap>();
+    oldVlans_->addVlan(make_shared<Vlan>(VlanID(1), "vlan1"));
+    newVlans_ = make_shared<VlanMap>();
+    newVlans_->addVlan(oldVlans_->getVlan(VlanID(1)));
+    newVlans_->addVlan(make_shared<Vlan>(VlanID(2), "vlan2"));
+  }
+
+  NodeMapDelta<PortMap> portsDelta() const {
+    return NodeMapDelta<PortMap>(oldPorts_.get(), newPorts_.get());
+  }
+  NodeMapDelta<VlanMap> vlansDelta() const {
+    return NodeMapDelta<VlanMap>(oldVlans_.get(), newVlans_.get());
+  }
+
+ protected:
+  shared_ptr<PortMap> oldPorts_;
+  shared_ptr<PortMap> newPorts_;
+  shared_ptr<VlanMap> oldVlans_;
+  shared_ptr<VlanMap> newVlans_;
+};
+
+} // namespace
+
+TEST_F(DeltaFunctionsTest, countChanges) {
+  auto counts = DeltaFunctions::countChanges(portsDelta());
+  EXPECT_EQ(1, counts.changed);
+  EXPECT_EQ(1, counts.added);
+  EXPECT_EQ(1, counts.removed);
+  EXPECT_EQ(3, counts.total());
+
+  auto unchanged = NodeMapDelta<PortMap>(oldPorts_.get(), oldPorts_.get());
+  EXPECT_EQ(0, DeltaFunctions::countChanges(unchanged).total());
+
+  auto allAdded = NodeMapDelta<VlanMap>(nullptr, newVlans_.get());
+  EXPECT_EQ(2, DeltaFunctions::countChanges(allAdded).added);
+}
+
+TEST_F(DeltaFunctionsTest, forEachChangedInDeltas) {
+  std::vector<std::string> changes;
+  std::array<DeltaCounts, 2> counts;
+  auto action = DeltaFunctions::forEachChangedInDeltas(
+      [&](const std::array<DeltaCounts, 2>& deltaCounts) {
+        // Called once all the changes are processed
+        EXPECT_EQ(4, changes.size());
+        counts = deltaCounts;
+      },
+      DeltaFunctions::onDelta(
+          portsDelta(),
+          [&](const shared_ptr<Port>& oldPort,
+              const shared_ptr<Port>& newPort) {
+            EXPECT_EQ(oldPort->getID(), newPort->getID());
+            changes.push_back("changed " + newPort->getName());
+          },
+          [&](const shared_ptr<Port>& newPort) {
+            changes.push_back("added " + newPort->getName());
+          },
+          [&](const shared_ptr<Port>& oldPort) {
+            changes.push_back("removed " + oldPort->getName());
+          }),
+      DeltaFunctions::onDelta(
+          vlansDelta(),
+          [&](const shared_ptr<Vlan>&, const shared_ptr<Vlan>&) {
+            ADD_FAILURE() << "no VLAN was modified";
+          },
+          [&](const shared_ptr<Vlan>& newVlan) {
+            changes.push_back("added " + newVlan->getName());
+          },
+          [&](const shared_ptr<Vlan>&) {
+            ADD_FAILURE() << "no VLAN was removed";
+          }));
+
+  EXPECT_EQ(LoopAction::CONTINUE, action);
+  std::vector<std::string> expected = {
+      "removed port1", "changed port2_modified", "added port4", "added vlan2"};
+  EXPECT_EQ(expected, changes);
+  EXPECT_EQ(1, counts[0].changed);
+  EXPECT_EQ(1, counts[0].added);
+  EXPECT_EQ(1, counts[0].removed);
+  EXPECT_EQ(1, counts[1].added);
+  EXPECT_EQ(1, counts[1].total());
+}
+
+TEST_F(DeltaFunctionsTest, forEachChangedInDeltasMatchesForEachChanged) {
+  std::vector<PortID> expected;
+  DeltaFunctions::forEachChanged(
+      portsDelta(),
+      [&](const shared_ptr<Port>&, const shared_ptr<Port>& newPort) {
+        expected.push_back(newPort->getID());
+      },
+      [&](const shared_ptr<Port>& newPort) {
+        expected.push_back(newPort->getID());
+      },
+      [&](const shared_ptr<Port>& oldPort) {
+        expected.push_back(oldPort->getID());
+      });
+
+  std::vector<PortID> walked;
+  DeltaFunctions::forEachChangedInDeltas(
+      [](const auto&) {},
+      DeltaFunctions::onDelta(
+          portsDelta(),
+          [&](const shared_ptr<Port>&, const shared_ptr<Port>& newPort) {
+            walked.push_back(newPort->getID());
+          },
+          [&](const shared_ptr<Port>& newPort) {
+            walked.push_back(newPort->getID());
+          },
+          [&](const shared_ptr<Port>& oldPort) {
+            walked.push_back(oldPort->getID());
+          }));
+  EXPECT_EQ(expected, walked);
+}
+
+TEST_F(DeltaFunctionsTest, forEachChangedInDeltasNoRefCounting) {
+  auto port = newPorts_->getPort(PortID(4));
+  auto useCount = port.use_count();
+  auto ignore = [](const auto&...) {};
+  DeltaFunctions::forEachChangedInDeltas(
+      ignore,
+      DeltaFunctions::onDelta(
+          portsDelta(),
+          ignore,
+          [&](const shared_ptr<Port>& newPort) {
+            // The callback gets the shared_ptr held by the map itself
+            EXPECT_EQ(port, newPort);
+            EXPECT_EQ(useCount, newPort.use_count());
+          },
+          ignore));
+}
+
+TEST_F(DeltaFunctionsTest, forEachChangedInDeltasBreak) {
+  int ports = 0;
+  int vlans = 0;
+  std::array<DeltaCounts, 2> counts;
+  auto ignore = [](const auto&...) {};
+  auto action = DeltaFunctions::forEachChangedInDeltas(
+      [&](const std::array<DeltaCounts, 2>& deltaCounts) {
+        counts = deltaCounts;
+      },
+      DeltaFunctions::onDelta(
+          portsDelta(),
+          [&](const auto&, const auto&) {
+            ++ports;
+            return LoopAction::BREAK;
+          },
+          [&](const auto&) { ++ports; },
+          [&](const auto&) { ++ports; }),
+      DeltaFunctions::onDelta(
+          vlansDelta(), ignore, [&](const auto&) { ++vlans; }, ignore));
+  EXPECT_EQ(LoopAction::BREAK, action);
+  // The removed port 1 and modified port 2, and nothing after
+  EXPECT_EQ(2, ports);
+  EXPECT_EQ(2, counts[0].total());
+  // The VLANs are still walked
+  EXPECT_EQ(1, vlans);
+  EXPECT_EQ(1, counts[1].total());
+}
+
+TEST_F(DeltaFunctionsTest, forEachChangedInDeltasBreakOnlyStopsItsDelta) {
+  // Each delta stops at its first change, whatever the others do
+  std::vector<std::string> changes;
+  auto action = DeltaFunctions::forEachChangedInDeltas(
+      DeltaFunctions::onDelta(
+          vlansDelta(),
+          [&](const auto&, const auto&) { return LoopAction::BREAK; },
+          [&](const shared_ptr<Vlan>& newVlan) {
+            changes.push_back("added " + newVlan->getName());
+            return LoopAction::BREAK;
+          },
+          [&](const auto&) { return LoopAction::BREAK; }),
+      DeltaFunctions::onDelta(
+          portsDelta(),
+          [&](const shared_ptr<Port>&, const shared_ptr<Port>& newPort) {
+            changes.push_back("changed " + newPort->getName());
+            return LoopAction::CONTINUE;
+          },
+          [&](const shared_ptr<Port>& newPort) {
+            changes.push_back("added " + newPort->getName());
+            return LoopAction::CONTINUE;
+          },
+          [&](const shared_ptr<Port>& oldPort) {
+            changes.push_back("removed " + oldPort->getName());
+            return LoopAction::BREAK;
+          }),
+      DeltaFunctions::onDelta(
+          vlansDelta(),
+          [&](const auto&, const auto&) {},
+          [&](const shared_ptr<Vlan>& newVlan) {
+            changes.push_back("added again " + newVlan->getName());
+          },
+          [&](const auto&) {}));
+  EXPECT_EQ(LoopAction::BREAK, action);
+  std::vector<std::string> expected = {
+      "added vlan2", "removed port1", "added again vlan2"};
+  EXPECT_EQ(expected, changes);
+}
+
+TEST_F(DeltaFunctionsTest, forEachChangedInDeltasWithoutCounts) {
+  std::vector<std::string> changes;
+  auto ignore = [](const auto&...) {};
+  auto action = DeltaFunctions::forEachChangedInDeltas(
+      DeltaFunctions::onDelta(
+          portsDelta(),
+          [&](const shared_ptr<Port>&, const shared_ptr<Port>& newPort) {
+            changes.push_back("changed " + newPort->getName());
+          },
+          [&](const shared_ptr<Port>& newPort) {
+            changes.push_back("added " + newPort->getName());
+          },
+          [&](const shared_ptr<Port>& oldPort) {
+            changes.push_back("removed " + oldPort->getName());
+          }),
+      DeltaFunctions::onDelta(
+          vlansDelta(),
+          ignore,
+          [&](const shared_ptr<Vlan>& newVlan) {
+            changes.push_back("added " + newVlan->getName());
+            return LoopAction::BREAK;
+          },
+          ignore));
+  EXPECT_EQ(LoopAction::BREAK, action);
+  std::vector<std::string> expected = {
+      "removed port1", "changed port2_modified", "added port4", "added vlan2"};
+  EXPECT_EQ(expected, changes);
+}
@@ -8,13 +8,16 @@
  *
  */
 #include "fboss/agent/state/DeltaFunctions.h"
+#include "fboss/agent/state/ForwardingInformationBaseContainer.h"
 #include "fboss/agent/state/ForwardingInformationBaseMap.h"
 #include "fboss/agent/state/NodeMapDelta.h"
 #include "fboss/agent/state/Route.h"
 #include "fboss/agent/state/RouteTypes.h"
+#include "fboss/agent/state/SwitchState.h"
 
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
+#include <folly/json_pointer.h>
 #include <gtest/gtest.h>
 #include <memory>
 
@@ -118,4 +121,46 @@ TEST(ForwardingInformationBaseV6, IPv6DefaultPrefixComparesSmallest) {
   EXPECT_EQ(firstRouteObserved->prefix().mask, 0);
 }
 
+TEST(ForwardingInformationBase, JsonPointerSerializeAndPatch) {
+  RoutePrefixV4 prefix4{folly::IPAddressV4("10.0.0.0"), 24};
+  RoutePrefixV6 prefix6{folly::IPAddressV6("2401:db00::"), 64};
+  auto fibContainer =
+      std::make_shared<ForwardingInformationBaseContainer>(RouterID(0));
+  fibContainer->getFibV4()->addNode(createRouteFromPrefix(prefix4));
+  fibContainer->getFibV6()->addNode(createRouteFromPrefix(prefix6));
+  auto fibs = std::make_shared<ForwardingInformationBaseMap>();
+  fibs->addNode(fibContainer);
+  auto state = std::make_shared<SwitchState>();
+  state->resetForwardingInformationBases(fibs);
+  state->publish();
+
+  // Serializing a route must match extracting it from the full serialization
+  for (auto path :
+       {"/fibs/entries/0/fibV4/entries/0",
+        "/fibs/entries/0/fibV6/entries/0/prefix",
+        "/fibs/entries/0/fibV6"}) {
+    auto jsonPtr = folly::json_pointer::parse(path);
+    auto dyn = state->toFollyDynamicAt(folly::range(jsonPtr.tokens()));
+    ASSERT_TRUE(dyn.has_value()) << path;
+    EXPECT_EQ(*dyn, *state->toFollyDynamic().get_ptr(jsonPtr)) << path;
+  }
+  std::vector<std::string> badPath{"fibs", "entries", "0", "fibV4", "1"};
+  EXPECT_FALSE(state->toFollyDynamicAt(folly::range(badPath)).has_value());
+
+  // Patching a v4 route leaves the v6 fib shared with the old state
+  std::vector<std::string> routePath{
+      "fibs", "entries", "0", "fibV4", "entries", "0"};
+  auto classID = cfg::AclLookupClass::CLASS_DROP;
+  auto newState = state->mergePatchAt(
+      folly::range(routePath),
+      folly::dynamic::object("classID", static_cast<int>(classID)));
+  auto oldRoute = fibContainer->getFibV4()->exactMatch(prefix4);
+  auto newFibContainer = newState->getFibs()->getFibContainer(RouterID(0));
+  auto newRoute = newFibContainer->getFibV4()->exactMatch(prefix4);
+  EXPECT_EQ(classID, newRoute->getClassID());
+  EXPECT_EQ(std::nullopt, oldRoute->getClassID());
+  EXPECT_EQ(fibContainer->getFibV6(), newFibContainer->getFibV6());
+  EXPECT_EQ(state->getPorts(), newState->getPorts());
+}
+
 } // namespace facebook::fboss
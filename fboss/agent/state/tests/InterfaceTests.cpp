@@ -19,6 +19,7 @@
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/TestUtils.h"
 
+#include <folly/json_pointer.h>
 #include <gtest/gtest.h>
 
 using namespace facebook::fboss;
@@ -430,3 +431,42 @@ TEST(InterfaceMap, applyConfig) {
   EXPECT_EQ(4, intfsV4->getGeneration());
   EXPECT_EQ(1337, intfsV4->getInterface(InterfaceID(3))->getMtu());
 }
+
+TEST(InterfaceMap, JsonPointerSerializeAndPatch) {
+  auto state = make_shared<SwitchState>();
+  for (int i = 1; i <= 2; ++i) {
+    state->addIntf(make_shared<Interface>(
+        InterfaceID(i),
+        RouterID(0),
+        VlanID(i),
+        folly::to<std::string>("intf", i),
+        MacAddress("00:02:00:00:00:01"),
+        9000,
+        false,
+        false));
+  }
+  state->publish();
+
+  // InterfaceMap serializes to a list rather than the default
+  // {entries, extraFields} layout of node maps
+  auto jsonPtr = folly::json_pointer::parse("/interfaces/1/name");
+  auto dyn = state->toFollyDynamicAt(folly::range(jsonPtr.tokens()));
+  ASSERT_TRUE(dyn.has_value());
+  EXPECT_EQ(*dyn, *state->toFollyDynamic().get_ptr(jsonPtr));
+  EXPECT_EQ("intf2", dyn->asString());
+  std::vector<std::string> entriesPath{"interfaces", "entries", "0"};
+  EXPECT_FALSE(state->toFollyDynamicAt(folly::range(entriesPath)).has_value());
+  EXPECT_THROW(
+      state->mergePatchAt(folly::range(entriesPath), folly::dynamic::object),
+      FbossError);
+
+  std::vector<std::string> intfPath{"interfaces", "0"};
+  auto newState = state->mergePatchAt(
+      folly::range(intfPath), folly::dynamic::object("name", "patched"));
+  auto newIntfs = newState->getInterfaces();
+  EXPECT_EQ("patched", newIntfs->getInterface(InterfaceID(1))->getName());
+  EXPECT_EQ("intf2", newIntfs->getInterface(InterfaceID(2))->getName());
+  EXPECT_EQ(
+      "intf1", state->getInterfaces()->getInterface(InterfaceID(1))->getName());
+  EXPECT_EQ(state->getPorts(), newState->getPorts());
+}
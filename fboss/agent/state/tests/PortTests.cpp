@@ -21,6 +21,8 @@
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/TestUtils.h"
 
+#include <folly/String.h>
+#include <folly/json_pointer.h>
 #include <gtest/gtest.h>
 
 using namespace facebook::fboss;
@@ -1160,3 +1162,95 @@ TEST(PortMap, iterateOrder) {
   ++it;
   EXPECT_EQ(ports->end(), it);
 }
+
+TEST(Port, JsonPointerSerializeAndPatch) {
+  auto state = make_shared<SwitchState>();
+  state->registerPort(PortID(1), "port1");
+  state->registerPort(PortID(2), "port2");
+  state->publish();
+
+  // Serializing a path must match extracting it from the full serialization
+  auto jsonPtr = folly::json_pointer::parse("/ports/entries/1/portName");
+  auto dyn = state->toFollyDynamicAt(folly::range(jsonPtr.tokens()));
+  ASSERT_TRUE(dyn.has_value());
+  EXPECT_EQ(*dyn, *state->toFollyDynamic().get_ptr(jsonPtr));
+  EXPECT_EQ("port2", dyn->asString());
+
+  std::vector<std::string> badPath{"ports", "entries", "2"};
+  EXPECT_FALSE(state->toFollyDynamicAt(folly::range(badPath)).has_value());
+
+  // Patching a port only clones the nodes along the path
+  std::vector<std::string> portPath{"ports", "entries", "0"};
+  folly::dynamic patch = folly::dynamic::object("portDescription", "patched");
+  auto newState = state->mergePatchAt(folly::range(portPath), patch);
+  EXPECT_EQ("patched", newState->getPort(PortID(1))->getDescription());
+  EXPECT_EQ(state->getPort(PortID(2)), newState->getPort(PortID(2)));
+  EXPECT_EQ(state->getVlans(), newState->getVlans());
+  EXPECT_EQ(state->getInterfaces(), newState->getInterfaces());
+  EXPECT_THROW(state->mergePatchAt(folly::range(badPath), patch), FbossError);
+}
+
+TEST(Port, JsonPointerPatchMapKeys) {
+  auto state = make_shared<SwitchState>();
+  state->registerPort(PortID(1), "port1");
+  state->registerPort(PortID(2), "port2");
+  state->publish();
+
+  // Changing the key of a port moves it in the map
+  std::vector<std::string> portPath{"ports", "entries", "0"};
+  auto newState = state->mergePatchAt(
+      folly::range(portPath), folly::dynamic::object("portId", 3));
+  EXPECT_EQ(nullptr, newState->getPorts()->getPortIf(PortID(1)));
+  EXPECT_EQ("port1", newState->getPort(PortID(3))->getName());
+  EXPECT_EQ(state->getPort(PortID(2)), newState->getPort(PortID(2)));
+  EXPECT_EQ(2, newState->getPorts()->size());
+
+  // Adding an entry to the map's entries adds a port
+  std::vector<std::string> entriesPath{"ports", "entries"};
+  auto entries = state->toFollyDynamicAt(folly::range(entriesPath));
+  ASSERT_TRUE(entries.has_value());
+  auto newPort = (*entries)[0];
+  newPort["portId"] = 4;
+  newPort["portName"] = "port4";
+  entries->push_back(newPort);
+  std::vector<std::string> portsPath{"ports"};
+  newState = state->mergePatchAt(
+      folly::range(portsPath), folly::dynamic::object("entries", *entries));
+  EXPECT_EQ(3, newState->getPorts()->size());
+  EXPECT_EQ("port4", newState->getPort(PortID(4))->getName());
+  EXPECT_EQ("port1", newState->getPort(PortID(1))->getName());
+  EXPECT_EQ(2, state->getPorts()->size());
+}
+
+TEST(Port, JsonPointerInvalidPathsAndPatches) {
+  auto state = make_shared<SwitchState>();
+  state->registerPort(PortID(1), "port1");
+  state->publish();
+
+  std::vector<std::vector<std::string>> badPaths{
+      // Not an index, a leading zero, out of range
+      {"ports", "entries", "x"},
+      {"ports", "entries", "00"},
+      {"ports", "entries", "1"},
+      {"ports", "nosuchfield"},
+      {"nosuchmap"},
+      // Through a leaf
+      {"ports", "entries", "0", "portName", "x"},
+      {"defaultVlan", "x"},
+  };
+  auto patch = folly::dynamic::object("portDescription", "patched");
+  for (const auto& path : badPaths) {
+    auto pathStr = folly::join("/", path);
+    EXPECT_FALSE(state->toFollyDynamicAt(folly::range(path)).has_value())
+        << pathStr;
+    EXPECT_THROW(state->mergePatchAt(folly::range(path), patch), FbossError)
+        << pathStr;
+  }
+
+  // A patch which doesn't deserialize fails without touching the state
+  std::vector<std::string> portPath{"ports", "entries", "0"};
+  EXPECT_ANY_THROW(state->mergePatchAt(
+      folly::range(portPath), folly::dynamic::object("portId", "notanumber")));
+  EXPECT_EQ(PortID(1), state->getPort(PortID(1))->getID());
+  EXPECT_EQ("port1", state->getPort(PortID(1))->getName());
+}
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/state/Port.h"
+#include "fboss/agent/state/PortMap.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace facebook::fboss;
+
+TEST(SwitchStateMemoryUsage, CountsSubtrees) {
+  auto state = testStateA();
+  auto usage = state->getMemoryUsage();
+
+  ASSERT_EQ(1, usage.count("ports"));
+  // The PortMap and every port in it
+  EXPECT_EQ(state->getPorts()->size() + 1, usage["ports"].objects);
+  EXPECT_GE(
+      usage["ports"].bytes,
+      state->getPorts()->size() * (sizeof(Port) + kSharedPtrControlBlockBytes));
+  ASSERT_EQ(1, usage.count("vlans"));
+  EXPECT_GT(usage["vlans"].objects, state->getVlans()->size());
+  EXPECT_EQ(1, usage["switchState"].objects);
+}
+
+TEST(SwitchStateMemoryUsage, CountsPublishedStates) {
+  auto before = SwitchState::getNumPublishedStates();
+  auto state = std::make_shared<SwitchState>();
+  EXPECT_EQ(before, SwitchState::getNumPublishedStates());
+
+  state->publish();
+  EXPECT_EQ(before + 1, SwitchState::getNumPublishedStates());
+  // Publishing again doesn't count the state twice
+  state->publish();
+  EXPECT_EQ(before + 1, SwitchState::getNumPublishedStates());
+
+  auto next = state->clone();
+  next->publish();
+  EXPECT_EQ(before + 2, SwitchState::getNumPublishedStates());
+
+  state.reset();
+  EXPECT_EQ(before + 1, SwitchState::getNumPublishedStates());
+  next.reset();
+  EXPECT_EQ(before, SwitchState::getNumPublishedStates());
+}
+
+TEST(SwitchStateMemoryUsage, CountsNodeSubtree) {
+  auto ports = std::make_shared<PortMap>();
+  ports->registerPort(PortID(1), "port1");
+  ports->registerPort(PortID(2), "port2");
+  auto port = ports->getPort(PortID(1));
+
+  // A node without children only counts itself
+  auto portUsage = port->getSubtreeMemoryUsage();
+  EXPECT_EQ(1, portUsage.objects);
+  EXPECT_EQ(port->getNodeBytes(), portUsage.bytes);
+  EXPECT_GE(portUsage.bytes, sizeof(Port));
+
+  // The map counts its entries, then each port is counted once
+  auto usage = ports->getSubtreeMemoryUsage();
+  EXPECT_EQ(3, usage.objects);
+  EXPECT_EQ(ports->getNodeBytes() + 2 * portUsage.bytes, usage.bytes);
+  EXPECT_GT(ports->getNodeBytes(), sizeof(PortMap));
+}
+
+TEST(SwitchStateMemoryUsage, ContainerMemoryUsage) {
+  std::vector<uint64_t> entries(10);
+  auto usage = containerMemoryUsage(entries);
+  EXPECT_EQ(10, usage.objects);
+  EXPECT_EQ(10 * sizeof(uint64_t), usage.bytes);
+
+  usage += MemoryUsage{8, 1};
+  EXPECT_EQ(11, usage.objects);
+  EXPECT_EQ(10 * sizeof(uint64_t) + 8, usage.bytes);
+}
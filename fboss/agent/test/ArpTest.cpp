@@ -9,11 +9,14 @@
  */
 #include <fb303/ServiceData.h>
 #include <folly/Memory.h>
+#include <folly/String.h>
 #include <folly/io/Cursor.h>
 #include <folly/io/IOBuf.h>
 #include "fboss/agent/AddressUtil.h"
 #include "fboss/agent/ArpHandler.h"
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/NeighborResolutionLimiter.h"
+#include "fboss/agent/NeighborTimerWheel.h"
 #include "fboss/agent/NeighborUpdater.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/SwitchStats.h"
@@ -26,8 +29,10 @@
 #include "fboss/agent/state/ArpEntry.h"
 #include "fboss/agent/state/ArpResponseTable.h"
 #include "fboss/agent/state/ArpTable.h"
+#include "fboss/agent/state/DeltaFunctions.h"
 #include "fboss/agent/state/Interface.h"
 #include "fboss/agent/state/PortDescriptor.h"
+#include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/state/Vlan.h"
 #include "fboss/agent/state/VlanMap.h"
@@ -37,10 +42,14 @@
 #include "fboss/agent/test/TestUtils.h"
 
 #include <boost/range/combine.hpp>
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 #include <array>
+#include <atomic>
 #include <future>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace facebook::fboss;
 using facebook::network::toBinaryAddress;
@@ -48,6 +57,7 @@ using facebook::network::toIPAddress;
 using facebook::network::thrift::BinaryAddress;
 using folly::IOBuf;
 using folly::IPAddressV4;
+using folly::IPAddressV6;
 using folly::StringPiece;
 using folly::io::Cursor;
 using std::make_shared;
@@ -227,6 +237,27 @@ getArpEntry(SwSwitch* sw, IPAddressV4 ip, VlanID vlanID = VlanID(1)) {
       ->getEntryIf(ip);
 }
 
+// An IP packet from 1.2.3.4 to dest, as punted to the CPU on VLAN 1
+unique_ptr<IOBuf> makePuntedPacket(IPAddressV4 dest) {
+  return make_unique<IOBuf>(PktUtil::parseHexData(folly::to<string>(
+      // dst mac, src mac
+      "02 00 01 00 00 01  02 00 02 01 02 03"
+      // 802.1q, VLAN 1
+      "81 00 00 01"
+      // IPv4
+      "08 00"
+      // Version(4), IHL(5), DSCP(0), ECN(0), Total Length(20)
+      "45  00  00 14"
+      // Identification(0), Flags(0), Fragment offset(0)
+      "00 00  00 00"
+      // TTL(31), Protocol(6), Checksum (0, fake)
+      "1F  06  00 00"
+      // Source IP (1.2.3.4)
+      "01 02 03 04",
+      // Destination IP
+      folly::hexlify(folly::range(dest.toByteArray())))));
+}
+
 /* This helper sends an arp request for targetIP and verifies it was correctly
    sent out. */
 void testSendArpRequest(
@@ -272,6 +303,30 @@ void testSendArpRequest(
   counters.checkDelta(SwitchStats::kCounterPrefix + "arp.reply.rx.sum", 0);
 }
 
+// Counts the state updates removing ARP or NDP entries
+class NeighborRemovalCounter : public AutoRegisterStateObserver {
+ public:
+  explicit NeighborRemovalCounter(SwSwitch* sw)
+      : AutoRegisterStateObserver(sw, "NeighborRemovalCounter") {}
+
+  void stateUpdated(const StateDelta& delta) override {
+    int removed = 0;
+    for (const auto& vlanDelta : delta.getVlansDelta()) {
+      DeltaFunctions::forEachRemoved(
+          vlanDelta.getArpDelta(), [&](const auto& /*entry*/) { ++removed; });
+      DeltaFunctions::forEachRemoved(
+          vlanDelta.getNdpDelta(), [&](const auto& /*entry*/) { ++removed; });
+    }
+    if (removed > 0) {
+      ++updates;
+      entriesRemoved += removed;
+    }
+  }
+
+  std::atomic<int> updates{0};
+  std::atomic<int> entriesRemoved{0};
+};
+
 } // unnamed namespace
 
 TEST(ArpTest, BasicSendRequest) {
@@ -314,6 +369,28 @@ TEST(ArpTest, BasicSendRequest) {
   counters.checkDelta(SwitchStats::kCounterPrefix + "arp.reply.rx.sum", 0);
 }
 
+TEST(ArpTest, SendRequestsFromTemplate) {
+  auto handle = setupTestHandle();
+  auto sw = handle->getSw();
+  VlanID vlanID(1);
+  IPAddressV4 senderIP = IPAddressV4("10.0.0.1");
+
+  auto intf = sw->getState()->getInterfaces()->getInterfaceIf(
+      RouterID(0), senderIP);
+  ASSERT_NE(intf, nullptr);
+
+  // Requests from the same sender share a template, so each request must
+  // still carry its own target
+  for (auto targetIP : {IPAddressV4("10.0.0.2"), IPAddressV4("10.0.0.3")}) {
+    EXPECT_SWITCHED_PKT(
+        sw,
+        "ARP request",
+        checkArpRequest(senderIP, intf->getMac(), targetIP, vlanID));
+    ArpHandler::sendArpRequest(
+        sw, vlanID, intf->getMac(), senderIP, targetIP);
+  }
+}
+
 TEST(ArpTest, TableUpdates) {
   auto handle = setupTestHandle();
   auto sw = handle->getSw();
@@ -700,6 +777,54 @@ TEST(ArpTest, NotMine) {
   counters.checkDelta(SwitchStats::kCounterPrefix + "trapped.error.sum", 0);
 }
 
+TEST(ArpTest, RxStatsBatched) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_rx_stats_batch_size = 2;
+  auto handle = setupTestHandle();
+  auto sw = handle->getSw();
+
+  auto arpRequest = [] {
+    return make_unique<IOBuf>(PktUtil::parseHexData(
+        // dst mac, src mac
+        "ff ff ff ff ff ff  00 02 00 01 02 03"
+        // 802.1q, VLAN 1
+        "81 00  00 01"
+        // ARP, htype: ethernet, ptype: IPv4, hlen: 6, plen: 4
+        "08 06  00 01  08 00  06  04"
+        // ARP Request
+        "00 01"
+        // Sender MAC
+        "00 02 00 01 02 03"
+        // Sender IP: 10.1.2.15
+        "0a 01 02 0f"
+        // Target MAC
+        "00 00 00 00 00 00"
+        // Target IP: 10.1.2.3
+        "0a 01 02 03"));
+  };
+
+  // Without a switch, the cache doesn't flush the batched stats itself
+  CounterCache counters(nullptr);
+  handle->rxPacket(arpRequest(), PortID(1), VlanID(1));
+  counters.update();
+  counters.checkDelta(SwitchStats::kCounterPrefix + "trapped.pkts.sum", 0);
+  counters.checkDelta(SwitchStats::kCounterPrefix + "trapped.arp.sum", 0);
+  counters.checkDelta(SwitchStats::kCounterPrefix + "arp.not_mine.sum", 1);
+
+  // The second packet completes the batch
+  handle->rxPacket(arpRequest(), PortID(1), VlanID(1));
+  counters.update();
+  counters.checkDelta(SwitchStats::kCounterPrefix + "trapped.pkts.sum", 2);
+  counters.checkDelta(SwitchStats::kCounterPrefix + "trapped.arp.sum", 1);
+
+  // The rest is added by the switch
+  handle->rxPacket(arpRequest(), PortID(1), VlanID(1));
+  sw->flushBatchedRxStats();
+  counters.update();
+  counters.checkDelta(SwitchStats::kCounterPrefix + "trapped.pkts.sum", 1);
+  counters.checkDelta(SwitchStats::kCounterPrefix + "trapped.arp.sum", 2);
+}
+
 TEST(ArpTest, BadHlen) {
   auto handle = setupTestHandle();
   auto sw = handle->getSw();
@@ -1481,3 +1606,133 @@ TEST(ArpTest, receivedPacketWithRouteToDestination) {
   counters.checkDelta(SwitchStats::kCounterPrefix + "ipv4.nexthop.sum", 1);
   counters.checkDelta(SwitchStats::kCounterPrefix + "ipv4.no_arp.sum", 0);
 }
+
+TEST(ArpTest, PuntedPacketResolutionDeduped) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_neighbor_resolution_interval_ms = 60 * 1000;
+  FLAGS_neighbor_resolution_rate = 0;
+  auto handle = setupTestHandle();
+  auto sw = handle->getSw();
+  VlanID vlanID(1);
+  IPAddressV4 targetIP("10.0.0.10");
+
+  EXPECT_SWITCHED_PKT(
+      sw,
+      "ARP request",
+      checkArpRequest(
+          IPAddressV4("10.0.0.1"),
+          MacAddress("00:02:00:00:00:01"),
+          targetIP,
+          vlanID));
+  handle->rxPacket(makePuntedPacket(targetIP), PortID(1), vlanID);
+  sw->getNeighborUpdater()->waitForPendingUpdates();
+  waitForStateUpdates(sw);
+  ASSERT_NE(getArpEntry(sw, targetIP, vlanID), nullptr);
+
+  // Flush the pending entry, as if the next packet was punted before it
+  // made it to the state
+  ThriftHandler thriftHandler(sw);
+  auto binAddr = toBinaryAddress(targetIP);
+  EXPECT_EQ(
+      1,
+      thriftHandler.flushNeighborEntry(
+          make_unique<BinaryAddress>(binAddr), vlanID));
+  waitForStateUpdates(sw);
+
+  CounterCache counters(sw);
+  handle->rxPacket(makePuntedPacket(targetIP), PortID(1), vlanID);
+  sw->getNeighborUpdater()->waitForPendingUpdates();
+  waitForStateUpdates(sw);
+
+  // No request was sent, so there is no new pending entry either
+  EXPECT_EQ(getArpEntry(sw, targetIP, vlanID), nullptr);
+  counters.update();
+  counters.checkDelta(SwitchStats::kCounterPrefix + "trapped.ipv4.sum", 1);
+  counters.checkDelta(SwitchStats::kCounterPrefix + "arp.request.tx.sum", 0);
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "arp.request.deduped.sum", 1);
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "arp.request.rate_limited.sum", 0);
+}
+
+TEST(ArpTest, PuntedPacketResolutionRateLimited) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_neighbor_resolution_interval_ms = 0;
+  FLAGS_neighbor_resolution_rate = 1;
+  FLAGS_neighbor_resolution_burst = 1;
+  auto handle = setupTestHandle();
+  auto sw = handle->getSw();
+  VlanID vlanID(1);
+
+  CounterCache counters(sw);
+  EXPECT_SWITCHED_PKT(
+      sw,
+      "ARP request",
+      checkArpRequest(
+          IPAddressV4("10.0.0.1"),
+          MacAddress("00:02:00:00:00:01"),
+          IPAddressV4("10.0.0.10"),
+          vlanID));
+  handle->rxPacket(
+      makePuntedPacket(IPAddressV4("10.0.0.10")), PortID(1), vlanID);
+  // The bucket is empty now, so this one is dropped
+  handle->rxPacket(
+      makePuntedPacket(IPAddressV4("10.0.0.11")), PortID(1), vlanID);
+  sw->getNeighborUpdater()->waitForPendingUpdates();
+  waitForStateUpdates(sw);
+
+  EXPECT_NE(getArpEntry(sw, IPAddressV4("10.0.0.10"), vlanID), nullptr);
+  EXPECT_EQ(getArpEntry(sw, IPAddressV4("10.0.0.11"), vlanID), nullptr);
+  counters.update();
+  counters.checkDelta(SwitchStats::kCounterPrefix + "trapped.ipv4.sum", 2);
+  counters.checkDelta(SwitchStats::kCounterPrefix + "arp.request.tx.sum", 1);
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "arp.request.deduped.sum", 0);
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "arp.request.rate_limited.sum", 1);
+}
+
+TEST(ArpTest, ExpiredEntriesRemovedInOneUpdate) {
+  gflags::FlagSaver flagSaver;
+  // Large enough for all the entries below to fall in the same bucket
+  FLAGS_neighbor_timer_bucket_ms = 1000;
+  auto handle = setupTestHandle(std::chrono::seconds(1));
+  auto sw = handle->getSw();
+
+  // Pending ARP and NDP entries on both VLANs, which all expire after one
+  // second as there are no probes left
+  std::array<std::pair<VlanID, IPAddressV4>, 2> arpEntries = {
+      std::make_pair(VlanID(1), IPAddressV4("10.0.0.2")),
+      std::make_pair(VlanID(55), IPAddressV4("10.0.55.2"))};
+  std::array<std::pair<VlanID, IPAddressV6>, 2> ndpEntries = {
+      std::make_pair(VlanID(1), IPAddressV6("2401:db00:2110:3001::2")),
+      std::make_pair(VlanID(55), IPAddressV6("2401:db00:2110:3055::2"))};
+
+  std::vector<std::unique_ptr<WaitForSwitchState>> expirations;
+  for (const auto& [vlan, ip] : arpEntries) {
+    expirations.push_back(make_unique<WaitForArpEntryExpiration>(sw, ip, vlan));
+  }
+  for (const auto& [vlan, ip] : ndpEntries) {
+    expirations.push_back(make_unique<WaitForNdpEntryExpiration>(sw, ip, vlan));
+  }
+
+  // Created within a few milliseconds of the start of a bucket, the entries
+  // can't straddle a bucket boundary
+  waitForNeighborTimerBucketStart();
+  for (const auto& [vlan, ip] : arpEntries) {
+    sw->getNeighborUpdater()->sentArpRequest(vlan, ip);
+  }
+  for (const auto& [vlan, ip] : ndpEntries) {
+    sw->getNeighborUpdater()->sentNeighborSolicitation(vlan, ip);
+  }
+  sw->getNeighborUpdater()->waitForPendingUpdates();
+  waitForStateUpdates(sw);
+
+  NeighborRemovalCounter removals(sw);
+  for (auto& expiration : expirations) {
+    EXPECT_TRUE(expiration->wait());
+  }
+  waitForStateUpdates(sw);
+  EXPECT_EQ(4, removals.entriesRemoved);
+  EXPECT_EQ(1, removals.updates);
+}
@@ -16,6 +16,9 @@
 namespace facebook::fboss {
 
 void CounterCache::update() {
+  if (sw_) {
+    sw_->flushBatchedRxStats();
+  }
   fb303::ThreadCachedServiceData::get()->publishStats();
   prev_.swap(current_);
   current_.clear();
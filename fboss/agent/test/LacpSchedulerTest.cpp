@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/LacpScheduler.h"
+
+#include <folly/io/async/EventBase.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace facebook::fboss;
+using std::chrono::milliseconds;
+
+namespace {
+
+class CountingCallback : public LacpScheduler::PeriodicCallback {
+ public:
+  void periodExpired(milliseconds lateness) noexcept override {
+    ++expired;
+    EXPECT_GE(lateness.count(), 0);
+  }
+  int expired{0};
+};
+
+class ReschedulingCallback : public LacpScheduler::PeriodicCallback {
+ public:
+  ReschedulingCallback(LacpScheduler* scheduler, folly::EventBase* evb, int n)
+      : scheduler_(scheduler), evb_(evb), remaining_(n) {}
+
+  void periodExpired(milliseconds /* lateness */) noexcept override {
+    if (--remaining_ > 0) {
+      scheduler_->schedule(this, milliseconds(FLAGS_lacp_tick_ms));
+    } else {
+      evb_->terminateLoopSoon();
+    }
+  }
+
+ private:
+  LacpScheduler* scheduler_;
+  folly::EventBase* evb_;
+  int remaining_;
+};
+
+} // namespace
+
+TEST(LacpScheduler, SharedPerEventBase) {
+  folly::EventBase evb1;
+  folly::EventBase evb2;
+  auto scheduler = LacpScheduler::get(&evb1);
+  EXPECT_EQ(scheduler, LacpScheduler::get(&evb1));
+  EXPECT_NE(scheduler, LacpScheduler::get(&evb2));
+}
+
+TEST(LacpScheduler, DueCallbacksRunInOneTick) {
+  folly::EventBase evb;
+  auto scheduler = LacpScheduler::get(&evb);
+  std::vector<CountingCallback> callbacks(100);
+  for (auto& callback : callbacks) {
+    scheduler->schedule(&callback, milliseconds(10));
+  }
+  EXPECT_EQ(callbacks.size(), scheduler->getNumScheduled());
+  evb.loop();
+  for (const auto& callback : callbacks) {
+    EXPECT_EQ(1, callback.expired);
+  }
+  // The deadlines may straddle two ticks at most
+  EXPECT_LE(scheduler->getTicks(), 2u);
+  EXPECT_EQ(0, scheduler->getNumScheduled());
+}
+
+TEST(LacpScheduler, CancelAndReschedule) {
+  folly::EventBase evb;
+  auto scheduler = LacpScheduler::get(&evb);
+  CountingCallback canceled;
+  CountingCallback rescheduled;
+  scheduler->schedule(&canceled, milliseconds(10));
+  scheduler->schedule(&rescheduled, milliseconds(10));
+  scheduler->schedule(&rescheduled, milliseconds(20));
+  EXPECT_EQ(2, scheduler->getNumScheduled());
+  scheduler->cancel(&canceled);
+  EXPECT_FALSE(canceled.isPeriodScheduled());
+  evb.loop();
+  EXPECT_EQ(0, canceled.expired);
+  EXPECT_EQ(1, rescheduled.expired);
+}
+
+TEST(LacpScheduler, RescheduleFromCallback) {
+  folly::EventBase evb;
+  auto scheduler = LacpScheduler::get(&evb);
+  ReschedulingCallback callback(scheduler.get(), &evb, 3);
+  scheduler->schedule(&callback, milliseconds(FLAGS_lacp_tick_ms));
+  evb.loopForever();
+  EXPECT_GE(scheduler->getTicks(), 3u);
+  EXPECT_FALSE(callback.isPeriodScheduled());
+}
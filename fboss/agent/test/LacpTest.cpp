@@ -24,10 +24,12 @@
 #include <folly/logging/xlog.h>
 #include <folly/synchronization/Baton.h>
 #include <folly/system/ThreadName.h>
+#include <gflags/gflags.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "fboss/agent/LacpController.h"
+#include "fboss/agent/LacpScheduler.h"
 #include "fboss/agent/LacpTypes.h"
 #include "fboss/agent/LinkAggregationManager.h"
 #include "fboss/agent/SwitchStats.h"
@@ -38,6 +40,8 @@
 #include "fboss/agent/types.h"
 
 using namespace facebook::fboss;
+using ::testing::_;
+using ::testing::Invoke;
 
 namespace {
 
@@ -120,6 +124,16 @@ class LacpServiceInterceptor : public LacpServicerIf {
       sw_->stats()->LacpMismatchPduTeardown();
     }
   }
+  void recordLacpPeriodicTransmission(
+      std::chrono::milliseconds lateness,
+      std::optional<std::chrono::milliseconds> jitter) override {
+    if (sw_) {
+      sw_->stats()->LacpTxLateness(lateness.count());
+      if (jitter) {
+        sw_->stats()->LacpTxJitter(jitter->count());
+      }
+    }
+  }
   std::vector<std::shared_ptr<LacpController>> getControllersFor(
       folly::Range<std::vector<PortID>::const_iterator> ports) override {
     std::vector<std::shared_ptr<LacpController>> filteredControllers;
@@ -203,6 +217,31 @@ class LacpServiceInterceptor : public LacpServicerIf {
   SwSwitch* sw_{nullptr};
 };
 
+/*
+ * Hands LACPDUs and periodic transmission stats over to the
+ * LinkAggregationManager of a SwSwitch, while still serving the controllers
+ * it was given like LacpServiceInterceptor.
+ */
+class LagManagerServicer : public LacpServiceInterceptor {
+ public:
+  explicit LagManagerServicer(SwSwitch* sw)
+      : LacpServiceInterceptor(sw->getLacpEvb(), sw),
+        lagManager_(sw->getLagManager()) {}
+
+  bool transmit(LACPDU lacpdu, PortID portID) override {
+    LacpServiceInterceptor::transmit(lacpdu, portID);
+    return lagManager_->transmit(lacpdu, portID);
+  }
+  void recordLacpPeriodicTransmission(
+      std::chrono::milliseconds lateness,
+      std::optional<std::chrono::milliseconds> jitter) override {
+    lagManager_->recordLacpPeriodicTransmission(lateness, jitter);
+  }
+
+ private:
+  LinkAggregationManager* lagManager_;
+};
+
 class MockLacpServicer : public LacpServicerIf {
   void enableForwardingAndSetPartnerState(
       PortID portID,
@@ -220,6 +259,9 @@ class MockLacpServicer : public LacpServicerIf {
   }
   void recordLacpTimeout() override {}
   void recordLacpMismatchPduTeardown() override {}
+  void recordLacpPeriodicTransmission(
+      std::chrono::milliseconds /* unused */,
+      std::optional<std::chrono::milliseconds> /* unused */) override {}
   MOCK_METHOD2(transmit, bool(LACPDU, PortID));
   MOCK_METHOD1(
       getControllersFor,
@@ -1288,3 +1330,99 @@ TEST_F(LacpTest, lacpDownCounters) {
   // both members should timeout
   counters.checkDelta(SwitchStats::kCounterPrefix + "lacp.rx_timeout.sum", 2);
 }
+
+/*
+ * The periodic LACPDUs of all the member ports due in the same scheduler tick
+ * are handed to the HwSwitch as one batch
+ */
+TEST_F(LacpTest, periodicTransmissionsSentInOneBatch) {
+  gflags::FlagSaver flagSaver;
+  // Wide enough ticks for the deadlines of all the ports to round up to the
+  // same one
+  FLAGS_lacp_tick_ms = 500;
+  auto handle = createTestHandle(testStateA(), SwitchFlags::ENABLE_LACP);
+  auto sw = handle->getSw();
+  ASSERT_NE(nullptr, sw->getLagManager());
+  auto lacpEvbase = sw->getLacpEvb();
+  LagManagerServicer servicer(sw);
+
+  // Only touched from the LACP thread until it is waited on
+  std::vector<size_t> batches;
+  EXPECT_CALL(*getMockHw(sw), sendPacketsOutOfPortAsync_(_, _))
+      .WillRepeatedly(Invoke([&batches](size_t numPkts, auto /* queue */) {
+        batches.push_back(numPkts);
+      }));
+
+  std::vector<PortID> ports = {PortID(1), PortID(2), PortID(3)};
+  folly::MacAddress systemID("02:90:fb:5e:24:28");
+  ParticipantInfo partner;
+  partner.systemPriority = 65535;
+  partner.systemID = {0x02, 0x90, 0xfb, 0x5e, 0x1e, 0x85};
+  partner.key = 1;
+  partner.portPriority = 32768;
+  partner.state = LacpState::ACTIVE | LacpState::AGGREGATABLE |
+      LacpState::COLLECTING | LacpState::DISTRIBUTING | LacpState::IN_SYNC |
+      LacpState::SHORT_TIMEOUT;
+  for (auto port : ports) {
+    auto controller = std::make_shared<LacpController>(
+        port,
+        lacpEvbase,
+        32768,
+        cfg::LacpPortRate::FAST,
+        cfg::LacpPortActivity::ACTIVE,
+        cfg::switch_config_constants::DEFAULT_LACP_HOLD_TIMER_MULTIPLIER(),
+        AggregatePortID(2),
+        65535,
+        systemID,
+        1 /* minimum-link count */,
+        &servicer);
+    servicer.addController(controller);
+    partner.port = port;
+    // Starts the short periodic transmissions
+    controller->restoreMachines(partner);
+  }
+
+  auto waitForLacpThread = [lacpEvbase]() {
+    // Twice, to also let the loop callbacks of the first loop run
+    lacpEvbase->runInEventBaseThreadAndWait([]() {});
+    lacpEvbase->runInEventBaseThreadAndWait([]() {});
+  };
+  // Leave out whatever was sent while restoring the machines
+  waitForLacpThread();
+  lacpEvbase->runInEventBaseThreadAndWait([&batches]() { batches.clear(); });
+
+  // The first periodic transmissions are due within a period and a tick,
+  // the next ones a period later and before the partners time out
+  std::this_thread::sleep_for(
+      PeriodicTransmissionMachine::SHORT_PERIOD +
+      std::chrono::milliseconds(FLAGS_lacp_tick_ms + 100));
+  waitForLacpThread();
+  lacpEvbase->runInEventBaseThreadAndWait([&batches, &ports]() {
+    EXPECT_EQ(std::vector<size_t>({ports.size()}), batches);
+  });
+}
+
+/*
+ * The lateness and jitter of periodic transmissions are recorded in the
+ * lacp.tx_lateness.ms and lacp.tx_jitter.ms histograms
+ */
+TEST_F(LacpTest, periodicTransmissionHistograms) {
+  auto handle = createTestHandle(testStateA(), SwitchFlags::ENABLE_LACP);
+  auto sw = handle->getSw();
+  ASSERT_NE(nullptr, sw->getLagManager());
+
+  CounterCache counters(sw);
+  // Far above anything recorded by a real transmission in this process
+  sw->getLagManager()->recordLacpPeriodicTransmission(
+      std::chrono::milliseconds(4000), std::chrono::milliseconds(3000));
+  // Without a jitter, only the lateness is recorded
+  sw->getLagManager()->recordLacpPeriodicTransmission(
+      std::chrono::milliseconds(4500), std::nullopt);
+  counters.update();
+#ifndef IS_OSS
+  auto prefix = SwitchStats::kCounterPrefix;
+  EXPECT_GE(counters.value(prefix + "lacp.tx_lateness.ms.p100"), 4500);
+  EXPECT_GE(counters.value(prefix + "lacp.tx_jitter.ms.p100"), 3000);
+  EXPECT_LT(counters.value(prefix + "lacp.tx_jitter.ms.p100"), 4000);
+#endif
+}
@@ -144,6 +144,28 @@ TEST(LldpManagerTest, LldpSend) {
   lldpManager.sendLldpOnAllPorts();
 }
 
+TEST(LldpManagerTest, LldpResendReusesFrames) {
+  auto handle = setupTestHandle();
+  auto sw = handle->getSw();
+
+  int numPortsUp = 0;
+  for (const auto& port : *sw->getState()->getPorts()) {
+    numPortsUp += port->isPortUp();
+  }
+  // Every round sends a full frame out of each port, even though they are
+  // only serialized the first time
+  EXPECT_HW_CALL(
+      sw,
+      sendPacketOutOfPortAsync_(
+          TxPacketMatcher::createMatcher("Lldp PDU", checkLldpPDU()),
+          _,
+          std::optional<uint8_t>(kNCStrictPriorityQueue)))
+      .Times(2 * numPortsUp);
+  LldpManager lldpManager(sw);
+  lldpManager.sendLldpOnAllPorts();
+  lldpManager.sendLldpOnAllPorts();
+}
+
 TEST(LldpManagerTest, LldpSendPeriodic) {
   auto handle = setupTestHandle();
   auto sw = handle->getSw();
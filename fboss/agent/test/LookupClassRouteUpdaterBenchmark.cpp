@@ -0,0 +1,142 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Format.h>
+#include <folly/IPAddressV6.h>
+#include <folly/init/Init.h>
+
+#include "fboss/agent/LookupClassRouteUpdater.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
+#include "fboss/agent/state/Interface.h"
+#include "fboss/agent/state/InterfaceMap.h"
+#include "fboss/agent/state/Port.h"
+#include "fboss/agent/state/PortMap.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <vector>
+
+DEFINE_int32(num_routes, 100000, "Number of routes installed");
+DEFINE_int32(num_nexthops, 8, "Number of nexthops per route");
+
+using namespace facebook::fboss;
+
+namespace {
+
+// Global state used by the benchmarks
+std::unique_ptr<HwTestHandle> handle;
+SwSwitch* sw;
+
+const std::vector<cfg::AclLookupClass> kLookupClasses = {
+    cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_0,
+    cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_1,
+    cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_2,
+    cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_3,
+    cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_4};
+
+void setPortLookupClasses(
+    PortID portID,
+    const std::vector<cfg::AclLookupClass>& lookupClasses) {
+  sw->updateStateBlocking(
+      "queue-per-host port flap",
+      [=](const std::shared_ptr<SwitchState>& state) {
+        auto newState = state->clone();
+        auto port = newState->getPorts()->getPort(portID)->modify(&newState);
+        port->setLookupClassesToDistributeTrafficOn(lookupClasses);
+        return newState;
+      });
+}
+
+/*
+ * Set up a queue-per-host switch with FLAGS_num_routes routes, all with
+ * nexthops in the subnet of interface 1.
+ *
+ * Port 1 is the only queue-per-host port of VLAN 1, so taking it out of
+ * queue-per-host drops the subnets of VLAN 1 from the subnets cache of
+ * LookupClassRouteUpdater, and putting it back caches them again and
+ * re-adds the routes through them. Port 13 stays queue-per-host on VLAN 55
+ * so that the cache, and the route index kept with it, never go empty.
+ */
+void init() {
+  auto config = testConfigA();
+  for (auto portIndex : {0, 12}) {
+    config.ports_ref()[portIndex].lookupClasses_ref() = kLookupClasses;
+  }
+  handle = createTestHandle(&config);
+  sw = handle->getSw();
+
+  RouteNextHopSet nexthops;
+  for (auto i = 0; i < FLAGS_num_nexthops; ++i) {
+    auto nexthop = folly::IPAddressV6(
+        folly::to<std::string>("2401:db00:2110:3001::", i + 10));
+    nexthops.emplace(UnresolvedNextHop(nexthop, UCMP_DEFAULT_WEIGHT));
+  }
+  auto updater = sw->getRouteUpdater();
+  for (auto i = 0; i < FLAGS_num_routes; ++i) {
+    auto network = folly::IPAddressV6(folly::to<std::string>(
+        "2803:6080:", folly::sformat("{:x}:{:x}::", i >> 16, i & 0xffff)));
+    updater.addRoute(
+        RouterID(0),
+        network,
+        64,
+        ClientID(1001),
+        RouteNextHopEntry(nexthops, AdminDistance::MAX_ADMIN_DISTANCE));
+  }
+  updater.program();
+  waitForStateUpdates(sw);
+  waitForRibUpdates(sw);
+  waitForStateUpdates(sw);
+
+  // The route index is built the first time routes are re-added
+  setPortLookupClasses(PortID(1), {});
+  setPortLookupClasses(PortID(1), kLookupClasses);
+  waitForStateUpdates(sw);
+  CHECK(sw->getLookupClassRouteUpdater()->isRouteIndexBuilt());
+}
+
+void setInterfaceMtu(InterfaceID intfID, int mtu) {
+  sw->updateStateBlocking(
+      "interface mtu change", [=](const std::shared_ptr<SwitchState>& state) {
+        auto newState = state->clone();
+        auto intf =
+            newState->getInterfaces()->getInterface(intfID)->modify(&newState);
+        intf->setMtu(mtu);
+        return newState;
+      });
+}
+
+} // namespace
+
+// The subnets of VLAN 1 are dropped and cached again, see init()
+BENCHMARK(PortFlap) {
+  setPortLookupClasses(PortID(1), {});
+  setPortLookupClasses(PortID(1), kLookupClasses);
+}
+
+// Interface changes re-cache its subnets, and so re-process the routes
+BENCHMARK(InterfaceChange) {
+  setInterfaceMtu(InterfaceID(1), 1500);
+  setInterfaceMtu(InterfaceID(1), 9000);
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+
+  // Installing routes is expensive, do it once up front rather than in
+  // BENCHMARK_SUSPEND blocks.
+  init();
+
+  folly::runBenchmarks();
+  handle.reset();
+  return 0;
+}
@@ -24,6 +24,9 @@
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
 
+#include <set>
+#include <vector>
+
 using folly::IPAddressV4;
 using folly::IPAddressV6;
 
@@ -149,6 +152,38 @@ class LookupClassRouteUpdaterTest : public ::testing::Test {
     return sw_;
   }
 
+  std::vector<cfg::AclLookupClass> kLookupClasses() const {
+    return {
+        cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_0,
+        cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_1,
+        cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_2,
+        cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_3,
+        cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_4};
+  }
+
+  LookupClassRouteUpdater::RidAndCidr kRidAndCidr(
+      RoutePrefix<AddrT> routePrefix) const {
+    return {kRid(), {folly::IPAddress(routePrefix.network), routePrefix.mask}};
+  }
+
+  bool isRouteIndexBuilt() {
+    bool built = false;
+    this->verifyStateUpdate([&]() {
+      built = sw_->getLookupClassRouteUpdater()->isRouteIndexBuilt();
+    });
+    return built;
+  }
+
+  std::set<LookupClassRouteUpdater::RidAndCidr> getIndexedRoutes(
+      AddrT nextHop) {
+    std::set<LookupClassRouteUpdater::RidAndCidr> routes;
+    this->verifyStateUpdate([&]() {
+      routes = sw_->getLookupClassRouteUpdater()->getIndexedRoutes(
+          kVlan(), folly::IPAddress(nextHop));
+    });
+    return routes;
+  }
+
   void resolveNeighbor(AddrT ipAddress, MacAddress macAddress) {
     /*
      * Cause a neighbor entry to resolve by receiving appropriate ARP/NDP, and
@@ -588,6 +623,75 @@ TYPED_TEST(LookupClassRouteUpdaterTest, PortLookupClassesChange) {
       this->kroutePrefix1(), cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_3);
 }
 
+// Test cases verifying routes re-added for newly cached subnets
+
+TYPED_TEST(LookupClassRouteUpdaterTest, ReAddRoutesForNewSubnets) {
+  this->updateLookupClasses({});
+  this->addRoute(this->kroutePrefix1(), {this->kIpAddressA()});
+  this->addRoute(this->kroutePrefix2(), {this->kIpAddressC()});
+  this->resolveNeighbor(this->kIpAddressA(), this->kMacAddressA());
+
+  this->verifyClassIDHelper(this->kroutePrefix1(), std::nullopt);
+  // The index is only needed once subnets get cached after routes
+  EXPECT_FALSE(this->isRouteIndexBuilt());
+
+  this->updateLookupClasses(this->kLookupClasses());
+
+  EXPECT_TRUE(this->isRouteIndexBuilt());
+  using Routes = std::set<LookupClassRouteUpdater::RidAndCidr>;
+  EXPECT_EQ(
+      Routes{this->kRidAndCidr(this->kroutePrefix1())},
+      this->getIndexedRoutes(this->kIpAddressA()));
+  EXPECT_EQ(
+      Routes{this->kRidAndCidr(this->kroutePrefix2())},
+      this->getIndexedRoutes(this->kIpAddressC()));
+  // Route 1 was re-added, and inherits the classID of its resolved nexthop
+  this->verifyClassIDHelper(
+      this->kroutePrefix1(), cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_0);
+  this->verifyClassIDHelper(this->kroutePrefix2(), std::nullopt);
+}
+
+TYPED_TEST(LookupClassRouteUpdaterTest, RouteIndexFollowsRouteUpdates) {
+  this->updateLookupClasses({});
+  this->addRoute(this->kroutePrefix1(), {this->kIpAddressA()});
+  this->updateLookupClasses(this->kLookupClasses());
+  ASSERT_TRUE(this->isRouteIndexBuilt());
+
+  using Routes = std::set<LookupClassRouteUpdater::RidAndCidr>;
+  auto route1 = this->kRidAndCidr(this->kroutePrefix1());
+  auto route3 = this->kRidAndCidr(this->kroutePrefix3());
+
+  this->addRoute(this->kroutePrefix3(), {this->kIpAddressA()});
+  EXPECT_EQ(
+      (Routes{route1, route3}), this->getIndexedRoutes(this->kIpAddressA()));
+
+  // Moving route 1 to another nexthop moves it in the index
+  this->addRoute(this->kroutePrefix1(), {this->kIpAddressB()});
+  EXPECT_EQ(Routes{route3}, this->getIndexedRoutes(this->kIpAddressA()));
+  EXPECT_EQ(Routes{route1}, this->getIndexedRoutes(this->kIpAddressB()));
+
+  this->removeRoute(this->kroutePrefix3());
+  EXPECT_TRUE(this->getIndexedRoutes(this->kIpAddressA()).empty());
+
+  // Routes added afterwards are still re-added for new subnets
+  this->resolveNeighbor(this->kIpAddressB(), this->kMacAddressB());
+  this->updateLookupClasses({});
+  this->updateLookupClasses(this->kLookupClasses());
+  this->verifyClassIDHelper(
+      this->kroutePrefix1(), cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_0);
+}
+
+TYPED_TEST(LookupClassRouteUpdaterTest, RouteIndexDroppedWithoutQueuePerHost) {
+  this->updateLookupClasses({});
+  this->addRoute(this->kroutePrefix1(), {this->kIpAddressA()});
+  this->updateLookupClasses(this->kLookupClasses());
+  ASSERT_TRUE(this->isRouteIndexBuilt());
+
+  this->updateLookupClasses({});
+  EXPECT_FALSE(this->isRouteIndexBuilt());
+  EXPECT_TRUE(this->getIndexedRoutes(this->kIpAddressA()).empty());
+}
+
 TYPED_TEST(LookupClassRouteUpdaterTest, CompeteClassIdUpdatesWithRouteUpdates) {
   this->addRoute(this->kroutePrefix1(), {this->kIpAddressA()});
   std::thread classIdUpdates([this]() {
@@ -11,13 +11,16 @@
 
 #include "fboss/agent/AddressUtil.h"
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/IPv6Handler.h"
 #include "fboss/agent/LinkAggregationManager.h"
+#include "fboss/agent/NeighborResolutionLimiter.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/ThriftHandler.h"
 #include "fboss/agent/TxPacket.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
+#include "fboss/agent/hw/mock/MockPlatform.h"
 #include "fboss/agent/hw/mock/MockRxPacket.h"
 #include "fboss/agent/packet/EthHdr.h"
 #include "fboss/agent/packet/Ethertype.h"
@@ -36,6 +39,7 @@
 
 #include <folly/IPAddressV6.h>
 #include <folly/MacAddress.h>
+#include <folly/String.h>
 #include <folly/io/Cursor.h>
 #include <netinet/icmp6.h>
 #include <future>
@@ -418,6 +422,36 @@ void sendNeighborAdvertisement(
   handle->rxPacket(std::move(buf), PortID(port), vlan);
 }
 
+// A UDP packet from 2401:db00:2110:1234::1:0 to dest, as punted to the CPU on
+// VLAN 5
+unique_ptr<IOBuf> makePuntedPacket(const IPAddressV6& dest) {
+  return make_unique<IOBuf>(PktUtil::parseHexData(folly::to<std::string>(
+      // dst mac, src mac
+      "00 02 00 ab cd ef  02 05 73 f9 46 fc"
+      // 802.1q, VLAN 5
+      "81 00 00 05"
+      // IPv6
+      "86 dd"
+      // Version 6, traffic class, flow label
+      "6e 00 00 00"
+      // Payload length: 24
+      "00 18"
+      // Next Header: 17 (UDP), Hop Limit (255)
+      "11 ff"
+      // src addr (2401:db00:2110:1234::1:0)
+      "24 01 db 00 21 10 12 34 00 00 00 00 00 01 00 00",
+      // dst addr
+      folly::hexlify(folly::range(dest.toByteArray())),
+      // source port (53 - DNS)
+      "00 35"
+      // destination port (53 - DNS)
+      "00 35"
+      // length
+      "00 00"
+      // checksum (not valid)
+      "2a 7e")));
+}
+
 } // unnamed namespace
 
 class NdpTest : public ::testing::Test {
@@ -659,6 +693,53 @@ TEST_F(NdpTest, TriggerSolicitation) {
       sw, IPAddressV6("2401:db00:2110:3004::2"), VlanID(5));
 }
 
+TEST_F(NdpTest, SolicitationsFromTemplate) {
+  auto handle = this->setupTestHandle();
+  auto sw = handle->getSw();
+
+  // Solicitations from the same source only differ in their destination and
+  // target, which are filled into a template along with the checksum
+  for (auto target :
+       {IPAddressV6("2401:db00:2110:3004::1"),
+        IPAddressV6("2401:db00:2110:3004::2:0")}) {
+    auto solicitedNodeAddr = target.getSolicitedNodeAddress();
+    EXPECT_SWITCHED_PKT(
+        sw,
+        "neighbor solicitation",
+        checkNeighborSolicitation(
+            MockPlatform::getMockLocalMac(),
+            MockPlatform::getMockLinkLocalIp6(),
+            MacAddress::createMulticast(solicitedNodeAddr),
+            solicitedNodeAddr,
+            target,
+            VlanID(5)));
+    IPv6Handler::sendMulticastNeighborSolicitation(
+        sw, target, MockPlatform::getMockLocalMac(), VlanID(5));
+  }
+
+  // Unicast solicitations carry no source MAC option, so use another template
+  IPAddressV6 target("2401:db00:2110:3004::3");
+  MacAddress targetMac("02:00:00:00:00:03");
+  EXPECT_SWITCHED_PKT(
+      sw,
+      "neighbor solicitation",
+      checkNeighborSolicitation(
+          MockPlatform::getMockLocalMac(),
+          MockPlatform::getMockLinkLocalIp6(),
+          targetMac,
+          target,
+          target,
+          VlanID(5),
+          false /* hasOption */));
+  IPv6Handler::sendUnicastNeighborSolicitation(
+      sw,
+      target,
+      targetMac,
+      MockPlatform::getMockLinkLocalIp6(),
+      MockPlatform::getMockLocalMac(),
+      VlanID(5));
+}
+
 TEST_F(NdpTest, RouterAdvertisement) {
   seconds raInterval(1);
   auto config = createSwitchConfig(raInterval, seconds(0));
@@ -1815,3 +1896,95 @@ TEST_F(NdpTest, PortFlapRecover) {
   EXPECT_NE(entry3, nullptr);
   EXPECT_EQ(entry3->isPending(), false);
 }
+
+TEST_F(NdpTest, PuntedPacketResolutionDeduped) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_neighbor_resolution_interval_ms = 60 * 1000;
+  FLAGS_neighbor_resolution_rate = 0;
+  auto handle = this->setupTestHandle();
+  auto sw = handle->getSw();
+  auto vlanID = VlanID(5);
+  IPAddressV6 targetIP("2401:db00:2110:3004::1:0");
+  auto getEntry = [&]() {
+    auto vlan = sw->getState()->getVlans()->getVlanIf(vlanID);
+    return vlan->getNdpTable()->getEntryIf(targetIP);
+  };
+
+  EXPECT_SWITCHED_PKT(
+      sw,
+      "neighbor solicitation",
+      checkNeighborSolicitation(
+          MockPlatform::getMockLocalMac(),
+          MockPlatform::getMockLinkLocalIp6(),
+          MacAddress("33:33:ff:01:00:00"),
+          IPAddressV6("ff02::1:ff01:0"),
+          targetIP,
+          vlanID));
+  handle->rxPacket(makePuntedPacket(targetIP), PortID(1), vlanID);
+  sw->getNeighborUpdater()->waitForPendingUpdates();
+  waitForStateUpdates(sw);
+  ASSERT_NE(getEntry(), nullptr);
+
+  // Flush the pending entry, as if the next packet was punted before it
+  // made it to the state
+  ThriftHandler thriftHandler(sw);
+  auto binAddr = toBinaryAddress(targetIP);
+  EXPECT_EQ(
+      1,
+      thriftHandler.flushNeighborEntry(
+          make_unique<BinaryAddress>(binAddr), vlanID));
+  waitForStateUpdates(sw);
+
+  CounterCache counters(sw);
+  handle->rxPacket(makePuntedPacket(targetIP), PortID(1), vlanID);
+  sw->getNeighborUpdater()->waitForPendingUpdates();
+  waitForStateUpdates(sw);
+
+  // No solicitation was sent, so there is no new pending entry either
+  EXPECT_EQ(getEntry(), nullptr);
+  counters.update();
+  counters.checkDelta(SwitchStats::kCounterPrefix + "trapped.pkts.sum", 1);
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "ndp.solicitation.deduped.sum", 1);
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "ndp.solicitation.rate_limited.sum", 0);
+}
+
+TEST_F(NdpTest, PuntedPacketResolutionRateLimited) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_neighbor_resolution_interval_ms = 0;
+  FLAGS_neighbor_resolution_rate = 1;
+  FLAGS_neighbor_resolution_burst = 1;
+  auto handle = this->setupTestHandle();
+  auto sw = handle->getSw();
+  auto vlanID = VlanID(5);
+  IPAddressV6 targetIP("2401:db00:2110:3004::1:0");
+  IPAddressV6 targetIP2("2401:db00:2110:3004::1:1");
+
+  CounterCache counters(sw);
+  EXPECT_SWITCHED_PKT(
+      sw,
+      "neighbor solicitation",
+      checkNeighborSolicitation(
+          MockPlatform::getMockLocalMac(),
+          MockPlatform::getMockLinkLocalIp6(),
+          MacAddress("33:33:ff:01:00:00"),
+          IPAddressV6("ff02::1:ff01:0"),
+          targetIP,
+          vlanID));
+  handle->rxPacket(makePuntedPacket(targetIP), PortID(1), vlanID);
+  // The bucket is empty now, so this one is dropped
+  handle->rxPacket(makePuntedPacket(targetIP2), PortID(1), vlanID);
+  sw->getNeighborUpdater()->waitForPendingUpdates();
+  waitForStateUpdates(sw);
+
+  auto ndpTable = sw->getState()->getVlans()->getVlanIf(vlanID)->getNdpTable();
+  EXPECT_NE(ndpTable->getEntryIf(targetIP), nullptr);
+  EXPECT_EQ(ndpTable->getEntryIf(targetIP2), nullptr);
+  counters.update();
+  counters.checkDelta(SwitchStats::kCounterPrefix + "trapped.pkts.sum", 2);
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "ndp.solicitation.deduped.sum", 0);
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "ndp.solicitation.rate_limited.sum", 1);
+}
@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <folly/IPAddressV6.h>
+#include <gflags/gflags.h>
+
+#include "fboss/agent/MemoryUsage.h"
+#include "fboss/agent/NeighborCacheEntry.h"
+#include "fboss/agent/NeighborEntryStore.h"
+#include "fboss/agent/state/NdpTable.h"
+
+#include <array>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+DEFINE_int32(neighbor_entries, 4096, "Number of neighbor entries to store");
+
+using namespace facebook::fboss;
+using folly::IPAddressV6;
+
+namespace {
+
+/*
+ * The cache entries need an EventBase and a NeighborCache to exist, so the
+ * benchmarks store a stand-in of the same size.
+ */
+struct FakeEntry {
+  explicit FakeEntry(const IPAddressV6& ip) : ip(ip) {}
+  IPAddressV6 ip;
+  std::array<
+      char,
+      sizeof(NeighborCacheEntry<NdpTable>) - sizeof(IPAddressV6)>
+      payload{};
+};
+
+using MapStore = std::unordered_map<IPAddressV6, std::shared_ptr<FakeEntry>>;
+using SlabStore = NeighborEntryStore<IPAddressV6, FakeEntry>;
+
+std::vector<IPAddressV6> ips;
+MapStore mapStore;
+SlabStore slabStore;
+
+void init() {
+  for (int i = 0; i < FLAGS_neighbor_entries; ++i) {
+    auto bytes = IPAddressV6("2401:db00::").toByteArray();
+    bytes[14] = i >> 8;
+    bytes[15] = i & 0xff;
+    ips.emplace_back(bytes);
+  }
+  for (const auto& ip : ips) {
+    mapStore.emplace(ip, std::make_shared<FakeEntry>(ip));
+    slabStore.emplace(ip, ip);
+  }
+}
+
+size_t mapStoreMemory() {
+  // Buckets, plus a node and a make_shared block per entry
+  return mapStore.bucket_count() * sizeof(void*) +
+      mapStore.size() *
+      (sizeof(MapStore::value_type) + sizeof(void*) + sizeof(FakeEntry) +
+       kSharedPtrControlBlockBytes);
+}
+
+} // namespace
+
+BENCHMARK(UnorderedMapLookup, numIters) {
+  size_t found = 0;
+  for (size_t n = 0; n < numIters; ++n) {
+    auto it = mapStore.find(ips[n % ips.size()]);
+    found += it->second->payload.size();
+  }
+  folly::doNotOptimizeAway(found);
+}
+
+BENCHMARK_RELATIVE(SlabStoreLookup, numIters) {
+  size_t found = 0;
+  for (size_t n = 0; n < numIters; ++n) {
+    auto entry = slabStore.find(ips[n % ips.size()]);
+    found += entry->payload.size();
+  }
+  folly::doNotOptimizeAway(found);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(UnorderedMapWalk, numIters) {
+  size_t walked = 0;
+  for (size_t n = 0; n < numIters; ++n) {
+    for (const auto& item : mapStore) {
+      walked += item.second->payload[0] + 1;
+    }
+  }
+  folly::doNotOptimizeAway(walked);
+}
+
+BENCHMARK_RELATIVE(SlabStoreWalk, numIters) {
+  size_t walked = 0;
+  for (size_t n = 0; n < numIters; ++n) {
+    slabStore.forEach(
+        [&](const FakeEntry& entry) { walked += entry.payload[0] + 1; });
+  }
+  folly::doNotOptimizeAway(walked);
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  init();
+
+  std::cout << FLAGS_neighbor_entries << " entries of " << sizeof(FakeEntry)
+            << " bytes: unordered_map " << mapStoreMemory()
+            << " bytes, slab store " << slabStore.getAllocatedMemorySize()
+            << " bytes" << std::endl;
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,175 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/NeighborEntryStore.h"
+
+#include <folly/IPAddressV4.h>
+#include <gtest/gtest.h>
+
+#include <set>
+
+using namespace facebook::fboss;
+using folly::IPAddressV4;
+
+namespace {
+
+int liveEntries = 0;
+
+struct TestEntry {
+  TestEntry(IPAddressV4 ip, int value) : ip(ip), value(value) {
+    ++liveEntries;
+  }
+  ~TestEntry() {
+    --liveEntries;
+  }
+  IPAddressV4 ip;
+  int value;
+};
+
+using Store = NeighborEntryStore<IPAddressV4, TestEntry, 4>;
+
+IPAddressV4 ipN(uint32_t n) {
+  return IPAddressV4::fromLongHBO(0x0a000000 + n);
+}
+
+} // namespace
+
+TEST(NeighborEntryStore, EmplaceFindErase) {
+  Store store;
+  EXPECT_TRUE(store.empty());
+  EXPECT_EQ(nullptr, store.find(ipN(1)));
+
+  auto entry = store.emplace(ipN(1), ipN(1), 1);
+  EXPECT_EQ(entry, store.find(ipN(1)));
+  EXPECT_EQ(1, entry->value);
+  EXPECT_EQ(1, store.size());
+
+  // Emplacing an existing IP replaces its entry
+  entry = store.emplace(ipN(1), ipN(1), 2);
+  EXPECT_EQ(2, store.find(ipN(1))->value);
+  EXPECT_EQ(1, store.size());
+  EXPECT_EQ(1, liveEntries);
+
+  EXPECT_TRUE(store.erase(ipN(1)));
+  EXPECT_FALSE(store.erase(ipN(1)));
+  EXPECT_EQ(nullptr, store.find(ipN(1)));
+  EXPECT_TRUE(store.empty());
+  EXPECT_EQ(0, liveEntries);
+}
+
+TEST(NeighborEntryStore, EntriesDoNotMove) {
+  Store store;
+  std::vector<TestEntry*> entries;
+  for (int i = 0; i < 10; ++i) {
+    entries.push_back(store.emplace(ipN(i), ipN(i), i));
+  }
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(entries[i], store.find(ipN(i)));
+    EXPECT_EQ(i, entries[i]->value);
+  }
+}
+
+TEST(NeighborEntryStore, ReusesFreedSlots) {
+  Store store;
+  for (int i = 0; i < 8; ++i) {
+    store.emplace(ipN(i), ipN(i), i);
+  }
+  auto erased = store.find(ipN(3));
+  store.erase(ipN(3));
+  auto memory = store.getAllocatedMemorySize();
+  EXPECT_EQ(erased, store.emplace(ipN(100), ipN(100), 100));
+  EXPECT_EQ(memory, store.getAllocatedMemorySize());
+}
+
+TEST(NeighborEntryStore, ForEach) {
+  Store store;
+  for (int i = 0; i < 10; ++i) {
+    store.emplace(ipN(i), ipN(i), i);
+  }
+  store.erase(ipN(2));
+  store.erase(ipN(7));
+
+  std::set<IPAddressV4> walked;
+  store.forEach([&](TestEntry& entry) {
+    EXPECT_TRUE(walked.insert(entry.ip).second);
+    ++entry.value;
+  });
+  EXPECT_EQ(8, walked.size());
+  EXPECT_EQ(0, walked.count(ipN(2)));
+  EXPECT_EQ(0, walked.count(ipN(7)));
+  EXPECT_EQ(2, store.find(ipN(1))->value);
+}
+
+TEST(NeighborEntryStore, ClearDestroysEntries) {
+  {
+    Store store;
+    for (int i = 0; i < 10; ++i) {
+      store.emplace(ipN(i), ipN(i), i);
+    }
+    EXPECT_EQ(10, liveEntries);
+    store.clear();
+    EXPECT_EQ(0, liveEntries);
+    EXPECT_TRUE(store.empty());
+    store.emplace(ipN(1), ipN(1), 1);
+  }
+  EXPECT_EQ(0, liveEntries);
+}
+
+TEST(NeighborEntryStore, GrowsGeometrically) {
+  Store store;
+  EXPECT_EQ(0, store.capacity());
+  EXPECT_EQ(0, store.getAllocatedMemorySize());
+  store.emplace(ipN(0), ipN(0), 0);
+  EXPECT_EQ(4, store.capacity());
+  for (int i = 1; i < 5; ++i) {
+    store.emplace(ipN(i), ipN(i), i);
+  }
+  EXPECT_EQ(4 + 8, store.capacity());
+  for (int i = 5; i < 13; ++i) {
+    store.emplace(ipN(i), ipN(i), i);
+  }
+  EXPECT_EQ(4 + 8 + 16, store.capacity());
+  for (int i = 0; i < 13; ++i) {
+    EXPECT_EQ(i, store.find(ipN(i))->value);
+  }
+}
+
+TEST(NeighborEntryStore, ReleasesEmptySlabs) {
+  Store store;
+  for (int i = 0; i < 13; ++i) {
+    store.emplace(ipN(i), ipN(i), i);
+  }
+  auto first = store.find(ipN(0));
+  auto memory = store.getAllocatedMemorySize();
+
+  // The last slab is kept while the one before it is more than half full
+  store.erase(ipN(12));
+  EXPECT_EQ(4 + 8 + 16, store.capacity());
+  for (int i = 4; i < 8; ++i) {
+    store.erase(ipN(i));
+  }
+  EXPECT_EQ(4 + 8, store.capacity());
+  EXPECT_GT(memory, store.getAllocatedMemorySize());
+
+  // The remaining entries did not move, and the released slots aren't reused
+  EXPECT_EQ(first, store.find(ipN(0)));
+  EXPECT_EQ(9, store.find(ipN(9))->value);
+  for (int i = 100; i < 104; ++i) {
+    store.emplace(ipN(i), ipN(i), i);
+  }
+  EXPECT_EQ(4 + 8, store.capacity());
+  EXPECT_EQ(8 + 4, store.size());
+
+  // Everything is released once the store is empty
+  for (int i : {0, 1, 2, 3, 8, 9, 10, 11, 100, 101, 102, 103}) {
+    EXPECT_TRUE(store.erase(ipN(i)));
+  }
+  EXPECT_EQ(0, store.capacity());
+  EXPECT_EQ(0, liveEntries);
+}
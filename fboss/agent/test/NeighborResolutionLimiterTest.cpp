@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/NeighborResolutionLimiter.h"
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+using folly::IPAddress;
+using std::chrono::milliseconds;
+using Result = NeighborResolutionLimiter::Result;
+
+namespace {
+const NeighborResolutionLimiter::Clock::time_point kStart(
+    std::chrono::hours(1));
+} // namespace
+
+TEST(NeighborResolutionLimiter, DedupPerDestination) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_neighbor_resolution_interval_ms = 1000;
+  FLAGS_neighbor_resolution_rate = 0;
+  NeighborResolutionLimiter limiter;
+
+  IPAddress ip("10.0.0.10");
+  EXPECT_EQ(Result::RESOLVE, limiter.shouldResolve(VlanID(1), ip, kStart));
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(
+        Result::DEDUPED,
+        limiter.shouldResolve(VlanID(1), ip, kStart + milliseconds(i)));
+  }
+  // Other destinations, or the same IP on another VLAN, are unaffected
+  EXPECT_EQ(
+      Result::RESOLVE,
+      limiter.shouldResolve(VlanID(1), IPAddress("10.0.0.11"), kStart));
+  EXPECT_EQ(Result::RESOLVE, limiter.shouldResolve(VlanID(2), ip, kStart));
+
+  // Resolved again once the interval is over
+  EXPECT_EQ(
+      Result::RESOLVE,
+      limiter.shouldResolve(VlanID(1), ip, kStart + milliseconds(1000)));
+  EXPECT_EQ(
+      Result::DEDUPED,
+      limiter.shouldResolve(VlanID(1), ip, kStart + milliseconds(1001)));
+}
+
+TEST(NeighborResolutionLimiter, EvictsLeastRecentlyResolved) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_neighbor_resolution_interval_ms = 1000;
+  FLAGS_neighbor_resolution_cache_size = 2;
+  FLAGS_neighbor_resolution_rate = 0;
+  NeighborResolutionLimiter limiter;
+
+  IPAddress ip1("2401:db00::1");
+  IPAddress ip2("2401:db00::2");
+  IPAddress ip3("2401:db00::3");
+  EXPECT_EQ(Result::RESOLVE, limiter.shouldResolve(VlanID(1), ip1, kStart));
+  EXPECT_EQ(Result::RESOLVE, limiter.shouldResolve(VlanID(1), ip2, kStart));
+  EXPECT_EQ(Result::RESOLVE, limiter.shouldResolve(VlanID(1), ip3, kStart));
+  EXPECT_EQ(2, limiter.getNumTracked());
+  EXPECT_EQ(Result::DEDUPED, limiter.shouldResolve(VlanID(1), ip3, kStart));
+  EXPECT_EQ(Result::RESOLVE, limiter.shouldResolve(VlanID(1), ip1, kStart));
+}
+
+TEST(NeighborResolutionLimiter, RateLimit) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_neighbor_resolution_interval_ms = 0;
+  FLAGS_neighbor_resolution_rate = 100;
+  FLAGS_neighbor_resolution_burst = 10;
+  NeighborResolutionLimiter limiter;
+
+  int resolved = 0;
+  for (uint32_t i = 0; i < 50; ++i) {
+    auto ip = IPAddress::fromLongHBO(0x0a000000 + i);
+    auto result = limiter.shouldResolve(VlanID(1), ip, kStart);
+    if (result == Result::RESOLVE) {
+      ++resolved;
+    } else {
+      EXPECT_EQ(Result::RATE_LIMITED, result);
+    }
+  }
+  EXPECT_EQ(10, resolved);
+  // Without dedup, nothing is tracked per destination
+  EXPECT_EQ(0, limiter.getNumTracked());
+
+  // The bucket refills at the configured rate
+  EXPECT_EQ(
+      Result::RESOLVE,
+      limiter.shouldResolve(
+          VlanID(1), IPAddress("10.1.0.1"), kStart + milliseconds(15)));
+  EXPECT_EQ(
+      Result::RATE_LIMITED,
+      limiter.shouldResolve(
+          VlanID(1), IPAddress("10.1.0.2"), kStart + milliseconds(15)));
+}
+
+TEST(NeighborResolutionLimiter, RateLimitedNotRecorded) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_neighbor_resolution_interval_ms = 1000;
+  FLAGS_neighbor_resolution_rate = 1;
+  FLAGS_neighbor_resolution_burst = 1;
+  NeighborResolutionLimiter limiter;
+
+  IPAddress ip1("10.0.0.1");
+  IPAddress ip2("10.0.0.2");
+  EXPECT_EQ(Result::RESOLVE, limiter.shouldResolve(VlanID(1), ip1, kStart));
+  EXPECT_EQ(
+      Result::RATE_LIMITED, limiter.shouldResolve(VlanID(1), ip2, kStart));
+  // ip2 was never resolved, so it goes through as soon as there is a token
+  EXPECT_EQ(
+      Result::RESOLVE,
+      limiter.shouldResolve(VlanID(1), ip2, kStart + milliseconds(1500)));
+}
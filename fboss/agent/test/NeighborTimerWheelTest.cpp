@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/NeighborTimerWheel.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/io/async/EventBase.h>
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <functional>
+
+using namespace facebook::fboss;
+using std::chrono::duration_cast;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+namespace {
+
+milliseconds deadline(steady_clock::time_point now, milliseconds timeout) {
+  return duration_cast<milliseconds>(now.time_since_epoch()) + timeout;
+}
+
+class CountingCallback : public folly::HHWheelTimer::Callback {
+ public:
+  void timeoutExpired() noexcept override {
+    ++expired;
+    if (onExpired) {
+      onExpired();
+    }
+  }
+  int expired{0};
+  std::function<void()> onExpired;
+};
+
+// Runs at the end of the loop iteration in which it was scheduled
+class EndOfLoopCallback : public folly::EventBase::LoopCallback {
+ public:
+  explicit EndOfLoopCallback(std::function<void()> fn) : fn_(std::move(fn)) {}
+  void runLoopCallback() noexcept override {
+    fn_();
+  }
+
+ private:
+  std::function<void()> fn_;
+};
+
+} // namespace
+
+TEST(NeighborTimerWheel, RoundsUpToBucket) {
+  milliseconds bucket(FLAGS_neighbor_timer_bucket_ms);
+  ASSERT_GT(bucket.count(), 0);
+  auto now = steady_clock::now();
+  for (auto timeout : {milliseconds(0),
+                       milliseconds(1),
+                       milliseconds(999),
+                       milliseconds(1000),
+                       milliseconds(30000)}) {
+    auto rounded = neighborTimerBucketTimeout(now, timeout);
+    EXPECT_GE(rounded, timeout);
+    EXPECT_LT(rounded, timeout + bucket);
+    EXPECT_EQ(0, deadline(now, rounded).count() % bucket.count());
+  }
+}
+
+TEST(NeighborTimerWheel, SameBucketSameDeadline) {
+  milliseconds bucket(FLAGS_neighbor_timer_bucket_ms);
+  ASSERT_GT(bucket.count(), 2);
+  // Just past the start of a bucket
+  steady_clock::time_point now(bucket * 10 + milliseconds(1));
+  auto first = neighborTimerBucketTimeout(now, milliseconds(1000));
+  auto second = neighborTimerBucketTimeout(
+      now, milliseconds(1000) + bucket - milliseconds(2));
+  EXPECT_EQ(deadline(now, first), deadline(now, second));
+}
+
+TEST(NeighborTimerWheel, NoBucket) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_neighbor_timer_bucket_ms = 0;
+  auto now = steady_clock::now();
+  EXPECT_EQ(
+      milliseconds(1234), neighborTimerBucketTimeout(now, milliseconds(1234)));
+}
+
+TEST(NeighborTimerWheel, CallbacksExpireTogether) {
+  folly::EventBase evb;
+  CountingCallback first;
+  CountingCallback second;
+  // What had expired by the end of the loop iteration of the first timeout
+  int expiredInFirstPass = -1;
+  EndOfLoopCallback endOfPass(
+      [&] { expiredInFirstPass = first.expired + second.expired; });
+  auto onExpired = [&] {
+    if (expiredInFirstPass < 0 && !endOfPass.isLoopCallbackScheduled()) {
+      evb.runInLoop(&endOfPass);
+    }
+  };
+  first.onExpired = onExpired;
+  second.onExpired = onExpired;
+
+  // Keep the two deadlines from falling on either side of a bucket boundary
+  waitForNeighborTimerBucketStart();
+  scheduleNeighborTimeout(&evb, &first, milliseconds(1));
+  scheduleNeighborTimeout(&evb, &second, milliseconds(2));
+  EXPECT_TRUE(first.isScheduled());
+  evb.loop();
+  EXPECT_EQ(1, first.expired);
+  EXPECT_EQ(1, second.expired);
+  // Both fired from the same tick of the wheel
+  EXPECT_EQ(2, expiredInFirstPass);
+}
@@ -13,6 +13,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 using namespace facebook::fboss;
 
 namespace {
@@ -155,4 +157,32 @@ TEST_F(PrefixTrackerTest, DeleteLessSpecificUntracked) {
   checkNotTracking(p2);
 }
 
+// Nested prefixes tracked by different identifiers are matched
+// independently, each by its own most specific tracked prefix
+TEST_F(PrefixTrackerTest, NestedPrefixesDifferentIdentifiers) {
+  startTracking("1:1::", 32, "foo", false);
+  startTracking("1:1:1:1::", 64, "bar", true);
+  std::vector<std::string> ids;
+  EXPECT_TRUE(tracker.tracking(p1, ids));
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ(ids, (std::vector<std::string>{"bar", "foo"}));
+
+  RoutePrefix<folly::IPAddressV6> p3{folly::IPAddressV6{"1:1:1:1:1::"}, 80};
+  EXPECT_TRUE(tracker.tracking(p3, ids));
+  EXPECT_EQ(ids, (std::vector<std::string>{"foo"}));
+
+  // A more specific exact prefix hides a less specific one of the same
+  // identifier
+  startTracking("1:1:1:1::", 64, "foo", true);
+  EXPECT_TRUE(tracker.tracking(p1, ids));
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ(ids, (std::vector<std::string>{"bar", "foo"}));
+  checkNotTracking(p3);
+
+  tracker.stopTracking("bar");
+  EXPECT_TRUE(tracker.tracking(p1, ids));
+  EXPECT_EQ(ids, (std::vector<std::string>{"foo"}));
+  EXPECT_EQ(2, tracker.getTrackedPrefixes().size());
+}
+
 } // namespace
@@ -11,6 +11,7 @@
 #include <gtest/gtest.h>
 
 #include "fboss/agent/FbossHwUpdateError.h"
+#include "fboss/agent/StateUpdateTracer.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/CounterCache.h"
@@ -22,6 +23,7 @@
 #include <folly/MacAddress.h>
 
 #include <algorithm>
+#include <map>
 
 using namespace facebook::fboss;
 using std::string;
@@ -238,6 +240,35 @@ TEST_P(SwSwitchUpdateProcessingTest, HwFailureProtectedUpdatesDuringExit) {
   EXPECT_EQ(startState, sw->getState());
 }
 
+TEST_P(SwSwitchUpdateProcessingTest, UpdatesAreTraced) {
+  auto origState = sw->getState();
+  auto newState = bringAllPortsUp(sw->getState()->clone());
+  newState->publish();
+  auto stateUpdateFn = [=](const std::shared_ptr<SwitchState>& /*state*/) {
+    return newState;
+  };
+  setStateChangedReturn(origState);
+  EXPECT_THROW(
+      sw->updateStateWithHwFailureProtection("Rejected update", stateUpdateFn),
+      FbossHwUpdateError);
+  setStateChangedReturn(newState);
+  sw->updateState("Accepted update", stateUpdateFn);
+  waitForStateUpdates(sw);
+
+  std::map<std::string, StateUpdateTracer::Trace> traces;
+  for (const auto& trace : sw->getStateUpdateTracer()->getTraces()) {
+    traces[trace.name] = trace;
+  }
+  ASSERT_EQ(1, traces.count("Rejected update"));
+  ASSERT_EQ(1, traces.count("Accepted update"));
+  const auto& rejected = traces["Rejected update"];
+  EXPECT_TRUE(rejected.failed);
+  const auto& accepted = traces["Accepted update"];
+  EXPECT_FALSE(accepted.failed);
+  EXPECT_EQ(newState->getGeneration(), accepted.generation);
+  EXPECT_GE(accepted.endTime, rejected.endTime);
+}
+
 INSTANTIATE_TEST_CASE_P(
     SwSwitchUpdateProcessingTest,
     SwSwitchUpdateProcessingTest,
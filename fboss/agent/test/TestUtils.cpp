@@ -14,6 +14,7 @@
 
 #include "fboss/agent/AgentConfig.h"
 #include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/NeighborTimerWheel.h"
 #include "fboss/agent/RxPacket.h"
 #include "fboss/agent/TunManager.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
@@ -38,6 +39,7 @@
 #include <folly/logging/Init.h>
 #include <chrono>
 #include <optional>
+#include <thread>
 
 using folly::ByteRange;
 using folly::IOBuf;
@@ -302,6 +304,20 @@ void waitForNeighborCacheThread(SwSwitch* sw) {
   evb->runInEventBaseThreadAndWait([]() { return; });
 }
 
+void waitForNeighborTimerBucketStart() {
+  std::chrono::milliseconds bucket(FLAGS_neighbor_timer_bucket_ms);
+  if (bucket.count() <= 0) {
+    return;
+  }
+  auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now().time_since_epoch());
+  // A deadline right on a bucket boundary isn't rounded up, while one a
+  // millisecond later is rounded to the next boundary, so leave a margin
+  /* sleep override */
+  std::this_thread::sleep_for(
+      bucket - now % bucket + std::chrono::milliseconds(1));
+}
+
 void waitForRibUpdates(SwSwitch* sw) {
   sw->getRouteUpdater().program();
 }
@@ -117,6 +117,12 @@ void waitForBackgroundThread(SwSwitch* sw);
  */
 void waitForNeighborCacheThread(SwSwitch* sw);
 
+/*
+ * Wait until just past the start of a neighbor timer bucket, so that
+ * timeouts scheduled right after all round up to the same deadline.
+ */
+void waitForNeighborTimerBucketStart();
+
 /*
  * Wait until all currently queued lambdas on ribUpdateThread are
  * done
@@ -12,6 +12,8 @@
 #include "fboss/agent/AddressUtil.h"
 #include "fboss/agent/ApplyThriftConfig.h"
 #include "fboss/agent/FbossHwUpdateError.h"
+#include "fboss/agent/RouteChangeTracker.h"
+#include "fboss/agent/RouteTablePager.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/ThriftHandler.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
@@ -25,9 +27,16 @@
 #include "fboss/agent/test/RouteScaleGenerators.h"
 #include "fboss/agent/test/TestUtils.h"
 
+#include <folly/Format.h>
 #include <folly/IPAddress.h>
+#include <folly/json.h>
+#include <folly/json_pointer.h>
+#include <folly/synchronization/Baton.h>
 #include <gtest/gtest.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
+#include <thrift/lib/cpp2/util/ScopedServerInterfaceThread.h>
+
+#include <thread>
 
 using namespace facebook::fboss;
 using namespace facebook::stats;
@@ -46,6 +55,8 @@ using ::testing::_;
 using ::testing::Return;
 using testing::UnorderedElementsAreArray;
 
+DECLARE_bool(enable_running_config_mutations);
+
 namespace {
 
 IpPrefix ipPrefix(StringPiece ip, int length) {
@@ -941,6 +952,148 @@ TEST_F(ThriftTest, addUnicastRoutesIsHwProtected) {
       FbossFibUpdateError);
 }
 
+TEST_F(ThriftTest, addUnicastRoutesFromConcurrentClients) {
+  ThriftHandler handler(sw_);
+  std::vector<std::thread> clients;
+  for (int16_t client = 10; client < 14; client++) {
+    clients.emplace_back([&handler, client] {
+      auto newRoutes = std::make_unique<std::vector<UnicastRoute>>();
+      newRoutes->push_back(*makeUnicastRoute(
+                                folly::sformat("aaaa:{}::/64", client),
+                                "2401:db00:2110:3001::1")
+                                .get());
+      handler.addUnicastRoutes(client, std::move(newRoutes));
+    });
+  }
+  for (auto& client : clients) {
+    client.join();
+  }
+  // Every client's route made it, whichever batch it was programmed in
+  auto state = sw_->getState();
+  for (int16_t client = 10; client < 14; client++) {
+    EXPECT_NE(
+        nullptr,
+        findRoute<folly::IPAddressV6>(
+            RouterID(0),
+            IPAddress::createNetwork(folly::sformat("aaaa:{}::/64", client)),
+            state));
+  }
+}
+
+TEST_F(ThriftTest, asyncRouteUpdatesFromConcurrentClientsBatched) {
+  auto handler = std::make_shared<ThriftHandler>(sw_);
+  apache::thrift::ScopedServerInterfaceThread server(handler);
+  auto client = server.newClient<FbossCtrlAsyncClient>();
+  auto batcher = handler->getRouteUpdateBatcher();
+
+  // Hold up state updates, so that route updates arriving meanwhile queue up
+  // behind the first batch instead of being programmed one at a time
+  folly::Baton<> unblock;
+  sw_->updateState(
+      "hold up state updates",
+      [&unblock](const std::shared_ptr<SwitchState>& /*state*/) {
+        unblock.wait();
+        return std::shared_ptr<SwitchState>();
+      });
+  std::vector<folly::SemiFuture<folly::Unit>> updates;
+  for (int16_t clientId = 10; clientId < 14; clientId++) {
+    std::vector<UnicastRoute> routes;
+    routes.push_back(*makeUnicastRoute(
+                          folly::sformat("aaaa:{}::/64", clientId),
+                          "2401:db00:2110:3001::1")
+                          .get());
+    updates.push_back(client->semifuture_addUnicastRoutes(clientId, routes));
+  }
+  while (batcher->getUpdatesQueued() < 4) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(0, batcher->getBatchesProgrammed());
+  unblock.post();
+
+  for (auto& result : folly::collectAll(std::move(updates)).get()) {
+    EXPECT_FALSE(result.hasException());
+  }
+  // The first batch took whichever updates had arrived, the rest were merged
+  EXPECT_LE(batcher->getBatchesProgrammed(), 2);
+  auto state = sw_->getState();
+  for (int16_t clientId = 10; clientId < 14; clientId++) {
+    EXPECT_NE(
+        nullptr,
+        findRoute<folly::IPAddressV6>(
+            RouterID(0),
+            IPAddress::createNetwork(folly::sformat("aaaa:{}::/64", clientId)),
+            state));
+  }
+
+  std::vector<IpPrefix> prefixes{ipPrefix("aaaa:10::", 64)};
+  client->semifuture_deleteUnicastRoutes(10, prefixes).get();
+  EXPECT_EQ(
+      nullptr,
+      findRoute<folly::IPAddressV6>(
+          RouterID(0),
+          IPAddress::createNetwork("aaaa:10::/64"),
+          sw_->getState()));
+}
+
+TEST_F(ThriftTest, getCurrentStateJSON) {
+  ThriftHandler handler(sw_);
+  auto state = sw_->getState();
+  for (auto path :
+       {"/ports/entries/0/portName",
+        "/fibs/entries/0/fibV4/entries/0",
+        "/interfaces/0",
+        "/defaultVlan"}) {
+    std::string ret;
+    handler.getCurrentStateJSON(ret, std::make_unique<std::string>(path));
+    EXPECT_EQ(
+        folly::parseJson(ret),
+        *state->toFollyDynamic().get_ptr(folly::json_pointer::parse(path)))
+        << path;
+  }
+
+  std::string ret;
+  // Not a JSON pointer, and a pointer to nothing
+  EXPECT_THROW(
+      handler.getCurrentStateJSON(
+          ret, std::make_unique<std::string>("ports/entries")),
+      FbossError);
+  EXPECT_THROW(
+      handler.getCurrentStateJSON(
+          ret, std::make_unique<std::string>("/ports/entries/1000")),
+      FbossError);
+}
+
+TEST_F(ThriftTest, patchCurrentStateJSON) {
+  gflags::FlagSaver flagSaver;
+  ThriftHandler handler(sw_);
+  auto patch = [&handler](std::string path, std::string patchStr) {
+    handler.patchCurrentStateJSON(
+        std::make_unique<std::string>(std::move(path)),
+        std::make_unique<std::string>(std::move(patchStr)));
+  };
+  auto portID = (*sw_->getState()->getPorts()->begin())->getID();
+
+  FLAGS_enable_running_config_mutations = false;
+  EXPECT_THROW(
+      patch("/ports/entries/0", R"({"portDescription": "patched"})"),
+      FbossError);
+
+  FLAGS_enable_running_config_mutations = true;
+  auto oldState = sw_->getState();
+  patch("/ports/entries/0", R"({"portDescription": "patched"})");
+  auto newState = sw_->getState();
+  EXPECT_EQ("patched", newState->getPort(portID)->getDescription());
+  EXPECT_EQ(oldState->getVlans(), newState->getVlans());
+  EXPECT_EQ(oldState->getFibs(), newState->getFibs());
+
+  // Bad pointers and patches leave the state as it is
+  EXPECT_THROW(patch("ports/entries/0", "{}"), FbossError);
+  EXPECT_THROW(patch("/ports/entries/1000", "{}"), FbossError);
+  EXPECT_ANY_THROW(patch("/ports/entries/0", "{"));
+  EXPECT_ANY_THROW(patch("/ports/entries/0", R"({"portId": "notanumber"})"));
+  EXPECT_EQ(newState, sw_->getState());
+}
+
 TEST_F(ThriftTest, getRouteTable) {
   ThriftHandler handler(sw_);
   auto [v4Routes, v6Routes] = getRouteCount(sw_->getState());
@@ -969,6 +1122,159 @@ TEST_F(ThriftTest, getRouteTableByClient) {
   // 6 intf routes + 2 default routes + 1 link local route
   EXPECT_EQ(6, routeTable.size());
 }
+
+TEST_F(ThriftTest, routeTablePager) {
+  auto countPages = [](RouteTablePager pager, size_t pageSize) {
+    std::vector<size_t> pages;
+    bool more = true;
+    while (more) {
+      size_t routes = 0;
+      more = pager.visitNext(pageSize, [&routes](RouterID, const auto&) {
+        ++routes;
+        return true;
+      });
+      pages.push_back(routes);
+    }
+    return pages;
+  };
+  auto state = sw_->getState();
+  // 6 intf routes + 2 default routes + 1 link local route
+  EXPECT_EQ(
+      std::vector<size_t>({2, 2, 2, 2, 1}),
+      countPages(RouteTablePager(state, std::nullopt, std::nullopt), 2));
+  EXPECT_EQ(
+      std::vector<size_t>({9}),
+      countPages(RouteTablePager(state, RouterID(0), std::nullopt), 100));
+  EXPECT_EQ(
+      std::vector<size_t>({0}),
+      countPages(RouteTablePager(state, RouterID(1), std::nullopt), 100));
+  // 2401:db00:2110:3001::/64 and 2401:db00:2110:3055::/64
+  EXPECT_EQ(
+      std::vector<size_t>({2}),
+      countPages(
+          RouteTablePager(
+              state,
+              std::nullopt,
+              IPAddress::createNetwork("2401:db00:2110::/48")),
+          100));
+  // 10.0.0.0/24 and 10.0.55.0/24, default route is not contained
+  EXPECT_EQ(
+      std::vector<size_t>({1, 1}),
+      countPages(
+          RouteTablePager(
+              state, std::nullopt, IPAddress::createNetwork("10.0.0.0/8")),
+          1));
+}
+
+TEST_F(ThriftTest, getRouteTableChangesSince) {
+  ThriftHandler handler(sw_);
+  auto bgpClient = static_cast<int16_t>(ClientID::BGPD);
+  RouteTableChanges initial;
+  handler.getRouteTableChangesSince(
+      initial, 0, std::make_unique<RouteTableFilter>(), 0);
+  // Clients without a cursor always need a full sync
+  EXPECT_TRUE(*initial.fullSyncRequired_ref());
+  auto generation = *initial.generation_ref();
+  auto runId = *initial.runId_ref();
+  EXPECT_NE(0, runId);
+
+  handler.addUnicastRoute(
+      bgpClient, makeUnicastRoute("7.1.0.0/16", "10.0.0.11"));
+  handler.addUnicastRoute(
+      bgpClient, makeUnicastRoute("aaaa:1::0/64", "2401:db00:2110:3001::11"));
+  waitForStateUpdates(sw_);
+
+  RouteTableChanges changes;
+  handler.getRouteTableChangesSince(
+      changes, generation, std::make_unique<RouteTableFilter>(), runId);
+  EXPECT_FALSE(*changes.fullSyncRequired_ref());
+  EXPECT_GT(*changes.generation_ref(), generation);
+  EXPECT_EQ(2, changes.changedRoutes_ref()->size());
+  EXPECT_EQ(0, changes.removedRoutes_ref()->size());
+
+  // Only v4 routes
+  auto filter = std::make_unique<RouteTableFilter>();
+  filter->prefix_ref() = ipPrefix("0.0.0.0", 0);
+  RouteTableChanges v4Changes;
+  handler.getRouteTableChangesSince(
+      v4Changes, generation, std::move(filter), runId);
+  ASSERT_EQ(1, v4Changes.changedRoutes_ref()->size());
+  EXPECT_EQ(
+      ipPrefix("7.1.0.0", 16), *v4Changes.changedRoutes_ref()[0].dest_ref());
+
+  // Removal since the last query
+  generation = *changes.generation_ref();
+  handler.deleteUnicastRoute(
+      bgpClient, std::make_unique<IpPrefix>(ipPrefix("7.1.0.0", 16)));
+  waitForStateUpdates(sw_);
+  RouteTableChanges removals;
+  handler.getRouteTableChangesSince(
+      removals, generation, std::make_unique<RouteTableFilter>(), runId);
+  EXPECT_EQ(0, removals.changedRoutes_ref()->size());
+  ASSERT_EQ(1, removals.removedRoutes_ref()->size());
+  EXPECT_EQ(ipPrefix("7.1.0.0", 16), removals.removedRoutes_ref()[0]);
+
+  // Generations from the future, e.g. before an agent restart
+  RouteTableChanges future;
+  handler.getRouteTableChangesSince(
+      future,
+      *removals.generation_ref() + 1,
+      std::make_unique<RouteTableFilter>(),
+      runId);
+  EXPECT_TRUE(*future.fullSyncRequired_ref());
+
+  // A generation from another agent run, even one that exists in this run
+  RouteTableChanges otherRun;
+  handler.getRouteTableChangesSince(
+      otherRun, generation, std::make_unique<RouteTableFilter>(), runId + 1);
+  EXPECT_TRUE(*otherRun.fullSyncRequired_ref());
+  EXPECT_EQ(0, otherRun.changedRoutes_ref()->size());
+  EXPECT_EQ(runId, *otherRun.runId_ref());
+}
+
+TEST_F(ThriftTest, getRouteTableChangesSinceHistoryExceeded) {
+  ThriftHandler handler(sw_);
+  auto bgpClient = static_cast<int16_t>(ClientID::BGPD);
+  RouteTableChanges initial;
+  handler.getRouteTableChangesSince(
+      initial, 0, std::make_unique<RouteTableFilter>(), 0);
+  auto generation = *initial.generation_ref();
+  auto runId = *initial.runId_ref();
+
+  gflags::FlagSaver flagSaver;
+  FLAGS_route_change_history_size = 1;
+  handler.addUnicastRoute(
+      bgpClient, makeUnicastRoute("7.1.0.0/16", "10.0.0.11"));
+  waitForStateUpdates(sw_);
+  RouteTableChanges afterFirst;
+  handler.getRouteTableChangesSince(
+      afterFirst, generation, std::make_unique<RouteTableFilter>(), runId);
+  EXPECT_FALSE(*afterFirst.fullSyncRequired_ref());
+  EXPECT_EQ(1, afterFirst.changedRoutes_ref()->size());
+
+  // Pushes the first change out of the history
+  handler.addUnicastRoute(
+      bgpClient, makeUnicastRoute("7.2.0.0/16", "10.0.0.11"));
+  waitForStateUpdates(sw_);
+
+  RouteTableChanges changes;
+  handler.getRouteTableChangesSince(
+      changes, generation, std::make_unique<RouteTableFilter>(), runId);
+  EXPECT_TRUE(*changes.fullSyncRequired_ref());
+  EXPECT_EQ(0, changes.changedRoutes_ref()->size());
+
+  // The latest change is still known
+  RouteTableChanges latest;
+  handler.getRouteTableChangesSince(
+      latest,
+      *afterFirst.generation_ref(),
+      std::make_unique<RouteTableFilter>(),
+      runId);
+  EXPECT_FALSE(*latest.fullSyncRequired_ref());
+  ASSERT_EQ(1, latest.changedRoutes_ref()->size());
+  EXPECT_EQ(
+      ipPrefix("7.2.0.0", 16), *latest.changedRoutes_ref()[0].dest_ref());
+}
 std::unique_ptr<MplsRoute> makeMplsRoute(
     int32_t mplsLabel,
     std::string nxtHop,
@@ -1353,6 +1659,38 @@ TEST_F(ThriftTest, getRouteTableVerifyCounterID) {
   EXPECT_EQ(*route.counterID_ref(), *counterID1);
 }
 
+TEST_F(ThriftTest, getAgentMemoryUsage) {
+  ThriftHandler handler(sw_);
+  MemoryUsageReport report;
+  handler.getAgentMemoryUsage(report);
+
+  // The PortMap and every port in it
+  auto numPorts = sw_->getState()->getPorts()->size();
+  ASSERT_EQ(1, report.switchState_ref()->count("ports"));
+  EXPECT_EQ(numPorts + 1, *report.switchState_ref()->at("ports").objects_ref());
+  // The interface and link local routes
+  ASSERT_EQ(1, report.rib_ref()->count("v6RadixTree"));
+  auto v6Nodes = *report.rib_ref()->at("v6RadixTree").objects_ref();
+  EXPECT_GT(v6Nodes, 0);
+  EXPECT_GT(*report.rib_ref()->at("v6RadixTree").bytes_ref(), 0);
+  // One ARP and NDP cache per VLAN, empty so far
+  ASSERT_EQ(1, report.neighborCaches_ref()->count("arp"));
+  ASSERT_EQ(1, report.neighborCaches_ref()->count("ndp"));
+  EXPECT_EQ(0, *report.neighborCaches_ref()->at("ndp").objects_ref());
+  EXPECT_GE(*report.oldSwitchStateGenerations_ref(), 0);
+
+  // New routes show up in the RIB radix trees
+  auto newRoutes = std::make_unique<std::vector<UnicastRoute>>();
+  newRoutes->push_back(
+      *makeUnicastRoute("aaaa::/64", "2401:db00:2110:3001::1"));
+  newRoutes->push_back(
+      *makeUnicastRoute("bbbb::/64", "2401:db00:2110:3001::1"));
+  handler.addUnicastRoutes(10, std::move(newRoutes));
+  handler.getAgentMemoryUsage(report);
+  EXPECT_GE(
+      *report.rib_ref()->at("v6RadixTree").objects_ref(), v6Nodes + 2);
+}
+
 TEST_F(ThriftTest, getLoopbackMode) {
   ThriftHandler handler(sw_);
   std::map<int32_t, PortLoopbackMode> port2LoopbackMode;
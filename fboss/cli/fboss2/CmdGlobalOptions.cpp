@@ -43,6 +43,18 @@ void CmdGlobalOptions::init(CLI::App& app) {
       ->check(CLI::PositiveNumber);
   app.add_option(
       "--color", color_, "color (no, yes => yes for tty and no for pipe)");
+  app.add_option(
+         "--max-parallel-hosts",
+         maxParallelHosts_,
+         "Maximum number of hosts queried at the same time")
+      ->check(CLI::PositiveNumber);
+  app.add_option(
+         "--rpc-timeout-ms",
+         rpcTimeoutMs_,
+         "Receive timeout in milliseconds of each Thrift call, if lower than "
+         "the default 45000. Commands making several calls may wait on a "
+         "host for several times this long")
+      ->check(CLI::NonNegativeNumber);
 
   initAdditional(app);
 }
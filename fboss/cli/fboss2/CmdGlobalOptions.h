@@ -93,10 +93,21 @@ class CmdGlobalOptions {
     return color_;
   }
 
+  int getMaxParallelHosts() {
+    return maxParallelHosts_;
+  }
+
+  int getRpcTimeoutMs() {
+    return rpcTimeoutMs_;
+  }
+
   // Setters for testing purposes
   void setAgentThriftPort(int port) {
     agentThriftPort_ = port;
   }
+  void setRpcTimeoutMs(int timeoutMs) {
+    rpcTimeoutMs_ = timeoutMs;
+  }
 
  private:
   void initAdditional(CLI::App& app);
@@ -114,6 +125,9 @@ class CmdGlobalOptions {
   int coopThriftPort_{6969};
   int bmcHttpPort_{8080};
   std::string color_{"yes"};
+  int maxParallelHosts_{128};
+  // 0 keeps the default receive timeout
+  int rpcTimeoutMs_{0};
 };
 
 } // namespace facebook::fboss
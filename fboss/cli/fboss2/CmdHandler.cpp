@@ -23,60 +23,16 @@
 #include "fboss/cli/fboss2/commands/show/transceiver/CmdShowTransceiver.h"
 #include "fboss/cli/fboss2/utils/CmdClientUtils.h"
 #include "fboss/cli/fboss2/utils/CmdUtils.h"
+#include "fboss/cli/fboss2/utils/StreamingOutput.h"
 #include "folly/futures/Future.h"
 #include "thrift/lib/cpp2/protocol/Serializer.h"
 
 #include <folly/Singleton.h>
+#include <folly/String.h>
 #include <folly/logging/xlog.h>
-#include <future>
+#include <chrono>
 #include <iostream>
 
-template <typename CmdTypeT>
-void printTabular(
-    CmdTypeT& cmd,
-    std::vector<std::future<
-        std::tuple<std::string, typename CmdTypeT::RetType, std::string>>>&
-        results,
-    std::ostream& out,
-    std::ostream& err) {
-  for (auto& result : results) {
-    auto [host, data, errStr] = result.get();
-    if (results.size() != 1) {
-      out << host << "::" << std::endl << std::string(80, '=') << std::endl;
-    }
-
-    if (errStr.empty()) {
-      cmd.printOutput(data);
-    } else {
-      err << errStr << std::endl << std::endl;
-    }
-  }
-}
-
-template <typename CmdTypeT>
-void printJson(
-    const CmdTypeT& /* cmd */,
-    std::vector<std::future<
-        std::tuple<std::string, typename CmdTypeT::RetType, std::string>>>&
-        results,
-    std::ostream& out,
-    std::ostream& err) {
-  std::map<std::string, typename CmdTypeT::RetType> hostResults;
-  for (auto& result : results) {
-    auto [host, data, errStr] = result.get();
-    if (errStr.empty()) {
-      hostResults[host] = data;
-    } else {
-      err << host << "::" << std::endl << std::string(80, '=') << std::endl;
-      err << errStr << std::endl << std::endl;
-    }
-  }
-
-  out << apache::thrift::SimpleJSONSerializer::serialize<std::string>(
-             hostResults)
-      << std::endl;
-}
-
 namespace facebook::fboss {
 
 // Avoid template linker error
@@ -126,21 +82,30 @@ void CmdHandler<CmdTypeT, CmdTypeTraits>::run() {
     hosts = {"localhost"};
   }
 
-  std::vector<std::future<std::tuple<std::string, RetType, std::string>>>
-      futureList;
-  for (const auto& host : hosts) {
-    futureList.push_back(std::async(
-        std::launch::async,
-        &CmdHandler::asyncHandler,
-        this,
-        host /*, inArgs*/));
-  }
-
-  if (CmdGlobalOptions::getInstance()->getFmt() == "tabular") {
-    printTabular(impl(), futureList, std::cout, std::cerr);
-  } else if (CmdGlobalOptions::getInstance()->getFmt() == "JSON") {
-    printJson(impl(), futureList, std::cout, std::cerr);
-  }
+  // --fmt only accepts tabular and JSON, in any case
+  auto fmt = CmdGlobalOptions::getInstance()->getFmt();
+  folly::toLowerAscii(fmt);
+  utils::StreamingOutput<CmdTypeT> output(
+      impl(), fmt == "json", hosts.size(), std::cout, std::cerr);
+
+  // Each worker thread keeps its own EventBase, and the Thrift clients
+  // created on it, for all the hosts it queries. This bounds the number of
+  // threads and outstanding connections whatever the number of hosts, while
+  // --rpc-timeout-ms bounds how long each call waits on an unresponsive one.
+  utils::runOnHosts(
+      hosts,
+      CmdGlobalOptions::getInstance()->getMaxParallelHosts(),
+      [this, &output](const std::string& host) {
+        auto start = std::chrono::steady_clock::now();
+        auto [resultHost, data, errStr] = asyncHandler(host);
+        output.print(
+            resultHost,
+            data,
+            errStr,
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start));
+      });
+  output.finish();
 }
 
 } // namespace facebook::fboss
@@ -0,0 +1,200 @@
+// (c) Facebook, Inc. and its affiliates. Confidential and proprietary.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <folly/Conv.h>
+#include <folly/json.h>
+#include <thrift/lib/cpp/transport/TTransportException.h>
+
+#include "fboss/cli/fboss2/CmdGlobalOptions.h"
+#include "fboss/cli/fboss2/commands/show/arp/CmdShowArp.h"
+#include "fboss/cli/fboss2/commands/show/arp/gen-cpp2/model_types.h"
+#include "fboss/cli/fboss2/test/CmdHandlerTestBase.h"
+#include "fboss/cli/fboss2/utils/CmdUtils.h"
+#include "fboss/cli/fboss2/utils/StreamingOutput.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+using namespace ::testing;
+
+namespace facebook::fboss {
+
+namespace {
+
+// Prints the IPs of the model, one per line
+class FakeCmd {
+ public:
+  using RetType = cli::ShowArpModel;
+
+  explicit FakeCmd(std::ostream& out) : out_(out) {}
+
+  void printOutput(const RetType& model) {
+    for (const auto& entry : model.get_arpEntries()) {
+      out_ << entry.get_ip() << std::endl;
+    }
+  }
+
+ private:
+  std::ostream& out_;
+};
+
+cli::ShowArpModel createModel(const std::string& ip) {
+  cli::ArpEntry entry;
+  entry.ip_ref() = ip;
+  cli::ShowArpModel model;
+  model.arpEntries_ref()->push_back(entry);
+  return model;
+}
+
+} // namespace
+
+TEST(StreamingOutputTest, tabularStreamsInOrder) {
+  std::stringstream out;
+  std::stringstream err;
+  FakeCmd cmd(out);
+  utils::StreamingOutput<FakeCmd> output(cmd, false, 3, out, err);
+
+  output.print(
+      "host1", createModel("10.0.0.1"), "", std::chrono::milliseconds(10));
+  // Printed right away, not when all the hosts are done
+  EXPECT_EQ(out.str(), "host1::\n" + std::string(80, '=') + "\n10.0.0.1\n");
+
+  output.print("host2", cli::ShowArpModel(), "boom", std::chrono::seconds(1));
+  output.print(
+      "host3", createModel("10.0.0.3"), "", std::chrono::milliseconds(10));
+  output.finish();
+
+  auto str = out.str();
+  auto host1 = str.find("host1::");
+  auto host3 = str.find("host3::");
+  ASSERT_NE(host1, std::string::npos);
+  ASSERT_NE(host3, std::string::npos);
+  EXPECT_LT(host1, str.find("10.0.0.1"));
+  EXPECT_LT(str.find("10.0.0.1"), host3);
+  EXPECT_LT(host3, str.find("10.0.0.3"));
+  // Errors only go to stderr, with the summary
+  EXPECT_EQ(str.find("host2"), std::string::npos);
+  EXPECT_NE(err.str().find("boom"), std::string::npos);
+  EXPECT_NE(err.str().find("1 of 3 hosts failed"), std::string::npos);
+}
+
+TEST(StreamingOutputTest, jsonStreamsInOrder) {
+  std::stringstream out;
+  std::stringstream err;
+  FakeCmd cmd(out);
+  utils::StreamingOutput<FakeCmd> output(cmd, true, 3, out, err);
+
+  output.print(
+      "host1", createModel("10.0.0.1"), "", std::chrono::milliseconds(10));
+  auto afterFirst = out.str();
+  EXPECT_EQ(afterFirst.rfind("{\"host1\":", 0), 0);
+  EXPECT_NE(afterFirst.find("10.0.0.1"), std::string::npos);
+
+  output.print("host2", cli::ShowArpModel(), "boom", std::chrono::seconds(1));
+  output.print(
+      "host3", createModel("10.0.0.3"), "", std::chrono::milliseconds(10));
+  output.finish();
+
+  auto str = out.str();
+  EXPECT_EQ(str.rfind(afterFirst, 0), 0);
+  EXPECT_LT(str.find("\"host1\""), str.find("\"host3\""));
+  // Failed hosts are left out, so stdout is still a valid JSON object
+  auto parsed = folly::parseJson(str);
+  EXPECT_EQ(parsed.size(), 2);
+  EXPECT_EQ(
+      parsed.at("host3").at("arpEntries").at(0).at("ip").asString(),
+      "10.0.0.3");
+  EXPECT_EQ(parsed.count("host2"), 0);
+  EXPECT_NE(err.str().find("boom"), std::string::npos);
+}
+
+TEST(StreamingOutputTest, slowHostsSummarized) {
+  std::stringstream out;
+  std::stringstream err;
+  FakeCmd cmd(out);
+  utils::StreamingOutput<FakeCmd> output(cmd, false, 2, out, err);
+
+  output.print(
+      "host1", createModel("10.0.0.1"), "", std::chrono::milliseconds(10));
+  output.print("host2", createModel("10.0.0.2"), "", std::chrono::seconds(6));
+  output.finish();
+
+  EXPECT_NE(err.str().find("0 of 2 hosts failed, 1 took"), std::string::npos);
+  EXPECT_NE(err.str().find("slow: host2: 6000ms"), std::string::npos);
+  EXPECT_EQ(err.str().find("host1"), std::string::npos);
+}
+
+TEST(RunOnHostsTest, concurrencyBounded) {
+  std::vector<std::string> hosts;
+  for (int i = 0; i < 32; i++) {
+    hosts.push_back(folly::to<std::string>("host", i));
+  }
+  std::atomic<int> active{0};
+  std::atomic<int> maxActive{0};
+  std::mutex lock;
+  std::map<std::string, int> calls;
+  utils::runOnHosts(hosts, 4, [&](const std::string& host) {
+    auto nowActive = ++active;
+    auto prevMax = maxActive.load();
+    while (nowActive > prevMax &&
+           !maxActive.compare_exchange_weak(prevMax, nowActive)) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      calls[host]++;
+    }
+    --active;
+  });
+
+  EXPECT_LE(maxActive.load(), 4);
+  EXPECT_EQ(calls.size(), hosts.size());
+  for (const auto& [host, numCalls] : calls) {
+    EXPECT_EQ(numCalls, 1) << host;
+  }
+}
+
+TEST(RunOnHostsTest, atLeastOneThread) {
+  std::vector<std::string> hosts{"host1", "host2", "host3"};
+  std::atomic<int> active{0};
+  std::atomic<int> calls{0};
+  utils::runOnHosts(hosts, 0, [&](const std::string& /* host */) {
+    EXPECT_EQ(++active, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    --active;
+    ++calls;
+  });
+  EXPECT_EQ(calls.load(), hosts.size());
+}
+
+class RpcTimeoutTestFixture : public CmdHandlerTestBase {
+ public:
+  void TearDown() override {
+    CmdGlobalOptions::getInstance()->setRpcTimeoutMs(0);
+    CmdHandlerTestBase::TearDown();
+  }
+};
+
+TEST_F(RpcTimeoutTestFixture, timeoutReportedAsError) {
+  setupMockedAgentServer();
+  EXPECT_CALL(getMockAgent(), getArpTable(_))
+      .WillOnce(Invoke([](auto& /* entries */) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+      }));
+  CmdGlobalOptions::getInstance()->setRpcTimeoutMs(100);
+
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_THROW(
+      CmdShowArp().queryClient(localhost()),
+      apache::thrift::transport::TTransportException);
+  EXPECT_LT(
+      std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+}
+
+} // namespace facebook::fboss
@@ -15,6 +15,7 @@
 #include "fboss/cli/fboss2/utils/HostInfo.h"
 #include "fboss/qsfp_service/if/gen-cpp2/QsfpService.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -37,7 +38,9 @@ std::unique_ptr<Client> createPlaintextClient(
   sock->setSendTimeout(kSendTimeout);
   auto channel =
       apache::thrift::HeaderClientChannel::newChannel(std::move(sock));
-  channel->setTimeout(kRecvTimeout);
+  auto rpcTimeout = CmdGlobalOptions::getInstance()->getRpcTimeoutMs();
+  channel->setTimeout(
+      rpcTimeout > 0 ? std::min(rpcTimeout, kRecvTimeout) : kRecvTimeout);
   return std::make_unique<Client>(std::move(channel));
 }
 
@@ -9,10 +9,12 @@
  */
 #include "fboss/cli/fboss2/utils/CmdUtils.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/logging/LogConfig.h>
 #include <folly/logging/LoggerDB.h>
 #include <folly/logging/xlog.h>
 
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 
@@ -90,4 +92,16 @@ void setLogLevel(std::string logLevelStr) {
   XLOG(DBG1) << "Setting loglevel to " << logLevelStr;
 }
 
+void runOnHosts(
+    const std::vector<std::string>& hosts,
+    int maxParallelHosts,
+    const std::function<void(const std::string&)>& fn) {
+  folly::CPUThreadPoolExecutor executor(std::clamp<size_t>(
+      hosts.size(), 1, std::max(1, maxParallelHosts)));
+  for (const auto& host : hosts) {
+    executor.add([&fn, host]() { fn(host); });
+  }
+  executor.join();
+}
+
 } // namespace facebook::fboss::utils
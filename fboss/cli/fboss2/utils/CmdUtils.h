@@ -10,7 +10,9 @@
 #pragma once
 
 #include <folly/IPAddress.h>
+#include <functional>
 #include <string>
+#include <vector>
 
 namespace facebook::fboss::utils {
 
@@ -29,4 +31,13 @@ void setLogLevel(std::string logLevelStr);
 
 void logUsage(const std::string& cmdName);
 
+/*
+ * Call fn for every host from a pool of at most maxParallelHosts threads,
+ * and return once all the calls are done.
+ */
+void runOnHosts(
+    const std::vector<std::string>& hosts,
+    int maxParallelHosts,
+    const std::function<void(const std::string&)>& fn);
+
 } // namespace facebook::fboss::utils
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/json.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss::utils {
+
+// Hosts taking longer than this to answer are listed in the summary
+constexpr auto kSlowHostThreshold = std::chrono::seconds(5);
+
+/*
+ * Prints each host's result as soon as it is available and keeps track of
+ * the hosts that failed or were slow, for the summary printed at the end.
+ * Results may arrive from several threads at once.
+ */
+template <typename CmdTypeT>
+class StreamingOutput {
+ public:
+  using RetType = typename CmdTypeT::RetType;
+
+  StreamingOutput(
+      CmdTypeT& cmd,
+      bool json,
+      size_t numHosts,
+      std::ostream& out,
+      std::ostream& err)
+      : cmd_(cmd), json_(json), numHosts_(numHosts), out_(out), err_(err) {
+    if (json_) {
+      out_ << "{";
+    }
+  }
+
+  void print(
+      const std::string& host,
+      const RetType& data,
+      const std::string& errStr,
+      std::chrono::milliseconds duration) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (json_) {
+      printJson(host, data, errStr);
+    } else {
+      printTabular(host, data, errStr);
+    }
+    if (!errStr.empty()) {
+      failedHosts_.emplace_back(host, errStr);
+    } else if (duration > kSlowHostThreshold) {
+      slowHosts_.emplace_back(host, duration);
+    }
+  }
+
+  // Terminate the output and summarize failed and slow hosts
+  void finish() {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (json_) {
+      out_ << "}" << std::endl;
+    }
+    if (numHosts_ == 1 || (failedHosts_.empty() && slowHosts_.empty())) {
+      return;
+    }
+    err_ << failedHosts_.size() << " of " << numHosts_ << " hosts failed, "
+         << slowHosts_.size() << " took more than "
+         << std::chrono::duration_cast<std::chrono::seconds>(
+                kSlowHostThreshold)
+                .count()
+         << "s" << std::endl;
+    for (const auto& [host, errStr] : failedHosts_) {
+      err_ << "  failed: " << host << ": " << errStr << std::endl;
+    }
+    for (const auto& [host, duration] : slowHosts_) {
+      err_ << "  slow: " << host << ": " << duration.count() << "ms"
+           << std::endl;
+    }
+  }
+
+ private:
+  void printTabular(
+      const std::string& host,
+      const RetType& data,
+      const std::string& errStr) {
+    if (numHosts_ != 1) {
+      out_ << host << "::" << std::endl << std::string(80, '=') << std::endl;
+    }
+
+    if (errStr.empty()) {
+      cmd_.printOutput(data);
+    } else {
+      err_ << errStr << std::endl << std::endl;
+    }
+  }
+
+  // Results are streamed as members of a single JSON object keyed by host
+  void printJson(
+      const std::string& host,
+      const RetType& data,
+      const std::string& errStr) {
+    if (errStr.empty()) {
+      out_ << (firstJsonResult_ ? "" : ",")
+           << folly::toJson(folly::dynamic(host)) << ":"
+           << apache::thrift::SimpleJSONSerializer::serialize<std::string>(
+                  data);
+      out_.flush();
+      firstJsonResult_ = false;
+    } else {
+      err_ << host << "::" << std::endl << std::string(80, '=') << std::endl;
+      err_ << errStr << std::endl << std::endl;
+    }
+  }
+
+  CmdTypeT& cmd_;
+  const bool json_;
+  const size_t numHosts_;
+  std::ostream& out_;
+  std::ostream& err_;
+
+  std::mutex lock_;
+  bool firstJsonResult_{true};
+  std::vector<std::pair<std::string, std::string>> failedHosts_;
+  std::vector<std::pair<std::string, std::chrono::milliseconds>> slowHosts_;
+};
+
+} // namespace facebook::fboss::utils
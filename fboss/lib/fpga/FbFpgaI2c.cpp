@@ -14,6 +14,13 @@
 #include <algorithm>
 #include <thread>
 
+DEFINE_int32(
+    fpga_i2c_read_cache_ms,
+    0,
+    "How long static upper page data (pages 00h-02h) read through the FPGA "
+    "I2C controllers can be served again without an I2C transaction, in "
+    "milliseconds. 0 disables the cache");
+
 namespace {
 constexpr uint32_t kFacebookFpgaRTCWriteBlock = 0x2000;
 constexpr uint32_t kFacebookFpgaRTCReadBlock = 0x3000;
@@ -80,6 +87,11 @@ void FbFpgaI2c::read(
     uint8_t channel,
     uint8_t offset,
     folly::MutableByteRange buf) {
+  if (readFromCache(channel, offset, buf)) {
+    incrReadCacheHits();
+    return;
+  }
+
   I2cDescriptorLower descLower(version_);
   I2cDescriptorUpper descUpper(version_);
   descLower.dataUnion.reg = 0;
@@ -117,6 +129,7 @@ void FbFpgaI2c::read(
     }
     // Update the number of bytes read
     incrReadBytes(buf.size());
+    updateReadCache(channel, offset, buf);
   }
 }
 
@@ -125,6 +138,18 @@ void FbFpgaI2c::writeByte(uint8_t channel, uint8_t offset, uint8_t val) {
 }
 
 void FbFpgaI2c::write(uint8_t channel, uint8_t offset, folly::ByteRange buf) {
+  // Selecting a page leaves the data of every page as it is, any other write
+  // may change what we have cached. Until the write completes we also can't
+  // tell which page is selected.
+  bool selectsPage = offset <= FbFpgaI2cOp::kPageSelectOffset &&
+      offset + buf.size() > FbFpgaI2cOp::kPageSelectOffset;
+  if (offset != FbFpgaI2cOp::kPageSelectOffset || buf.size() != 1) {
+    eraseReadCache(channel);
+  }
+  if (selectsPage) {
+    selectedPage_[getI2cControllerChannel(channel)].reset();
+  }
+
   I2cDescriptorLower descLower(version_);
   I2cDescriptorUpper descUpper(version_);
   descLower.dataUnion.reg = 0;
@@ -164,6 +189,83 @@ void FbFpgaI2c::write(uint8_t channel, uint8_t offset, folly::ByteRange buf) {
   }
   // Update the number of bytes write
   incrWriteBytes(buf.size());
+  if (selectsPage) {
+    selectedPage_[getI2cControllerChannel(channel)] =
+        buf[FbFpgaI2cOp::kPageSelectOffset - offset];
+  }
+}
+
+void FbFpgaI2c::transaction(
+    uint8_t channel,
+    const std::vector<FbFpgaI2cOp>& ops) {
+  for (const auto& op : ops) {
+    if (op.type == FbFpgaI2cOp::Type::READ) {
+      read(channel, op.offset, op.readBuf);
+    } else {
+      write(channel, op.offset, op.writeBuf);
+    }
+  }
+}
+
+void FbFpgaI2c::invalidateReadCache(uint8_t channel) {
+  eraseReadCache(channel);
+  selectedPage_[getI2cControllerChannel(channel)].reset();
+}
+
+std::optional<FbFpgaI2c::ReadCacheKey> FbFpgaI2c::getReadCacheKey(
+    uint8_t channel,
+    uint8_t offset) const {
+  // The lower page holds clear on read flags and doesn't depend on the
+  // page selected, never cache it. Neither are the volatile upper pages,
+  // e.g. the latched lane flags and monitors of page 11h.
+  auto hwChannel = getI2cControllerChannel(channel);
+  if (FLAGS_fpga_i2c_read_cache_ms <= 0 || offset < kUpperPageOffset ||
+      !selectedPage_[hwChannel] ||
+      *selectedPage_[hwChannel] > kLastStaticPage) {
+    return std::nullopt;
+  }
+  return ReadCacheKey(hwChannel, *selectedPage_[hwChannel], offset);
+}
+
+bool FbFpgaI2c::readFromCache(
+    uint8_t channel,
+    uint8_t offset,
+    folly::MutableByteRange buf) {
+  auto key = getReadCacheKey(channel, offset);
+  if (!key) {
+    return false;
+  }
+  auto iter = readCache_.find(*key);
+  if (iter == readCache_.end()) {
+    return false;
+  }
+  if (std::chrono::steady_clock::now() - iter->second.readTime >
+      std::chrono::milliseconds(FLAGS_fpga_i2c_read_cache_ms)) {
+    readCache_.erase(iter);
+    return false;
+  }
+  if (iter->second.data.size() < buf.size()) {
+    return false;
+  }
+  std::memcpy(buf.begin(), iter->second.data.data(), buf.size());
+  return true;
+}
+
+void FbFpgaI2c::updateReadCache(
+    uint8_t channel,
+    uint8_t offset,
+    folly::ByteRange buf) {
+  if (auto key = getReadCacheKey(channel, offset)) {
+    readCache_[*key] = CachedRead{std::chrono::steady_clock::now(),
+                                  std::vector<uint8_t>(buf.begin(), buf.end())};
+  }
+}
+
+void FbFpgaI2c::eraseReadCache(uint8_t channel) {
+  auto hwChannel = getI2cControllerChannel(channel);
+  readCache_.erase(
+      readCache_.lower_bound(ReadCacheKey(hwChannel, 0, 0)),
+      readCache_.lower_bound(ReadCacheKey(hwChannel + 1, 0, 0)));
 }
 
 template <typename Register>
@@ -325,6 +427,30 @@ void FbFpgaI2cController::write(
   }
 }
 
+void FbFpgaI2cController::transaction(
+    uint8_t channel,
+    const std::vector<FbFpgaI2cOp>& ops) {
+  XLOG(DBG5) << folly::sformat(
+      "FbFpgaI2cController::transaction pim {:d} rtc {:d} chan {:d} ops {:d}",
+      pim_,
+      rtc_,
+      channel,
+      ops.size());
+  if (eventBase_->isInEventBaseThread()) {
+    syncedFbI2c_.lock()->transaction(channel, ops);
+  } else {
+    via(eventBase_.get())
+        .thenValue([&](auto&&) mutable {
+          syncedFbI2c_.lock()->transaction(channel, ops);
+        })
+        .get();
+  }
+}
+
+void FbFpgaI2cController::invalidateReadCache(uint8_t channel) {
+  syncedFbI2c_.lock()->invalidateReadCache(channel);
+}
+
 folly::EventBase* FbFpgaI2cController::getEventBase() {
   return eventBase_.get();
 }
@@ -9,9 +9,18 @@
 #include <folly/Range.h>
 #include <folly/Synchronized.h>
 #include <folly/io/async/EventBase.h>
+#include <gflags/gflags.h>
 
 #include <stdint.h>
+#include <array>
+#include <chrono>
+#include <map>
+#include <optional>
 #include <thread>
+#include <tuple>
+#include <vector>
+
+DECLARE_int32(fpga_i2c_read_cache_ms);
 
 namespace facebook::fboss {
 inline uint8_t getI2cControllerIdx(uint8_t port) {
@@ -27,6 +36,33 @@ class FbFpgaI2cError : public I2cError {
   explicit FbFpgaI2cError(const std::string& what) : I2cError(what) {}
 };
 
+/*
+ * One step of a transaction batched on an I2C channel. The buffers are not
+ * owned and must outlive the transaction.
+ */
+struct FbFpgaI2cOp {
+  enum class Type { READ, WRITE };
+
+  static FbFpgaI2cOp read(uint8_t offset, folly::MutableByteRange buf) {
+    return FbFpgaI2cOp{Type::READ, offset, buf, folly::ByteRange()};
+  }
+  static FbFpgaI2cOp write(uint8_t offset, folly::ByteRange buf) {
+    return FbFpgaI2cOp{Type::WRITE, offset, folly::MutableByteRange(), buf};
+  }
+  // Select the upper page of the module that the following reads access
+  static FbFpgaI2cOp selectPage(const uint8_t& page) {
+    return write(kPageSelectOffset, folly::ByteRange(&page, 1));
+  }
+  static FbFpgaI2cOp selectPage(uint8_t&& page) = delete;
+
+  static constexpr uint8_t kPageSelectOffset = 127;
+
+  Type type;
+  uint8_t offset;
+  folly::MutableByteRange readBuf;
+  folly::ByteRange writeBuf;
+};
+
 class FbFpgaI2c : public I2cController {
  public:
   // TODO(clin82): After refactor Wedge400I2CBus to make use of
@@ -45,7 +81,36 @@ class FbFpgaI2c : public I2cController {
   void writeByte(uint8_t channel, uint8_t offset, uint8_t val);
   void write(uint8_t channel, uint8_t offset, folly::ByteRange buf);
 
+  // Run the ops one after the other on the channel, stopping at the first
+  // failure
+  void transaction(uint8_t channel, const std::vector<FbFpgaI2cOp>& ops);
+
+  // Forget the pages read from the module behind the channel, for example
+  // when it was reset or replaced
+  void invalidateReadCache(uint8_t channel);
+
  private:
+  static constexpr uint8_t kNumChannels = 4;
+  static constexpr uint8_t kUpperPageOffset = 128;
+  // Pages 00h-02h hold identification, advertising and thresholds, which
+  // don't change while the module is plugged in. The other pages hold clear
+  // on read flags, monitors and controls, so they are always read from the
+  // module.
+  static constexpr uint8_t kLastStaticPage = 0x02;
+
+  struct CachedRead {
+    std::chrono::steady_clock::time_point readTime;
+    std::vector<uint8_t> data;
+  };
+  // (channel, page, offset)
+  using ReadCacheKey = std::tuple<uint8_t, uint8_t, uint8_t>;
+
+  std::optional<ReadCacheKey> getReadCacheKey(uint8_t channel, uint8_t offset)
+      const;
+  bool
+  readFromCache(uint8_t channel, uint8_t offset, folly::MutableByteRange buf);
+  void updateReadCache(uint8_t channel, uint8_t offset, folly::ByteRange buf);
+  void eraseReadCache(uint8_t channel);
   bool waitForResponse(size_t len);
   uint32_t getRegAddr(uint32_t regBase, uint32_t regIncr);
   uint32_t getRTCIOBlockSize();
@@ -62,6 +127,12 @@ class FbFpgaI2c : public I2cController {
 
   int rtcId_{-1};
   int version_{0};
+
+  // Static upper page data recently read from the modules. Only used when
+  // fpga_i2c_read_cache_ms is set.
+  std::map<ReadCacheKey, CachedRead> readCache_;
+  // Upper page last selected on each channel, if known
+  std::array<std::optional<uint8_t>, kNumChannels> selectedPage_;
 };
 
 class FbFpgaI2cController {
@@ -87,6 +158,14 @@ class FbFpgaI2cController {
   void writeByte(uint8_t channel, uint8_t offset, uint8_t val);
   void write(uint8_t channel, uint8_t offset, folly::ByteRange buf);
 
+  /* Run a batch of ops, typically a page select followed by reads from that
+   * page, with a single hop to the controller thread and a single lock
+   * acquisition instead of one per op.
+   */
+  void transaction(uint8_t channel, const std::vector<FbFpgaI2cOp>& ops);
+
+  void invalidateReadCache(uint8_t channel);
+
   folly::EventBase* getEventBase();
 
   /* Get the I2c transaction stats from this controller with the lock
@@ -2,6 +2,8 @@
 
 #include "fboss/lib/fpga/FbFpgaPimQsfpController.h"
 
+#include <folly/lang/Bits.h>
+
 namespace {
 constexpr uint32_t kFacebookFpgaQsfpPresentRegOffset = 0x8;
 constexpr uint32_t kFacebookFpgaQsfpResetRegOffset = 0x30;
@@ -88,4 +90,16 @@ void FbFpgaPimQsfpController::clearAllTransceiverReset() {
   memoryRegion_->write(kFacebookFpgaQsfpResetRegOffset, 0x0);
 }
 
+int FbFpgaPimQsfpController::clearTransceiversInReset() {
+  uint32_t resetReg = memoryRegion_->read(kFacebookFpgaQsfpResetRegOffset);
+  if (resetReg == 0) {
+    return 0;
+  }
+  XLOG(DBG5) << folly::format(
+      "Clearing transceivers out of reset, QsfpResetReg value:{:#x}",
+      resetReg);
+  memoryRegion_->write(kFacebookFpgaQsfpResetRegOffset, 0x0);
+  return folly::popcount(resetReg);
+}
+
 } // namespace facebook::fboss
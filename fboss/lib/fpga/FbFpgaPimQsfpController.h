@@ -28,6 +28,9 @@ class FbFpgaPimQsfpController {
   // This function will bring all the transceivers out of reset.
   void clearAllTransceiverReset();
 
+  // Bring the transceivers held in reset out of it, returning how many were.
+  int clearTransceiversInReset();
+
  private:
   std::unique_ptr<FpgaMemoryRegion> memoryRegion_;
   unsigned int portsPerPim_;
@@ -0,0 +1,138 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include "fboss/lib/fpga/FbFpgaRegisters.h"
+#include "fboss/lib/fpga/FpgaDevice.h"
+
+#include <folly/Range.h>
+
+#include <array>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+
+namespace facebook::fboss {
+
+/*
+ * Fake FPGA register backend for the FbFpgaI2c RTCs. Descriptors written to
+ * it complete right away against an in memory module EEPROM per channel,
+ * with the upper page selected by byte 127 like on QSFP/CMIS modules.
+ */
+class FakeFbFpgaI2cDevice : public FpgaDevice {
+ public:
+  static constexpr uint32_t kFakePhysicalAddr = 0xfdf00000;
+  static constexpr uint32_t kFakeSize = 0x10000;
+
+  explicit FakeFbFpgaI2cDevice(int version)
+      : FpgaDevice(kFakePhysicalAddr, kFakeSize), version_(version) {}
+
+  void mmap() override {}
+
+  uint32_t read(uint32_t offset) const override {
+    auto iter = regs_.find(offset);
+    return iter == regs_.end() ? 0 : iter->second;
+  }
+
+  void write(uint32_t offset, uint32_t value) override {
+    regs_[offset] = value;
+    for (uint32_t rtc = 0; rtc < kMaxRtcs; rtc++) {
+      if (offset == getRegAddr(I2CRegisterType::DESC_UPPER, rtc)) {
+        I2cDescriptorUpperDataUnion upper;
+        upper.reg = value;
+        if (upper.valid) {
+          runDescriptor(rtc, upper);
+        }
+        return;
+      }
+    }
+  }
+
+  void setModuleData(
+      uint32_t rtc,
+      uint8_t channel,
+      uint8_t page,
+      uint8_t offset,
+      folly::ByteRange data) {
+    auto& module = modules_[{rtc, channel}];
+    for (size_t i = 0; i < data.size(); i++) {
+      moduleByte(module, page, offset + i) = data[i];
+    }
+  }
+
+  // Number of descriptors the fake ran, i.e. I2C transactions
+  int getNumTransactions() const {
+    return numTransactions_;
+  }
+
+ private:
+  static constexpr uint32_t kMaxRtcs = 4;
+  static constexpr uint32_t kFacebookFpgaRTCWriteBlock = 0x2000;
+  static constexpr uint32_t kFacebookFpgaRTCReadBlock = 0x3000;
+  static constexpr uint8_t kPageSelectOffset = 127;
+  static constexpr uint8_t kPageSize = 128;
+
+  struct Module {
+    std::array<uint8_t, kPageSize> lowerPage{};
+    std::map<uint8_t, std::array<uint8_t, kPageSize>> upperPages;
+  };
+
+  uint32_t getRegAddr(I2CRegisterType type, uint32_t rtc) const {
+    auto addr = I2CRegisterAddrConstants::getI2CRegisterAddr(version_, type);
+    return addr.baseAddr + addr.addrIncr * rtc;
+  }
+
+  uint32_t getBlockAddr(uint32_t blockBase, uint32_t rtc) const {
+    return blockBase + (version_ == 1 ? 0x80 : 0x200) * rtc;
+  }
+
+  static uint8_t& moduleByte(Module& module, uint8_t page, int offset) {
+    if (offset < kPageSize) {
+      return module.lowerPage[offset];
+    }
+    return module.upperPages[page].at(offset - kPageSize);
+  }
+
+  void runDescriptor(uint32_t rtc, I2cDescriptorUpperDataUnion upper) {
+    I2cDescriptorLowerDataUnion lower;
+    lower.reg = read(getRegAddr(I2CRegisterType::DESC_LOWER, rtc));
+    auto& module = modules_[{rtc, upper.channel}];
+    auto page = module.lowerPage[kPageSelectOffset];
+
+    std::array<uint8_t, 256> data{};
+    if (lower.op == 1) {
+      for (int i = 0; i < lower.len; i++) {
+        data[i] = moduleByte(module, page, upper.offset + i);
+      }
+      auto readBlock = getBlockAddr(kFacebookFpgaRTCReadBlock, rtc);
+      for (int i = 0; i < lower.len; i += 4) {
+        uint32_t word;
+        std::memcpy(&word, &data[i], sizeof(word));
+        regs_[readBlock + i] = word;
+      }
+    } else {
+      auto writeBlock = getBlockAddr(kFacebookFpgaRTCWriteBlock, rtc);
+      for (int i = 0; i < lower.len; i += 4) {
+        uint32_t word = read(writeBlock + i);
+        std::memcpy(&data[i], &word, sizeof(word));
+      }
+      // A page select takes effect from the next transaction on
+      for (int i = 0; i < lower.len; i++) {
+        moduleByte(module, page, upper.offset + i) = data[i];
+      }
+    }
+
+    I2cRtcStatusDataUnion status;
+    status.reg = 0;
+    status.desc0done = 1;
+    regs_[getRegAddr(I2CRegisterType::RTC_STATUS, rtc)] = status.reg;
+    numTransactions_++;
+  }
+
+  int version_;
+  std::unordered_map<uint32_t, uint32_t> regs_;
+  std::map<std::pair<uint32_t, uint8_t>, Module> modules_;
+  int numTransactions_{0};
+};
+
+} // namespace facebook::fboss
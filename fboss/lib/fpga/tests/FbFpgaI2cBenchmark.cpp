@@ -0,0 +1,92 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "fboss/lib/fpga/FbFpgaI2c.h"
+#include "fboss/lib/fpga/tests/FakeFbFpgaI2cDevice.h"
+
+using namespace facebook::fboss;
+
+namespace {
+constexpr uint32_t kRtc = 0;
+constexpr uint8_t kChannel = 0;
+constexpr int kVersion = 0;
+constexpr uint8_t kPage = 0x11;
+// Thresholds, the only kind of page the read cache keeps
+constexpr uint8_t kStaticPage = 0x02;
+// DOM fields a partial refresh reads from one page: (offset, length)
+const std::vector<std::pair<uint8_t, uint8_t>> kFieldRanges = {
+    {130, 8},
+    {154, 16},
+    {186, 16},
+    {218, 16},
+};
+
+struct Controller {
+  Controller()
+      : device(std::make_unique<FakeFbFpgaI2cDevice>(kVersion)),
+        controller(
+            std::make_unique<FpgaMemoryRegion>(
+                "i2c", device.get(), 0, FakeFbFpgaI2cDevice::kFakeSize),
+            kRtc,
+            0 /* pim */,
+            kVersion) {}
+
+  std::unique_ptr<FakeFbFpgaI2cDevice> device;
+  FbFpgaI2cController controller;
+  std::array<uint8_t, 256> buf{};
+};
+
+// Page select and each read hop to the controller thread on their own, the
+// way TransceiverI2CApi::moduleRead/moduleWrite issue them
+void readPageOpByOp(Controller& c, unsigned iters) {
+  for (unsigned i = 0; i < iters; i++) {
+    c.controller.writeByte(kChannel, FbFpgaI2cOp::kPageSelectOffset, kPage);
+    for (const auto& [offset, len] : kFieldRanges) {
+      c.controller.read(
+          kChannel, offset, folly::MutableByteRange(&c.buf[offset], len));
+    }
+  }
+}
+
+void readPageBatched(Controller& c, unsigned iters, uint8_t page = kPage) {
+  std::vector<FbFpgaI2cOp> ops{FbFpgaI2cOp::selectPage(page)};
+  for (const auto& [offset, len] : kFieldRanges) {
+    ops.push_back(FbFpgaI2cOp::read(
+        offset, folly::MutableByteRange(&c.buf[offset], len)));
+  }
+  for (unsigned i = 0; i < iters; i++) {
+    c.controller.transaction(kChannel, ops);
+  }
+}
+} // namespace
+
+BENCHMARK(PageReadOpByOp, iters) {
+  folly::BenchmarkSuspender suspender;
+  Controller c;
+  suspender.dismiss();
+  readPageOpByOp(c, iters);
+}
+
+BENCHMARK_RELATIVE(PageReadBatched, iters) {
+  folly::BenchmarkSuspender suspender;
+  Controller c;
+  suspender.dismiss();
+  readPageBatched(c, iters);
+}
+
+BENCHMARK_RELATIVE(PageReadBatchedCached, iters) {
+  folly::BenchmarkSuspender suspender;
+  gflags::FlagSaver flagSaver;
+  FLAGS_fpga_i2c_read_cache_ms = 60000;
+  Controller c;
+  suspender.dismiss();
+  readPageBatched(c, iters, kStaticPage);
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
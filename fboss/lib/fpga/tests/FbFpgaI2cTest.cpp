@@ -0,0 +1,137 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include "fboss/lib/fpga/FbFpgaI2c.h"
+#include "fboss/lib/fpga/tests/FakeFbFpgaI2cDevice.h"
+
+namespace {
+constexpr uint32_t kRtc = 1;
+constexpr uint8_t kChannel = 2;
+constexpr int kVersion = 0;
+} // namespace
+
+namespace facebook::fboss {
+
+class FbFpgaI2cTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    device_ = std::make_unique<FakeFbFpgaI2cDevice>(kVersion);
+    i2c_ = std::make_unique<FbFpgaI2c>(
+        std::make_unique<FpgaMemoryRegion>(
+            "i2c", device_.get(), 0, FakeFbFpgaI2cDevice::kFakeSize),
+        kRtc,
+        0 /* pim */,
+        kVersion);
+
+    std::array<uint8_t, 4> page01{0x01, 0x02, 0x03, 0x04};
+    std::array<uint8_t, 4> page02{0x05, 0x06, 0x07, 0x08};
+    std::array<uint8_t, 4> page10{0x10, 0x11, 0x12, 0x13};
+    std::array<uint8_t, 4> page11{0x20, 0x21, 0x22, 0x23};
+    device_->setModuleData(
+        kRtc, kChannel, 0x01, 130, folly::ByteRange(page01.data(), 4));
+    device_->setModuleData(
+        kRtc, kChannel, 0x02, 130, folly::ByteRange(page02.data(), 4));
+    device_->setModuleData(
+        kRtc, kChannel, 0x10, 130, folly::ByteRange(page10.data(), 4));
+    device_->setModuleData(
+        kRtc, kChannel, 0x11, 130, folly::ByteRange(page11.data(), 4));
+  }
+
+  std::array<uint8_t, 4> readPage(uint8_t page) {
+    std::array<uint8_t, 4> buf{};
+    i2c_->transaction(
+        kChannel,
+        {FbFpgaI2cOp::selectPage(page),
+         FbFpgaI2cOp::read(130, folly::MutableByteRange(buf.data(), 4))});
+    return buf;
+  }
+
+  std::unique_ptr<FakeFbFpgaI2cDevice> device_;
+  std::unique_ptr<FbFpgaI2c> i2c_;
+};
+
+TEST_F(FbFpgaI2cTest, transactionReadsSelectedPage) {
+  std::array<uint8_t, 2> first{};
+  std::array<uint8_t, 2> second{};
+  uint8_t page = 0x11;
+  i2c_->transaction(
+      kChannel,
+      {FbFpgaI2cOp::selectPage(page),
+       FbFpgaI2cOp::read(130, folly::MutableByteRange(first.data(), 2)),
+       FbFpgaI2cOp::read(132, folly::MutableByteRange(second.data(), 2))});
+
+  EXPECT_EQ(first, (std::array<uint8_t, 2>{0x20, 0x21}));
+  EXPECT_EQ(second, (std::array<uint8_t, 2>{0x22, 0x23}));
+  EXPECT_EQ(device_->getNumTransactions(), 3);
+  EXPECT_EQ(*i2c_->getI2cControllerPlatformStats().readTotal__ref(), 2);
+  EXPECT_EQ(*i2c_->getI2cControllerPlatformStats().writeTotal__ref(), 1);
+}
+
+TEST_F(FbFpgaI2cTest, readCacheDisabledByDefault) {
+  readPage(0x10);
+  readPage(0x10);
+  EXPECT_EQ(device_->getNumTransactions(), 4);
+  EXPECT_EQ(*i2c_->getI2cControllerPlatformStats().readCacheHits__ref(), 0);
+}
+
+TEST_F(FbFpgaI2cTest, readCacheKeyedByPage) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_fpga_i2c_read_cache_ms = 60000;
+
+  EXPECT_EQ(readPage(0x01), (std::array<uint8_t, 4>{0x01, 0x02, 0x03, 0x04}));
+  EXPECT_EQ(readPage(0x02), (std::array<uint8_t, 4>{0x05, 0x06, 0x07, 0x08}));
+  EXPECT_EQ(device_->getNumTransactions(), 4);
+
+  // Only the page selects go to the module now
+  EXPECT_EQ(readPage(0x01), (std::array<uint8_t, 4>{0x01, 0x02, 0x03, 0x04}));
+  EXPECT_EQ(readPage(0x02), (std::array<uint8_t, 4>{0x05, 0x06, 0x07, 0x08}));
+  EXPECT_EQ(device_->getNumTransactions(), 6);
+  EXPECT_EQ(*i2c_->getI2cControllerPlatformStats().readCacheHits__ref(), 2);
+}
+
+TEST_F(FbFpgaI2cTest, readCacheInvalidatedByWrites) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_fpga_i2c_read_cache_ms = 60000;
+
+  readPage(0x02);
+  uint8_t val = 0x55;
+  i2c_->writeByte(kChannel, 130, val);
+  EXPECT_EQ(readPage(0x02), (std::array<uint8_t, 4>{0x55, 0x06, 0x07, 0x08}));
+
+  i2c_->invalidateReadCache(kChannel);
+  std::array<uint8_t, 4> buf{};
+  i2c_->read(kChannel, 130, folly::MutableByteRange(buf.data(), 4));
+  i2c_->read(kChannel, 130, folly::MutableByteRange(buf.data(), 4));
+  // Without a known page selected nothing is cached
+  EXPECT_EQ(*i2c_->getI2cControllerPlatformStats().readCacheHits__ref(), 0);
+}
+
+TEST_F(FbFpgaI2cTest, lowerPageNotCached) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_fpga_i2c_read_cache_ms = 60000;
+
+  readPage(0x01);
+  i2c_->readByte(kChannel, 3);
+  i2c_->readByte(kChannel, 3);
+  EXPECT_EQ(*i2c_->getI2cControllerPlatformStats().readCacheHits__ref(), 0);
+}
+
+TEST_F(FbFpgaI2cTest, volatilePagesNotCached) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_fpga_i2c_read_cache_ms = 60000;
+
+  // Page 11h holds latched lane flags, which clear on read
+  EXPECT_EQ(readPage(0x11), (std::array<uint8_t, 4>{0x20, 0x21, 0x22, 0x23}));
+  std::array<uint8_t, 4> cleared{};
+  device_->setModuleData(
+      kRtc, kChannel, 0x11, 130, folly::ByteRange(cleared.data(), 4));
+  EXPECT_EQ(readPage(0x11), cleared);
+  EXPECT_EQ(readPage(0x10), (std::array<uint8_t, 4>{0x10, 0x11, 0x12, 0x13}));
+  EXPECT_EQ(readPage(0x10), (std::array<uint8_t, 4>{0x10, 0x11, 0x12, 0x13}));
+  EXPECT_EQ(device_->getNumTransactions(), 8);
+  EXPECT_EQ(*i2c_->getI2cControllerPlatformStats().readCacheHits__ref(), 0);
+}
+
+} // namespace facebook::fboss
@@ -31,6 +31,7 @@ class I2cController {
     *i2cControllerPlatformStats_.writeTotal__ref() = 0;
     *i2cControllerPlatformStats_.writeFailed__ref() = 0;
     *i2cControllerPlatformStats_.writeBytes__ref() = 0;
+    *i2cControllerPlatformStats_.readCacheHits__ref() = 0;
   }
   // Total number of reads
   void incrReadTotal(uint32_t count = 1) {
@@ -56,6 +57,10 @@ class I2cController {
   void incrWriteBytes(uint32_t count = 1) {
     *i2cControllerPlatformStats_.writeBytes__ref() += count;
   }
+  // Number of reads served from cache
+  void incrReadCacheHits(uint32_t count = 1) {
+    *i2cControllerPlatformStats_.readCacheHits__ref() += count;
+  }
 
   /* Get the I2c transaction stats from the i2c controller
    */
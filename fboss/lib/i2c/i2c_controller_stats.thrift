@@ -11,4 +11,13 @@ struct I2cControllerStats {
   5: i64 writeTotal_ = STAT_UNINITIALIZED
   6: i64 writeFailed_ = STAT_UNINITIALIZED
   7: i64 writeBytes_ = STAT_UNINITIALIZED
+  // Reads served from the controller read cache without an I2C transaction
+  8: i64 readCacheHits_ = STAT_UNINITIALIZED
+}
+
+// Cost of refreshing one transceiver EEPROM page, summed over all modules
+struct I2cPageReadStats {
+  1: string pageName_ = ""
+  2: i64 readTotal_ = STAT_UNINITIALIZED
+  3: i64 readBytes_ = STAT_UNINITIALIZED
 }
@@ -29,6 +29,32 @@ void MinipackBaseI2cBus::moduleRead(
       port, offset, folly::MutableByteRange(buf, len));
 }
 
+void MinipackBaseI2cBus::moduleReadBatch(
+    unsigned int module,
+    uint8_t /* i2cAddress */,
+    const std::vector<ModuleRead>& reads) {
+  std::vector<FbFpgaI2cOp> ops;
+  ops.reserve(reads.size());
+  for (const auto& read : reads) {
+    if (read.len > 128) {
+      throw MinipackI2cError("Too long read");
+    }
+    ops.push_back(FbFpgaI2cOp::read(
+        read.offset, folly::MutableByteRange(read.buf, read.len)));
+  }
+  auto pim = getPim(module);
+  auto port = getQsfpPimPort(module);
+
+  XLOG(DBG3) << folly::format(
+      "I2C batch of {:d} reads to pim {:d}, port {:d}",
+      reads.size(),
+      pim,
+      port);
+
+  systemContainer_->getPimContainer(pim)->getI2cController(port)->transaction(
+      port, ops);
+}
+
 void MinipackBaseI2cBus::moduleWrite(
     unsigned int module,
     uint8_t /* i2cAddress */,
@@ -32,6 +32,10 @@ class MinipackBaseI2cBus : public TransceiverI2CApi {
       int offset,
       int len,
       const uint8_t* buf) override;
+  void moduleReadBatch(
+      unsigned int module,
+      uint8_t i2cAddress,
+      const std::vector<ModuleRead>& reads) override;
 
   bool isPresent(unsigned int module) override;
   void scanPresence(std::map<int32_t, ModulePresence>& presences) override;
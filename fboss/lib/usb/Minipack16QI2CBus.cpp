@@ -25,9 +25,11 @@ Minipack16QI2CBus::~Minipack16QI2CBus() {}
 void Minipack16QI2CBus::ensureOutOfReset(unsigned int module) {
   auto pim = getPim(module);
   auto port = getQsfpPimPort(module);
-  systemContainer_->getPimContainer(pim)
-      ->getPimQsfpController()
-      ->ensureQsfpOutOfReset(port);
+  auto pimContainer = systemContainer_->getPimContainer(pim);
+  pimContainer->getPimQsfpController()->ensureQsfpOutOfReset(port);
+  // This is called for newly inserted modules, don't serve them the pages
+  // read from the module they replaced
+  pimContainer->getI2cController(port)->invalidateReadCache(port);
 }
 
 folly::EventBase* Minipack16QI2CBus::getEventBase(unsigned int module) {
@@ -38,10 +38,11 @@ void Minipack16QTransceiverApi::triggerQsfpHardReset(unsigned int module) {
   auto pimID = getPimID(module);
   auto port = getQsfpPimPort(module);
 
-  MinipackSystemContainer::getInstance()
-      ->getPimContainer(pimID)
-      ->getPimQsfpController()
-      ->triggerQsfpHardReset(port);
+  auto pimContainer =
+      MinipackSystemContainer::getInstance()->getPimContainer(pimID);
+  pimContainer->getPimQsfpController()->triggerQsfpHardReset(port);
+  // Whatever was read from the module before the reset is stale now
+  pimContainer->getI2cController(port)->invalidateReadCache(port);
 }
 
 /* This function will bring all the transceivers out of reset. Just clear the
@@ -50,7 +51,7 @@ void Minipack16QTransceiverApi::triggerQsfpHardReset(unsigned int module) {
 void Minipack16QTransceiverApi::clearAllTransceiverReset() {
   for (auto pimIndex = 0; pimIndex < MinipackSystemContainer::kNumberPim;
        pimIndex++) {
-    auto pimID = MinipackSystemContainer::kPimStartNum;
+    auto pimID = MinipackSystemContainer::kPimStartNum + pimIndex;
     MinipackSystemContainer::getInstance()
         ->getPimContainer(pimID)
         ->getPimQsfpController()
@@ -58,4 +59,17 @@ void Minipack16QTransceiverApi::clearAllTransceiverReset() {
   }
 }
 
+int Minipack16QTransceiverApi::clearTransceiversInReset() {
+  int numCleared = 0;
+  for (auto pimIndex = 0; pimIndex < MinipackSystemContainer::kNumberPim;
+       pimIndex++) {
+    auto pimID = MinipackSystemContainer::kPimStartNum + pimIndex;
+    numCleared += MinipackSystemContainer::getInstance()
+                      ->getPimContainer(pimID)
+                      ->getPimQsfpController()
+                      ->clearTransceiversInReset();
+  }
+  return numCleared;
+}
+
 } // namespace facebook::fboss
@@ -30,6 +30,10 @@ class Minipack16QTransceiverApi : public TransceiverPlatformApi {
    * reset bits of all the transceivers through FPGA.
    */
   void clearAllTransceiverReset() override;
+
+  /* Clear the reset bits of the PIMs that have transceivers held in reset.
+   */
+  int clearTransceiversInReset() override;
 };
 
 } // namespace facebook::fboss
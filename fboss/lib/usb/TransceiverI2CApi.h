@@ -16,6 +16,7 @@
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace facebook::fboss {
 enum class ModulePresence { PRESENT, ABSENT, UNKNOWN };
@@ -57,6 +58,25 @@ class TransceiverI2CApi {
       int len,
       const uint8_t* buf) = 0;
 
+  /* One of the reads of moduleReadBatch(): len bytes at offset into buf */
+  struct ModuleRead {
+    int offset;
+    int len;
+    uint8_t* buf;
+  };
+
+  /* Read several ranges of the module memory, in order. Buses that can
+   * batch I2C transactions issue them together, the others one at a time.
+   */
+  virtual void moduleReadBatch(
+      unsigned int module,
+      uint8_t i2cAddress,
+      const std::vector<ModuleRead>& reads) {
+    for (const auto& read : reads) {
+      moduleRead(module, i2cAddress, read.offset, read.len, read.buf);
+    }
+  }
+
   virtual void verifyBus(bool autoReset) = 0;
 
   virtual bool isPresent(unsigned int module) = 0;
@@ -84,6 +104,15 @@ class TransceiverI2CApi {
    */
   virtual void clearAllTransceiverReset(){};
 
+  /* Bring the transceivers held in reset out of it and return how many of
+   * them were. Buses that can't hold transceivers in reset have none to
+   * clear.
+   */
+  virtual int clearTransceiversInReset() {
+    clearAllTransceiverReset();
+    return 0;
+  }
+
   /*
    * Function that returns the eventbase that suppose to execute the I2C txn
    * associated with the module. At this moment, only Minipack and Yamp which
@@ -39,6 +39,12 @@ class TransceiverPlatformApi {
    * So function we will stay no op for those platforms.
    */
   virtual void clearAllTransceiverReset() = 0;
+
+  /* Bring only the transceivers that are held in reset out of it, and return
+   * how many of them were. This lets the caller skip waiting for the
+   * transceivers to become functional when none of them was in reset.
+   */
+  virtual int clearTransceiversInReset() = 0;
 };
 
 } // namespace facebook::fboss
@@ -48,6 +48,10 @@ class TransceiverPlatformI2cApi : public TransceiverPlatformApi {
     i2cBus_->clearAllTransceiverReset();
   }
 
+  int clearTransceiversInReset() override {
+    return i2cBus_->clearTransceiversInReset();
+  }
+
   // For platforms having Qsfp control through I2C, the i2c object is referred
   // by this class. This is a raw pointer and its value is populated by this
   // class constructor
@@ -0,0 +1,17 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <gmock/gmock.h>
+#include "fboss/lib/usb/TransceiverPlatformApi.h"
+
+namespace facebook::fboss {
+
+class MockTransceiverPlatformApi : public TransceiverPlatformApi {
+ public:
+  MOCK_METHOD1(triggerQsfpHardReset, void(unsigned int));
+  MOCK_METHOD0(clearAllTransceiverReset, void());
+  MOCK_METHOD0(clearTransceiversInReset, int());
+};
+
+} // namespace facebook::fboss
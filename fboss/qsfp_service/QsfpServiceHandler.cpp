@@ -45,6 +45,12 @@ QsfpServiceHandler::QsfpServiceHandler(
   XLOG(INFO) << "FbossPhyMacsecService inside QsfpServiceHandler Started";
 }
 
+QsfpServiceHandler::~QsfpServiceHandler() {
+  for (auto& subscriber : *transceiverInfoSubscribers_.wlock()) {
+    std::move(subscriber.publisher).complete();
+  }
+}
+
 void QsfpServiceHandler::init() {
   // Initialize the PhyManager all ExternalPhy for the system
   manager_->initExternalPhyMap();
@@ -98,6 +104,53 @@ void QsfpServiceHandler::syncPorts(
   manager_->syncPorts(info, std::move(ports));
 }
 
+apache::thrift::ResponseAndServerStream<
+    std::map<int32_t, TransceiverInfo>,
+    std::map<int32_t, TransceiverInfo>>
+QsfpServiceHandler::subscribeTransceiverInfoChanges() {
+  auto log = LOG_THRIFT_CALL(INFO);
+  auto done = std::make_shared<std::atomic<bool>>(false);
+  auto streamAndPublisher =
+      apache::thrift::ServerStream<std::map<int32_t, TransceiverInfo>>::
+          createPublisher([done]() {
+            *done = true;
+            XLOG(INFO) << "Transceiver info subscriber disconnected";
+          });
+
+  std::map<int32_t, TransceiverInfo> info;
+  auto subscribers = transceiverInfoSubscribers_.wlock();
+  // Take the snapshot while holding the lock, so no change can be published
+  // between the snapshot and the subscription.
+  manager_->getTransceiversInfo(info, std::make_unique<std::vector<int32_t>>());
+  subscribers->push_back(
+      TransceiverInfoSubscriber{std::move(streamAndPublisher.second), done});
+  return {std::move(info), std::move(streamAndPublisher.first)};
+}
+
+void QsfpServiceHandler::publishTransceiverInfoChanges() {
+  auto subscribers = transceiverInfoSubscribers_.wlock();
+  // Always collect the changes, so that the next subscriber only gets the
+  // changes made after it subscribed.
+  auto changed = manager_->getChangedTransceiversInfo();
+  for (auto it = subscribers->begin(); it != subscribers->end();) {
+    if (*it->done) {
+      std::move(it->publisher).complete();
+      it = subscribers->erase(it);
+    } else {
+      ++it;
+    }
+  }
+  if (changed.empty() || subscribers->empty()) {
+    return;
+  }
+  XLOG(DBG2) << "Publishing " << changed.size()
+             << " changed transceivers to " << subscribers->size()
+             << " subscribers";
+  for (auto& subscriber : *subscribers) {
+    subscriber.publisher.next(changed);
+  }
+}
+
 void QsfpServiceHandler::pauseRemediation(int32_t timeout) {
   auto log = LOG_THRIFT_CALL(INFO);
   manager_->setPauseRemediation(timeout);
@@ -1,7 +1,11 @@
 // Copyright 2004-present Facebook. All Rights Reserved.
 #pragma once
 
+#include <folly/Synchronized.h>
 #include <folly/futures/Future.h>
+#include <thrift/lib/cpp2/async/ServerStream.h>
+
+#include <atomic>
 
 #include "common/fb303/cpp/FacebookBase2.h"
 
@@ -23,7 +27,7 @@ class QsfpServiceHandler : public facebook::fboss::QsfpServiceSvIf,
   QsfpServiceHandler(
       std::unique_ptr<TransceiverManager> manager,
       std::shared_ptr<mka::MacsecHandler> handler);
-  ~QsfpServiceHandler() override = default;
+  ~QsfpServiceHandler() override;
 
   void init();
   facebook::fb303::cpp2::fb_status getStatus() override;
@@ -57,6 +61,21 @@ class QsfpServiceHandler : public facebook::fboss::QsfpServiceSvIf,
       std::map<int32_t, TransceiverInfo>& info,
       std::unique_ptr<std::map<int32_t, PortStatus>> ports) override;
 
+  /*
+   * Returns all the transceivers info and a stream of the ones which change
+   * after that.
+   */
+  apache::thrift::ResponseAndServerStream<
+      std::map<int32_t, TransceiverInfo>,
+      std::map<int32_t, TransceiverInfo>>
+  subscribeTransceiverInfoChanges() override;
+
+  /*
+   * Push the transceivers changed since the last call to all subscribers.
+   * Called after every refresh of the transceivers.
+   */
+  void publishTransceiverInfoChanges();
+
   /*
    * Customise the transceiver based on the speed at which it has
    * been configured to operate at
@@ -144,6 +163,15 @@ class QsfpServiceHandler : public facebook::fboss::QsfpServiceSvIf,
 
   std::unique_ptr<TransceiverManager> manager_{nullptr};
   std::shared_ptr<mka::MacsecHandler> macsecHandler_;
+
+  struct TransceiverInfoSubscriber {
+    apache::thrift::ServerStreamPublisher<std::map<int32_t, TransceiverInfo>>
+        publisher;
+    // Set once the client cancels or disconnects
+    std::shared_ptr<std::atomic<bool>> done;
+  };
+  folly::Synchronized<std::vector<TransceiverInfoSubscriber>>
+      transceiverInfoSubscribers_;
 };
 } // namespace fboss
 } // namespace facebook
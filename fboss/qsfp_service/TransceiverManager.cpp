@@ -5,6 +5,8 @@
 #include "fboss/agent/gen-cpp2/agent_config_types.h"
 #include "fboss/lib/config/PlatformConfigUtils.h"
 
+#include <folly/logging/xlog.h>
+
 namespace facebook {
 namespace fboss {
 const TransceiverManager::PortNameMap&
@@ -26,5 +28,68 @@ TransceiverManager::getPortNameToModuleMap() const {
 
   return portNameToModule_;
 }
+
+void TransceiverManager::triggerRemediationHardReset(TransceiverID id) {
+  // This api accepts 1 based module id however the module id in
+  // TransceiverManager is 0 based.
+  qsfpPlatApi_->triggerQsfpHardReset(static_cast<unsigned int>(id) + 1);
+}
+
+std::map<int32_t, TransceiverInfo>
+TransceiverManager::getChangedTransceiversInfo() {
+  std::map<int32_t, TransceiverInfo> changed;
+  auto lockedTransceivers = transceivers_.rlock();
+  auto lastGenerations = lastInfoGenerations_.wlock();
+  for (auto it = lastGenerations->begin(); it != lastGenerations->end();) {
+    if (lockedTransceivers->find(it->first) == lockedTransceivers->end()) {
+      TransceiverInfo info;
+      info.present_ref() = false;
+      info.port_ref() = it->first;
+      changed[it->first] = info;
+      it = lastGenerations->erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (const auto& [id, transceiver] : *lockedTransceivers) {
+    // Read the generation before the info, so that we may send the same info
+    // twice but never miss an update
+    auto generation = transceiver->getTransceiverInfoGeneration();
+    if (auto it = lastGenerations->find(id);
+        it != lastGenerations->end() && it->second == generation) {
+      continue;
+    }
+    try {
+      changed[id] = transceiver->getTransceiverInfo();
+    } catch (const std::exception& ex) {
+      // Info not populated yet, will be picked up once it is
+      XLOG(DBG3) << "Transceiver " << id
+                 << ": Error calling getTransceiverInfo(): " << ex.what();
+      continue;
+    }
+    (*lastGenerations)[id] = generation;
+  }
+  return changed;
+}
+
+void TransceiverManager::recordI2cPageRead(
+    const std::string& pageName,
+    int bytes) {
+  auto stats = i2cPageReadStats_.wlock();
+  auto& pageStats = (*stats)[pageName];
+  *pageStats.pageName__ref() = pageName;
+  *pageStats.readTotal__ref() += 1;
+  *pageStats.readBytes__ref() += bytes;
+}
+
+std::vector<I2cPageReadStats> TransceiverManager::getI2cPageReadStats()
+    const {
+  std::vector<I2cPageReadStats> result;
+  auto stats = i2cPageReadStats_.rlock();
+  for (const auto& pageStats : *stats) {
+    result.push_back(pageStats.second);
+  }
+  return result;
+}
 } // namespace fboss
 } // namespace facebook
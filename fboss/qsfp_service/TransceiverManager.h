@@ -11,6 +11,7 @@
 #pragma once
 
 #include <map>
+#include <string>
 #include <vector>
 
 #include <folly/Synchronized.h>
@@ -59,6 +60,14 @@ class TransceiverManager {
       std::map<int32_t, TransceiverInfo>& info,
       std::unique_ptr<std::map<int32_t, PortStatus>> ports) = 0;
 
+  /*
+   * Transceivers whose info changed since the previous call, based on the
+   * generation each transceiver bumps when refresh() changes its info.
+   * Transceivers which are no longer there are returned as not present.
+   * Meant to be called after refreshTransceivers() by a single consumer.
+   */
+  std::map<int32_t, TransceiverInfo> getChangedTransceiversInfo();
+
   virtual PlatformMode getPlatformMode() const = 0;
 
   bool isValidTransceiver(int32_t id) {
@@ -82,6 +91,13 @@ class TransceiverManager {
     return pauseRemediationUntil_;
   }
 
+  /*
+   * Hard reset a transceiver as part of its own remediation. Unlike a reset
+   * requested through the thrift API the Transceiver object is kept, since
+   * the module calling this is still in the middle of its refresh.
+   */
+  virtual void triggerRemediationHardReset(TransceiverID id);
+
   /* Virtual function to return the i2c transactions stats in a platform.
    * This will be overridden by derived classes which are platform specific
    * and has the platform specific implementation for this counter
@@ -97,6 +113,18 @@ class TransceiverManager {
    */
   virtual void publishI2cTransactionStats() = 0;
 
+  /*
+   * Account the I2C read of 'bytes' bytes of a transceiver EEPROM page to
+   * that page, so that we can tell which pages our refreshes spend the bus
+   * time on. Called by the modules with their lock held.
+   */
+  void recordI2cPageRead(const std::string& pageName, int bytes);
+
+  /*
+   * Returns the I2C read cost of each EEPROM page refreshed so far
+   */
+  std::vector<I2cPageReadStats> getI2cPageReadStats() const;
+
   /*
    * Virtual functions to get the cached transceiver signal flags and media lane
    * signals and clear the cached data. This is introduced mainly due to the
@@ -176,6 +204,11 @@ class TransceiverManager {
   mutable PortNameMap portNameToModule_;
   PortGroups portGroupMap_;
   std::unique_ptr<QsfpConfig> qsfpConfig_;
+  // Info generation of each transceiver last returned by
+  // getChangedTransceiversInfo()
+  folly::Synchronized<std::map<TransceiverID, int64_t>> lastInfoGenerations_;
+  folly::Synchronized<std::map<std::string, I2cPageReadStats>>
+      i2cPageReadStats_;
 };
 } // namespace fboss
 } // namespace facebook
@@ -47,6 +47,18 @@ service QsfpService extends fb303.FacebookService {
   map<i32, transceiver.TransceiverInfo> syncPorts(1: map<i32, ctrl.PortStatus> ports)
     throws (1: fboss.FbossBaseError error)
 
+  /*
+   * Subscribe to transceiver changes. The response has the info of all
+   * transceivers, after that the stream only carries the transceivers whose
+   * info changed (or which were removed) after each refresh of the
+   * transceivers. Changes to the DOM sensor readings (temperature, voltage,
+   * power and bias) alone are not streamed, use getTransceiverInfo for
+   * current readings.
+   */
+  map<i32, transceiver.TransceiverInfo>,
+    stream<map<i32, transceiver.TransceiverInfo>>
+    subscribeTransceiverInfoChanges()
+
   /*
    * Qsfp service has an internal remediation loop and may potentially perform
    * interruptive operation to modules that carry no active(up) link. However
@@ -37,7 +37,8 @@ void QsfpCache::init(folly::EventBase* evb, const PortMapThrift& ports) {
 
   portsChanged(ports);
 
-  syncAllPresentTransceivers();
+  folly::via(evb_).thenValue(
+      [this](auto&&) { subscribeToTransceiverChanges(); });
 
   attachEventBase(evb);
   scheduleTimeout(kLivenessCheckInterval);
@@ -231,6 +232,8 @@ folly::Future<TransceiverInfo> QsfpCache::futureGet(TransceiverID tcvrId) {
 
 void QsfpCache::timeoutExpired() noexcept {
   confirmAlive().then(&QsfpCache::maybeSync, this);
+  // Resubscribe (and so full sync) if the stream broke
+  subscribeToTransceiverChanges();
   scheduleTimeout(kLivenessCheckInterval);
 }
 
@@ -260,15 +263,7 @@ void QsfpCache::syncAllPresentTransceivers() {
       })
       .thenValue([this](auto&& tcvrs) mutable {
         // sync transceivers map with results
-        auto writableTcvrs = this->tcvrs_.wlock();
-        for (auto& [id, info] : tcvrs) {
-          // Only store present transceivers
-          if (*info.present_ref()) {
-            writableTcvrs->emplace(TransceiverID(id), info);
-          }
-        }
-        XLOG(DBG1) << "Got " << writableTcvrs->size()
-                   << " present transceivers from qsfp_service";
+        updatePresentTransceivers(tcvrs, true);
       })
       .thenError(folly::tag_t<std::exception>{}, [](const std::exception& e) {
         XLOG(ERR) << PlatformAlert() << "Exception talking to qsfp_service,"
@@ -276,6 +271,100 @@ void QsfpCache::syncAllPresentTransceivers() {
       });
 }
 
+void QsfpCache::updatePresentTransceivers(
+    const TcvrMapThrift& tcvrs,
+    bool fullSync) {
+  auto writableTcvrs = tcvrs_.wlock();
+  if (fullSync) {
+    writableTcvrs->clear();
+  }
+  for (const auto& [id, info] : tcvrs) {
+    // Only store present transceivers
+    if (*info.present_ref()) {
+      (*writableTcvrs)[TransceiverID(id)] = info;
+    } else {
+      writableTcvrs->erase(TransceiverID(id));
+    }
+  }
+  XLOG(DBG1) << "Got " << tcvrs.size() << " transceivers from qsfp_service, "
+             << writableTcvrs->size() << " present transceivers cached";
+}
+
+void QsfpCache::subscribeToTransceiverChanges() {
+  CHECK(evb_->isInEventBaseThread());
+  if (subscribed_) {
+    return;
+  }
+  cancelSubscription();
+  subscribed_ = true;
+  // Callbacks from subscriptions we have since given up on are ignored
+  auto id = ++subscriptionId_;
+
+  auto onChanges = [this, id](folly::Try<TcvrMapThrift>&& changes) {
+    if (id != subscriptionId_) {
+      return;
+    }
+    if (changes.hasValue()) {
+      updatePresentTransceivers(*changes, false);
+      return;
+    }
+    if (changes.hasException()) {
+      XLOG(ERR) << "Transceiver changes stream from qsfp_service broke: "
+                << changes.exception().what();
+    }
+    // Resubscribe on the next liveness check
+    subscribed_ = false;
+  };
+
+  QsfpClient::createClient(evb_)
+      .thenValue([this, id](std::unique_ptr<QsfpServiceAsyncClient> client) {
+        auto options = QsfpClient::getRpcOptions();
+        auto fut = client->semifuture_subscribeTransceiverInfoChanges(options);
+        if (id == subscriptionId_) {
+          // The stream only lives as long as the client
+          subscriptionClient_ = std::move(client);
+        }
+        return std::move(fut).via(evb_);
+      })
+      .thenValue([this, id, onChanges = std::move(onChanges)](
+                     auto&& responseAndStream) mutable {
+        if (id != subscriptionId_) {
+          return;
+        }
+        XLOG(DBG1) << "Subscribed to transceiver changes from qsfp_service";
+        updatePresentTransceivers(responseAndStream.response, true);
+        auto subscription = std::move(responseAndStream.stream)
+                                .subscribeExTry(
+                                    folly::getKeepAliveToken(evb_),
+                                    std::move(onChanges));
+        cancelSubscription_ = [subscription =
+                                   std::move(subscription)]() mutable {
+          subscription.cancel();
+          std::move(subscription).detach();
+        };
+      })
+      .thenError(
+          folly::tag_t<std::exception>{}, [this, id](const std::exception& e) {
+            if (id != subscriptionId_) {
+              return;
+            }
+            XLOG(ERR) << PlatformAlert()
+                      << "Failed to subscribe to transceiver changes, "
+                      << "fetching all transceivers instead: " << e.what();
+            subscribed_ = false;
+            syncAllPresentTransceivers();
+          });
+}
+
+void QsfpCache::cancelSubscription() {
+  if (cancelSubscription_) {
+    cancelSubscription_();
+    cancelSubscription_ = nullptr;
+  }
+  subscriptionClient_.reset();
+  subscribed_ = false;
+}
+
 AutoInitQsfpCache::AutoInitQsfpCache() {
   init(&evb_);
   thread_.reset(new std::thread([=] { evb_.loopForever(); }));
@@ -283,6 +372,7 @@ AutoInitQsfpCache::AutoInitQsfpCache() {
 
 AutoInitQsfpCache::~AutoInitQsfpCache() {
   if (thread_) {
+    evb_.runInEventBaseThreadAndWait([this] { cancelSubscription(); });
     evb_.runInEventBaseThread([this] { evb_.terminateLoopSoon(); });
     thread_->join();
   }
@@ -14,6 +14,7 @@
 #include <optional>
 
 #include <boost/container/flat_map.hpp>
+#include <folly/Function.h>
 #include <folly/Synchronized.h>
 #include <folly/Unit.h>
 #include <folly/futures/Future.h>
@@ -23,6 +24,7 @@
 
 #include "fboss/agent/if/gen-cpp2/ctrl_types.h"
 #include "fboss/agent/types.h"
+#include "fboss/qsfp_service/if/gen-cpp2/QsfpServiceAsyncClient.h"
 #include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
 
 /*
@@ -60,6 +62,16 @@
  * and store the last aliveSince. If this changes, we reset remoteGen_
  * back to zero so we will re-sync all ports.
  *
+ * Transceiver updates
+ * -------------------
+ * Rather than polling all transceivers, we subscribe to the transceiver
+ * changes of qsfp_service. The subscription response carries the info of all
+ * transceivers and replaces the cache (full sync), after that qsfp_service
+ * only streams the transceivers which changed. If the stream breaks (e.g.
+ * qsfp_service restarts) we subscribe again, i.e. do a full sync, on the
+ * next liveness check. If subscribing fails we fall back to fetching all
+ * transceivers with getTransceiverInfo.
+ *
  * Threading model
  * ---------------
  * All thrift calls to qsfp_service are done on evb_. No guarantee for
@@ -111,6 +123,12 @@ class QsfpCache : private folly::AsyncTimeout {
   // output state of the cache. Useful for debugging
   void dump();
 
+ protected:
+  /* Cancels the transceiver changes subscription, must be called in the evb
+   * thread before the evb stops looping.
+   */
+  void cancelSubscription();
+
  private:
   // Forbidden copy constructor and assignment operator
   QsfpCache(QsfpCache const&) = delete;
@@ -139,6 +157,16 @@ class QsfpCache : private folly::AsyncTimeout {
 
   void syncAllPresentTransceivers();
 
+  /* Subscribes to transceiver changes from qsfp_service, unless there is
+   * already an active subscription.
+   */
+  void subscribeToTransceiverChanges();
+
+  /* Stores present transceivers, removes the ones no longer present. With
+   * fullSync, transceivers not in tcvrs are removed as well.
+   */
+  void updatePresentTransceivers(const TcvrMapThrift& tcvrs, bool fullSync);
+
   struct PortCacheValue {
     PortStatus port;
     uint32_t generation{0};
@@ -160,6 +188,12 @@ class QsfpCache : private folly::AsyncTimeout {
   int64_t remoteAliveSince_{-1};
 
   std::atomic_bool initialized_{false};
+
+  // Transceiver changes subscription, only accessed in the evb thread
+  bool subscribed_{false};
+  uint64_t subscriptionId_{0};
+  std::unique_ptr<QsfpServiceAsyncClient> subscriptionClient_;
+  folly::Function<void()> cancelSubscription_;
 };
 
 class AutoInitQsfpCache : public QsfpCache {
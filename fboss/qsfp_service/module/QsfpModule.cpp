@@ -16,6 +16,7 @@
 #include "fboss/lib/phy/gen-cpp2/phy_types.h"
 #include "fboss/lib/usb/TransceiverI2CApi.h"
 #include "fboss/qsfp_service/StatsPublisher.h"
+#include "fboss/qsfp_service/TransceiverManager.h"
 #include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
 #include "fboss/qsfp_service/module/TransceiverImpl.h"
 
@@ -27,6 +28,11 @@ DEFINE_int32(
     qsfp_data_refresh_interval,
     10,
     "how often to refetch qsfp data that changes frequently");
+DEFINE_int32(
+    qsfp_static_page_refresh_interval,
+    0,
+    "how often to refetch qsfp pages holding static data (vendor info, "
+    "thresholds, capabilities), 0 to only fetch them on module detection");
 DEFINE_int32(
     customize_interval,
     30,
@@ -57,6 +63,56 @@ static constexpr int kStateMachineOpticsRemediateInterval = 30;
 // Miniphoton module part number
 static constexpr auto kMiniphotonPartNumber = "LUX1626C4AD";
 
+static void clearSensorReading(Sensor& sensor) {
+  *sensor.value_ref() = 0;
+}
+
+template <typename OptionalSensorRef>
+static void clearOptionalSensorReading(OptionalSensorRef sensor) {
+  if (sensor) {
+    clearSensorReading(*sensor);
+  }
+}
+
+// Drops the live readings from the transceiver info: the time it was
+// collected at, the DOM sensor values (temperature, voltage, per channel
+// power and bias), and the read/write down times and VDM stats. These move
+// on nearly every refresh. The sensor alarm flags are kept.
+static void clearLiveReadings(TransceiverInfo& info) {
+  info.timeCollected_ref().reset();
+  info.stats_ref().reset();
+  info.vdmDiagsStats_ref().reset();
+  if (auto sensor = info.sensor_ref()) {
+    clearSensorReading(*sensor->temp_ref());
+    clearSensorReading(*sensor->vcc_ref());
+  }
+  for (auto& channel : *info.channels_ref()) {
+    auto& sensors = *channel.sensors_ref();
+    clearSensorReading(*sensors.rxPwr_ref());
+    clearSensorReading(*sensors.txBias_ref());
+    clearSensorReading(*sensors.txPwr_ref());
+    clearOptionalSensorReading(sensors.txSnr_ref());
+    clearOptionalSensorReading(sensors.rxSnr_ref());
+    clearOptionalSensorReading(sensors.rxPwrdBm_ref());
+    clearOptionalSensorReading(sensors.txPwrdBm_ref());
+  }
+}
+
+// Generations are taken from a single counter, so that a module replacing
+// another one for the same transceiver can't repeat its generation
+static std::atomic<int64_t> lastInfoGeneration{0};
+
+// Whether the transceiver info changed, apart from its live readings
+static bool transceiverInfoChanged(
+    const TransceiverInfo& oldInfo,
+    const TransceiverInfo& newInfo) {
+  auto oldCopy = oldInfo;
+  auto newCopy = newInfo;
+  clearLiveReadings(oldCopy);
+  clearLiveReadings(newCopy);
+  return !(oldCopy == newCopy);
+}
+
 TransceiverID QsfpModule::getID() const {
   return TransceiverID(qsfpImpl_->getNum());
 }
@@ -316,6 +372,35 @@ bool QsfpModule::shouldRefresh(time_t cooldown) const {
   return std::time(nullptr) - lastRefreshTime_ >= cooldown;
 }
 
+bool QsfpModule::shouldRefreshStaticPages() const {
+  return FLAGS_qsfp_static_page_refresh_interval > 0 &&
+      std::time(nullptr) - lastStaticRefreshTime_ >=
+      FLAGS_qsfp_static_page_refresh_interval;
+}
+
+void QsfpModule::readPageRangesLocked(
+    const std::string& pageName,
+    int pageOffset,
+    const ByteRanges& ranges,
+    uint8_t* pageData) {
+  // expects the lock to be held
+  std::vector<TransceiverI2CApi::ModuleRead> reads;
+  reads.reserve(ranges.size());
+  for (const auto& range : ranges) {
+    reads.push_back({range.first,
+                     range.second - range.first,
+                     pageData + range.first - pageOffset});
+  }
+  // The ranges are all on the page currently selected, so buses which can
+  // batch transactions read them in one go
+  qsfpImpl_->readTransceiverBatch(TransceiverI2CApi::ADDR_QSFP, reads);
+  if (transceiverManager_) {
+    for (const auto& read : reads) {
+      transceiverManager_->recordI2cPageRead(pageName, read.len);
+    }
+  }
+}
+
 void QsfpModule::ensureOutOfReset() const {
   qsfpImpl_->ensureOutOfReset();
   XLOG(DBG3) << "Cleared the reset register of QSFP.";
@@ -541,7 +626,7 @@ void QsfpModule::refreshLocked() {
     // these fields are in the LOWER qsfp page. There are a small
     // number of writable fields on other qsfp pages, but we don't
     // currently use them.
-    updateQsfpData(false);
+    updateQsfpData(shouldRefreshStaticPages());
   }
 
   // assign
@@ -549,7 +634,15 @@ void QsfpModule::refreshLocked() {
   phy::LinkSnapshot snapshot;
   snapshot.transceiverInfo_ref() = info;
   snapshots_.wlock()->addSnapshot(snapshot);
-  *info_.wlock() = info;
+  auto cachedInfo = info_.wlock();
+  bool changed = !cachedInfo->has_value() ||
+      transceiverInfoChanged(**cachedInfo, info);
+  *cachedInfo = info;
+  if (changed) {
+    // Only bump the generation after info_ is updated, so that readers
+    // never see the new generation with the old info
+    infoGeneration_ = ++lastInfoGeneration;
+  }
 }
 
 bool QsfpModule::shouldRemediate(time_t cooldown) {
@@ -8,6 +8,7 @@
  *
  */
 #pragma once
+#include <atomic>
 #include <cstdint>
 #include <mutex>
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
@@ -19,7 +20,11 @@
 #include <folly/Synchronized.h>
 #include <folly/experimental/FunctionScheduler.h>
 #include <folly/futures/Future.h>
+#include <algorithm>
 #include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace facebook {
 namespace fboss {
@@ -96,6 +101,10 @@ class QsfpModule : public Transceiver {
    */
   TransceiverInfo getTransceiverInfo() override;
 
+  int64_t getTransceiverInfoGeneration() const override {
+    return infoGeneration_.load();
+  }
+
   void transceiverPortsChanged(
       const std::map<uint32_t, PortStatus>& ports) override;
 
@@ -260,6 +269,9 @@ class QsfpModule : public Transceiver {
 
   folly::Synchronized<TransceiverSnapshotCache> snapshots_;
   folly::Synchronized<std::optional<TransceiverInfo>> info_;
+  // Bumped after info_ is updated with different data, not counting the
+  // live readings
+  std::atomic<int64_t> infoGeneration_{0};
   /*
    * qsfpModuleMutex_ is held around all the read and writes to the qsfpModule
    *
@@ -274,6 +286,10 @@ class QsfpModule : public Transceiver {
    * too frequently. These MUST be accessed holding qsfpModuleMutex_.
    */
   time_t lastRefreshTime_{0};
+  time_t lastStaticRefreshTime_{0};
+  // Partial refreshes only read the bytes of the fields we parse, the others
+  // are re-read before the pages are dumped
+  bool unparsedBytesStale_{false};
   time_t lastCustomizeTime_{0};
   time_t lastRemediateTime_{0};
 
@@ -430,6 +446,90 @@ class QsfpModule : public Transceiver {
    */
   virtual void updateQsfpData(bool allPages = true) = 0;
 
+  /*
+   * Byte ranges [first, second) of an EEPROM page, using the same offsets
+   * as the field maps (i.e. upper pages start at 128).
+   */
+  using ByteRanges = std::vector<std::pair<int, int>>;
+
+  // Unused bytes we would rather read than pay for another I2C transaction
+  static constexpr int kMaxI2cReadGap = 16;
+
+  // Which bytes of a page are read when refreshing it
+  enum class PageReadMode {
+    // The whole page
+    FULL,
+    // Only the bytes of the fields we parse
+    PARSED_FIELDS,
+    // Only the bytes PARSED_FIELDS skips
+    UNPARSED_BYTES,
+  };
+
+  /*
+   * Collapse the fields of a field map that live on the given page into the
+   * byte ranges that have to be read to parse them.
+   */
+  template <typename FieldMap>
+  static ByteRanges getFieldRanges(const FieldMap& fields, int dataAddress) {
+    ByteRanges ranges;
+    for (const auto& field : fields) {
+      if (field.second.dataAddress == dataAddress) {
+        int start = field.second.offset;
+        ranges.emplace_back(start, start + field.second.length);
+      }
+    }
+    std::sort(ranges.begin(), ranges.end());
+    ByteRanges merged;
+    for (const auto& range : ranges) {
+      if (!merged.empty() &&
+          range.first <= merged.back().second + kMaxI2cReadGap) {
+        merged.back().second = std::max(merged.back().second, range.second);
+      } else {
+        merged.push_back(range);
+      }
+    }
+    return merged;
+  }
+
+  /*
+   * The byte ranges of the page starting at pageOffset that are not covered
+   * by the given sorted ranges.
+   */
+  static ByteRanges getComplementRanges(
+      const ByteRanges& ranges,
+      int pageOffset) {
+    ByteRanges complement;
+    int start = pageOffset;
+    for (const auto& range : ranges) {
+      if (range.first > start) {
+        complement.emplace_back(start, range.first);
+      }
+      start = std::max(start, range.second);
+    }
+    if (start < pageOffset + MAX_QSFP_PAGE_SIZE) {
+      complement.emplace_back(start, pageOffset + MAX_QSFP_PAGE_SIZE);
+    }
+    return complement;
+  }
+
+  /*
+   * Read the given ranges of the currently selected page into pageData,
+   * which caches the page from offset pageOffset (0 for the lower page, 128
+   * for the upper ones). The bytes read are accounted to pageName in the
+   * I2C page read stats. Expects the lock to be held.
+   */
+  void readPageRangesLocked(
+      const std::string& pageName,
+      int pageOffset,
+      const ByteRanges& ranges,
+      uint8_t* pageData);
+
+  /*
+   * Whether the pages holding static data should be re-read along with the
+   * frequently changing ones this refresh.
+   */
+  bool shouldRefreshStaticPages() const;
+
   /*
    * Helpers to parse DOM data for DAC cables. These incorporate some
    * extra fields that FB has vendors put in the 'Vendor specific'
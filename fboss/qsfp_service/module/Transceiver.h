@@ -58,6 +58,14 @@ class Transceiver {
    */
   virtual TransceiverInfo getTransceiverInfo() = 0;
 
+  /*
+   * Generation of the transceiver information, bumped on every refresh()
+   * that changes it. Lets callers tell if getTransceiverInfo() changed
+   * without fetching and comparing it. Live readings such as the DOM sensor
+   * values don't count as a change.
+   */
+  virtual int64_t getTransceiverInfoGeneration() const = 0;
+
   /*
    * Return raw page data from the qsfp DOM
    */
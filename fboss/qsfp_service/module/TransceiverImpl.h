@@ -13,8 +13,10 @@
 #include <folly/io/async/EventBase.h>
 #include <cstdint>
 #include <optional>
+#include <vector>
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/types.h"
+#include "fboss/lib/usb/TransceiverI2CApi.h"
 #include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
 
 namespace facebook {
@@ -42,6 +44,18 @@ class TransceiverImpl {
       int len,
       uint8_t* fieldValue) = 0;
 
+  /*
+   * Read several ranges of the transceiver memory. Implementations whose bus
+   * can batch I2C transactions override this to issue them together.
+   */
+  virtual void readTransceiverBatch(
+      int dataAddress,
+      const std::vector<TransceiverI2CApi::ModuleRead>& reads) {
+    for (const auto& read : reads) {
+      readTransceiver(dataAddress, read.offset, read.len, read.buf);
+    }
+  }
+
   /*
    * This function will check if the transceiver is present or not
    */
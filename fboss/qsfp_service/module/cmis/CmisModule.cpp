@@ -256,6 +256,22 @@ static CmisFieldInfo::CmisFieldMap cmisFields = {
     {CmisField::VDM_VAL_PRE_FEC_BER_HOST_IN_CUR, {CmisPages::PAGE25, 166, 2}},
 };
 
+// Names the I2C read cost of each page is accounted under
+static std::map<int, std::string> cmisPageNames = {
+    {CmisPages::LOWER, "cmis.lower"},
+    {CmisPages::PAGE00, "cmis.page00"},
+    {CmisPages::PAGE01, "cmis.page01"},
+    {CmisPages::PAGE02, "cmis.page02"},
+    {CmisPages::PAGE10, "cmis.page10"},
+    {CmisPages::PAGE11, "cmis.page11"},
+    {CmisPages::PAGE13, "cmis.page13"},
+    {CmisPages::PAGE14, "cmis.page14"},
+    {CmisPages::PAGE20, "cmis.page20"},
+    {CmisPages::PAGE21, "cmis.page21"},
+    {CmisPages::PAGE24, "cmis.page24"},
+    {CmisPages::PAGE25, "cmis.page25"},
+};
+
 static CmisFieldMultiplier qsfpMultiplier = {
     {CmisField::LENGTH_SMF, 100},
     {CmisField::LENGTH_OM5, 2},
@@ -1264,6 +1280,7 @@ CmisModule::getQsfpValuePtr(int dataAddress, int offset, int length) const {
 
 RawDOMData CmisModule::getRawDOMData() {
   lock_guard<std::mutex> g(qsfpModuleMutex_);
+  refreshUnparsedBytesLocked();
   RawDOMData data;
   if (present_) {
     *data.lower_ref() =
@@ -1277,6 +1294,7 @@ RawDOMData CmisModule::getRawDOMData() {
 
 DOMDataUnion CmisModule::getDOMDataUnion() {
   lock_guard<std::mutex> g(qsfpModuleMutex_);
+  refreshUnparsedBytesLocked();
   CmisData cmisData;
   if (present_) {
     *cmisData.lower_ref() =
@@ -1340,9 +1358,14 @@ void CmisModule::updateQsfpData(bool allPages) {
     XLOG(DBG2) << "Performing " << ((allPages) ? "full" : "partial")
                << " qsfp data cache refresh for transceiver "
                << folly::to<std::string>(qsfpImpl_->getName());
-    qsfpImpl_->readTransceiver(
-        TransceiverI2CApi::ADDR_QSFP, 0, sizeof(lowerPage_), lowerPage_);
+    // Only the fields we parse are read from the pages that change, the
+    // static pages are read in full and only when all pages are refreshed.
+    auto mode = allPages ? PageReadMode::FULL : PageReadMode::PARSED_FIELDS;
+    readCmisPageLocked(CmisPages::LOWER, lowerPage_, mode);
     lastRefreshTime_ = std::time(nullptr);
+    if (allPages) {
+      lastStaticRefreshTime_ = lastRefreshTime_;
+    }
     dirty_ = false;
     setQsfpFlatMem();
     if ((getSettingsValue(CmisField::MODULE_STATE) >> 1 & 0x7) ==
@@ -1352,67 +1375,17 @@ void CmisModule::updateQsfpData(bool allPages) {
       setLegacyModuleStateMachineCmisModuleReady(false);
     }
 
-    // If we have flat memory, we don't have to set the page
-    if (!flatMem_) {
-      uint8_t page = 0x00;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-    }
-    qsfpImpl_->readTransceiver(
-        TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page0_), page0_);
-    if (!flatMem_) {
-      uint8_t page = 0x10;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page10_), page10_);
-
-      page = 0x11;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page11_), page11_);
-
-      if (getLegacyModuleStateMachineCmisModuleReady()) {
-        page = 0x14;
-        auto diagFeature = (uint8_t)DiagnosticFeatureEncoding::SNR;
+    if (allPages) {
+      // If we have flat memory, we don't have to set the page
+      if (!flatMem_) {
+        uint8_t page = 0x00;
         qsfpImpl_->writeTransceiver(
             TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-        qsfpImpl_->writeTransceiver(
-            TransceiverI2CApi::ADDR_QSFP,
-            128,
-            sizeof(diagFeature),
-            &diagFeature);
-        qsfpImpl_->readTransceiver(
-            TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page14_), page14_);
-
-        if (isVdmSupported()) {
-          page = 0x20;
-          qsfpImpl_->writeTransceiver(
-              TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-          qsfpImpl_->readTransceiver(
-              TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page20_), page20_);
-
-          page = 0x21;
-          qsfpImpl_->writeTransceiver(
-              TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-          qsfpImpl_->readTransceiver(
-              TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page21_), page21_);
-
-          page = 0x24;
-          qsfpImpl_->writeTransceiver(
-              TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-          qsfpImpl_->readTransceiver(
-              TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page24_), page24_);
-
-          page = 0x25;
-          qsfpImpl_->writeTransceiver(
-              TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-          qsfpImpl_->readTransceiver(
-              TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page25_), page25_);
-        }
       }
+      readCmisPageLocked(CmisPages::PAGE00, page0_, PageReadMode::FULL);
     }
+    readCmisVolatilePagesLocked(mode);
+    unparsedBytesStale_ = !allPages;
 
     if (!allPages) {
       // The information on the following pages are static. Thus no need to
@@ -1425,20 +1398,17 @@ void CmisModule::updateQsfpData(bool allPages) {
       uint8_t page = 0x01;
       qsfpImpl_->writeTransceiver(
           TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page01_), page01_);
+      readCmisPageLocked(CmisPages::PAGE01, page01_, PageReadMode::FULL);
 
       page = 0x02;
       qsfpImpl_->writeTransceiver(
           TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page02_), page02_);
+      readCmisPageLocked(CmisPages::PAGE02, page02_, PageReadMode::FULL);
 
       page = 0x13;
       qsfpImpl_->writeTransceiver(
           TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page13_), page13_);
+      readCmisPageLocked(CmisPages::PAGE13, page13_, PageReadMode::FULL);
     }
   } catch (const std::exception& ex) {
     // No matter what kind of exception throws, we need to set the dirty_ flag
@@ -1451,6 +1421,111 @@ void CmisModule::updateQsfpData(bool allPages) {
   }
 }
 
+void CmisModule::readCmisVolatilePagesLocked(PageReadMode mode) {
+  // expects the lock to be held
+  if (flatMem_) {
+    return;
+  }
+  uint8_t page = 0x10;
+  qsfpImpl_->writeTransceiver(
+      TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
+  readCmisPageLocked(CmisPages::PAGE10, page10_, mode);
+
+  page = 0x11;
+  qsfpImpl_->writeTransceiver(
+      TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
+  readCmisPageLocked(CmisPages::PAGE11, page11_, mode);
+
+  if (!getLegacyModuleStateMachineCmisModuleReady()) {
+    return;
+  }
+  page = 0x14;
+  auto diagFeature = (uint8_t)DiagnosticFeatureEncoding::SNR;
+  qsfpImpl_->writeTransceiver(
+      TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
+  qsfpImpl_->writeTransceiver(
+      TransceiverI2CApi::ADDR_QSFP, 128, sizeof(diagFeature), &diagFeature);
+  readCmisPageLocked(CmisPages::PAGE14, page14_, mode);
+
+  if (isVdmSupported()) {
+    page = 0x20;
+    qsfpImpl_->writeTransceiver(
+        TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
+    readCmisPageLocked(CmisPages::PAGE20, page20_, mode);
+
+    page = 0x21;
+    qsfpImpl_->writeTransceiver(
+        TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
+    readCmisPageLocked(CmisPages::PAGE21, page21_, mode);
+
+    page = 0x24;
+    qsfpImpl_->writeTransceiver(
+        TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
+    readCmisPageLocked(CmisPages::PAGE24, page24_, mode);
+
+    page = 0x25;
+    qsfpImpl_->writeTransceiver(
+        TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
+    readCmisPageLocked(CmisPages::PAGE25, page25_, mode);
+  }
+}
+
+void CmisModule::readCmisPageLocked(
+    int dataAddress,
+    uint8_t* pageData,
+    PageReadMode mode) {
+  // expects the lock to be held
+  static const std::map<int, std::pair<ByteRanges, ByteRanges>> fieldRanges =
+      [] {
+        std::map<int, std::pair<ByteRanges, ByteRanges>> ranges;
+        for (const auto& page : cmisPageNames) {
+          auto parsed = getFieldRanges(cmisFields, page.first);
+          auto unparsed = getComplementRanges(
+              parsed, page.first == CmisPages::LOWER ? 0 : MAX_QSFP_PAGE_SIZE);
+          ranges[page.first] = {std::move(parsed), std::move(unparsed)};
+        }
+        return ranges;
+      }();
+
+  int pageOffset = dataAddress == CmisPages::LOWER ? 0 : MAX_QSFP_PAGE_SIZE;
+  const auto& pageName = cmisPageNames.at(dataAddress);
+  switch (mode) {
+    case PageReadMode::FULL:
+      readPageRangesLocked(
+          pageName,
+          pageOffset,
+          {{pageOffset, pageOffset + MAX_QSFP_PAGE_SIZE}},
+          pageData);
+      break;
+    case PageReadMode::PARSED_FIELDS:
+      readPageRangesLocked(
+          pageName, pageOffset, fieldRanges.at(dataAddress).first, pageData);
+      break;
+    case PageReadMode::UNPARSED_BYTES:
+      readPageRangesLocked(
+          pageName, pageOffset, fieldRanges.at(dataAddress).second, pageData);
+      break;
+  }
+}
+
+void CmisModule::refreshUnparsedBytesLocked() {
+  // expects the lock to be held
+  if (!present_ || !unparsedBytesStale_) {
+    return;
+  }
+  try {
+    readCmisPageLocked(
+        CmisPages::LOWER, lowerPage_, PageReadMode::UNPARSED_BYTES);
+    readCmisVolatilePagesLocked(PageReadMode::UNPARSED_BYTES);
+    unparsedBytesStale_ = false;
+  } catch (const std::exception& ex) {
+    // Dump what we have, the next refresh will tell if the module is gone
+    XLOG(ERR) << "Error reading unparsed bytes of transceiver:"
+              << folly::to<std::string>(qsfpImpl_->getName()) << ": "
+              << ex.what();
+  }
+}
+
 void CmisModule::setApplicationCode(cfg::PortSpeed speed) {
   auto applicationIter = speedApplicationMapping.find(speed);
 
@@ -1672,10 +1747,7 @@ void CmisModule::remediateFlakyTransceiver() {
              << qsfpImpl_->getName();
 
   if (moduleResetCounter_ < kResetCounterLimit) {
-    // This api accept 1 based module id however the module id in WedgeManager
-    // is 0 based.
-    transceiverManager_->getQsfpPlatformApi()->triggerQsfpHardReset(
-        static_cast<unsigned int>(getID()) + 1);
+    transceiverManager_->triggerRemediationHardReset(getID());
     moduleResetCounter_++;
   } else {
     XLOG(DBG2) << "Reached reset limit for module " << qsfpImpl_->getName();
@@ -300,6 +300,22 @@ class CmisModule : public QsfpModule {
 
  private:
   void getFieldValueLocked(CmisField fieldName, uint8_t* fieldValue) const;
+  /*
+   * Refresh the cached copy of a page, which has to be selected already.
+   */
+  void readCmisPageLocked(
+      int dataAddress,
+      uint8_t* pageData,
+      PageReadMode mode);
+  /*
+   * Select and refresh the upper pages that change at runtime
+   */
+  void readCmisVolatilePagesLocked(PageReadMode mode);
+  /*
+   * Bring the bytes that partial refreshes skip up to date, before the
+   * pages are dumped
+   */
+  void refreshUnparsedBytesLocked();
   /*
    * Helpers to parse DOM data for DAC cables. These incorporate some
    * extra fields that FB has vendors put in the 'Vendor specific'
@@ -117,6 +117,13 @@ static SffFieldInfo::SffFieldMap qsfpFields = {
     {SffField::TXRX_OUTPUT_CONTROL, {SffPages::PAGE3, 241, 1}},
 };
 
+// Names the I2C read cost of each page is accounted under
+static std::map<int, std::string> sffPageNames = {
+    {SffPages::LOWER, "sff.lower"},
+    {SffPages::PAGE0, "sff.page00"},
+    {SffPages::PAGE3, "sff.page03"},
+};
+
 static SffFieldMultiplier qsfpMultiplier = {
     {SffField::LENGTH_SM_KM, 1000},
     {SffField::LENGTH_OM3, 2},
@@ -779,6 +786,7 @@ SffModule::getQsfpValuePtr(int dataAddress, int offset, int length) const {
 
 RawDOMData SffModule::getRawDOMData() {
   lock_guard<std::mutex> g(qsfpModuleMutex_);
+  refreshUnparsedBytesLocked();
   RawDOMData data;
   if (present_) {
     *data.lower_ref() =
@@ -793,6 +801,7 @@ RawDOMData SffModule::getRawDOMData() {
 
 DOMDataUnion SffModule::getDOMDataUnion() {
   lock_guard<std::mutex> g(qsfpModuleMutex_);
+  refreshUnparsedBytesLocked();
   Sff8636Data sffData;
   if (present_) {
     *sffData.lower_ref() =
@@ -827,9 +836,16 @@ void SffModule::updateQsfpData(bool allPages) {
     XLOG(DBG2) << "Performing " << ((allPages) ? "full" : "partial")
                << " qsfp data cache refresh for transceiver "
                << folly::to<std::string>(qsfpImpl_->getName());
-    qsfpImpl_->readTransceiver(
-        TransceiverI2CApi::ADDR_QSFP, 0, sizeof(lowerPage_), lowerPage_);
+    // Outside of full refreshes only the fields we parse are read
+    readSffPageLocked(
+        SffPages::LOWER,
+        lowerPage_,
+        allPages ? PageReadMode::FULL : PageReadMode::PARSED_FIELDS);
     lastRefreshTime_ = std::time(nullptr);
+    if (allPages) {
+      lastStaticRefreshTime_ = lastRefreshTime_;
+    }
+    unparsedBytesStale_ = !allPages;
     dirty_ = false;
     setQsfpFlatMem();
 
@@ -848,14 +864,12 @@ void SffModule::updateQsfpData(bool allPages) {
       qsfpImpl_->writeTransceiver(
           TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
     }
-    qsfpImpl_->readTransceiver(
-        TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page0_), page0_);
+    readSffPageLocked(SffPages::PAGE0, page0_, PageReadMode::FULL);
     if (!flatMem_) {
       uint8_t page = 3;
       qsfpImpl_->writeTransceiver(
           TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page3_), page3_);
+      readSffPageLocked(SffPages::PAGE3, page3_, PageReadMode::FULL);
     }
   } catch (const std::exception& ex) {
     // No matter what kind of exception throws, we need to set the dirty_ flag
@@ -868,6 +882,62 @@ void SffModule::updateQsfpData(bool allPages) {
   }
 }
 
+void SffModule::readSffPageLocked(
+    int dataAddress,
+    uint8_t* pageData,
+    PageReadMode mode) {
+  // expects the lock to be held
+  static const std::map<int, std::pair<ByteRanges, ByteRanges>> fieldRanges =
+      [] {
+        std::map<int, std::pair<ByteRanges, ByteRanges>> ranges;
+        for (const auto& page : sffPageNames) {
+          auto parsed = getFieldRanges(qsfpFields, page.first);
+          auto unparsed = getComplementRanges(
+              parsed, page.first == SffPages::LOWER ? 0 : MAX_QSFP_PAGE_SIZE);
+          ranges[page.first] = {std::move(parsed), std::move(unparsed)};
+        }
+        return ranges;
+      }();
+
+  int pageOffset = dataAddress == SffPages::LOWER ? 0 : MAX_QSFP_PAGE_SIZE;
+  const auto& pageName = sffPageNames.at(dataAddress);
+  switch (mode) {
+    case PageReadMode::FULL:
+      readPageRangesLocked(
+          pageName,
+          pageOffset,
+          {{pageOffset, pageOffset + MAX_QSFP_PAGE_SIZE}},
+          pageData);
+      break;
+    case PageReadMode::PARSED_FIELDS:
+      readPageRangesLocked(
+          pageName, pageOffset, fieldRanges.at(dataAddress).first, pageData);
+      break;
+    case PageReadMode::UNPARSED_BYTES:
+      readPageRangesLocked(
+          pageName, pageOffset, fieldRanges.at(dataAddress).second, pageData);
+      break;
+  }
+}
+
+void SffModule::refreshUnparsedBytesLocked() {
+  // expects the lock to be held
+  if (!present_ || !unparsedBytesStale_) {
+    return;
+  }
+  // Partial refreshes only ever read the lower page, no need to select a page
+  try {
+    readSffPageLocked(
+        SffPages::LOWER, lowerPage_, PageReadMode::UNPARSED_BYTES);
+    unparsedBytesStale_ = false;
+  } catch (const std::exception& ex) {
+    // Dump what we have, the next refresh will tell if the module is gone
+    XLOG(ERR) << "Error reading unparsed bytes of transceiver:"
+              << folly::to<std::string>(qsfpImpl_->getName()) << ": "
+              << ex.what();
+  }
+}
+
 void SffModule::setCdrIfSupported(
     cfg::PortSpeed speed,
     FeatureState currentStateTx,
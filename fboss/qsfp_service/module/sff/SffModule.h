@@ -256,6 +256,15 @@ class SffModule : public QsfpModule {
   void updateQsfpData(bool allPages = true) override;
 
  private:
+  /*
+   * Refresh the cached copy of a page, which has to be selected already.
+   */
+  void readSffPageLocked(int dataAddress, uint8_t* pageData, PageReadMode mode);
+  /*
+   * Bring the bytes that partial refreshes skip up to date, before the
+   * pages are dumped
+   */
+  void refreshUnparsedBytesLocked();
   /*
    * Helpers to parse DOM data for DAC cables. These incorporate some
    * extra fields that FB has vendors put in the 'Vendor specific'
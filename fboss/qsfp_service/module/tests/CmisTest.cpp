@@ -10,6 +10,7 @@
 
 #include <folly/Conv.h>
 #include <folly/Memory.h>
+#include <folly/io/IOBuf.h>
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 #include <cstdint>
@@ -434,6 +435,97 @@ TEST(Cmis400GLr4Test, transceiverInfoTest) {
   EXPECT_EQ(xcvr->numMediaLanes(), 4);
 }
 
+// Partial refreshes only read the fields we parse and skip the static pages,
+// the bytes they skip are read when the pages are dumped
+TEST(CmisTest, partialRefreshTest) {
+  gflags::FlagSaver flagSaver;
+  gflags::SetCommandLineOption("qsfp_data_refresh_interval", "0");
+  int idx = 1;
+  std::unique_ptr<Cmis200GTransceiver> qsfpImpl =
+      std::make_unique<Cmis200GTransceiver>(idx);
+  auto eeprom = qsfpImpl.get();
+
+  std::unique_ptr<CmisModule> xcvr =
+      std::make_unique<CmisModule>(nullptr, std::move(qsfpImpl), 4);
+  xcvr->refresh();
+  auto fullData = xcvr->getDOMDataUnion();
+  auto fullInfo = xcvr->getTransceiverInfo();
+  eeprom->getAndClearBytesRead();
+
+  // A parsed field (the temperature MSB), a byte no field covers and a
+  // static field (the first letter of the vendor name) change
+  eeprom->setLowerPageByte(14, 0x29);
+  eeprom->setLowerPageByte(60, 0xab);
+  eeprom->setUpperPageByte(0x00, 129, 'X');
+  xcvr->refresh();
+
+  auto bytesRead = eeprom->getAndClearBytesRead();
+  for (auto page : {0x00, 0x01, 0x02, 0x13}) {
+    EXPECT_EQ(bytesRead.count(page), 0) << "static page " << page << " read";
+  }
+  for (auto page : {FakeTransceiverImpl::kLowerPage, 0x10, 0x11, 0x14}) {
+    EXPECT_GT(bytesRead[page], 0) << "page " << page << " not read";
+    EXPECT_LT(bytesRead[page], 128) << "page " << page << " read in full";
+  }
+
+  auto partialInfo = xcvr->getTransceiverInfo();
+  TransceiverTestsHelper tests(partialInfo);
+  tests.verifyTemp(41.26953125);
+  tests.verifyVendorName(*fullInfo.vendor_ref().value_or({}).name_ref());
+
+  // Dumping the pages reads the bytes the partial refresh skipped, once
+  auto partialData = xcvr->getDOMDataUnion();
+  bytesRead = eeprom->getAndClearBytesRead();
+  EXPECT_GT(bytesRead[FakeTransceiverImpl::kLowerPage], 0);
+  EXPECT_EQ(bytesRead.count(0x00), 0);
+  xcvr->getDOMDataUnion();
+  EXPECT_TRUE(eeprom->getAndClearBytesRead().empty());
+
+  const auto& fullCmis = *fullData.cmis_ref();
+  const auto& partialCmis = *partialData.cmis_ref();
+  EXPECT_EQ(partialCmis.lower_ref()->data()[14], 0x29);
+  EXPECT_EQ(partialCmis.lower_ref()->data()[60], 0xab);
+  folly::IOBufEqualTo eq;
+  EXPECT_TRUE(eq(*fullCmis.page0_ref(), *partialCmis.page0_ref()));
+  EXPECT_TRUE(eq(*fullCmis.page11_ref(), *partialCmis.page11_ref()));
+  EXPECT_TRUE(eq(*fullCmis.page14_ref(), *partialCmis.page14_ref()));
+}
+
+// The info generation only moves when something other than the live DOM
+// readings changes
+TEST(CmisTest, infoGenerationTest) {
+  gflags::FlagSaver flagSaver;
+  gflags::SetCommandLineOption("qsfp_data_refresh_interval", "0");
+  int idx = 1;
+  std::unique_ptr<Cmis200GTransceiver> qsfpImpl =
+      std::make_unique<Cmis200GTransceiver>(idx);
+  auto eeprom = qsfpImpl.get();
+
+  std::unique_ptr<CmisModule> xcvr =
+      std::make_unique<CmisModule>(nullptr, std::move(qsfpImpl), 4);
+  xcvr->refresh();
+  auto generation = xcvr->getTransceiverInfoGeneration();
+  EXPECT_GT(generation, 0);
+  xcvr->refresh();
+  EXPECT_EQ(generation, xcvr->getTransceiverInfoGeneration());
+
+  // The temperature, voltage and lane 0 tx bias change
+  eeprom->setLowerPageByte(14, 0x29);
+  eeprom->setLowerPageByte(16, 0x82);
+  eeprom->setUpperPageByte(0x11, 170, 0x30);
+  xcvr->refresh();
+  EXPECT_EQ(generation, xcvr->getTransceiverInfoGeneration());
+  // The readings are still current
+  auto info = xcvr->getTransceiverInfo();
+  TransceiverTestsHelper tests(info);
+  tests.verifyTemp(41.26953125);
+
+  // Tx LOS is now raised on lane 2 as well
+  eeprom->setUpperPageByte(0x11, 136, 0x0f);
+  xcvr->refresh();
+  EXPECT_GT(xcvr->getTransceiverInfoGeneration(), generation);
+}
+
 TEST(CmisFlatMemTest, transceiverInfoTest) {
   int idx = 1;
   std::unique_ptr<CmisFlatMemTransceiver> qsfpImpl =
@@ -37,6 +37,7 @@ int FakeTransceiverImpl::readTransceiver(
         pageLower_.begin() + offset,
         pageLower_.begin() + offset + read,
         fieldValue);
+    bytesRead_[kLowerPage] += read;
     len -= read;
     offset = QsfpModule::MAX_QSFP_PAGE_SIZE;
   }
@@ -48,6 +49,7 @@ int FakeTransceiverImpl::readTransceiver(
         upperPages_[page_].begin() + offset,
         upperPages_[page_].begin() + offset + len,
         fieldValue + read);
+    bytesRead_[page_] += len;
     read += len;
   }
   return read;
@@ -74,6 +76,23 @@ int FakeTransceiverImpl::writeTransceiver(
   return len;
 }
 
+void FakeTransceiverImpl::setLowerPageByte(int offset, uint8_t value) {
+  pageLower_.at(offset) = value;
+}
+
+void FakeTransceiverImpl::setUpperPageByte(
+    int page,
+    int offset,
+    uint8_t value) {
+  upperPages_.at(page).at(offset - QsfpModule::MAX_QSFP_PAGE_SIZE) = value;
+}
+
+std::map<int, int> FakeTransceiverImpl::getAndClearBytesRead() {
+  std::map<int, int> bytesRead;
+  bytesRead.swap(bytesRead_);
+  return bytesRead;
+}
+
 folly::StringPiece FakeTransceiverImpl::getName() {
   return moduleName_;
 }
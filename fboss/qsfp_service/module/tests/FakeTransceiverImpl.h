@@ -36,10 +36,21 @@ class FakeTransceiverImpl : public TransceiverImpl {
   folly::StringPiece getName() override;
   int getNum() const override;
 
+  // Change the fake eeprom behind the module's back, like the module itself
+  // would. Upper page offsets start at 128.
+  void setLowerPageByte(int offset, uint8_t value);
+  void setUpperPageByte(int page, int offset, uint8_t value);
+
+  // Bytes read from each page since the last call, kLowerPage for the lower
+  // page
+  std::map<int, int> getAndClearBytesRead();
+  static constexpr int kLowerPage = -1;
+
  private:
   int module_{0};
   std::string moduleName_;
   int page_{0};
+  std::map<int, int> bytesRead_;
   std::map<int, std::array<uint8_t, 128>> upperPages_;
   std::array<uint8_t, 128> pageLower_;
 };
@@ -219,6 +219,46 @@ TEST(UnknownModuleIdentifierTest, transceiverInfoTest) {
   }
 }
 
+// Partial refreshes only read the fields we parse from the lower page, the
+// bytes they skip are read when the pages are dumped
+TEST(SffTest, partialRefreshTest) {
+  gflags::FlagSaver flagSaver;
+  gflags::SetCommandLineOption("qsfp_data_refresh_interval", "0");
+  int idx = 1;
+  std::unique_ptr<SffCwdm4Transceiver> qsfpImpl =
+      std::make_unique<SffCwdm4Transceiver>(idx);
+  auto eeprom = qsfpImpl.get();
+  std::unique_ptr<SffModule> qsfp =
+      std::make_unique<SffModule>(nullptr, std::move(qsfpImpl), 4);
+  qsfp->refresh();
+  qsfp->getDOMDataUnion();
+  eeprom->getAndClearBytesRead();
+
+  // A parsed field (the temperature MSB), a byte no field covers and a
+  // static field (the first letter of the vendor name) change
+  eeprom->setLowerPageByte(22, 0x20);
+  eeprom->setLowerPageByte(70, 0xab);
+  eeprom->setUpperPageByte(0, 148, 'X');
+  qsfp->refresh();
+
+  auto bytesRead = eeprom->getAndClearBytesRead();
+  EXPECT_EQ(bytesRead.count(0), 0);
+  EXPECT_EQ(bytesRead.count(3), 0);
+  EXPECT_GT(bytesRead[FakeTransceiverImpl::kLowerPage], 0);
+  EXPECT_LT(bytesRead[FakeTransceiverImpl::kLowerPage], 128);
+
+  TransceiverInfo info = qsfp->getTransceiverInfo();
+  TransceiverTestsHelper tests(info);
+  tests.verifyTemp(32.015625);
+  tests.verifyVendorName("FACETEST");
+
+  auto data = qsfp->getDOMDataUnion();
+  bytesRead = eeprom->getAndClearBytesRead();
+  EXPECT_GT(bytesRead[FakeTransceiverImpl::kLowerPage], 0);
+  EXPECT_EQ(bytesRead.count(0), 0);
+  EXPECT_EQ(data.sff8636_ref()->lower_ref()->data()[70], 0xab);
+}
+
 // Tests that a badly programmed module throws an exception
 TEST(BadSffTest, simpleRead) {
   int idx = 1;
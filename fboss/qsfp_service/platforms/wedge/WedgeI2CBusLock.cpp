@@ -57,6 +57,14 @@ void WedgeI2CBusLock::moduleRead(
   wedgeI2CBus_->moduleRead(module, address, offset, len, buf);
 }
 
+void WedgeI2CBusLock::moduleReadBatch(
+    unsigned int module,
+    uint8_t address,
+    const std::vector<ModuleRead>& reads) {
+  BusGuard g(this);
+  wedgeI2CBus_->moduleReadBatch(module, address, reads);
+}
+
 void WedgeI2CBusLock::moduleWrite(
     unsigned int module,
     uint8_t address,
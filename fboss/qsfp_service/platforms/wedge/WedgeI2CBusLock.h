@@ -38,6 +38,10 @@ class WedgeI2CBusLock : public TransceiverI2CApi {
       int offset,
       int len,
       const uint8_t* buf) override;
+  void moduleReadBatch(
+      unsigned int module,
+      uint8_t i2cAddress,
+      const std::vector<ModuleRead>& reads) override;
   void read(uint8_t i2cAddress, int offset, int len, uint8_t* buf);
   void write(uint8_t i2cAddress, int offset, int len, const uint8_t* buf);
 
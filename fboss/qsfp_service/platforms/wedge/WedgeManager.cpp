@@ -22,7 +22,9 @@
 #include <folly/json.h>
 #include <folly/logging/xlog.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
+#include <algorithm>
 #include <chrono>
+#include <thread>
 
 // allow us to configure the qsfp_service dir so that the qsfp cold boot test
 // can run concurrently with itself
@@ -36,9 +38,25 @@ DEFINE_bool(
     false,
     "Initialize pim xphys after creating xphy map");
 
+DEFINE_int32(
+    transceiver_refresh_timeout_ms,
+    2000,
+    "Transceivers taking longer than this to refresh are reported and "
+    "refreshed after the other transceivers on their bus");
+
+DEFINE_int32(
+    transceiver_refresh_deadline_ms,
+    10000,
+    "Transceivers whose bus is still busy this long into a refresh cycle are "
+    "skipped, and refreshed first in the next cycle");
+
+DEFINE_int32(
+    transceiver_out_of_reset_wait_ms,
+    2000,
+    "How long to wait for transceivers taken out of reset to be functional");
+
 namespace {
 
-constexpr int kSecAfterModuleOutOfReset = 2;
 constexpr auto kForceColdBootFileName = "cold_boot_once_qsfp_service";
 constexpr auto kWarmbootStateFileName = "qsfp_service_state";
 constexpr auto kPhyStateKey = "phy";
@@ -427,23 +445,122 @@ std::vector<TransceiverID> WedgeManager::refreshTransceivers() {
   // transceiver mapping and type here.
   updateTransceiverMap();
 
-  std::vector<folly::Future<folly::Unit>> futs;
   XLOG(INFO) << "Start refreshing all transceivers...";
 
   auto lockedTransceivers = transceivers_.rlock();
 
+  // Transceivers behind the same I2C controller are refreshed one after the
+  // other on the controller's event base, while the controllers are refreshed
+  // in parallel. Transceivers without an event base all share one bus.
+  std::map<folly::EventBase*, TransceiverBus> buses;
   for (const auto& transceiver : *lockedTransceivers) {
-    XLOG(DBG3) << "Fired to refresh transceiver "
-               << transceiver.second->getID();
-    transceiverIds.push_back(TransceiverID(transceiver.second->getID()));
-    futs.push_back(transceiver.second->futureRefresh());
+    transceiverIds.push_back(transceiver.first);
+    auto& bus = buses[wedgeI2cBus_->getEventBase(transceiver.first + 1)];
+    if (bus.transceivers.empty()) {
+      bus.name = folly::to<std::string>(
+          "qsfp.bus_", static_cast<int>(transceiver.first));
+    }
+    bus.transceivers.push_back(transceiver.second.get());
+  }
+  {
+    auto history = refreshHistory_.rlock();
+    auto priority = [&history](const Transceiver* transceiver) {
+      auto id = transceiver->getID();
+      if (history->skipped.count(id)) {
+        return 0;
+      }
+      return history->slow.count(id) ? 2 : 1;
+    };
+    for (auto& bus : buses) {
+      std::stable_sort(
+          bus.second.transceivers.begin(),
+          bus.second.transceivers.end(),
+          [&priority](const Transceiver* lhs, const Transceiver* rhs) {
+            return priority(lhs) < priority(rhs);
+          });
+    }
   }
 
-  folly::collectAll(futs.begin(), futs.end()).wait();
+  auto deadline = std::chrono::steady_clock::now() +
+      std::chrono::milliseconds(FLAGS_transceiver_refresh_deadline_ms);
+  std::vector<folly::Future<std::chrono::milliseconds>> futs;
+  std::vector<std::string> busNames;
+  for (auto& bus : buses) {
+    if (!bus.first) {
+      continue;
+    }
+    XLOG(DBG3) << "Fired to refresh " << bus.second.transceivers.size()
+               << " transceivers on " << bus.second.name;
+    busNames.push_back(bus.second.name);
+    futs.push_back(folly::via(bus.first).thenValue(
+        [this, &bus = bus.second, deadline](auto&&) {
+          return refreshTransceiversOnBus(bus.transceivers, deadline);
+        }));
+  }
+  if (auto it = buses.find(nullptr); it != buses.end()) {
+    busNames.push_back(it->second.name);
+    futs.push_back(folly::makeFuture(
+        refreshTransceiversOnBus(it->second.transceivers, deadline)));
+  }
+
+  auto results = folly::collectAll(futs.begin(), futs.end()).get();
+  for (size_t i = 0; i < results.size(); ++i) {
+    if (results[i].hasValue()) {
+      tcData().setCounter(
+          folly::to<std::string>(busNames[i], ".refresh_ms"),
+          results[i].value().count());
+    }
+  }
+  {
+    auto history = refreshHistory_.rlock();
+    tcData().setCounter("qsfp.refresh_skipped", history->skipped.size());
+    tcData().setCounter("qsfp.refresh_slow", history->slow.size());
+  }
   XLOG(INFO) << "Finished refreshing all transceivers";
   return transceiverIds;
 }
 
+std::chrono::milliseconds WedgeManager::refreshTransceiversOnBus(
+    const std::vector<Transceiver*>& transceivers,
+    std::chrono::steady_clock::time_point deadline) {
+  auto start = std::chrono::steady_clock::now();
+  for (auto it = transceivers.begin(); it != transceivers.end(); ++it) {
+    auto id = (*it)->getID();
+    auto refreshStart = std::chrono::steady_clock::now();
+    if (refreshStart > deadline) {
+      XLOG(WARN) << "Refresh deadline passed, skipping the remaining "
+                 << std::distance(it, transceivers.end())
+                 << " transceivers on the bus of transceiver " << id;
+      auto history = refreshHistory_.wlock();
+      for (; it != transceivers.end(); ++it) {
+        history->skipped.insert((*it)->getID());
+      }
+      break;
+    }
+
+    try {
+      (*it)->refresh();
+    } catch (const std::exception& ex) {
+      XLOG(DBG2) << "Transceiver " << id
+                 << ": Error calling refresh(): " << ex.what();
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - refreshStart);
+    auto history = refreshHistory_.wlock();
+    history->skipped.erase(id);
+    if (elapsed.count() > FLAGS_transceiver_refresh_timeout_ms) {
+      XLOG(WARN) << "Transceiver " << id << " took " << elapsed.count()
+                 << "ms to refresh, refreshing it last on its bus";
+      history->slow.insert(id);
+    } else {
+      history->slow.erase(id);
+    }
+  }
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+}
+
 int WedgeManager::scanTransceiverPresence(
     std::unique_ptr<std::vector<int32_t>> ids) {
   // If the id list is empty, we default to scan the presence of all the
@@ -469,10 +586,17 @@ int WedgeManager::scanTransceiverPresence(
 }
 
 void WedgeManager::clearAllTransceiverReset() {
-  qsfpPlatApi_->clearAllTransceiverReset();
+  auto numCleared = qsfpPlatApi_->clearTransceiversInReset();
+  auto resetTriggered = transceiversReset_.exchange(false);
+  if (numCleared == 0 && !resetTriggered) {
+    // Nothing is coming out of reset, no need to wait for it
+    return;
+  }
   // Required delay time between a transceiver getting out of reset and fully
   // functional.
-  sleep(kSecAfterModuleOutOfReset);
+  /* sleep override */
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(FLAGS_transceiver_out_of_reset_wait_ms));
 }
 
 void WedgeManager::triggerQsfpHardReset(int idx) {
@@ -486,6 +610,7 @@ void WedgeManager::triggerQsfpHardResetLocked(
   // This api accepts 1 based module id however the module id in
   // WedgeManager is 0 based.
   qsfpPlatApi_->triggerQsfpHardReset(idx + 1);
+  transceiversReset_ = true;
 
   if (auto it = lockedTransceivers->find(TransceiverID(idx));
       it != lockedTransceivers->end()) {
@@ -493,6 +618,13 @@ void WedgeManager::triggerQsfpHardResetLocked(
   }
 }
 
+void WedgeManager::triggerRemediationHardReset(TransceiverID id) {
+  TransceiverManager::triggerRemediationHardReset(id);
+  // Make the next clearAllTransceiverReset() wait for the module, as it does
+  // for resets requested through triggerQsfpHardReset()
+  transceiversReset_ = true;
+}
+
 std::unique_ptr<TransceiverI2CApi> WedgeManager::getI2CBus() {
   return std::make_unique<WedgeI2CBusLock>(std::make_unique<WedgeI2CBus>());
 }
@@ -619,6 +751,17 @@ void WedgeManager::updateTransceiverMap() {
  * That class has the function to get the I2c transaction status.
  */
 void WedgeManager::publishI2cTransactionStats() {
+  // Populate the i2c read cost per transceiver page
+  for (const auto& pageStats : getI2cPageReadStats()) {
+    auto statName = folly::to<std::string>(
+        "qsfp.page.", *pageStats.pageName__ref(), ".readTotal");
+    tcData().setCounter(statName, *pageStats.readTotal__ref());
+
+    statName = folly::to<std::string>(
+        "qsfp.page.", *pageStats.pageName__ref(), ".readBytes");
+    tcData().setCounter(statName, *pageStats.readBytes__ref());
+  }
+
   // Get the i2c transaction stats from TransactionManager class (its
   // sub-class having platform specific implementation)
   auto counters = getI2cControllerStats();
@@ -654,6 +797,10 @@ void WedgeManager::publishI2cTransactionStats() {
     statName = folly::to<std::string>(
         "qsfp.", *counter.controllerName__ref(), ".writeBytes");
     tcData().setCounter(statName, *counter.writeBytes__ref());
+
+    statName = folly::to<std::string>(
+        "qsfp.", *counter.controllerName__ref(), ".readCacheHits");
+    tcData().setCounter(statName, *counter.readCacheHits__ref());
   }
 }
 
@@ -4,6 +4,10 @@
 
 #include <boost/container/flat_map.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <set>
+
 #include "fboss/agent/AgentConfig.h"
 #include "fboss/agent/platforms/common/PlatformMapping.h"
 #include "fboss/agent/platforms/common/PlatformMode.h"
@@ -15,6 +19,9 @@
 
 DECLARE_string(qsfp_service_volatile_dir);
 DECLARE_bool(init_pim_xphys);
+DECLARE_int32(transceiver_refresh_timeout_ms);
+DECLARE_int32(transceiver_refresh_deadline_ms);
+DECLARE_int32(transceiver_out_of_reset_wait_ms);
 
 namespace facebook::fboss {
 
@@ -107,6 +114,13 @@ class WedgeManager : public TransceiverManager {
   // use of the specific implementation from each platform.
   virtual void triggerQsfpHardReset(int idx);
 
+  void triggerRemediationHardReset(TransceiverID id) override;
+
+  // For testing purpose
+  bool isTransceiverResetPending() const {
+    return transceiversReset_;
+  }
+
   /*
    * This function takes the portId, port profile id and creates phy port
    * config using platform mapping.
@@ -196,8 +210,35 @@ class WedgeManager : public TransceiverManager {
       int idx,
       LockedTransceiversPtr& lockedTransceivers);
 
+  // Transceivers sharing an I2C controller, in the order to refresh them
+  struct TransceiverBus {
+    // Named after its first transceiver, for the refresh latency counter
+    std::string name;
+    std::vector<Transceiver*> transceivers;
+  };
+
+  struct RefreshHistory {
+    // Skipped by the last refresh cycle, refreshed first on their bus
+    std::set<TransceiverID> skipped;
+    // Took longer than transceiver_refresh_timeout_ms to refresh last time,
+    // refreshed last on their bus
+    std::set<TransceiverID> slow;
+  };
+
+  /*
+   * Refresh the transceivers of a bus one after the other, skipping the
+   * ones left once the deadline has passed. Returns how long it took.
+   */
+  std::chrono::milliseconds refreshTransceiversOnBus(
+      const std::vector<Transceiver*>& transceivers,
+      std::chrono::steady_clock::time_point deadline);
+
   std::map<std::string, int> portNameToSwPort_;
   bool forceColdBoot_{false};
   folly::dynamic qsfpServiceState_;
+  folly::Synchronized<RefreshHistory> refreshHistory_;
+  // A transceiver was hard reset since we last waited for transceivers to
+  // come out of reset
+  std::atomic<bool> transceiversReset_{false};
 };
 } // namespace facebook::fboss
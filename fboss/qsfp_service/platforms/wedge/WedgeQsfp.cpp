@@ -79,6 +79,27 @@ int WedgeQsfp::readTransceiver(
   return len;
 }
 
+void WedgeQsfp::readTransceiverBatch(
+    int dataAddress,
+    const std::vector<TransceiverI2CApi::ModuleRead>& reads) {
+  try {
+    SCOPE_EXIT {
+      wedgeQsfpstats_.updateReadDownTime();
+    };
+    SCOPE_FAIL {
+      StatsPublisher::bumpReadFailure();
+    };
+    SCOPE_SUCCESS {
+      wedgeQsfpstats_.recordReadSuccess();
+    };
+    threadSafeI2CBus_->moduleReadBatch(module_ + 1, dataAddress, reads);
+  } catch (const std::exception& ex) {
+    XLOG(ERR) << "Batch of " << reads.size() << " reads from transceiver "
+              << module_ << " failed: " << ex.what();
+    throw;
+  }
+}
+
 int WedgeQsfp::writeTransceiver(
     int dataAddress,
     int offset,
@@ -78,6 +78,10 @@ class WedgeQsfp : public TransceiverImpl {
   int readTransceiver(int dataAddress, int offset, int len, uint8_t* fieldValue)
       override;
 
+  void readTransceiverBatch(
+      int dataAddress,
+      const std::vector<TransceiverI2CApi::ModuleRead>& reads) override;
+
   /* write to the eeprom (usually to change the page setting) */
   int writeTransceiver(
       int dataAddress,
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "fboss/qsfp_service/platforms/wedge/WedgeManager.h"
+#include "fboss/qsfp_service/platforms/wedge/WedgeQsfp.h"
 
 #include "fboss/lib/usb/tests/MockTransceiverI2CApi.h"
 #include "fboss/qsfp_service/module/tests/MockSffModule.h"
@@ -14,8 +15,12 @@ class MockWedgeManager : public WedgeManager {
   MockWedgeManager(
       int numModules = 16,
       int numPortsPerModule = 4,
-      std::unique_ptr<PlatformMapping> platformMapping = nullptr)
-      : WedgeManager(nullptr, std::move(platformMapping), PlatformMode::WEDGE) {
+      std::unique_ptr<PlatformMapping> platformMapping = nullptr,
+      std::unique_ptr<TransceiverPlatformApi> api = nullptr)
+      : WedgeManager(
+            std::move(api),
+            std::move(platformMapping),
+            PlatformMode::WEDGE) {
     numModules_ = numModules;
     numPortsPerModule_ = numPortsPerModule;
   }
@@ -59,6 +64,11 @@ class MockWedgeManager : public WedgeManager {
     return transceivers_;
   }
 
+  // For building transceivers to replace the ones in the transceiver map
+  std::unique_ptr<WedgeQsfp> makeQsfpImpl(int idx) {
+    return std::make_unique<WedgeQsfp>(idx, wedgeI2cBus_.get());
+  }
+
   int getNumQsfpModules() override {
     return numModules_;
   }
@@ -11,10 +11,13 @@
 #include "fboss/qsfp_service/platforms/wedge/tests/MockWedgeManager.h"
 
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
+#include "fboss/lib/usb/tests/MockTransceiverPlatformApi.h"
 #include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
+#include "fboss/qsfp_service/module/sff/SffModule.h"
 #include "fboss/qsfp_service/module/tests/MockTransceiverImpl.h"
 #include "fboss/qsfp_service/test/FakeConfigsHelper.h"
 
+#include <fb303/ServiceData.h>
 #include <folly/Memory.h>
 
 #include <gmock/gmock.h>
@@ -27,6 +30,29 @@ using namespace facebook::fboss;
 using namespace ::testing;
 namespace {
 
+// Sff module recording the order transceivers are refreshed in, and taking
+// refreshTime to refresh
+class SlowSffModule : public SffModule {
+ public:
+  SlowSffModule(
+      TransceiverManager* transceiverManager,
+      std::unique_ptr<TransceiverImpl> qsfpImpl,
+      std::vector<TransceiverID>* refreshed)
+      : SffModule(transceiverManager, std::move(qsfpImpl), 4),
+        refreshed_(refreshed) {}
+
+  void refresh() override {
+    refreshed_->push_back(getID());
+    /* sleep override */
+    std::this_thread::sleep_for(refreshTime);
+  }
+
+  std::chrono::milliseconds refreshTime{0};
+
+ private:
+  std::vector<TransceiverID>* refreshed_;
+};
+
 class WedgeManagerTest : public ::testing::Test {
  public:
   void SetUp() override {
@@ -102,6 +128,35 @@ TEST_F(WedgeManagerTest, getTransceiverInfoBasic) {
   }
 }
 
+TEST_F(WedgeManagerTest, getChangedTransceiversInfo) {
+  // All transceivers are returned the first time
+  auto changed = wedgeManager_->getChangedTransceiversInfo();
+  EXPECT_EQ(wedgeManager_->getNumQsfpModules(), changed.size());
+  EXPECT_TRUE(wedgeManager_->getChangedTransceiversInfo().empty());
+
+  // Refreshing transceivers whose data didn't change returns nothing, even
+  // though the collected time moved
+  /* sleep override */
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  wedgeManager_->refreshTransceivers();
+  EXPECT_TRUE(wedgeManager_->getChangedTransceiversInfo().empty());
+
+  // Only the removed transceiver is returned, as absent
+  wedgeManager_->overridePresence(5, false);
+  wedgeManager_->refreshTransceivers();
+  changed = wedgeManager_->getChangedTransceiversInfo();
+  ASSERT_EQ(1, changed.size());
+  EXPECT_FALSE(*changed.at(4).present_ref());
+  EXPECT_TRUE(wedgeManager_->getChangedTransceiversInfo().empty());
+
+  // And again once it is back
+  wedgeManager_->overridePresence(5, true);
+  wedgeManager_->refreshTransceivers();
+  changed = wedgeManager_->getChangedTransceiversInfo();
+  ASSERT_EQ(1, changed.size());
+  EXPECT_TRUE(*changed.at(4).present_ref());
+}
+
 TEST_F(WedgeManagerTest, getTransceiverInfoWithReadExceptions) {
   // Cause read exceptions while refreshing transceivers and confirm that
   // transceiverInfo still has the old data (this is verified by comparing
@@ -329,6 +384,104 @@ TEST_F(WedgeManagerTest, coldBootTest) {
   }
 }
 
+TEST_F(WedgeManagerTest, remediationHardResetTest) {
+  gflags::FlagSaver flagSaver;
+  // Don't actually wait for the module to come out of reset
+  FLAGS_transceiver_out_of_reset_wait_ms = 0;
+  auto api = std::make_unique<MockTransceiverPlatformApi>();
+  auto mockApi = api.get();
+  wedgeManager_.reset();
+  wedgeManager_ = std::make_unique<NiceMock<MockWedgeManager>>(
+      16, 4, nullptr, std::move(api));
+  wedgeManager_->initTransceiverMap();
+  EXPECT_FALSE(wedgeManager_->isTransceiverResetPending());
+
+  // The platform api takes 1 based module ids
+  EXPECT_CALL(*mockApi, triggerQsfpHardReset(3)).Times(1);
+  wedgeManager_->triggerRemediationHardReset(TransceiverID(2));
+  EXPECT_TRUE(wedgeManager_->isTransceiverResetPending());
+  // Unlike triggerQsfpHardReset(), the module doing the remediation is kept
+  {
+    auto transceivers = wedgeManager_->getSynchronizedTransceivers().rlock();
+    EXPECT_NE(transceivers->find(TransceiverID(2)), transceivers->end());
+  }
+
+  // Even though no transceiver is held in reset anymore, clearing the resets
+  // has to wait for the module that was reset, and consumes the reset
+  EXPECT_CALL(*mockApi, clearTransceiversInReset()).WillOnce(Return(0));
+  wedgeManager_->WedgeManager::clearAllTransceiverReset();
+  EXPECT_FALSE(wedgeManager_->isTransceiverResetPending());
+}
+
+class WedgeManagerRefreshTest : public WedgeManagerTest {
+ public:
+  void SetUp() override {
+    WedgeManagerTest::SetUp();
+    // The mock I2C bus has no event bases, so all transceivers share a bus
+    auto transceivers = wedgeManager_->getSynchronizedTransceivers().wlock();
+    for (int i = 0; i < wedgeManager_->getNumQsfpModules(); i++) {
+      auto transceiver = std::make_unique<SlowSffModule>(
+          wedgeManager_.get(), wedgeManager_->makeQsfpImpl(i), &refreshed_);
+      modules_.push_back(transceiver.get());
+      (*transceivers)[TransceiverID(i)] = std::move(transceiver);
+    }
+  }
+
+  std::vector<TransceiverID> refresh() {
+    refreshed_.clear();
+    wedgeManager_->refreshTransceivers();
+    return refreshed_;
+  }
+
+  std::vector<TransceiverID> ids(std::vector<int> order) {
+    std::vector<TransceiverID> result;
+    for (auto id : order) {
+      result.push_back(TransceiverID(id));
+    }
+    return result;
+  }
+
+  gflags::FlagSaver flagSaver_;
+  std::vector<TransceiverID> refreshed_;
+  std::vector<SlowSffModule*> modules_;
+};
+
+TEST_F(WedgeManagerRefreshTest, slowTransceiverRefreshedLast) {
+  FLAGS_transceiver_refresh_timeout_ms = 50;
+  modules_[0]->refreshTime = std::chrono::milliseconds(100);
+  EXPECT_EQ(
+      refresh(),
+      ids({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}));
+  EXPECT_EQ(fb303::fbData->getCounter("qsfp.refresh_slow"), 1);
+  EXPECT_EQ(fb303::fbData->getCounter("qsfp.refresh_skipped"), 0);
+  EXPECT_TRUE(fb303::fbData->hasCounter("qsfp.bus_0.refresh_ms"));
+
+  // Once it is fast again, it goes back to its place after one more cycle
+  modules_[0]->refreshTime = std::chrono::milliseconds(0);
+  EXPECT_EQ(
+      refresh(),
+      ids({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0}));
+  EXPECT_EQ(fb303::fbData->getCounter("qsfp.refresh_slow"), 0);
+  EXPECT_EQ(
+      refresh(),
+      ids({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}));
+}
+
+TEST_F(WedgeManagerRefreshTest, transceiversPastDeadlineSkipped) {
+  FLAGS_transceiver_refresh_deadline_ms = 50;
+  modules_[1]->refreshTime = std::chrono::milliseconds(100);
+  EXPECT_EQ(refresh(), ids({0, 1}));
+  EXPECT_EQ(fb303::fbData->getCounter("qsfp.refresh_skipped"), 14);
+  EXPECT_EQ(fb303::fbData->getCounter("qsfp.refresh_slow"), 0);
+
+  // The skipped transceivers are refreshed first in the next cycle
+  modules_[1]->refreshTime = std::chrono::milliseconds(0);
+  EXPECT_EQ(
+      refresh(),
+      ids({2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1}));
+  EXPECT_EQ(fb303::fbData->getCounter("qsfp.refresh_skipped"), 0);
+}
+
 TEST_F(WedgeManagerTest, getAndClearTransceiversSignalFlagsTest) {
   std::map<int32_t, SignalFlags> signalFlags;
 
@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/qsfp_service/lib/QsfpCache.h"
+
+#include "fboss/qsfp_service/QsfpServiceHandler.h"
+#include "fboss/qsfp_service/platforms/wedge/tests/MockWedgeManager.h"
+#include "fboss/qsfp_service/test/FakeConfigsHelper.h"
+
+#include <folly/experimental/TestUtil.h>
+#include <gflags/gflags.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <thrift/lib/cpp2/util/ScopedServerInterfaceThread.h>
+
+#include <chrono>
+#include <thread>
+
+DECLARE_string(qsfp_service_host);
+DECLARE_int32(qsfp_service_port);
+
+using namespace facebook::fboss;
+using namespace ::testing;
+
+namespace {
+
+constexpr int kNumModules = 16;
+
+// Waits up to 10 seconds for the cache to catch up with qsfp_service
+template <typename Predicate>
+bool waitFor(Predicate predicate) {
+  for (int i = 0; i < 1000; ++i) {
+    if (predicate()) {
+      return true;
+    }
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return predicate();
+}
+
+// Runs a QsfpServiceHandler with a mock WedgeManager, and a QsfpCache talking
+// to it
+class QsfpCacheTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setupFakeAgentConfig(agentCfgPath_);
+    setupFakeQsfpConfig(qsfpCfgPath_);
+    gflags::SetCommandLineOptionWithMode(
+        "qsfp_data_refresh_interval", "0", gflags::SET_FLAGS_DEFAULT);
+
+    auto wedgeManager =
+        std::make_unique<NiceMock<MockWedgeManager>>(kNumModules, 4);
+    wedgeManager->initTransceiverMap();
+    wedgeManager_ = wedgeManager.get();
+    handler_ = std::make_shared<QsfpServiceHandler>(
+        std::move(wedgeManager), nullptr);
+    server_ = std::make_unique<apache::thrift::ScopedServerInterfaceThread>(
+        handler_, "::1", 0);
+
+    FLAGS_qsfp_service_host = "::1";
+    FLAGS_qsfp_service_port = server_->getPort();
+    cache_ = std::make_unique<AutoInitQsfpCache>();
+  }
+
+  void TearDown() override {
+    cache_.reset();
+    server_.reset();
+    handler_.reset();
+  }
+
+  // What the refresh loop of qsfp_service does
+  void refreshAndPublish() {
+    wedgeManager_->refreshTransceivers();
+    handler_->publishTransceiverInfoChanges();
+  }
+
+  bool isCached(int tcvrId) {
+    return cache_->getIf(TransceiverID(tcvrId)).has_value();
+  }
+
+  gflags::FlagSaver flagSaver_;
+  folly::test::TemporaryDirectory tmpDir_;
+  std::string agentCfgPath_ = tmpDir_.path().string() + "/fakeAgentConfig";
+  std::string qsfpCfgPath_ = tmpDir_.path().string() + "/fakeQsfpConfig";
+  NiceMock<MockWedgeManager>* wedgeManager_;
+  std::shared_ptr<QsfpServiceHandler> handler_;
+  std::unique_ptr<apache::thrift::ScopedServerInterfaceThread> server_;
+  std::unique_ptr<AutoInitQsfpCache> cache_;
+};
+
+} // namespace
+
+TEST_F(QsfpCacheTest, subscriptionSyncsAllTransceivers) {
+  // The subscription response fills the cache
+  ASSERT_TRUE(waitFor([&] {
+    for (int i = 0; i < kNumModules; ++i) {
+      if (!isCached(i)) {
+        return false;
+      }
+    }
+    return true;
+  }));
+  EXPECT_TRUE(*cache_->get(TransceiverID(0)).present_ref());
+}
+
+TEST_F(QsfpCacheTest, changesAreStreamed) {
+  ASSERT_TRUE(waitFor([&] { return isCached(kNumModules - 1); }));
+
+  // Nothing was published yet, so the first publish resends everything
+  refreshAndPublish();
+  for (int i = 0; i < kNumModules; ++i) {
+    EXPECT_TRUE(isCached(i)) << "transceiver " << i;
+  }
+
+  // A removed transceiver is dropped from the cache...
+  wedgeManager_->overridePresence(5, false);
+  refreshAndPublish();
+  EXPECT_TRUE(waitFor([&] { return !isCached(4); }));
+  for (int i = 0; i < kNumModules; ++i) {
+    EXPECT_EQ(i != 4, isCached(i)) << "transceiver " << i;
+  }
+
+  // ...and added back once it is present again
+  wedgeManager_->overridePresence(5, true);
+  refreshAndPublish();
+  EXPECT_TRUE(waitFor([&] { return isCached(4); }));
+  EXPECT_TRUE(*cache_->get(TransceiverID(4)).present_ref());
+}